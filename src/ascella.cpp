@@ -26,7 +26,7 @@ void ASCELLA::setLEDStatusMode(camLedMode ledMode, QString brightnessVal){
     int bytesSent;
     u_int8_t brightnessIntVal;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setLEDStatusMode: Handle is Null");
         return void();
     }
@@ -45,7 +45,7 @@ void ASCELLA::setLEDStatusMode(camLedMode ledMode, QString brightnessVal){
         brightnessIntVal = brightnessVal.toInt();
         g_out_packet_buf[3] = (unsigned char)(brightnessIntVal & 0xFF);
 
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -69,7 +69,7 @@ void ASCELLA::setAutoFocusMode(camAfMode afMode){
 
     int bytesSent;
 
-    if(uvccamera::handle == NULL)
+    if(uvc.usbHandle() == NULL)
     {
         emit logHandle(QtCriticalMsg, "setAutoFocusMode: Handle is Null");
         return void();
@@ -85,7 +85,7 @@ void ASCELLA::setAutoFocusMode(camAfMode afMode){
         else if(afMode == OneShot)
             g_out_packet_buf[2] = 0x00;
 
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -110,7 +110,7 @@ void ASCELLA::setExposureCompensation(QString exposureVal){
     int bytesSent;
     u_int8_t exposureIntVal;
 
-    if(uvccamera::handle == NULL)
+    if(uvc.usbHandle() == NULL)
     {
         emit logHandle(QtCriticalMsg, "setExposureCompensation: Handle is Null");
         return void();
@@ -122,7 +122,7 @@ void ASCELLA::setExposureCompensation(QString exposureVal){
     exposureIntVal = exposureVal.toInt();
     g_out_packet_buf[2] = (unsigned char)(exposureIntVal & 0xFF);
 
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                         0x21,
                                         0x09,
                                         0x200,
@@ -141,7 +141,7 @@ void ASCELLA::setSceneMode(camSceneMode sceneMode){
 
     int bytesSent;
 
-    if(uvccamera::handle == NULL)
+    if(uvc.usbHandle() == NULL)
     {
         emit logHandle(QtCriticalMsg, "setSceneMode: Handle is Null");
         return void();
@@ -155,7 +155,7 @@ void ASCELLA::setSceneMode(camSceneMode sceneMode){
         else if(sceneMode == 0x02)
             g_out_packet_buf[2] = 0x20;
 
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -182,7 +182,7 @@ void ASCELLA::setNoiseReduceMode(camNoiseReduceMode NoiseReduceMode, QString Noi
     int bytesSent;
     u_int8_t noiseReduceFixIntVal;    
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setNoiseReduceMode: Handle is Null");
         return void();
     }
@@ -199,7 +199,7 @@ void ASCELLA::setNoiseReduceMode(camNoiseReduceMode NoiseReduceMode, QString Noi
             g_out_packet_buf[2] = (unsigned char)(noiseReduceFixIntVal & 0xFF);
        }
 
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -225,7 +225,7 @@ void ASCELLA::setLimitMaxFrameRateMode(camLimitMaxFRMode LimitMaxFRMode, QString
     int bytesSent;
     u_int8_t maxFRIntVal;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setLimitMaxFrameRate: Handle is Null");
         return void();
     }
@@ -239,7 +239,7 @@ void ASCELLA::setLimitMaxFrameRateMode(camLimitMaxFRMode LimitMaxFRMode, QString
             maxFRIntVal = maxFrameRateVal.toInt();
             g_out_packet_buf[2] = (unsigned char)(maxFRIntVal & 0xFF);
         }
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -264,7 +264,7 @@ void ASCELLA::setColorMode(camColorMode colorMode, QString blackwhiteThreshold){
     int bytesSent;
     u_int8_t bwThresholdIntVal;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setColorMode: Handle is Null");
         return void();
     }
@@ -285,7 +285,7 @@ void ASCELLA::setColorMode(camColorMode colorMode, QString blackwhiteThreshold){
             g_out_packet_buf[3] = bwThresholdIntVal;
         }
 
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -311,7 +311,7 @@ void ASCELLA::setCenterWeightedAutoFocus(){
 
     int bytesSent;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setCenterWeightedAutoFocus: Handle is Null");
         return void();
     }
@@ -320,7 +320,7 @@ void ASCELLA::setCenterWeightedAutoFocus(){
     g_out_packet_buf[1] = 0xFF;
     g_out_packet_buf[2] = 0x01;
 
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                         0x21,
                                         0x09,
                                         0x200,
@@ -344,7 +344,7 @@ bool ASCELLA::setCustomAreaAutoFocus(QString afHoriStart, QString afHoriEnd, QSt
     int afVertiStartIntVal;
     int afVertiEndIntVal;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setCustomWeightedAutoFocus: Handle is Null");
         return false;
     }
@@ -372,7 +372,7 @@ bool ASCELLA::setCustomAreaAutoFocus(QString afHoriStart, QString afHoriEnd, QSt
     g_out_packet_buf[9] = (afVertiEndIntVal >> 8);
     g_out_packet_buf[10] = (afVertiEndIntVal >> 0);
 
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                         0x21,
                                         0x09,
                                         0x200,
@@ -392,7 +392,7 @@ void ASCELLA::setBinnedResizedMode(camBinnResizeMode mode){
 
     int bytesSent;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setBinnedResizedMode: Handle is Null");
         return void();
     }
@@ -402,7 +402,7 @@ void ASCELLA::setBinnedResizedMode(camBinnResizeMode mode){
         g_out_packet_buf[1] = 0xEE;
         g_out_packet_buf[2] = mode;
 
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -426,7 +426,7 @@ void ASCELLA::setQFactor(camQFactorMode qFactorMode, QString qFactorValue){
 
     int bytesSent;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "setQFactor: Handle is Null");
         return void();
     }
@@ -438,7 +438,7 @@ void ASCELLA::setQFactor(camQFactorMode qFactorMode, QString qFactorValue){
         g_out_packet_buf[2] = qFactorMode;
         g_out_packet_buf[3] = (unsigned char)qFactorValue.toUInt();
 
-        bytesSent = libusb_control_transfer(uvccamera::handle,
+        bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                             0x21,
                                             0x09,
                                             0x200,
@@ -464,7 +464,7 @@ void ASCELLA::setQFactor(camQFactorMode qFactorMode, QString qFactorValue){
 void ASCELLA::setRollValue(QString rollValue){
     int bytesSent;
     u_int8_t rollIntVal;
-    if(uvccamera::handle == NULL)
+    if(uvc.usbHandle() == NULL)
     {
         emit logHandle(QtCriticalMsg, "setRollValue: Handle is Null");
         return void();
@@ -475,7 +475,7 @@ void ASCELLA::setRollValue(QString rollValue){
     g_out_packet_buf[1] = 0x00;
     rollIntVal = rollValue.toInt();
     g_out_packet_buf[2] = (unsigned char)(rollIntVal & 0xFF);
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                         0x21,
                                         0x09,
                                         0x200,
@@ -563,7 +563,7 @@ void ASCELLA::getDefaultValues(u_int8_t *pDefaultValue){
 
     int bytesSent;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "getDefaultValues: Handle is Null");
         return void();
     }
@@ -575,7 +575,7 @@ void ASCELLA::getDefaultValues(u_int8_t *pDefaultValue){
     g_out_packet_buf[2] = 1;
 
     // Sending the request command to get default values - output buffer
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                         0x21,
                                         0x09,
                                         0x200,
@@ -590,7 +590,7 @@ void ASCELLA::getDefaultValues(u_int8_t *pDefaultValue){
     }
 
     // Getting the response - in buffer
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                         0xA1,
                                         0x01,
                                         0x100,
@@ -626,7 +626,7 @@ void ASCELLA::getDefaultValues(u_int8_t *pDefaultValue){
 void ASCELLA::getCurrentValues(u_int8_t *pCurrentValue){
     int bytesSent;
 
-    if(uvccamera::handle == NULL){
+    if(uvc.usbHandle() == NULL){
         emit logHandle(QtCriticalMsg, "getCurrentValues: Handle is Null");
         return void();
     }
@@ -638,7 +638,7 @@ void ASCELLA::getCurrentValues(u_int8_t *pCurrentValue){
     g_out_packet_buf[2] = 2;
 
     // Sending the request command to get current values - output buffer
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                         0x21,
                                         0x09,
                                         0x200,
@@ -652,7 +652,7 @@ void ASCELLA::getCurrentValues(u_int8_t *pCurrentValue){
     }
 
     usleep(100000); // sleep for 100ms
-    bytesSent = libusb_control_transfer(uvccamera::handle,
+    bytesSent = libusb_control_transfer(uvc.usbHandle(),
                                                0xA1, // req type
                                                0x01, // request
                                                0x100, // value
@@ -40,6 +40,14 @@
 #include <sys/time.h>
 #include <libintl.h>
 #include <math.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 #include <QTimer>
 #include <QAudioDeviceInfo>
 #include <QAudioInput>
@@ -62,10 +70,15 @@ static u_int32_t latency_ms = 15;
 static pa_usec_t latency = 0;
 static int sample_index = 0;
 static audio_buff_t *audio_buffers = NULL; /*pointer to buffers list*/
-static int buffer_read_index = 0; /*current read index of buffer list*/
-static int buffer_write_index = 0;/*current write index of buffer list*/
-
-static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+/*
+ * single producer [capture thread] / single consumer [encoder thread] ring:
+ * indexes only grow, slot = index % AUDBUFF_NUM. The producer owns
+ * buffer_write_index, the consumer owns buffer_read_index, each side
+ * reads the other index with acquire and publishes its own with release.
+ */
+static unsigned int buffer_read_index = 0; /*buffers consumed*/
+static unsigned int buffer_write_index = 0;/*buffers produced*/
+static unsigned int buffers_dropped = 0;
 
 
 
@@ -169,6 +182,9 @@ qint64 AudioInfo::writeData(const char *data, qint64 len)
 AudioInput::AudioInput()
 {
     audio_buff = NULL;
+    audio_context = NULL;
+    alsaPeriodFrames = ALSA_PERIOD_FRAMES;
+    alsaPcm = NULL;
 }
 
 AudioInput::~AudioInput()
@@ -331,6 +347,7 @@ void AudioInput::pa_sourcelist_cb(pa_context *c, const pa_source_info *l, int eo
 
         /*fill device data*/
         audio_ctx->list_devices[audio_ctx->num_input_dev-1].id = l->index; /*saves dev id*/
+        audio_ctx->list_devices[audio_ctx->num_input_dev-1].api = AUDIO_API_PULSE;
         strncpy(audio_ctx->list_devices[audio_ctx->num_input_dev-1].name,  l->name, 511);
         strncpy(audio_ctx->list_devices[audio_ctx->num_input_dev-1].description, l->description, 255);
         audio_ctx->list_devices[audio_ctx->num_input_dev-1].channels = channels;
@@ -529,34 +546,41 @@ void AudioInput::audio_fill_buffer(audio_context_t *audio_ctx, int64_t ts, void
      uint64_t frame_length = NSEC_PER_SEC / audio_ctx->samprate;
      uint64_t buffer_length = frame_length * (audio_ctx->capture_buff_size / audio_ctx->channels);
 
+     /*generated timestamps count samples from the monotonic time of the first one*/
+     if(audio_ctx->snd_begintime <= 0)
+     {
+         audio_ctx->snd_begintime = ts - buffer_length;
+         audio_ctx->current_ts = audio_ctx->snd_begintime;
+     }
+
      audio_ctx->current_ts += buffer_length; /*buffer end time*/
 
      audio_ctx->ts_drift = audio_ctx->current_ts - ts;
 
-     /*get the current write indexed buffer flag*/
-     pthread_mutex_lock(&mutex);
-     int flag = audio_buffers[buffer_write_index].flag;
-     pthread_mutex_unlock(&mutex);
-     if(flag == AUDIO_BUFF_USED)
+     /*ring full - the consumer did not keep up*/
+     unsigned int write_index = buffer_write_index;
+     if(write_index - __atomic_load_n(&buffer_read_index, __ATOMIC_ACQUIRE) >= AUDBUFF_NUM)
      {
-         fprintf(stderr, "AUDIO: write buffer(%i) is still in use - dropping data\n", buffer_write_index);
+         if((buffers_dropped++ % 100) == 0)
+             fprintf(stderr, "AUDIO: ring buffer full - dropping data (%u buffers dropped)\n", buffers_dropped);
          return;
      }
 
+     audio_buff_t *audio_buff = &audio_buffers[write_index % AUDBUFF_NUM];
+
      /*write max_frames and fill a buffer*/
-     memcpy(audio_buffers[buffer_write_index].data,
+     memcpy(audio_buff->data,
          audio_ctx->capture_buff,
          audio_ctx->capture_buff_size * sizeof(sample_t));
      /*buffer begin time*/
-     audio_buffers[buffer_write_index].timestamp = audio_ctx->current_ts - buffer_length;
+     audio_buff->timestamp = audio_ctx->current_ts - buffer_length;
+     audio_buff->ts_drift = audio_ctx->ts_drift;
 
-     audio_buffers[buffer_write_index].level_meter[0] = audio_ctx->capture_buff_level[0];
-     audio_buffers[buffer_write_index].level_meter[1] = audio_ctx->capture_buff_level[1];
+     audio_buff->level_meter[0] = audio_ctx->capture_buff_level[0];
+     audio_buff->level_meter[1] = audio_ctx->capture_buff_level[1];
 
-     pthread_mutex_lock(&mutex);
-     audio_buffers[buffer_write_index].flag = AUDIO_BUFF_USED;
-     NEXT_IND(buffer_write_index, AUDBUFF_NUM);
-     pthread_mutex_unlock(&mutex);
+     /*publish the buffer*/
+     __atomic_store_n(&buffer_write_index, write_index + 1, __ATOMIC_RELEASE);
 
      audioInput->captureAudio();
 
@@ -816,6 +840,313 @@ void AudioInput::recordAudio(){
     return ((void *) 0);
 }
 
+/*
+ * add the alsa capture devices to the device list, every capture pcm of a
+ * card is listed twice: hw: (no conversion, lowest latency) and plughw:
+ * (alsa converts format, rate and channels)
+ * args:
+ *    audio_ctx - pointer to audio context
+ *
+ * asserts:
+ *    audio_ctx is not null
+ *
+ * returns: number of devices added
+ */
+int AudioInput::alsa_get_devicelist(audio_context_t *audio_ctx)
+{
+    assert(audio_ctx != NULL);
+
+    int added = 0;
+    int card = -1;
+    while (snd_card_next(&card) == 0 && card >= 0)
+    {
+        char ctl_name[32];
+        snd_ctl_t *ctl;
+        snprintf(ctl_name, sizeof(ctl_name), "hw:%d", card);
+        if (snd_ctl_open(&ctl, ctl_name, 0) < 0)
+            continue;
+
+        snd_ctl_card_info_t *card_info;
+        snd_ctl_card_info_alloca(&card_info);
+        if (snd_ctl_card_info(ctl, card_info) < 0)
+        {
+            snd_ctl_close(ctl);
+            continue;
+        }
+
+        int pcm_device = -1;
+        while (snd_ctl_pcm_next_device(ctl, &pcm_device) == 0 && pcm_device >= 0)
+        {
+            snd_pcm_info_t *pcm_info;
+            snd_pcm_info_alloca(&pcm_info);
+            snd_pcm_info_set_device(pcm_info, pcm_device);
+            snd_pcm_info_set_subdevice(pcm_info, 0);
+            snd_pcm_info_set_stream(pcm_info, SND_PCM_STREAM_CAPTURE);
+            if (snd_ctl_pcm_info(ctl, pcm_info) < 0)
+                continue; /*playback only*/
+
+            /*probe the native channels and rate, a device held by pulse reports the defaults*/
+            int channels = 2;
+            unsigned int rate = 48000;
+            char hw_name[64];
+            snd_pcm_t *pcm;
+            snprintf(hw_name, sizeof(hw_name), "hw:%d,%d", card, pcm_device);
+            if (snd_pcm_open(&pcm, hw_name, SND_PCM_STREAM_CAPTURE, SND_PCM_NONBLOCK) == 0)
+            {
+                snd_pcm_hw_params_t *hw_params;
+                snd_pcm_hw_params_alloca(&hw_params);
+                if (snd_pcm_hw_params_any(pcm, hw_params) >= 0)
+                {
+                    unsigned int max_channels = 0;
+                    if (snd_pcm_hw_params_get_channels_max(hw_params, &max_channels) == 0 && max_channels > 0)
+                        channels = max_channels > 2 ? 2 : max_channels;
+                    if (snd_pcm_hw_params_test_rate(pcm, hw_params, 48000, 0) != 0)
+                    {
+                        if (snd_pcm_hw_params_test_rate(pcm, hw_params, 44100, 0) == 0)
+                            rate = 44100;
+                        else
+                            snd_pcm_hw_params_get_rate_min(hw_params, &rate, NULL);
+                    }
+                }
+                snd_pcm_close(pcm);
+            }
+
+            for (int plug = 0; plug < 2; plug++)
+            {
+                audio_ctx->num_input_dev++;
+                audio_ctx->list_devices = (audio_device_t *)realloc(audio_ctx->list_devices, audio_ctx->num_input_dev * sizeof(audio_device_t));
+                if(audio_ctx->list_devices == NULL)
+                {
+                    fprintf(stderr,"AUDIO: FATAL memory allocation failure (alsa_get_devicelist): %s\n", strerror(errno));
+                    exit(-1);
+                }
+                devIndex++;
+
+                audio_device_t *dev = &audio_ctx->list_devices[audio_ctx->num_input_dev-1];
+                memset(dev, 0, sizeof(audio_device_t));
+                dev->id = card;
+                dev->api = AUDIO_API_ALSA;
+                snprintf(dev->name, sizeof(dev->name), "%shw:%d,%d", plug ? "plug" : "", card, pcm_device);
+                snprintf(dev->description, sizeof(dev->description), "ALSA %s: %s (%s)",
+                         plug ? "plughw" : "hw", snd_ctl_card_info_get_name(card_info), snd_pcm_info_get_name(pcm_info));
+                dev->channels = channels;
+                dev->samprate = rate;
+                dev->low_latency = (double) latency_ms / 1000;
+                dev->high_latency = dev->low_latency;
+
+                audioDeviceList.append(dev->description);
+                audioDeviceMap.insertMulti(devIndex, dev->name);
+                audioDeviceSampleRateMap.insertMulti(dev->name, dev->samprate);
+                audioDeviceChannelsMap.insertMulti(dev->name, dev->channels);
+                added++;
+            }
+        }
+        snd_ctl_close(ctl);
+    }
+    return added;
+}
+
+/*
+ * open and configure an alsa capture device for interleaved mmap access
+ * args:
+ *    audio_ctx - pointer to audio context (device, channels and rate)
+ *    period - period size in frames
+ *    format - set to the negotiated sample format (float or s16)
+ *
+ * asserts:
+ *    none
+ *
+ * returns: pcm handle or NULL on error
+ */
+snd_pcm_t *AudioInput::alsa_open_capture(audio_context_t *audio_ctx, snd_pcm_uframes_t period, snd_pcm_format_t *format)
+{
+    snd_pcm_t *pcm = NULL;
+    snd_pcm_hw_params_t *hw_params;
+    snd_pcm_sw_params_t *sw_params;
+    const char *dev = audio_ctx->list_devices[audio_ctx->device].name;
+    unsigned int rate = audio_ctx->samprate;
+    snd_pcm_uframes_t buffer_size = period * ALSA_PERIODS;
+    int err;
+
+    if ((err = snd_pcm_open(&pcm, dev, SND_PCM_STREAM_CAPTURE, 0)) < 0)
+    {
+        fprintf(stderr, "AUDIO: (alsa) can't open %s: %s\n", dev, snd_strerror(err));
+        return NULL;
+    }
+
+    snd_pcm_hw_params_alloca(&hw_params);
+    snd_pcm_hw_params_any(pcm, hw_params);
+    if ((err = snd_pcm_hw_params_set_access(pcm, hw_params, SND_PCM_ACCESS_MMAP_INTERLEAVED)) < 0)
+    {
+        fprintf(stderr, "AUDIO: (alsa) %s has no mmap access: %s\n", dev, snd_strerror(err));
+        snd_pcm_close(pcm);
+        return NULL;
+    }
+    /*float is what the ring holds, most hw: devices only offer s16*/
+    *format = SND_PCM_FORMAT_FLOAT_LE;
+    if (snd_pcm_hw_params_set_format(pcm, hw_params, *format) < 0)
+    {
+        *format = SND_PCM_FORMAT_S16_LE;
+        if ((err = snd_pcm_hw_params_set_format(pcm, hw_params, *format)) < 0)
+        {
+            fprintf(stderr, "AUDIO: (alsa) no supported sample format on %s: %s\n", dev, snd_strerror(err));
+            snd_pcm_close(pcm);
+            return NULL;
+        }
+    }
+    if ((err = snd_pcm_hw_params_set_channels(pcm, hw_params, audio_ctx->channels)) < 0 ||
+        (err = snd_pcm_hw_params_set_rate_near(pcm, hw_params, &rate, NULL)) < 0 ||
+        (err = snd_pcm_hw_params_set_period_size_near(pcm, hw_params, &period, NULL)) < 0 ||
+        (err = snd_pcm_hw_params_set_buffer_size_near(pcm, hw_params, &buffer_size)) < 0 ||
+        (err = snd_pcm_hw_params(pcm, hw_params)) < 0)
+    {
+        fprintf(stderr, "AUDIO: (alsa) can't configure %s (chan:%d rate:%d): %s\n",
+                dev, audio_ctx->channels, audio_ctx->samprate, snd_strerror(err));
+        snd_pcm_close(pcm);
+        return NULL;
+    }
+    if ((int) rate != audio_ctx->samprate)
+    {
+        fprintf(stderr, "AUDIO: (alsa) %s runs at %u Hz instead of %d Hz\n", dev, rate, audio_ctx->samprate);
+        audio_ctx->samprate = rate;
+    }
+
+    /*wake up once per period*/
+    snd_pcm_sw_params_alloca(&sw_params);
+    snd_pcm_sw_params_current(pcm, sw_params);
+    snd_pcm_sw_params_set_avail_min(pcm, sw_params, period);
+    snd_pcm_sw_params_set_start_threshold(pcm, sw_params, 1);
+    if ((err = snd_pcm_sw_params(pcm, sw_params)) < 0)
+        fprintf(stderr, "AUDIO: (alsa) sw params not applied: %s\n", snd_strerror(err));
+
+    printf("AUDIO: (alsa) capturing from %s\n\t (channels %d rate %u period %lu buffer %lu %s)\n",
+           dev, audio_ctx->channels, rate, (unsigned long) period, (unsigned long) buffer_size,
+           *format == SND_PCM_FORMAT_FLOAT_LE ? "float" : "s16");
+    return pcm;
+}
+
+/*
+ * capture loop for alsa devices, runs under it's own thread started by
+ * audio_start_pulseaudio with real time priority when allowed. The pcm is
+ * already open and running, samples are read in place from the mmap area
+ * and stored in the same ring as the pulse path.
+ * args:
+ *   arg - pointer to AudioInput
+ *
+ * asserts:
+ *   none
+ *
+ * returns: pointer to error code
+ */
+void *AudioInput::alsa_read_audio(void *arg)
+{
+    AudioInput *audioInput = static_cast<AudioInput *>(arg);
+    audio_context_t *audio_ctx = audioInput->audio_context;
+    snd_pcm_t *pcm = audioInput->alsaPcm;
+    snd_pcm_format_t format = audioInput->alsaFormat;
+    int err;
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 10;
+    if ((err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)) != 0)
+        fprintf(stderr, "AUDIO: (alsa) real time priority not granted: %s\n", strerror(err));
+
+    uint64_t frame_length = NSEC_PER_SEC / audio_ctx->samprate; /*in nanosec*/
+    sample_t *capture_buff = (sample_t *) audio_ctx->capture_buff;
+    int samples_stored = 0;
+    int chan = 0;
+
+    while (audio_ctx->stream_flag == AUDIO_STRM_ON)
+    {
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(pcm);
+        if (avail < 0)
+        {
+            fprintf(stderr, "AUDIO: (alsa) overrun: %s\n", snd_strerror(avail));
+            if (snd_pcm_recover(pcm, avail, 1) < 0 || snd_pcm_start(pcm) < 0)
+                break;
+            continue;
+        }
+        if (avail < audioInput->alsaPeriodFrames)
+        {
+            /*timeout keeps the stop flag responsive*/
+            err = snd_pcm_wait(pcm, 100);
+            if (err < 0 && snd_pcm_recover(pcm, err, 1) < 0)
+                break;
+            continue;
+        }
+
+        /*the oldest available frame was captured delay frames ago*/
+        snd_pcm_sframes_t delay = avail;
+        snd_pcm_delay(pcm, &delay);
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int64_t ts = (int64_t) now.tv_sec * NSEC_PER_SEC + now.tv_nsec - (int64_t) delay * (int64_t) frame_length;
+        if (audio_ctx->last_ts <= 0)
+            audio_ctx->last_ts = ts;
+
+        const snd_pcm_channel_area_t *areas;
+        snd_pcm_uframes_t offset;
+        snd_pcm_uframes_t frames = avail;
+        if ((err = snd_pcm_mmap_begin(pcm, &areas, &offset, &frames)) < 0)
+        {
+            if (snd_pcm_recover(pcm, err, 1) < 0)
+                break;
+            continue;
+        }
+
+        /*interleaved - all channels are in the first area*/
+        const uint8_t *base = (const uint8_t *) areas[0].addr + (areas[0].first + offset * areas[0].step) / 8;
+        uint32_t numSamples = frames * audio_ctx->channels;
+        for (uint32_t i = 0; i < numSamples; ++i)
+        {
+            sample_t sample;
+            if (format == SND_PCM_FORMAT_FLOAT_LE)
+                sample = ((const float *) base)[i];
+            else
+                sample = ((const int16_t *) base)[i] / 32768.0f;
+            capture_buff[samples_stored++] = sample;
+
+            /*store peak value*/
+            if (audio_ctx->capture_buff_level[chan] < sample)
+                audio_ctx->capture_buff_level[chan] = sample;
+            chan++;
+            if (chan >= audio_ctx->channels)
+                chan = 0;
+
+            if (samples_stored >= audio_ctx->capture_buff_size)
+            {
+                /*timestamp of the last frame of the buffer*/
+                int64_t buff_ts = ts + (i / audio_ctx->channels) * frame_length;
+                audio_fill_buffer(audio_ctx, buff_ts, arg);
+                audio_ctx->capture_buff_level[0] = 0;
+                audio_ctx->capture_buff_level[1] = 0;
+                samples_stored = 0;
+            }
+        }
+
+        snd_pcm_sframes_t committed = snd_pcm_mmap_commit(pcm, offset, frames);
+        if (committed < 0 || (snd_pcm_uframes_t) committed != frames)
+        {
+            if (snd_pcm_recover(pcm, committed >= 0 ? -EPIPE : committed, 1) < 0 || snd_pcm_start(pcm) < 0)
+                break;
+        }
+    }
+
+    printf("AUDIO: (alsa) stream terminated(%i)\n", audio_ctx->stream_flag);
+    snd_pcm_drop(pcm);
+    snd_pcm_close(pcm);
+    audioInput->alsaPcm = NULL;
+    return ((void *) 0);
+}
+
+void AudioInput::setAlsaPeriodSize(int frames)
+{
+    if (frames < 32)
+        frames = 32;
+    alsaPeriodFrames = frames;
+}
+
 bool AudioInput::audio_init()
 {    
     audioDeviceList.clear();
@@ -1014,8 +1345,14 @@ audio_context_t* AudioInput::audio_init_pulseaudio()
     }
 
     if (pa_get_devicelist(audio_ctx) < 0)
-    {
         fprintf(stderr, "AUDIO: Pulseaudio failed to get audio device list from PULSE server\n");
+
+    /*capture devices are also listed for direct alsa access, works without a pulse server*/
+    alsa_get_devicelist(audio_ctx);
+
+    if (audio_ctx->num_input_dev == 0)
+    {
+        fprintf(stderr, "AUDIO: no audio input device found\n");
         free(audio_ctx);
         return NULL;
     }
@@ -1086,7 +1423,7 @@ int AudioInput::audio_init_buffers(audio_context_t *audio_ctx)
     }
 
     /*free audio_buffers (if any)*/
-    audio_free_buffers;
+    audio_free_buffers();
 
     audio_buffers = (audio_buff_t *)calloc(AUDBUFF_NUM, sizeof(audio_buff_t));
     if(audio_buffers == NULL)
@@ -1104,8 +1441,10 @@ int AudioInput::audio_init_buffers(audio_context_t *audio_ctx)
             fprintf(stderr,"AUDIO: FATAL memory allocation failure (audio_init_buffers): %s\n", strerror(errno));
             exit(-1);
         }
-        audio_buffers[i].flag = AUDIO_BUFF_FREE;
     }
+    buffer_read_index = 0;
+    buffer_write_index = 0;
+    buffers_dropped = 0;
 
     return 0;
 }
@@ -1131,6 +1470,7 @@ int AudioInput::audio_free_buffers()
 
     free(audio_buffers);
     audio_buffers = NULL;
+    return 0;
 }
 
 
@@ -1149,6 +1489,24 @@ int AudioInput::audio_start_pulseaudio(VideoEncoder videoEncoder)
     /*assertions*/
     assert(audio_context != NULL);
 
+    audio_context->api = audio_context->list_devices[audio_context->device].api;
+
+    /*open the alsa device here, so a busy or unsupported device fails the start*/
+    if(audio_context->api == AUDIO_API_ALSA)
+    {
+        int err;
+        alsaPcm = alsa_open_capture(audio_context, alsaPeriodFrames, &alsaFormat);
+        if(alsaPcm == NULL)
+            return (-1);
+        if((err = snd_pcm_start(alsaPcm)) < 0)
+        {
+            fprintf(stderr, "AUDIO: (alsa) snd_pcm_start failed: %s\n", snd_strerror(err));
+            snd_pcm_close(alsaPcm);
+            alsaPcm = NULL;
+            return (-1);
+        }
+    }
+
     /*alloc the ring buffer*/
     audio_init_buffers(audio_context);
 
@@ -1160,11 +1518,17 @@ int AudioInput::audio_start_pulseaudio(VideoEncoder videoEncoder)
 
     audio_context->stream_flag = AUDIO_STRM_ON;
 
-    /* start audio capture thread */
-    if(pthread_create(&my_read_thread, NULL, pulse_read_audio, this))
+    /* start audio capture thread, alsa devices of the list are read directly */
+    if(pthread_create(&my_read_thread, NULL,
+                      audio_context->api == AUDIO_API_ALSA ? alsa_read_audio : pulse_read_audio, this))
     {
-        fprintf(stderr, "AUDIO: (pulseaudio) read thread creation failed\n");
+        fprintf(stderr, "AUDIO: read thread creation failed\n");
         audio_context->stream_flag = AUDIO_STRM_OFF;
+        if(alsaPcm)
+        {
+            snd_pcm_close(alsaPcm);
+            alsaPcm = NULL;
+        }
         return (-1);
     }
 
@@ -1197,7 +1561,7 @@ int AudioInput::audio_stop_pulseaudio()
 
     pthread_join(my_read_thread, NULL);
 
-    printf("AUDIO: (pulseaudio) read thread joined\n");
+    printf("AUDIO: read thread joined\n");
 
     return 0;
 }
@@ -1271,11 +1635,58 @@ audio_buff_t *AudioInput::audio_get_buffer()
 
 int16_t AudioInput::clip_int16 (float in)
 {
-    //int16_t out = (int16_t) (in < -32768) ? -32768 : (in > 32767) ? 32767 : in;
+    /* round half away from zero as the vector bodies of float_to_int16 do: add +-0.5 in float, truncate */
+    in += (in < 0) ? -0.5f : 0.5f;
+    if(in <= -32768.0f)
+        return -32768;
+    if(in >= 32767.0f)
+        return 32767;
+    return (int16_t) in;
+}
 
-    long lout =  lroundf(in);
-    int16_t out = (lout < -32768) ? -32768 : (lout > 32767) ? 32767: (int16_t) lout;
-    return (out);
+/*
+ * convert float samples [-1.0, 1.0] to clipped int16
+ * args:
+ *   out - int16 destination
+ *   in - float source
+ *   samples - number of samples
+ *
+ * asserts:
+ *   none
+ *
+ * returns: none
+ */
+void AudioInput::float_to_int16(int16_t *out, const float *in, int samples)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    for(; i + 8 <= samples; i += 8)
+    {
+        __m128 a = _mm_mul_ps(_mm_loadu_ps(in + i), scale);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(in + i + 4), scale);
+        /* round half away from zero, cvttps truncates, packs saturates to int16 */
+        a = _mm_add_ps(a, _mm_or_ps(_mm_and_ps(a, sign), half));
+        b = _mm_add_ps(b, _mm_or_ps(_mm_and_ps(b, sign), half));
+        _mm_storeu_si128((__m128i *)(out + i), _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b)));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float32x4_t scale = vdupq_n_f32(32767.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    for(; i + 8 <= samples; i += 8)
+    {
+        float32x4_t a = vmulq_f32(vld1q_f32(in + i), scale);
+        float32x4_t b = vmulq_f32(vld1q_f32(in + i + 4), scale);
+        /* round half away from zero, vcvtq truncates */
+        a = vaddq_f32(a, vbslq_f32(vdupq_n_u32(0x80000000), a, half));
+        b = vaddq_f32(b, vbslq_f32(vdupq_n_u32(0x80000000), b, half));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b))));
+    }
+#endif
+    for(; i < samples; ++i)
+        out[i] = clip_int16(in[i] * 32767);
 }
 
 /*
@@ -1293,15 +1704,19 @@ int16_t AudioInput::clip_int16 (float in)
  */
 int AudioInput::audio_get_next_buffer(audio_buff_t *buff)
 {  
-    pthread_mutex_lock(&mutex);
-    int flag = audio_buffers[buffer_read_index].flag;
-    pthread_mutex_unlock(&mutex);
+    if(audio_buffers == NULL)
+        return 1;
 
-    if(flag == AUDIO_BUFF_FREE)
+    unsigned int read_index = buffer_read_index;
+    if(read_index == __atomic_load_n(&buffer_write_index, __ATOMIC_ACQUIRE))
         return 1; /*all done*/
 
+    audio_buff_t *audio_buff = &audio_buffers[read_index % AUDBUFF_NUM];
+    buff->timestamp = audio_buff->timestamp;
+    buff->ts_drift = audio_buff->ts_drift;
+
 //    /*aplly fx*/
-//    audio_fx_apply(audio_context, (sample_t *) audio_buffers[buffer_read_index].data, mask);
+//    audio_fx_apply(audio_context, (sample_t *) audio_buff->data, mask);
 
     /*copy data into requested format type*/
     int i = 0;
@@ -1311,18 +1726,14 @@ int AudioInput::audio_get_next_buffer(audio_buff_t *buff)
         case GV_SAMPLE_TYPE_FLOAT:
         {
             sample_t *my_data = (sample_t *) buff->data;
-            memcpy( my_data, audio_buffers[buffer_read_index].data,
+            memcpy( my_data, audio_buff->data,
                 audio_context->capture_buff_size * sizeof(sample_t));
             break;
         }
         case GV_SAMPLE_TYPE_INT16:
         {
-            int16_t *my_data = (int16_t *) buff->data;
-            sample_t *buff_p = (sample_t *) audio_buffers[buffer_read_index].data;
-            for(i = 0; i < audio_context->capture_buff_size; ++i)
-            {
-                my_data[i] = clip_int16( (buff_p[i]) * 32767);
-            }
+            float_to_int16((int16_t *) buff->data, (sample_t *) audio_buff->data,
+                audio_context->capture_buff_size);
             break;
         }
         case GV_SAMPLE_TYPE_FLOATP:
@@ -1330,7 +1741,7 @@ int AudioInput::audio_get_next_buffer(audio_buff_t *buff)
             int j=0;
 
             float *my_data[audio_context->channels];
-            sample_t *buff_p = (sample_t *) audio_buffers[buffer_read_index].data;
+            sample_t *buff_p = (sample_t *) audio_buff->data;
 
             for(j = 0; j < audio_context->channels; ++j)
                 my_data[j] = (float *) (((float *) buff->data) +
@@ -1348,7 +1759,7 @@ int AudioInput::audio_get_next_buffer(audio_buff_t *buff)
             int j=0;
 
             int16_t *my_data[audio_context->channels];
-            sample_t *buff_p = (sample_t *) audio_buffers[buffer_read_index].data;
+            sample_t *buff_p = (sample_t *) audio_buff->data;
 
             for(j = 0; j < audio_context->channels; ++j)
                 my_data[j] = (int16_t *) (((int16_t *) buff->data) +
@@ -1363,15 +1774,13 @@ int AudioInput::audio_get_next_buffer(audio_buff_t *buff)
         }
     }
 
-    buff->timestamp = audio_buffers[buffer_read_index].timestamp;
+    buff->timestamp = audio_buff->timestamp;
 
-    buff->level_meter[0] = audio_buffers[buffer_read_index].level_meter[0];
-    buff->level_meter[1] = audio_buffers[buffer_read_index].level_meter[1];
+    buff->level_meter[0] = audio_buff->level_meter[0];
+    buff->level_meter[1] = audio_buff->level_meter[1];
 
-    pthread_mutex_lock(&mutex);
-    audio_buffers[buffer_read_index].flag = AUDIO_BUFF_FREE;
-    NEXT_IND(buffer_read_index, AUDBUFF_NUM);
-    pthread_mutex_unlock(&mutex);
+    /*hand the slot back to the producer*/
+    __atomic_store_n(&buffer_read_index, read_index + 1, __ATOMIC_RELEASE);
     return 0;
 }
 
@@ -1389,4 +1798,195 @@ void AudioInput::audio_delete_buffer(audio_buff_t *audio_buff)
     free(audio_buff);
 }
 
+AudioEncodeWorker::AudioEncodeWorker(AudioInput *audioInput)
+{
+    m_audioInput = audioInput;
+    m_encoder = NULL;
+    m_buff = NULL;
+    m_driftStarted = false;
+
+    moveToThread(&m_thread);
+    connect(m_audioInput, SIGNAL(captureAudio()), this, SLOT(encodePending()), Qt::QueuedConnection);
+    m_thread.start();
+}
+
+AudioEncodeWorker::~AudioEncodeWorker()
+{
+    stop();
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void AudioEncodeWorker::start(VideoEncoder *encoder, audio_buff_t *buff)
+{
+    QMutexLocker locker(&m_mutex);
+    m_encoder = encoder;
+    m_buff = buff;
+
+    m_fifo.clear();
+    m_driftStarted = false;
+    m_driftOffset = 0;
+    m_driftFiltered = 0;
+    m_correcting = false;
+    m_maxDrift = 0;
+    m_framesIn = 0;
+    m_framesInserted = 0;
+    m_framesDropped = 0;
+    m_nextLogFrames = 0;
+}
+
+void AudioEncodeWorker::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    /*final values, written by the trailer of the file being closed*/
+    if(m_encoder && m_driftStarted)
+        setDriftTags(m_audioInput->audio_context->samprate);
+    m_encoder = NULL;
+    m_buff = NULL;
+    m_fifo.clear();
+}
+
+/**
+ * @brief AudioEncodeWorker::encodePending - encode every buffer published by the capture thread.
+ * One wakeup may find several buffers, later wakeups then find the ring empty.
+ */
+void AudioEncodeWorker::encodePending()
+{
+    QMutexLocker locker(&m_mutex);
+    if(m_encoder == NULL || m_buff == NULL)
+        return;
+
+    audio_context_t *audio_ctx = m_audioInput->audio_context;
+    int channels = audio_ctx->channels;
+    int frames = audio_ctx->capture_buff_size / channels;
+    int codecFrames = m_encoder->pAudioCodecCtx ? m_encoder->pAudioCodecCtx->frame_size : 0;
+    if(codecFrames <= 0)
+        codecFrames = frames;
+
+    while(m_audioInput->audio_get_next_buffer(m_buff) == 0)
+    {
+        const int16_t *samples = (const int16_t *) m_buff->data;
+        int correction = driftCorrection(m_buff, frames, audio_ctx->samprate);
+        int at = correction ? quietestFrame(samples, frames, channels) : frames;
+
+        /*repeat (+1) or skip (-1) the sample frame at 'at'*/
+        int size = m_fifo.size();
+        m_fifo.resize(size + (frames + correction) * channels);
+        int16_t *out = m_fifo.data() + size;
+        memcpy(out, samples, at * channels * sizeof(int16_t));
+        out += at * channels;
+        if(correction > 0)
+        {
+            memcpy(out, samples + at * channels, channels * sizeof(int16_t));
+            out += channels;
+        }
+        int rest = correction < 0 ? at + 1 : at;
+        memcpy(out, samples + rest * channels, (frames - rest) * channels * sizeof(int16_t));
+
+        /*the codec takes whole frames of its own size*/
+        int codecSamples = codecFrames * channels;
+        int done = 0;
+        while(m_fifo.size() - done >= codecSamples)
+        {
+            m_encoder->encodeAudio(m_fifo.data() + done);
+            done += codecSamples;
+        }
+        m_fifo.remove(0, done);
+    }
+}
+
+/**
+ * @brief AudioEncodeWorker::setDriftTags - drift so far as container tags. Tags are written with
+ * each file header and again before the trailer [avi keeps the values of its header].
+ */
+void AudioEncodeWorker::setDriftTags(int samprate)
+{
+    double skew = m_framesIn ? (m_framesDropped - m_framesInserted + m_driftFiltered) * 1e6 / m_framesIn : 0;
+    m_encoder->setMetadata("audio_clock_skew_ppm", QString::number(skew, 'f', 2));
+    m_encoder->setMetadata("audio_frames_inserted", QString::number(m_framesInserted));
+    m_encoder->setMetadata("audio_frames_dropped", QString::number(m_framesDropped));
+    m_encoder->setMetadata("audio_max_drift_ms", QString::number(m_maxDrift * 1000.0 / samprate, 'f', 2));
+}
+
+/**
+ * @brief AudioEncodeWorker::driftCorrection - update the drift estimate with one buffer.
+ * Timestamp jitter is milliseconds while real clock drift is a few ms per minute, so the drift
+ * is low passed over AUDIO_DRIFT_TIME_CONST and only corrected outside a deadband, with hysteresis.
+ * @return -1 drop a sample frame, +1 repeat a sample frame, 0 nothing to correct
+ */
+int AudioEncodeWorker::driftCorrection(const audio_buff_t *buff, int frames, int samprate)
+{
+    /*positive - the device delivered more samples than the monotonic clock asks for*/
+    double drift = (double) buff->ts_drift * samprate / NSEC_PER_SEC;
+    m_framesIn += frames;
+
+    if(!m_driftStarted)
+    {
+        /*constant capture latency is not drift*/
+        m_driftStarted = true;
+        m_driftOffset = drift;
+        m_nextLogFrames = (qint64) AUDIO_DRIFT_LOG_SEC * samprate;
+        return 0;
+    }
+
+    drift -= m_driftOffset;
+    if(fabs(drift) > m_maxDrift)
+        m_maxDrift = fabs(drift);
+
+    double residual = drift - (m_framesDropped - m_framesInserted);
+    double weight = qMin(1.0, (double) frames / ((double) samprate * AUDIO_DRIFT_TIME_CONST));
+    m_driftFiltered += (residual - m_driftFiltered) * weight;
+
+    if(m_framesIn >= m_nextLogFrames)
+    {
+        m_nextLogFrames += (qint64) AUDIO_DRIFT_LOG_SEC * samprate;
+        setDriftTags(samprate);
+    }
+
+    double startFrames = AUDIO_DRIFT_START_MS * samprate / 1000.0;
+    double stopFrames = AUDIO_DRIFT_STOP_MS * samprate / 1000.0;
+    if(!m_correcting && fabs(m_driftFiltered) >= startFrames)
+        m_correcting = true;
+    else if(m_correcting && fabs(m_driftFiltered) <= stopFrames)
+        m_correcting = false;
+    if(!m_correcting)
+        return 0;
+
+    if(m_driftFiltered >= 1.0)
+    {
+        m_framesDropped++;
+        m_driftFiltered -= 1.0;
+        return -1;
+    }
+    if(m_driftFiltered <= -1.0)
+    {
+        m_framesInserted++;
+        m_driftFiltered += 1.0;
+        return 1;
+    }
+    return 0;
+}
 
+/**
+ * @brief AudioEncodeWorker::quietestFrame - a dropped or repeated frame is least audible where the signal is lowest
+ * @return index of the sample frame with the lowest amplitude, never the last one
+ */
+int AudioEncodeWorker::quietestFrame(const int16_t *samples, int frames, int channels)
+{
+    int best = 0;
+    int bestLevel = INT_MAX;
+    for(int i = 0; i < frames - 1; i++)
+    {
+        int level = 0;
+        for(int c = 0; c < channels; c++)
+            level += abs(samples[i * channels + c]);
+        if(level < bestLevel)
+        {
+            bestLevel = level;
+            best = i;
+            if(level == 0)
+                break;
+        }
+    }
+    return best;
+}
@@ -6,6 +6,9 @@
 #include <pulse/pulseaudio.h>
 #include <QAudioFormat>
 #include <QAudioDeviceInfo>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
 #include "videoencoder.h"
 #include "alsa.h"
 
@@ -23,10 +26,18 @@
 #define AUDBUFF_NUM     80    /*number of audio buffers*/
 #define AUDBUFF_FRAMES  1152  /*number of audio frames per buffer*/
 
-/*Audio Buffer flags*/
-#define AUDIO_BUFF_FREE     (0)
-#define AUDIO_BUFF_USED     (1)
-#define NEXT_IND(ind,size) ind++;if(ind>=size) ind=0
+/*Audio capture api of a device*/
+#define AUDIO_API_PULSE     (0)
+#define AUDIO_API_ALSA      (1)  /*direct hw:/plughw: capture with mmap access*/
+
+#define ALSA_PERIOD_FRAMES  256   /*default alsa period size (frames)*/
+#define ALSA_PERIODS        4     /*alsa periods per hardware buffer*/
+
+/*drift compensation*/
+#define AUDIO_DRIFT_TIME_CONST  (30)    /*seconds, time constant of the drift low pass*/
+#define AUDIO_DRIFT_START_MS    (5)     /*corrections start once the filtered drift is beyond this*/
+#define AUDIO_DRIFT_STOP_MS     (1)     /*and continue until it is back within this*/
+#define AUDIO_DRIFT_LOG_SEC     (60)    /*seconds between drift tag updates*/
 
 /*audio sample format (definition also in gview_encoder)*/
 #ifndef GV_SAMPLE_TYPE_INT16
@@ -70,6 +81,7 @@ typedef float sample_t;
 typedef struct _audio_device_t
 {
     int id;                 /*audo device id*/
+    int api;                /*AUDIO_API_PULSE or AUDIO_API_ALSA*/
     int channels;           /*max channels*/
     int samprate;           /*default samplerate*/
     double low_latency;     /*default low latency*/
@@ -109,7 +121,7 @@ typedef struct _audio_buff_t
 {
     void *data; /*sample buffer - usually sample_t (float)*/
     int64_t timestamp;
-    int flag;
+    int64_t ts_drift; /*generated - real timestamp at the end of the buffer (nanosec)*/
     float level_meter[2]; /*average sample level*/
 }audio_buff_t;
 
@@ -157,10 +169,16 @@ private:
     static void get_latency(pa_stream *s);
     static int audio_init_buffers(audio_context_t *audio_ctx);
     static int16_t clip_int16 (float in);
+    static void float_to_int16(int16_t *out, const float *in, int samples);
     static int audio_free_buffers();
     int pa_get_devicelist(audio_context_t *audio_ctx);
     static void stream_request_cb(pa_stream *s, size_t length, void *data);
 
+    // direct alsa capture
+    int alsa_get_devicelist(audio_context_t *audio_ctx);
+    static void *alsa_read_audio(void *arg);
+    static snd_pcm_t *alsa_open_capture(audio_context_t *audio_ctx, snd_pcm_uframes_t period, snd_pcm_format_t *format);
+
     static void audio_fill_buffer(audio_context_t *audio_ctx, int64_t ts, void *arg);
     // init pulseaudio
     audio_context_t* audio_init_pulseaudio();   
@@ -172,6 +190,10 @@ private:
 
     QTimer *timer;
 
+    int alsaPeriodFrames;
+    snd_pcm_t *alsaPcm;             // opened and started by audio_start_pulseaudio, closed by the read thread
+    snd_pcm_format_t alsaFormat;
+
 
 public slots:
     audio_buff_t *audio_get_buffer();
@@ -180,6 +202,11 @@ public slots:
     void setChannelCount(uint index);
     void setSampleRate(int sampleRate);
     void audio_set_pulseaudio_device(int index);
+    /**
+     * @brief setAlsaPeriodSize - period size used by the alsa devices of the list, applied on the next start
+     * @param frames - frames per period
+     */
+    void setAlsaPeriodSize(int frames);
     int audio_start_pulseaudio(VideoEncoder videoEncoder);
     int audio_stop_pulseaudio();
     void audio_close_pulseaudio();
@@ -197,4 +224,58 @@ signals:
     void muteStateChanged(int muteState);
 };
 
+/**
+ * @brief The AudioEncodeWorker class - drains the audio ring and encodes it on its own thread,
+ * so sample conversion and audio encoding do not run on the GUI thread.
+ */
+class AudioEncodeWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    AudioEncodeWorker(AudioInput *audioInput);
+    ~AudioEncodeWorker();
+
+    /**
+     * @brief start - begin encoding the captured audio buffers
+     * @param encoder - encoder of the current recording
+     * @param buff - buffer from AudioInput::audio_get_buffer, used for conversion
+     */
+    void start(VideoEncoder *encoder, audio_buff_t *buff);
+    /**
+     * @brief stop - wait for the running encode and detach from the encoder
+     */
+    void stop();
+
+public slots:
+    void encodePending();
+
+private:
+    int driftCorrection(const audio_buff_t *buff, int frames, int samprate);
+    void setDriftTags(int samprate);
+    static int quietestFrame(const int16_t *samples, int frames, int channels);
+
+    AudioInput *m_audioInput;
+    VideoEncoder *m_encoder;
+    audio_buff_t *m_buff;
+    QMutex m_mutex;
+    QThread m_thread;
+
+    /*
+     * The capture device clock is compared with the monotonic clock shared with the video
+     * frames. The difference is removed by dropping or repeating single sample frames at
+     * the quietest point of a buffer, so the encoder always gets whole codec frames from m_fifo.
+     */
+    QVector<int16_t> m_fifo;
+    bool m_driftStarted;
+    double m_driftOffset;       // drift at the start of the recording (frames)
+    double m_driftFiltered;     // low passed residual drift (frames)
+    bool m_correcting;          // filtered drift went beyond AUDIO_DRIFT_START_MS
+    double m_maxDrift;          // largest drift seen (frames)
+    qint64 m_framesIn;          // frames read from the ring
+    qint64 m_framesInserted;
+    qint64 m_framesDropped;
+    qint64 m_nextLogFrames;
+};
+
 #endif // AUDIOINPUT_H
@@ -0,0 +1,389 @@
+/*
+ * bandwidthplanner.cpp -- usb bandwidth estimation and capture format selection
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bandwidthplanner.h"
+#include "v4l2-api.h"
+#include <QFile>
+#include <QFileInfo>
+#include <linux/usb/ch9.h>
+#include <linux/usb/video.h>
+
+BandwidthPlanner *BandwidthPlanner::instance()
+{
+    static BandwidthPlanner *planner = NULL;
+    if (!planner)
+        planner = new BandwidthPlanner();
+    return planner;
+}
+
+static QString readSysfs(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+    return QString::fromLatin1(file.readAll()).trimmed();
+}
+
+/**
+ * @brief readStreamingEndpoints - type and alternate setting rates of the video streaming endpoint,
+ * from the raw descriptors of the usb device. The streaming interfaces follow the video control
+ * interface the video node belongs to, up to the video control interface of the next function.
+ */
+static void readStreamingEndpoints(const QString &path, int controlInterface, UsbLink &link)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    QByteArray data = file.readAll();
+    const uchar *d = (const uchar *)data.constData();
+    int size = data.size();
+    bool function = false, streaming = false, bulk = false;
+    QVector<qint64> rates;
+
+    for (int pos = USB_DT_DEVICE_SIZE; pos + 2 <= size && d[pos] >= 2 && pos + d[pos] <= size; pos += d[pos]) {
+        const uchar *desc = d + pos;
+        int len = desc[0];
+        switch (desc[1]) {
+        case USB_DT_CONFIG:
+            function = streaming = false;
+            break;
+        case USB_DT_INTERFACE:
+            if (len < USB_DT_INTERFACE_SIZE)
+                break;
+            if (desc[5] == USB_CLASS_VIDEO && desc[6] == UVC_SC_VIDEOCONTROL)
+                function = desc[2] == controlInterface;
+            streaming = function && desc[5] == USB_CLASS_VIDEO && desc[6] == UVC_SC_VIDEOSTREAMING;
+            break;
+        case USB_DT_ENDPOINT: {
+            if (!streaming || len < USB_DT_ENDPOINT_SIZE || !(desc[2] & USB_DIR_IN))
+                break;
+            int type = desc[3] & USB_ENDPOINT_XFERTYPE_MASK;
+            if (type == USB_ENDPOINT_XFER_BULK)
+                bulk = true;
+            if (type != USB_ENDPOINT_XFER_ISOC)
+                break;
+            int maxPacket = desc[4] | (desc[5] << 8);
+            int interval = qBound(1, (int)desc[6], 16);
+            const uchar *next = desc + len;
+            qint64 bytes, perSec;
+            if (link.speedMbps >= 5000 && pos + len + USB_DT_SS_EP_COMP_SIZE <= size && next[1] == USB_DT_SS_ENDPOINT_COMP) {
+                bytes = next[4] | (next[5] << 8);                           // wBytesPerInterval
+                perSec = 8000 >> (interval - 1);
+            } else if (link.speedMbps >= 480) {
+                bytes = (maxPacket & 0x7ff) * (((maxPacket >> 11) & 3) + 1);  // high bandwidth transactions
+                perSec = 8000 >> (interval - 1);
+            } else {
+                bytes = maxPacket & 0x3ff;
+                perSec = 1000 >> (interval - 1);
+            }
+            if (bytes * perSec > 0 && !rates.contains(bytes * perSec))
+                rates.append(bytes * perSec);
+            break;
+        }
+        }
+    }
+    qSort(rates.begin(), rates.end());
+    link.bulk = bulk && rates.isEmpty();
+    link.altSettings = rates;
+}
+
+bool BandwidthPlanner::usbLink(int videoIndex, UsbLink &link)
+{
+    // the video node hangs off the video control interface [bus-port:config.interface],
+    // busnum, speed and descriptors are files of the usb device above it
+    QString path = QFileInfo(QString("/sys/class/video4linux/video%1/device").arg(videoIndex)).canonicalFilePath();
+    int controlInterface = QFileInfo(path).fileName().section('.', -1).toInt();
+    for (int level = 0; level < 3 && !path.isEmpty() && path != "/"; level++) {
+        if (QFile::exists(path + "/busnum") && QFile::exists(path + "/speed")) {
+            link.bus = readSysfs(path + "/busnum").toInt();
+            link.speedMbps = readSysfs(path + "/speed").toInt();
+            readStreamingEndpoints(path + "/descriptors", controlInterface, link);
+            return link.speedMbps > 0;
+        }
+        path = QFileInfo(path).path();
+    }
+    return false;
+}
+
+qint64 BandwidthPlanner::busCapacity(const UsbLink &link)
+{
+    if (link.speedMbps <= 0)
+        return Q_INT64_C(0x7fffffffffffffff);
+    if (link.speedMbps >= 5000)
+        return USB3_BUS_BYTES_PER_SEC * (link.speedMbps / 5000);
+    if (link.speedMbps >= 480)
+        return link.bulk ? USB2_BULK_BYTES_PER_SEC : USB2_BUS_BYTES_PER_SEC;
+    return USB1_BUS_BYTES_PER_SEC;
+}
+
+qint64 BandwidthPlanner::endpointCapacity(const UsbLink &link)
+{
+    if (link.speedMbps <= 0)
+        return Q_INT64_C(0x7fffffffffffffff);
+    if (link.bulk)
+        return busCapacity(link);
+    if (!link.altSettings.isEmpty())
+        return link.altSettings.last();
+    if (link.speedMbps >= 5000)
+        return USB3_ENDPOINT_BYTES_PER_SEC;
+    if (link.speedMbps >= 480)
+        return USB2_ENDPOINT_BYTES_PER_SEC;
+    return USB1_BUS_BYTES_PER_SEC;
+}
+
+qint64 BandwidthPlanner::busShare(const UsbLink &link, qint64 bytesPerSec)
+{
+    if (link.bulk || link.altSettings.isEmpty())
+        return bytesPerSec;
+    foreach (qint64 rate, link.altSettings) {
+        if (rate >= bytesPerSec)
+            return rate;
+    }
+    return link.altSettings.last();
+}
+
+qint64 BandwidthPlanner::estimateBandwidth(__u32 pixelformat, uint width, uint height, uint fps)
+{
+    qint64 pixels = (qint64)width * height;
+    qint64 frameBytes;
+
+    switch (pixelformat) {
+    case V4L2_PIX_FMT_MJPEG:
+        frameBytes = pixels * 2 / MJPEG_COMPRESSION_RATIO;
+        break;
+    case V4L2_PIX_FMT_H264:
+        frameBytes = pixels / H264_PIXELS_PER_BYTE;
+        break;
+    case V4L2_PIX_FMT_GREY:
+    case V4L2_PIX_FMT_SGRBG8:
+    case V4L2_PIX_FMT_SBGGR8:
+    case V4L2_PIX_FMT_SGBRG8:
+    case V4L2_PIX_FMT_SRGGB8:
+        frameBytes = pixels;
+        break;
+    case V4L2_PIX_FMT_Y12:
+    case V4L2_PIX_FMT_NV12:
+    case V4L2_PIX_FMT_NV21:
+    case V4L2_PIX_FMT_NV12M:
+    case V4L2_PIX_FMT_NV21M:
+    case V4L2_PIX_FMT_YUV420:
+    case V4L2_PIX_FMT_YVU420:
+    case V4L2_PIX_FMT_YUV420M:
+    case V4L2_PIX_FMT_YVU420M:
+        frameBytes = pixels * 3 / 2;
+        break;
+    case V4L2_PIX_FMT_RGB24:
+    case V4L2_PIX_FMT_BGR24:
+        frameBytes = pixels * 3;
+        break;
+    default:        // yuyv, uyvy, y16
+        frameBytes = pixels * 2;
+        break;
+    }
+    return frameBytes * fps * (100 + UVC_OVERHEAD_PERCENT) / 100;
+}
+
+int BandwidthPlanner::cpuCost(__u32 pixelformat, QString *work)
+{
+    int cost;
+    QString text;
+
+    switch (pixelformat) {
+    case V4L2_PIX_FMT_YUYV:
+    case V4L2_PIX_FMT_NV12:
+    case V4L2_PIX_FMT_NV21:
+    case V4L2_PIX_FMT_NV12M:
+    case V4L2_PIX_FMT_NV21M:
+    case V4L2_PIX_FMT_YUV420:
+    case V4L2_PIX_FMT_YVU420:
+    case V4L2_PIX_FMT_YUV420M:
+    case V4L2_PIX_FMT_YVU420M:
+    case V4L2_PIX_FMT_GREY:
+        cost = 1;
+        text = "copied to the shader";
+        break;
+    case V4L2_PIX_FMT_UYVY:
+        cost = 2;
+        text = "repacked to yuyv";
+        break;
+    case V4L2_PIX_FMT_Y16:
+        cost = 1;
+        text = "copied to the 16 bit shader";
+        break;
+    case V4L2_PIX_FMT_Y12:
+        cost = 2;
+        text = "unpacked to the 16 bit shader";
+        break;
+    case V4L2_PIX_FMT_SGRBG8:
+        cost = 4;
+        text = "demosaiced";
+        break;
+    case V4L2_PIX_FMT_MJPEG:
+        cost = 6;
+        text = "jpeg decoded";
+        break;
+    case V4L2_PIX_FMT_H264:
+        cost = 8;
+        text = "h264 decoded";
+        break;
+    default:
+        cost = 5;
+        text = "converted by libv4lconvert";
+        break;
+    }
+    if (work)
+        *work = text;
+    return cost;
+}
+
+void BandwidthPlanner::reserve(CameraSession *camera, const UsbLink &link, qint64 bytesPerSec)
+{
+    QMutexLocker locker(&m_mutex);
+    Reservation reservation;
+    reservation.bus = link.bus;
+    reservation.bytesPerSec = busShare(link, bytesPerSec);
+    reservation.periodic = !link.bulk;
+    m_reservations.insert(camera, reservation);
+}
+
+void BandwidthPlanner::release(CameraSession *camera)
+{
+    QMutexLocker locker(&m_mutex);
+    m_reservations.remove(camera);
+}
+
+qint64 BandwidthPlanner::available(CameraSession *camera, const UsbLink &link)
+{
+    if (link.speedMbps <= 0)
+        return Q_INT64_C(0x7fffffffffffffff);
+
+    QMutexLocker locker(&m_mutex);
+    qint64 used = 0;
+    QMap<CameraSession *, Reservation>::const_iterator it;
+    for (it = m_reservations.constBegin(); it != m_reservations.constEnd(); ++it) {
+        // bulk transfers only get what the periodic ones leave, they do not reduce the periodic budget
+        if (it.key() != camera && it.value().bus == link.bus && (link.bulk || it.value().periodic))
+            used += it.value().bytesPerSec;
+    }
+    return busCapacity(link) - used;
+}
+
+bool BandwidthPlanner::fits(CameraSession *camera, const UsbLink &link, qint64 bytesPerSec)
+{
+    return bytesPerSec <= endpointCapacity(link) && busShare(link, bytesPerSec) <= available(camera, link);
+}
+
+static QString modeText(const CaptureMode &mode)
+{
+    return QString("%1 %2x%3@%4").arg(v4l2::pixfmt2s(mode.pixelformat)).arg(mode.width).arg(mode.height).arg(mode.fps);
+}
+
+static QString rateText(qint64 bytesPerSec)
+{
+    return QString::number(bytesPerSec / 1e6, 'f', 1) + " MB/s";
+}
+
+/**
+ * @brief better - ranking of two estimated modes for the requested fps
+ */
+static bool better(const CaptureMode &a, const CaptureMode &b, uint fps)
+{
+    if (a.fits != b.fits)
+        return a.fits;
+    if (!a.fits)
+        return a.bytesPerSec < b.bytesPerSec;   // neither fits, least overload
+
+    bool aReaches = a.fps >= fps, bReaches = b.fps >= fps;
+    if (aReaches != bReaches)
+        return aReaches;
+    int aCost = BandwidthPlanner::cpuCost(a.pixelformat), bCost = BandwidthPlanner::cpuCost(b.pixelformat);
+    if (aReaches) {
+        if (aCost != bCost)
+            return aCost < bCost;
+        if (a.fps != b.fps)
+            return a.fps < b.fps;               // closest to the requested rate
+    } else {
+        if (a.fps != b.fps)
+            return a.fps > b.fps;
+        if (aCost != bCost)
+            return aCost < bCost;
+    }
+    return a.bytesPerSec < b.bytesPerSec;
+}
+
+int BandwidthPlanner::plan(CameraSession *camera, const UsbLink &link, uint fps, QVector<CaptureMode> &modes, QString &explanation)
+{
+    if (modes.isEmpty()) {
+        explanation = "No capture mode offered for the requested size";
+        return -1;
+    }
+
+    qint64 usable = available(camera, link);
+    QStringList lines;
+    if (link.speedMbps > 0) {
+        lines << QString("USB bus %1 at %2 Mbps: %3 left to this camera").arg(link.bus).arg(link.speedMbps).arg(rateText(qMax(usable, 0LL)));
+        if (link.bulk)
+            lines << "Bulk endpoint: shares what the isochronous cameras leave, no bandwidth is reserved";
+        else if (!link.altSettings.isEmpty())
+            lines << QString("Isochronous endpoint: %1 alternate settings up to %2, a stream takes the whole setting it needs")
+                     .arg(link.altSettings.count()).arg(rateText(link.altSettings.last()));
+        else
+            lines << QString("Isochronous endpoint, descriptors unknown: up to %1").arg(rateText(endpointCapacity(link)));
+    } else {
+        lines << "USB link unknown, bandwidth not checked";
+    }
+
+    int best = -1;
+    QMap<__u32, int> nearest;       // mode closest to the requested fps, per format, for the report
+    for (int i = 0; i < modes.count(); i++) {
+        CaptureMode &mode = modes[i];
+        mode.bytesPerSec = estimateBandwidth(mode.pixelformat, mode.width, mode.height, mode.fps);
+        mode.fits = fits(camera, link, mode.bytesPerSec);
+        if (best < 0 || better(mode, modes.at(best), fps))
+            best = i;
+        int shown = nearest.value(mode.pixelformat, -1);
+        if (shown < 0 || qAbs((int)mode.fps - (int)fps) < qAbs((int)modes.at(shown).fps - (int)fps))
+            nearest.insert(mode.pixelformat, i);
+    }
+
+    QMap<__u32, int>::const_iterator it;
+    for (it = nearest.constBegin(); it != nearest.constEnd(); ++it) {
+        const CaptureMode &mode = modes.at(it.value());
+        QString work;
+        cpuCost(mode.pixelformat, &work);
+        QString share;
+        if (!link.bulk && busShare(link, mode.bytesPerSec) != mode.bytesPerSec)
+            share = QString(" [takes %1 of the bus]").arg(rateText(busShare(link, mode.bytesPerSec)));
+        lines << QString("%1: %2%3, %4, %5").arg(modeText(mode)).arg(rateText(mode.bytesPerSec)).arg(share)
+                 .arg(mode.fits ? "fits" : "does not fit").arg(work);
+    }
+
+    const CaptureMode &chosen = modes.at(best);
+    QString work;
+    cpuCost(chosen.pixelformat, &work);
+    if (!chosen.fits)
+        lines << QString("Selected %1: no mode fits, it needs the least bandwidth - expect dropped frames").arg(modeText(chosen));
+    else if (chosen.fps < fps)
+        lines << QString("Selected %1: %2 fps does not fit, highest rate that fits [%3]").arg(modeText(chosen)).arg(fps).arg(work);
+    else
+        lines << QString("Selected %1: lowest cpu cost of the modes that fit [%2]").arg(modeText(chosen)).arg(work);
+    explanation = lines.join("\n");
+    return best;
+}
@@ -0,0 +1,148 @@
+/*
+ * bandwidthplanner.h -- usb bandwidth estimation and capture format selection
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BANDWIDTHPLANNER_H
+#define BANDWIDTHPLANNER_H
+
+#include <QMutex>
+#include <QMap>
+#include <QVector>
+#include <QString>
+#include <linux/videodev2.h>
+#include "camerasession.h"
+
+// usable payload rates, bytes/s
+#define USB1_BUS_BYTES_PER_SEC          1023000LL       /* one 1023 byte isochronous packet per frame */
+#define USB2_BUS_BYTES_PER_SEC          48000000LL      /* 80% of each microframe is left to periodic transfers */
+#define USB2_ENDPOINT_BYTES_PER_SEC     24576000LL      /* high bandwidth endpoint, 3 x 1024 bytes per microframe */
+#define USB2_BULK_BYTES_PER_SEC         40000000LL      /* bulk throughput of a high speed link, no periodic traffic */
+#define USB3_BUS_BYTES_PER_SEC          400000000LL     /* 5 Gbps after 8b/10b coding and protocol overhead */
+#define USB3_ENDPOINT_BYTES_PER_SEC     393216000LL     /* 3 bursts of 16 x 1024 bytes per microframe */
+
+#define UVC_OVERHEAD_PERCENT            3               /* payload headers and partly filled packets */
+#define MJPEG_COMPRESSION_RATIO         5               /* typical mjpeg frame against the yuyv frame */
+#define H264_PIXELS_PER_BYTE            50              /* ~0.16 bits per pixel at camera encoder bit rates */
+
+/**
+ * @brief The CaptureMode struct - one format/frame size/frame interval offered by a camera
+ */
+struct CaptureMode {
+    __u32 pixelformat;
+    int formatIndex;        // VIDIOC_ENUM_FMT index, as used by the format list
+    uint width, height;
+    uint fps;
+    int fpsIndex;           // VIDIOC_ENUM_FRAMEINTERVALS index, as used by the fps list
+    qint64 bytesPerSec;     // estimated by the planner
+    bool fits;
+
+    CaptureMode() : pixelformat(0), formatIndex(-1), width(0), height(0), fps(0), fpsIndex(-1),
+                    bytesPerSec(0), fits(false) {}
+};
+
+/**
+ * @brief The UsbLink struct - usb bus, link speed and streaming endpoint of a camera, from sysfs
+ */
+struct UsbLink {
+    int bus;                // usb bus number, one root hub - one bandwidth budget
+    int speedMbps;          // 12, 480, 5000, ...
+    bool bulk;              // video streaming endpoint is bulk, isochronous otherwise
+    QVector<qint64> altSettings;    // bytes/s of the isochronous alternate settings, ascending. Empty if unknown
+
+    UsbLink() : bus(-1), speedMbps(0), bulk(false) {}
+};
+
+/**
+ * @brief The BandwidthPlanner class - estimates the usb bandwidth of capture modes and keeps the
+ * bandwidth of streaming cameras per bus, so a mode is only picked when it fits next to the
+ * other cameras on the same root hub.
+ */
+class BandwidthPlanner
+{
+public:
+    static BandwidthPlanner *instance();
+
+    /**
+     * @brief usbLink - bus number and speed of the usb device of /dev/videoN
+     * @return false for cameras which are not on usb
+     */
+    static bool usbLink(int videoIndex, UsbLink &link);
+
+    /**
+     * @brief busCapacity - bytes/s of the bus left to isochronous [periodic] transfers, or to bulk
+     * transfers of a bulk camera
+     */
+    static qint64 busCapacity(const UsbLink &link);
+    /**
+     * @brief endpointCapacity - largest rate of the streaming endpoint, the largest alternate setting
+     * of an isochronous endpoint
+     */
+    static qint64 endpointCapacity(const UsbLink &link);
+    /**
+     * @brief busShare - bytes/s a stream takes from the bus. An isochronous stream takes the whole
+     * alternate setting the driver picks, the smallest one carrying the payload; bulk takes the payload.
+     */
+    static qint64 busShare(const UsbLink &link, qint64 bytesPerSec);
+
+    /**
+     * @brief estimateBandwidth - bytes/s a mode needs on the bus
+     */
+    static qint64 estimateBandwidth(__u32 pixelformat, uint width, uint height, uint fps);
+
+    /**
+     * @brief cpuCost - relative cost of bringing a frame of the format to the preview
+     * @param work - set to the work done on the cpu
+     */
+    static int cpuCost(__u32 pixelformat, QString *work = NULL);
+
+    void reserve(CameraSession *camera, const UsbLink &link, qint64 bytesPerSec);
+    void release(CameraSession *camera);
+
+    /**
+     * @brief available - bandwidth left to camera on the bus, other streaming cameras subtracted.
+     * Isochronous cameras share the periodic budget, a bulk camera gets what all others leave.
+     */
+    qint64 available(CameraSession *camera, const UsbLink &link);
+
+    /**
+     * @brief fits - the stream passes the endpoint and its bus share fits next to the other cameras
+     */
+    bool fits(CameraSession *camera, const UsbLink &link, qint64 bytesPerSec);
+
+    /**
+     * @brief plan - estimate the modes and pick the one with the lowest cpu cost that fits,
+     * preferring modes reaching the requested fps
+     * @param explanation - set to the estimates and the reason of the choice
+     * @return index of the chosen mode, -1 if modes is empty
+     */
+    int plan(CameraSession *camera, const UsbLink &link, uint fps, QVector<CaptureMode> &modes, QString &explanation);
+
+private:
+    BandwidthPlanner() {}
+
+    struct Reservation {
+        int bus;
+        qint64 bytesPerSec;     // bus share
+        bool periodic;          // isochronous
+    };
+
+    QMutex m_mutex;
+    QMap<CameraSession *, Reservation> m_reservations;
+};
+
+#endif // BANDWIDTHPLANNER_H
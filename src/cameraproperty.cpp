@@ -41,7 +41,6 @@ Cameraproperty::Cameraproperty()
     connect(this,SIGNAL(setCamName(QString)),&uvccam,SLOT(currentlySelectedDevice(QString)));
     connect(this,SIGNAL(logHandle(QtMsgType,QString)),this,SLOT(logWriter(QtMsgType,QString)));
     connect(&uvccam,SIGNAL(logHandle(QtMsgType,QString)),this,SLOT(logWriter(QtMsgType,QString)));
-     connect(&uvccam,SIGNAL(currentlySelectedCameraEnum(CommonEnums::ECameraNames)),&frmrend,SLOT(selectedCameraEnum(CommonEnums::ECameraNames)));
     //Added by Dhurka - 13th Oct 2016
     /**
      * @brief connect - This signal is used to send the currently selected camera enum to videostreaming.cpp
@@ -55,14 +54,22 @@ Cameraproperty::Cameraproperty()
     // Added by Sankari: To notify user about hid access 
     // 07 Dec 2017
     connect(&uvccam,SIGNAL(hidWarningReceived(QString, QString)),this,SLOT(notifyUser(QString, QString)));
+
+    // Device list is scanned once here and then updated by udev events
+    m_registry = DeviceRegistry::instance();
+    connect(m_registry,SIGNAL(deviceAdded(QString,QString)),this,SIGNAL(cameraDeviceAdded(QString,QString)));
+    connect(m_registry,SIGNAL(deviceRemoved(QString,QString)),this,SIGNAL(cameraDeviceRemoved(QString,QString)));
+    if(!m_registry->isRunning()) {
+        emit logHandle(QtCriticalMsg,"Device registry not available, devices are scanned on every refresh");
+    }
 }
 
 Cameraproperty::Cameraproperty(bool enableLog) {
 	saveLog	= enableLog;
+    m_registry = NULL;
 }
 
 Cameraproperty::~Cameraproperty() {
-
 }
 //Added by Dhurka - 13th Oct 2016
 /**
@@ -143,7 +150,38 @@ void Cameraproperty::openEventNode(QString businfo){ //open device event path fi
     }
 }
 
+/**
+ * @brief Cameraproperty::listRegisteredDevices - fill the camera list from the device registry
+ * No device is opened here, the registry already holds querycap and usb details of every node.
+ */
+void Cameraproperty::listRegisteredDevices() {
+    QList<CameraDeviceInfo> devices = m_registry->devices();
+    cameraMap.clear();
+    deviceNodeMap.clear();
+    availableCam.clear();
+    int deviceIndex = 1;
+    for (int i = 0; i < devices.count(); i++) {
+        QString cameraName = devices.at(i).cardName;
+        if(cameraName.length()>22){
+            cameraName.insert(22,"\n");
+        }
+        cameraMap.insert(devices.at(i).videoIndex,QString::number(deviceIndex,10));
+        deviceNodeMap.insert(deviceIndex,devices.at(i).busInfo);
+        availableCam.append(cameraName);
+        deviceIndex++;
+    }
+    emit logHandle(QtDebugMsg,"Camera devices Connected to System: "+ availableCam.join(", "));
+    uvccam.updateDeviceMaps(devices);
+    availableCam.prepend("----Select Camera Device----");
+    modelCam.setStringList(availableCam);
+}
+
 void Cameraproperty::checkforDevice() {
+    if (m_registry && m_registry->isRunning()) {
+        listRegisteredDevices();
+        return void();
+    }
+
     int deviceBeginNumber,deviceEndNumber;
     cameraMap.clear();
     deviceNodeMap.clear();
@@ -209,8 +247,15 @@ void Cameraproperty::checkforDevice() {
 
 int Cameraproperty::getUsbSpeed(QString serialNumber){
 
+    // link speed from the registry, a usb 3 device on a usb 2 port runs at 480 Mbps
+    CameraDeviceInfo device;
+    if(m_registry && m_registry->deviceBySerial(serialNumber, device) && device.speedMbps > 0) {
+        return (device.speedMbps < 5000) ? USB2_0 : USB3_0;
+    }
+
     QString usbType;
     int retVal, r;
+    int usbSpeed = -1;
     uint16_t usb;
     libusb_device **list = NULL;
     libusb_context *context = NULL;
@@ -222,9 +267,9 @@ int Cameraproperty::getUsbSpeed(QString serialNumber){
         return -1;
     }
 
-    size_t count = libusb_get_device_list(context, &list);
+    ssize_t count = libusb_get_device_list(context, &list);
 
-    for (size_t idx = 0; idx < count; idx++) {
+    for (ssize_t idx = 0; idx < count && usbSpeed < 0; idx++) {
         libusb_device *device = list[idx];
         struct libusb_device_descriptor devDesc = {0};
 
@@ -232,40 +277,41 @@ int Cameraproperty::getUsbSpeed(QString serialNumber){
 
         if (retVal != LIBUSB_SUCCESS) {
             printf("libusb_get_device_descriptor return %d\n", retVal);
-            return -1;
+            continue;
         }
+        // only e-con devices are opened to read the serial number
+        if(devDesc.idVendor != 0x2560)
+            continue;
+
         retVal = libusb_open(device, &h_handle);
 
         if(retVal < 0) {
             printf("Problem acquiring device handle in %s \n", __func__);
-            return -1;
+            continue;
         }
 
-        if(devDesc.idVendor == 0x2560) {
-            unsigned char data[100];
-            memset(data,0,sizeof(data));
-            libusb_get_string_descriptor_ascii(h_handle,devDesc.iSerialNumber,data,sizeof(data));
-            QString serialNo = QString::fromLocal8Bit((const char *)data);
-            int ret = QString::compare(serialNo, serialNumber, Qt::CaseInsensitive);
-            if(ret == 0){
-                usb = devDesc.bcdUSB;
-                usbType.setNum(usb,16);
-                int usbValue = usbType.toInt();
-                if(usbValue < 300)
-                   return USB2_0;
-                else
-                   return USB3_0;
-            }
-        }
-        if(h_handle) {
-            libusb_close(h_handle);
-            h_handle = NULL;
+        unsigned char data[100];
+        memset(data,0,sizeof(data));
+        libusb_get_string_descriptor_ascii(h_handle,devDesc.iSerialNumber,data,sizeof(data));
+        QString serialNo = QString::fromLocal8Bit((const char *)data);
+        int ret = QString::compare(serialNo, serialNumber, Qt::CaseInsensitive);
+        if(ret == 0){
+            usb = devDesc.bcdUSB;
+            usbType.setNum(usb,16);
+            int usbValue = usbType.toInt();
+            if(usbValue < 300)
+               usbSpeed = USB2_0;
+            else
+               usbSpeed = USB3_0;
         }
+        libusb_close(h_handle);
+        h_handle = NULL;
     }
 
-    libusb_free_device_list(list, 1);
+    if(list)
+        libusb_free_device_list(list, 1);
     libusb_exit(context);
-
+    return usbSpeed;
 }
 
 void Cameraproperty::setCurrentDevice(QString deviceIndex,QString deviceName) {
@@ -284,12 +330,21 @@ void Cameraproperty::setCurrentDevice(QString deviceIndex,QString deviceName) {
     }
     else
     {
+        m_currentVideoNode = "/dev/video" + QString::number(cameraMap.key(deviceIndex));
         emit setFirstCamDevice(cameraMap.key(deviceIndex));
         emit setCamName(deviceName);
         uvccam.getDeviceNodeName(deviceNodeMap.value(deviceIndex.toInt()));
     }
 }
 
+/**
+ * @brief Cameraproperty::isCurrentDevice - check whether a video node is the one of the selected camera
+ * @param videoNode - /dev/videoN from cameraDeviceAdded/cameraDeviceRemoved
+ */
+bool Cameraproperty::isCurrentDevice(QString videoNode) {
+    return !m_currentVideoNode.isEmpty() && videoNode == m_currentVideoNode;
+}
+
 void Cameraproperty::createLogger() {
     if (saveLog){
 	log.close();
@@ -42,6 +42,7 @@
 #include "videostreaming.h"
 #include "logger.h"
 #include "libudev.h"
+#include "deviceregistry.h"
 class Cameraproperty : public QObject, public v4l2
 {
     Q_OBJECT
@@ -58,7 +59,6 @@ public:
 
     uvccamera uvccam;
     Videostreaming vidStr;
-    FrameRenderer frmrend;
     logger log;
     void checkforEconDevice(QStringList*);
 
@@ -73,10 +73,16 @@ private:
     QMap<int, QString> deviceNodeMap;
     QMap<int, QString> libusbNodeMap;
 
+    // shared registry of the video/hid nodes, NULL when logging only
+    DeviceRegistry *m_registry;
+    QString m_currentVideoNode;     // node of the camera selected with setCurrentDevice
+    void listRegisteredDevices();
+
 
 public slots:
 
     int  getUsbSpeed(QString serialNumber);
+    bool isCurrentDevice(QString videoNode);
     /**
      * @brief Check e-con Cameras
      *  - List all the camera devices detected in the system
@@ -170,6 +176,10 @@ signals:
     // 07 Dec 2017
     void notifyUserInfo(QString title, QString text);
 
+    // Incremental hotplug events for the camera list
+    void cameraDeviceAdded(QString videoNode, QString cameraName);
+    void cameraDeviceRemoved(QString videoNode, QString cameraName);
+
 };
 
 
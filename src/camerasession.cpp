@@ -0,0 +1,78 @@
+/*
+ * camerasession.cpp -- state of one opened camera
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "camerasession.h"
+#include <unistd.h>
+
+QList<CameraSession *> CameraSession::s_sessions;
+CameraSession *CameraSession::s_selected = NULL;
+
+CameraSession::CameraSession()
+{
+    deviceNumber = -1;
+    cameraEnum = CommonEnums::NONE;
+    hidFd = -1;
+    usbHandle = NULL;
+    kernelDriverDetached = 0;
+    s_sessions.append(this);
+}
+
+CameraSession::~CameraSession()
+{
+    closeHid();
+    s_sessions.removeOne(this);
+    if (s_selected == this)
+        s_selected = s_sessions.isEmpty() ? NULL : s_sessions.first();
+}
+
+CameraSession *CameraSession::selected()
+{
+    if (!s_selected)
+        s_selected = new CameraSession();
+    return s_selected;
+}
+
+void CameraSession::select(CameraSession *session)
+{
+    if (session)
+        s_selected = session;
+}
+
+const QList<CameraSession *> &CameraSession::sessions()
+{
+    return s_sessions;
+}
+
+void CameraSession::closeHid()
+{
+    if (hidFd >= 0) {
+        close(hidFd);
+        hidFd = -1;
+    }
+    if (usbHandle) {
+        libusb_release_interface(usbHandle, 2);
+        if (kernelDriverDetached)
+            libusb_attach_kernel_driver(usbHandle, 2);
+        libusb_close(usbHandle);
+        libusb_exit(NULL);
+        usbHandle = NULL;
+        kernelDriverDetached = 0;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * camerasession.h -- state of one opened camera
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CAMERASESSION_H
+#define CAMERASESSION_H
+
+#include <QObject>
+#include <QList>
+#include <QStringListModel>
+#include <libusb.h>
+#include "common_enums.h"
+
+/**
+ * @brief The CameraSession class - device node, camera type, extension unit handle and format
+ * lists of one camera. Every Videostreaming item previews the camera of its own session, so
+ * several cameras stream, record and keep their hid handle open in one process.
+ * The camera picked in the camera list and the extension unit control pages work on the
+ * selected session, Videostreaming::selectSession() switches them to another camera.
+ */
+class CameraSession : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QObject *resolutionModel READ resolutionModel CONSTANT)
+    Q_PROPERTY(QObject *stillOutputFormatModel READ stillOutputFormatModel CONSTANT)
+    Q_PROPERTY(QObject *videoOutputFormatModel READ videoOutputFormatModel CONSTANT)
+    Q_PROPERTY(QObject *fpsModel READ fpsModel CONSTANT)
+    Q_PROPERTY(QObject *encodersModel READ encodersModel CONSTANT)
+
+public:
+    CameraSession();
+    ~CameraSession();
+
+    /**
+     * @brief selected - session of the camera picked in the UI, created on first use
+     */
+    static CameraSession *selected();
+    static void select(CameraSession *session);
+    static const QList<CameraSession *> &sessions();
+
+    /**
+     * @brief closeHid - close the hidraw node/libusb handle of the extension unit
+     */
+    void closeHid();
+
+    QObject *resolutionModel() { return &resolution; }
+    QObject *stillOutputFormatModel() { return &stillOutputFormat; }
+    QObject *videoOutputFormatModel() { return &videoOutputFormat; }
+    QObject *fpsModel() { return &fpsList; }
+    QObject *encodersModel() { return &encoderList; }
+
+    // video node
+    int deviceNumber;                   // N of /dev/videoN
+    QString cameraName;
+    CommonEnums::ECameraNames cameraEnum;
+
+    // extension unit
+    QString hidNode;                    // usb location of the hid interface
+    QString openNode;                   // hidraw node opened for hidNode
+    int hidFd;
+    libusb_device_handle *usbHandle;    // Ascella cameras, controlled through libusb
+    int kernelDriverDetached;
+
+    // formats offered for this camera
+    QStringListModel resolution;
+    QStringListModel stillOutputFormat;
+    QStringListModel videoOutputFormat;
+    QStringListModel fpsList;
+    QStringListModel encoderList;
+
+private:
+    static QList<CameraSession *> s_sessions;
+    static CameraSession *s_selected;
+};
+
+#endif // CAMERASESSION_H
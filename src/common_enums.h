@@ -72,7 +72,11 @@ public:
         NO_RENDER = 0,      // stop render for skipframes
         RGB_BUFFER_RENDER = 1, // rgba
         YUYV_BUFFER_RENDER,
-	UYVY_BUFFER_RENDER
+	UYVY_BUFFER_RENDER,
+        YUV420_BUFFER_RENDER,  // y, u, v planes with quarter size chroma
+        MONO_BUFFER_RENDER,    // y plane only, grey cameras
+        MONO16_BUFFER_RENDER,  // y plane of 16 bit samples with 12 bits used, y12/y16 cameras
+        BAYER_BUFFER_RENDER    // raw grbg plane in the y buffer, demosaiced by the shader
     }ERenderBuffer;
 	
     Q_ENUMS(ERenderBuffer)
@@ -0,0 +1,221 @@
+/*
+ * controlcache.cpp -- cached extension unit state of the opened cameras
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "controlcache.h"
+#include "hidengine.h"
+
+ControlCache *ControlCache::instance()
+{
+    static ControlCache *cache = NULL;
+    if (!cache)
+        cache = new ControlCache();
+    return cache;
+}
+
+bool ControlCache::request(const QString &device, int fd, const unsigned char *outBuf, int len,
+                           QObject *receiver, const char *member)
+{
+    if (fd < 0 || len < 3)
+        return false;
+
+    DeviceState &state = m_devices[device];
+    quint16 key = commandKey(outBuf);
+    Waiter waiter;
+    waiter.receiver = receiver;
+    waiter.member = member;
+
+    if (state.replies.contains(key)) {
+        QMetaObject::invokeMethod(receiver, member, Qt::QueuedConnection, Q_ARG(QByteArray, state.replies.value(key)));
+        return true;
+    }
+
+    // the same control is already being read, share its reply
+    QHash<QFutureWatcher<QByteArray> *, Pending>::iterator it;
+    for (it = m_pending.begin(); it != m_pending.end(); ++it) {
+        if (it.value().device == device && it.value().key == key && it.value().generation == state.generation) {
+            it.value().waiters.append(waiter);
+            return true;
+        }
+    }
+
+    Pending pending;
+    pending.device = device;
+    pending.key = key;
+    pending.generation = state.generation;
+    pending.waiters.append(waiter);
+
+    QFutureWatcher<QByteArray> *watcher = new QFutureWatcher<QByteArray>(this);
+    connect(watcher, SIGNAL(finished()), this, SLOT(replyReceived()));
+    m_pending.insert(watcher, pending);
+    watcher->setFuture(HidEngine::instance()->submit(fd, outBuf, len, HID_DEFAULT_TIMEOUT_MS, 2, true));
+    return true;
+}
+
+void ControlCache::replyReceived()
+{
+    QFutureWatcher<QByteArray> *watcher = static_cast<QFutureWatcher<QByteArray> *>(sender());
+    Pending pending = m_pending.take(watcher);
+    QFuture<QByteArray> future = watcher->future();
+    watcher->deleteLater();
+
+    if (future.resultCount() == 0)
+        return;
+    QByteArray reply = future.result();
+
+    DeviceState &state = m_devices[pending.device];
+    if (pending.generation == state.generation)
+        state.replies.insert(pending.key, reply);
+    for (int i = 0; i < pending.waiters.count(); i++) {
+        const Waiter &waiter = pending.waiters.at(i);
+        if (waiter.receiver)
+            QMetaObject::invokeMethod(waiter.receiver, waiter.member.constData(), Qt::DirectConnection, Q_ARG(QByteArray, reply));
+    }
+}
+
+void ControlCache::commandSent(const QString &device, const unsigned char *outBuf, int len, int kind)
+{
+    if (len < 3)
+        return;
+    DeviceState &state = m_devices[device];
+    invalidate(state, outBuf[1]);
+    if (kind == HID_COMMAND || (kind == HID_SETTING_SUBID && len < 4))
+        return;
+    HidSetting setting;
+    setting.command = QByteArray((const char *)outBuf, len);
+    setting.kind = kind;
+    journalSetting(state, setting);
+}
+
+void ControlCache::deviceOpened(const QString &device)
+{
+    if (!m_devices.contains(device))
+        return;
+    DeviceState &state = m_devices[device];
+    state.replies.clear();
+    state.generation++;
+}
+
+QList<HidSetting> ControlCache::journal(const QString &device) const
+{
+    QList<HidSetting> settings;
+    if (!m_devices.contains(device))
+        return settings;
+    const DeviceState &state = m_devices[device];
+    for (int i = 0; i < state.order.count(); i++)
+        settings.append(state.settings.value(state.order.at(i)));
+    return settings;
+}
+
+/**
+ * @brief ControlCache::replay - commands of different controls don't depend on each other's reply,
+ * so they are written back to back and the round trips overlap. The replies are counted as they
+ * arrive, the GUI thread is not blocked.
+ */
+int ControlCache::replay(const QString &device, int fd, const QList<HidSetting> &settings)
+{
+    if (fd < 0)
+        return 0;
+
+    DeviceState &state = m_devices[device];
+    int id = ++m_lastReplay;
+    Replay replay;
+    replay.device = device;
+    replay.sent = replay.answered = replay.pending = 0;
+
+    QList<QFutureWatcher<QByteArray> *> watchers;
+    for (int i = 0; i < settings.count(); i++) {
+        const HidSetting &setting = settings.at(i);
+        if (setting.command.size() < (setting.kind == HID_SETTING_SUBID ? 4 : 3))
+            continue;
+        invalidate(state, (unsigned char)setting.command.at(1));
+        journalSetting(state, setting);
+
+        QFutureWatcher<QByteArray> *watcher = new QFutureWatcher<QByteArray>(this);
+        watcher->setProperty("replay", id);
+        connect(watcher, SIGNAL(finished()), this, SLOT(replayReplied()));
+        watchers.append(watcher);
+        replay.sent++;
+    }
+    replay.pending = replay.sent;
+    m_replays.insert(id, replay);
+
+    // futures are set once the replay is registered, a reply can't arrive before it
+    int w = 0;
+    for (int i = 0; i < settings.count() && w < watchers.count(); i++) {
+        const HidSetting &setting = settings.at(i);
+        if (setting.command.size() < (setting.kind == HID_SETTING_SUBID ? 4 : 3))
+            continue;
+        watchers.at(w++)->setFuture(HidEngine::instance()->submit(fd, (const unsigned char *)setting.command.constData(),
+                                                                  setting.command.size(), HID_DEFAULT_TIMEOUT_MS, 2, true));
+    }
+    if (replay.sent == 0) {
+        m_replays.remove(id);
+        emit replayFinished(device, 0, 0);
+    }
+    return replay.sent;
+}
+
+void ControlCache::replayReplied()
+{
+    QFutureWatcher<QByteArray> *watcher = static_cast<QFutureWatcher<QByteArray> *>(sender());
+    int id = watcher->property("replay").toInt();
+    bool answered = watcher->future().resultCount() > 0;
+    watcher->deleteLater();
+
+    if (!m_replays.contains(id))
+        return;
+    Replay &replay = m_replays[id];
+    if (answered)
+        replay.answered++;
+    if (--replay.pending > 0)
+        return;
+    Replay done = m_replays.take(id);
+    emit replayFinished(done.device, done.answered, done.sent);
+}
+
+void ControlCache::invalidate(DeviceState &state, unsigned char cameraId)
+{
+    QHash<quint16, QByteArray>::iterator it = state.replies.begin();
+    while (it != state.replies.end()) {
+        if ((it.key() >> 8) == cameraId)
+            it = state.replies.erase(it);
+        else
+            ++it;
+    }
+    state.generation++;
+}
+
+quint32 ControlCache::settingKey(const HidSetting &setting)
+{
+    const unsigned char *outBuf = (const unsigned char *)setting.command.constData();
+    quint32 key = (outBuf[1] << 8) | outBuf[2];
+    if (setting.kind == HID_SETTING_SUBID)
+        key |= (0x100u | outBuf[3]) << 16;
+    return key;
+}
+
+void ControlCache::journalSetting(DeviceState &state, const HidSetting &setting)
+{
+    quint32 key = settingKey(setting);
+    // the latest value of a control replaces the earlier one but keeps the order of the commands
+    state.order.removeOne(key);
+    state.order.append(key);
+    state.settings.insert(key, setting);
+}
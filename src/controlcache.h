@@ -0,0 +1,143 @@
+/*
+ * controlcache.h -- cached extension unit state of the opened cameras
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CONTROLCACHE_H
+#define CONTROLCACHE_H
+
+#include <QObject>
+#include <QMap>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QByteArray>
+#include <QStringList>
+#include <QFutureWatcher>
+
+// journal kind of a command sent with uvccamera::sendHidCmd
+#define HID_COMMAND             0   /* action or get, not journaled */
+#define HID_SETTING             1   /* one entry per [camera id, command id] */
+#define HID_SETTING_SUBID       2   /* one entry per [camera id, command id, byte 3], byte 3 selects the control */
+
+/**
+ * @brief The HidSetting struct - journaled command with its journal kind
+ */
+struct HidSetting {
+    QByteArray command;
+    int kind;           // HID_SETTING or HID_SETTING_SUBID
+};
+
+/**
+ * @brief The ControlCache class - per device state of the hid extension unit, keyed by the
+ * hid node (usb physical location) so it survives reopening the same camera.
+ *  - replies of the get commands are cached until a command is sent to the same camera id
+ *    or the device is opened again, concurrent gets of the same control share one request.
+ *  - commands the caller marks as settings are journaled in order, one entry per control,
+ *    replaying the journal brings a camera back to the same state. Actions [store, grab, set to
+ *    default] and gets are never journaled.
+ * Must be used from the GUI thread.
+ */
+class ControlCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ControlCache *instance();
+
+    /**
+     * @brief request - answer a get command from the cache or queue it on the hid engine
+     * @param device - hid node of the camera
+     * @param fd - opened hidraw node
+     * @param outBuf - report to write, outBuf[0] is the report number
+     * @param member - slot of receiver, called as member(QByteArray reply)
+     */
+    bool request(const QString &device, int fd, const unsigned char *outBuf, int len,
+                 QObject *receiver, const char *member);
+
+    /**
+     * @brief commandSent - a command was answered on the synchronous path, drop the cached
+     * replies of its camera id and journal it if it is a setting
+     * @param kind - HID_COMMAND, HID_SETTING or HID_SETTING_SUBID
+     */
+    void commandSent(const QString &device, const unsigned char *outBuf, int len, int kind);
+
+    /**
+     * @brief deviceOpened - the camera may have been reset, forget its cached replies
+     */
+    void deviceOpened(const QString &device);
+
+    /**
+     * @brief journal - commands which set the current extension unit state, oldest first
+     */
+    QList<HidSetting> journal(const QString &device) const;
+
+    /**
+     * @brief replay - send the settings pipelined, replayFinished is emitted once all are answered
+     * @return number of commands sent
+     */
+    int replay(const QString &device, int fd, const QList<HidSetting> &settings);
+
+signals:
+    void replayFinished(QString device, int answered, int sent);
+
+private slots:
+    void replyReceived();
+    void replayReplied();
+
+private:
+    struct Waiter {
+        QPointer<QObject> receiver;
+        QByteArray member;
+    };
+    struct Pending {
+        QString device;
+        quint16 key;
+        uint generation;
+        QList<Waiter> waiters;
+    };
+    struct DeviceState {
+        QHash<quint16, QByteArray> replies;     // get command -> last reply
+        QList<quint32> order;                   // journal order
+        QHash<quint32, HidSetting> settings;    // journal entries
+        uint generation;                        // bumped on invalidation, stale replies are not cached
+
+        DeviceState() : generation(0) {}
+    };
+
+    struct Replay {
+        QString device;
+        int sent;
+        int answered;
+        int pending;
+    };
+
+    ControlCache() : m_lastReplay(0) {}
+
+    static inline quint16 commandKey(const unsigned char *outBuf) { return (outBuf[1] << 8) | outBuf[2]; }
+    static quint32 settingKey(const HidSetting &setting);
+    void invalidate(DeviceState &state, unsigned char cameraId);
+    void journalSetting(DeviceState &state, const HidSetting &setting);
+
+    QMap<QString, DeviceState> m_devices;
+    QHash<QFutureWatcher<QByteArray> *, Pending> m_pending;
+    QHash<int, Replay> m_replays;
+    int m_lastReplay;
+};
+
+#endif // CONTROLCACHE_H
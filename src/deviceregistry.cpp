@@ -0,0 +1,289 @@
+/*
+ * deviceregistry.cpp -- camera device registry kept current by udev events
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "deviceregistry.h"
+#include <QCoreApplication>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/videodev2.h>
+
+DeviceRegistry *DeviceRegistry::instance()
+{
+    static DeviceRegistry *registry = NULL;
+    if (!registry) {
+        registry = new DeviceRegistry();
+        // stop the monitor thread while the event loops still exist, the registry itself is never deleted
+        if (QCoreApplication::instance())
+            connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), registry, SLOT(shutdown()), Qt::DirectConnection);
+        registry->start();
+    }
+    return registry;
+}
+
+DeviceRegistry::DeviceRegistry()
+{
+    m_udev = NULL;
+    m_monitor = NULL;
+    m_notifier = NULL;
+}
+
+DeviceRegistry::~DeviceRegistry()
+{
+    shutdown();
+    if (m_monitor)
+        udev_monitor_unref(m_monitor);
+    if (m_udev)
+        udev_unref(m_udev);
+}
+
+void DeviceRegistry::shutdown()
+{
+    if (m_thread.isRunning()) {
+        // the notifier has to be destroyed in the thread it was created in
+        QMetaObject::invokeMethod(this, "stopNotifier", Qt::BlockingQueuedConnection);
+        m_thread.quit();
+        m_thread.wait();
+    }
+}
+
+bool DeviceRegistry::start()
+{
+    if (m_monitor)
+        return true;
+
+    m_udev = udev_new();
+    if (!m_udev) {
+        fprintf(stderr, "DeviceRegistry: can't create udev\n");
+        return false;
+    }
+
+    // monitor is enabled before the scan so no device is missed in between,
+    // events for devices found by the scan are simply applied again
+    m_monitor = udev_monitor_new_from_netlink(m_udev, "udev");
+    if (!m_monitor) {
+        fprintf(stderr, "DeviceRegistry: can't create udev monitor\n");
+        udev_unref(m_udev);
+        m_udev = NULL;
+        return false;
+    }
+    udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "video4linux", NULL);
+    udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "hidraw", NULL);
+    udev_monitor_enable_receiving(m_monitor);
+
+    // hidraw first, so video nodes find their hid nodes when they are added
+    const char *subsystems[] = { "hidraw", "video4linux" };
+    for (int i = 0; i < 2; i++) {
+        struct udev_enumerate *enumerate = udev_enumerate_new(m_udev);
+        struct udev_list_entry *entry;
+        udev_enumerate_add_match_subsystem(enumerate, subsystems[i]);
+        udev_enumerate_scan_devices(enumerate);
+        udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+            struct udev_device *dev = udev_device_new_from_syspath(m_udev, udev_list_entry_get_name(entry));
+            if (dev) {
+                addDevice(dev);
+                udev_device_unref(dev);
+            }
+        }
+        udev_enumerate_unref(enumerate);
+    }
+
+    moveToThread(&m_thread);
+    m_thread.start();
+    QMetaObject::invokeMethod(this, "startNotifier", Qt::QueuedConnection);
+    return true;
+}
+
+QList<CameraDeviceInfo> DeviceRegistry::devices()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_devices.values();
+}
+
+bool DeviceRegistry::deviceBySerial(QString serialNumber, CameraDeviceInfo &info)
+{
+    QMutexLocker locker(&m_mutex);
+    QMap<int, CameraDeviceInfo>::const_iterator it;
+    for (it = m_devices.constBegin(); it != m_devices.constEnd(); ++it) {
+        if (!it.value().serialNumber.isEmpty() &&
+            QString::compare(it.value().serialNumber, serialNumber, Qt::CaseInsensitive) == 0) {
+            info = it.value();
+            return true;
+        }
+    }
+    return false;
+}
+
+void DeviceRegistry::startNotifier()
+{
+    m_notifier = new QSocketNotifier(udev_monitor_get_fd(m_monitor), QSocketNotifier::Read, this);
+    connect(m_notifier, SIGNAL(activated(int)), this, SLOT(receiveEvent()));
+}
+
+void DeviceRegistry::stopNotifier()
+{
+    delete m_notifier;
+    m_notifier = NULL;
+}
+
+void DeviceRegistry::receiveEvent()
+{
+    struct udev_device *dev = udev_monitor_receive_device(m_monitor);
+    if (!dev)
+        return;
+
+    const char *action = udev_device_get_action(dev);
+    if (action && !strcmp(action, "add"))
+        addDevice(dev);
+    else if (action && !strcmp(action, "remove"))
+        removeDevice(dev);
+    udev_device_unref(dev);
+}
+
+void DeviceRegistry::addDevice(struct udev_device *dev)
+{
+    const char *subsystem = udev_device_get_subsystem(dev);
+    if (!subsystem)
+        return;
+
+    // owned by dev, must not be unreferenced
+    struct udev_device *usbDev = udev_device_get_parent_with_subsystem_devtype(dev, "usb", "usb_device");
+    if (!strcmp(subsystem, "video4linux"))
+        addVideoNode(dev, usbDev);
+    else if (!strcmp(subsystem, "hidraw") && usbDev)
+        addHidNode(dev, usbDev);
+}
+
+/**
+ * @brief DeviceRegistry::addVideoNode - querycap the node once and store it with its usb details
+ */
+void DeviceRegistry::addVideoNode(struct udev_device *dev, struct udev_device *usbDev)
+{
+    CameraDeviceInfo info;
+    QString sysName = QString::fromUtf8(udev_device_get_sysname(dev));
+    if (!sysName.startsWith("video"))
+        return;
+    info.videoIndex = sysName.mid(5).toInt();
+    info.videoNode = udev_device_get_devnode(dev) ? QString::fromUtf8(udev_device_get_devnode(dev)) : "/dev/" + sysName;
+
+    int fd = ::open(info.videoNode.toLatin1().data(), O_RDWR | O_NONBLOCK);
+    if (fd < 0) {
+        perror(info.videoNode.toLatin1().data());
+        return;
+    }
+    struct v4l2_capability cap;
+    memset(&cap, 0, sizeof(cap));
+    int ret = ::ioctl(fd, VIDIOC_QUERYCAP, &cap);
+    ::close(fd);
+    if (ret < 0) {
+        perror("VIDIOC_QUERYCAP");
+        return;
+    }
+    info.cardName = QString::fromUtf8((const char *)cap.card);
+    info.busInfo = QString::fromUtf8((const char *)cap.bus_info);
+
+    if (usbDev) {
+        info.usbSysPath = QString::fromUtf8(udev_device_get_syspath(usbDev));
+        info.product = QString::fromUtf8(udev_device_get_sysattr_value(usbDev, "product"));
+        info.serialNumber = QString::fromUtf8(udev_device_get_sysattr_value(usbDev, "serial"));
+        info.vid = QString::fromUtf8(udev_device_get_sysattr_value(usbDev, "idVendor")).toLower();
+        info.pid = QString::fromUtf8(udev_device_get_sysattr_value(usbDev, "idProduct")).toLower();
+        info.speedMbps = QString::fromUtf8(udev_device_get_sysattr_value(usbDev, "speed")).toInt();
+    }
+
+    m_mutex.lock();
+    if (!info.usbSysPath.isEmpty())
+        info.hidNodes = m_hidByUsb.values(info.usbSysPath);
+    bool known = m_devices.contains(info.videoIndex);
+    m_devices.insert(info.videoIndex, info);
+    m_mutex.unlock();
+
+    if (!known)
+        emit deviceAdded(info.videoNode, info.cardName);
+}
+
+void DeviceRegistry::addHidNode(struct udev_device *dev, struct udev_device *usbDev)
+{
+    if (!udev_device_get_devnode(dev))
+        return;
+    QString hidNode = QString::fromUtf8(udev_device_get_devnode(dev));
+    QString usbSysPath = QString::fromUtf8(udev_device_get_syspath(usbDev));
+    QStringList changed;
+
+    m_mutex.lock();
+    if (!m_hidByUsb.contains(usbSysPath, hidNode))
+        m_hidByUsb.insert(usbSysPath, hidNode);
+    QMap<int, CameraDeviceInfo>::iterator it;
+    for (it = m_devices.begin(); it != m_devices.end(); ++it) {
+        if (it.value().usbSysPath == usbSysPath && !it.value().hidNodes.contains(hidNode)) {
+            it.value().hidNodes.append(hidNode);
+            changed.append(it.value().videoNode);
+        }
+    }
+    m_mutex.unlock();
+
+    for (int i = 0; i < changed.count(); i++)
+        emit deviceChanged(changed.at(i));
+}
+
+/**
+ * @brief DeviceRegistry::removeDevice - sysfs is already gone, so the device is found by its node name
+ */
+void DeviceRegistry::removeDevice(struct udev_device *dev)
+{
+    const char *subsystem = udev_device_get_subsystem(dev);
+    if (!subsystem)
+        return;
+
+    if (!strcmp(subsystem, "video4linux")) {
+        QString sysName = QString::fromUtf8(udev_device_get_sysname(dev));
+        if (!sysName.startsWith("video"))
+            return;
+        m_mutex.lock();
+        bool known = m_devices.contains(sysName.mid(5).toInt());
+        CameraDeviceInfo info = m_devices.take(sysName.mid(5).toInt());
+        m_mutex.unlock();
+        if (known)
+            emit deviceRemoved(info.videoNode, info.cardName);
+    } else if (!strcmp(subsystem, "hidraw") && udev_device_get_devnode(dev)) {
+        QString hidNode = QString::fromUtf8(udev_device_get_devnode(dev));
+        QStringList changed;
+
+        m_mutex.lock();
+        QMultiMap<QString, QString>::iterator hid = m_hidByUsb.begin();
+        while (hid != m_hidByUsb.end()) {
+            if (hid.value() == hidNode)
+                hid = m_hidByUsb.erase(hid);
+            else
+                ++hid;
+        }
+        QMap<int, CameraDeviceInfo>::iterator it;
+        for (it = m_devices.begin(); it != m_devices.end(); ++it) {
+            if (it.value().hidNodes.removeAll(hidNode))
+                changed.append(it.value().videoNode);
+        }
+        m_mutex.unlock();
+
+        for (int i = 0; i < changed.count(); i++)
+            emit deviceChanged(changed.at(i));
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * deviceregistry.h -- camera device registry kept current by udev events
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DEVICEREGISTRY_H
+#define DEVICEREGISTRY_H
+
+#include <QObject>
+#include <QMap>
+#include <QMutex>
+#include <QThread>
+#include <QStringList>
+#include <QSocketNotifier>
+#include "libudev.h"
+
+/**
+ * @brief The CameraDeviceInfo struct - everything known about one /dev/videoN node
+ */
+struct CameraDeviceInfo
+{
+    int videoIndex;         // N of /dev/videoN
+    QString videoNode;      // /dev/videoN
+    QString cardName;       // querycap card
+    QString busInfo;        // querycap bus_info
+    QString usbSysPath;     // sysfs path of the parent usb device
+    QString product;        // usb product string
+    QString serialNumber;
+    QString vid;            // idVendor, lower case hex
+    QString pid;            // idProduct, lower case hex
+    int speedMbps;          // usb link speed, 0 if unknown
+    QStringList hidNodes;   // /dev/hidrawN of the same usb device
+
+    CameraDeviceInfo() : videoIndex(-1), speedMbps(0) {}
+};
+
+/**
+ * @brief The DeviceRegistry class - video4linux and hidraw devices, scanned once and then
+ * updated from a udev monitor on a background thread. Lookups never open a device.
+ * One registry is shared by the whole application.
+ */
+class DeviceRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    // the shared registry, started on first use
+    static DeviceRegistry *instance();
+
+    /**
+     * @brief start - scan the present devices and start monitoring
+     * @return false if udev is not available
+     */
+    bool start();
+    inline bool isRunning() const { return m_monitor != NULL; }
+
+    // snapshot of all video nodes ordered by index
+    QList<CameraDeviceInfo> devices();
+    bool deviceBySerial(QString serialNumber, CameraDeviceInfo &info);
+
+signals:
+    void deviceAdded(QString videoNode, QString cardName);
+    void deviceRemoved(QString videoNode, QString cardName);
+    // hid node of a listed camera appeared or disappeared
+    void deviceChanged(QString videoNode);
+
+private slots:
+    void shutdown();
+    void startNotifier();
+    void stopNotifier();
+    void receiveEvent();
+
+private:
+    DeviceRegistry();
+    ~DeviceRegistry();
+
+    void addDevice(struct udev_device *dev);
+    void removeDevice(struct udev_device *dev);
+    void addVideoNode(struct udev_device *dev, struct udev_device *usbDev);
+    void addHidNode(struct udev_device *dev, struct udev_device *usbDev);
+
+    struct udev *m_udev;
+    struct udev_monitor *m_monitor;
+    QSocketNotifier *m_notifier;
+    QThread m_thread;
+
+    QMutex m_mutex;
+    QMap<int, CameraDeviceInfo> m_devices;      // by video index
+    QMultiMap<QString, QString> m_hidByUsb;     // usb sysfs path -> hidraw node
+};
+
+#endif // DEVICEREGISTRY_H
@@ -0,0 +1,182 @@
+/*
+ * frameexport.cpp -- publish captured frames to a shared memory ring
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frameexport.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+
+FrameExport::FrameExport()
+{
+    m_header = NULL;
+    m_mapSize = 0;
+    m_frameSize = 0;
+    m_slotCount = 0;
+}
+
+FrameExport::~FrameExport()
+{
+    close();
+}
+
+/**
+ * @brief liveProducer - pid of the running process publishing an active ring under the name,
+ * 0 for no ring, a closed one or one left by a crashed process
+ */
+static pid_t liveProducer(const char *shmName)
+{
+    int fd = shm_open(shmName, O_RDONLY, 0);
+    if (fd < 0)
+        return 0;
+    pid_t pid = 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(struct qtcam_shm_header)) {
+        void *base = mmap(NULL, sizeof(struct qtcam_shm_header), PROT_READ, MAP_SHARED, fd, 0);
+        if (base != MAP_FAILED) {
+            const struct qtcam_shm_header *header = (const struct qtcam_shm_header *)base;
+            if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == QTCAM_SHM_MAGIC &&
+                __atomic_load_n(&header->state, __ATOMIC_ACQUIRE) == QTCAM_SHM_STATE_ACTIVE &&
+                header->producer_pid > 0 &&
+                (kill(header->producer_pid, 0) == 0 || errno == EPERM))
+                pid = header->producer_pid;
+            munmap(base, sizeof(struct qtcam_shm_header));
+        }
+    }
+    ::close(fd);
+    return pid;
+}
+
+bool FrameExport::open(const QString &name, size_t frameSize, uint slotCount)
+{
+    if (m_header && name == m_name && frameSize <= m_frameSize && slotCount == m_slotCount)
+        return true;
+    close();
+
+    size_t slotSize = (QTCAM_SHM_SLOT_HEADER_SIZE + frameSize + QTCAM_SHM_ALIGN - 1) & ~((size_t)QTCAM_SHM_ALIGN - 1);
+    size_t mapSize = QTCAM_SHM_SLOTS_OFFSET + slotSize * slotCount;
+    QByteArray shmName = (QTCAM_SHM_PREFIX + name).toLatin1();
+
+    // the name belongs to another camera [this or another process] while its producer runs
+    pid_t owner = liveProducer(shmName.constData());
+    if (owner) {
+        fprintf(stderr, "Frame export: %s is published by process %d\n", shmName.constData(), (int)owner);
+        return false;
+    }
+    // a stale ring of a crashed instance is replaced, clients still mapping it keep their copy
+    shm_unlink(shmName.constData());
+    int fd = shm_open(shmName.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        perror("shm_open");
+        return false;
+    }
+    if (ftruncate(fd, mapSize) < 0) {
+        perror("ftruncate");
+        ::close(fd);
+        shm_unlink(shmName.constData());
+        return false;
+    }
+    void *base = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        shm_unlink(shmName.constData());
+        return false;
+    }
+
+    m_header = (struct qtcam_shm_header *)base;
+    m_header->version = QTCAM_SHM_VERSION;
+    m_header->slot_count = slotCount;
+    m_header->slot_size = slotSize;
+    m_header->data_offset = QTCAM_SHM_SLOT_HEADER_SIZE;
+    m_header->frame_count = 0;
+    m_header->futex = 0;
+    m_header->producer_pid = getpid();
+    m_header->state = QTCAM_SHM_STATE_ACTIVE;
+    // magic last, clients check it before trusting the rest of the header
+    __atomic_store_n(&m_header->magic, QTCAM_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    m_name = name;
+    m_mapSize = mapSize;
+    m_frameSize = slotSize - QTCAM_SHM_SLOT_HEADER_SIZE;
+    m_slotCount = slotCount;
+    return true;
+}
+
+void FrameExport::close()
+{
+    if (!m_header)
+        return;
+    __atomic_store_n(&m_header->state, QTCAM_SHM_STATE_CLOSED, __ATOMIC_RELEASE);
+    wakeClients();
+    munmap(m_header, m_mapSize);
+    shm_unlink((QTCAM_SHM_PREFIX + m_name).toLatin1().constData());
+    m_header = NULL;
+    m_mapSize = 0;
+    m_frameSize = 0;
+}
+
+void FrameExport::publish(const void *data, const v4l2_format &format, const v4l2_buffer &buf, qint64 captureNs)
+{
+    if (!m_header || buf.bytesused > m_frameSize)
+        return;
+
+    // driver timestamps may be copied or from another clock, clients are promised CLOCK_MONOTONIC
+    if (captureNs <= 0) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        captureNs = now.tv_sec * 1000000000LL + now.tv_nsec;
+    }
+
+    uint64_t frameNumber = m_header->frame_count;
+    uint8_t *slotBase = (uint8_t *)m_header + QTCAM_SHM_SLOTS_OFFSET + (frameNumber % m_slotCount) * m_header->slot_size;
+    struct qtcam_shm_slot *slot = (struct qtcam_shm_slot *)slotBase;
+
+    __atomic_store_n(&slot->lock, 2 * frameNumber + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->frame_number = frameNumber;
+    slot->timestamp_ns = (uint64_t)captureNs;
+    slot->sequence = buf.sequence;
+    slot->pixelformat = format.fmt.pix.pixelformat;
+    slot->width = format.fmt.pix.width;
+    slot->height = format.fmt.pix.height;
+    slot->bytesperline = format.fmt.pix.bytesperline;
+    slot->bytesused = buf.bytesused;
+    memcpy(slotBase + QTCAM_SHM_SLOT_HEADER_SIZE, data, buf.bytesused);
+
+    __atomic_store_n(&slot->lock, 2 * frameNumber + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&m_header->frame_count, frameNumber + 1, __ATOMIC_RELEASE);
+    wakeClients();
+}
+
+void FrameExport::wakeClients()
+{
+    __atomic_add_fetch(&m_header->futex, 1, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &m_header->futex, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
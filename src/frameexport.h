@@ -0,0 +1,69 @@
+/*
+ * frameexport.h -- publish captured frames to a shared memory ring
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAMEEXPORT_H
+#define FRAMEEXPORT_H
+
+#include <QString>
+#include <linux/videodev2.h>
+#include "shmclient/qtcam_shm.h"
+
+/**
+ * @brief The FrameExport class - writer side of the shared memory frame ring.
+ * See shmclient/qtcam_shm.h for the layout and protocol, shmclient/qtcam_shm_client.h
+ * for the client library.
+ */
+class FrameExport
+{
+public:
+    FrameExport();
+    ~FrameExport();
+
+    /**
+     * @brief open - create the ring, or reuse it when it is already big enough
+     * @param name - shared memory name, clients open "/qtcam-<name>"
+     * @param frameSize - maximum bytes of one frame
+     * @param slotCount - number of frames kept in the ring
+     * @return true - success /false - failure, also when a running producer publishes under the name
+     */
+    bool open(const QString &name, size_t frameSize, uint slotCount);
+    void close();
+
+    /**
+     * @brief publish - copy one frame into the next slot and wake the clients
+     * @param data - frame data
+     * @param format - current capture format
+     * @param buf - dequeued v4l2 buffer [bytesused, sequence]
+     * @param captureNs - CLOCK_MONOTONIC capture time, 0 if unknown [dequeue time is used]
+     */
+    void publish(const void *data, const v4l2_format &format, const v4l2_buffer &buf, qint64 captureNs);
+
+    inline bool isOpen() const { return m_header != NULL; }
+
+private:
+    void wakeClients();
+
+    QString m_name;
+    struct qtcam_shm_header *m_header;
+    size_t m_mapSize;
+    size_t m_frameSize;
+    uint m_slotCount;
+};
+
+#endif // FRAMEEXPORT_H
@@ -0,0 +1,193 @@
+/*
+ * framepool.cpp -- pool of capture frames backed by a memfd
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "framepool.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/types.h>
+
+/* Older glibc does not provide memfd_create() and the sealing flags */
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC         0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING   0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS         (1024 + 9)
+#endif
+#ifndef F_SEAL_SHRINK
+#define F_SEAL_SHRINK       0x0002
+#endif
+
+/* udmabuf - turns memfd pages into a dmabuf, see linux/udmabuf.h */
+struct frame_pool_udmabuf_create {
+    __u32 memfd;
+    __u32 flags;
+    __u64 offset;
+    __u64 size;
+};
+#define FRAME_POOL_UDMABUF_CREATE   _IOW('u', 0x42, struct frame_pool_udmabuf_create)
+#define FRAME_POOL_UDMABUF_FLAGS_CLOEXEC    0x01
+
+static int frame_pool_memfd_create(const char *name, unsigned int flags)
+{
+#ifdef SYS_memfd_create
+    return syscall(SYS_memfd_create, name, flags);
+#else
+    (void)name; (void)flags;
+    return -1;
+#endif
+}
+
+FramePool::FramePool()
+{
+    m_base = NULL;
+    m_slotSize = 0;
+    m_totalSize = 0;
+    m_count = 0;
+    m_memfd = -1;
+    m_refs = NULL;
+}
+
+FramePool::~FramePool()
+{
+    deinit();
+}
+
+bool FramePool::init(size_t frameSize, uint count, bool exportDmabuf)
+{
+    deinit();
+    if (!frameSize || !count)
+        return false;
+
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    m_slotSize = (frameSize + pageSize - 1) & ~(pageSize - 1);
+    m_totalSize = m_slotSize * count;
+
+    m_memfd = frame_pool_memfd_create("qtcam-frames", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (m_memfd < 0) {
+        perror("memfd_create");
+        return false;
+    }
+    if (ftruncate(m_memfd, m_totalSize) < 0) {
+        perror("ftruncate");
+        deinit();
+        return false;
+    }
+    // udmabuf refuses memfds that can shrink
+    fcntl(m_memfd, F_ADD_SEALS, F_SEAL_SHRINK);
+
+    void *base = ::mmap(NULL, m_totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_memfd, 0);
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        deinit();
+        return false;
+    }
+    m_base = (uint8_t *)base;
+    m_count = count;
+    m_refs = new QAtomicInt[count];
+
+    if (exportDmabuf && !exportDmabufs()) {
+        deinit();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief FramePool::exportDmabufs - create one dmabuf per slot from the memfd
+ * @return false if /dev/udmabuf is not available
+ */
+bool FramePool::exportDmabufs()
+{
+    int devfd = ::open("/dev/udmabuf", O_RDWR);
+    if (devfd < 0) {
+        perror("/dev/udmabuf");
+        return false;
+    }
+    for (uint i = 0; i < m_count; i++) {
+        struct frame_pool_udmabuf_create create;
+        create.memfd = m_memfd;
+        create.flags = FRAME_POOL_UDMABUF_FLAGS_CLOEXEC;
+        create.offset = offset(i);
+        create.size = m_slotSize;
+        int fd = ::ioctl(devfd, FRAME_POOL_UDMABUF_CREATE, &create);
+        if (fd < 0) {
+            perror("UDMABUF_CREATE");
+            ::close(devfd);
+            return false;
+        }
+        m_dmabufFds.append(fd);
+    }
+    ::close(devfd);
+    return true;
+}
+
+void FramePool::deinit()
+{
+    for (int i = 0; i < m_dmabufFds.count(); i++)
+        ::close(m_dmabufFds.at(i));
+    m_dmabufFds.clear();
+
+    if (m_base) {
+        ::munmap(m_base, m_totalSize);
+        m_base = NULL;
+    }
+    if (m_memfd >= 0) {
+        ::close(m_memfd);
+        m_memfd = -1;
+    }
+    delete[] m_refs;
+    m_refs = NULL;
+    m_count = 0;
+}
+
+int FramePool::acquire()
+{
+    for (uint i = 0; i < m_count; i++) {
+        if (m_refs[i].testAndSetAcquire(0, 1))
+            return i;
+    }
+    return -1;
+}
+
+void FramePool::retain(int slot)
+{
+    if (slot >= 0 && (uint)slot < m_count)
+        m_refs[slot].ref();
+}
+
+void FramePool::release(int slot)
+{
+    if (slot >= 0 && (uint)slot < m_count)
+        m_refs[slot].deref();
+}
+
+int FramePool::refCount(int slot) const
+{
+    if (slot < 0 || (uint)slot >= m_count)
+        return 0;
+    return m_refs[slot].load();
+}
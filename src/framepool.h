@@ -0,0 +1,83 @@
+/*
+ * framepool.h -- pool of capture frames backed by a memfd
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include <QAtomicInt>
+#include <QVector>
+#include <sys/types.h>
+#include <stdint.h>
+
+/**
+ * @brief The FramePool class - fixed number of page aligned frame slots in one memfd.
+ * Capture buffers are handed to the driver (USERPTR, or DMABUF through udmabuf) from this pool.
+ * A dequeued frame can be retained by any consumer [decoder, encoder, still writer, IPC] and
+ * is returned to the pool when the last reference is released, so no copy is needed to keep
+ * a frame after its V4L2 buffer index is requeued.
+ */
+class FramePool
+{
+public:
+    FramePool();
+    ~FramePool();
+
+    /**
+     * @brief init - allocate the pool
+     * @param frameSize - bytes needed for one frame [sizeimage]
+     * @param count - number of slots
+     * @param exportDmabuf - create a dmabuf fd for each slot through /dev/udmabuf
+     * @return true - success /false - failure
+     */
+    bool init(size_t frameSize, uint count, bool exportDmabuf = false);
+    void deinit();
+
+    // take a free slot with one reference, -1 when all slots are in use
+    int acquire();
+    void retain(int slot);
+    void release(int slot);
+    int refCount(int slot) const;
+
+    inline bool isValid() const { return m_base != NULL; }
+    inline uint count() const { return m_count; }
+    inline size_t slotSize() const { return m_slotSize; }
+    inline int memfd() const { return m_memfd; }
+    inline off_t offset(int slot) const { return (off_t)slot * m_slotSize; }
+    inline uint8_t *data(int slot) const { return m_base + offset(slot); }
+    // slot holding the address, -1 outside the pool
+    inline int slotOf(const void *p) const {
+        const uint8_t *b = (const uint8_t *)p;
+        return (m_base && b >= m_base && b < m_base + m_totalSize) ? (int)((b - m_base) / m_slotSize) : -1;
+    }
+    inline int dmabufFd(int slot) const { return m_dmabufFds.isEmpty() ? -1 : m_dmabufFds.at(slot); }
+    inline bool hasDmabuf() const { return !m_dmabufFds.isEmpty(); }
+
+private:
+    bool exportDmabufs();
+
+    uint8_t *m_base;
+    size_t m_slotSize;
+    size_t m_totalSize;
+    uint m_count;
+    int m_memfd;
+    QAtomicInt *m_refs;
+    QVector<int> m_dmabufFds;
+};
+
+#endif // FRAMEPOOL_H
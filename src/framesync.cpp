@@ -0,0 +1,315 @@
+/*
+ * framesync.cpp -- grouping of frames from several cameras by capture time
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "framesync.h"
+#include <time.h>
+
+FrameSynchronizer *FrameSynchronizer::instance()
+{
+    static FrameSynchronizer *synchronizer = NULL;
+    if (!synchronizer)
+        synchronizer = new FrameSynchronizer();
+    return synchronizer;
+}
+
+FrameSynchronizer::FrameSynchronizer()
+{
+    qRegisterMetaType<FrameSet>("FrameSet");
+    m_tolerance = SYNC_DEFAULT_TOLERANCE_NS;
+    m_policy = SYNC_POLICY_DROP;
+    m_skewSum = m_skewMax = 0;
+    m_sets = m_dropped = m_duplicated = 0;
+}
+
+int FrameSynchronizer::indexOf(CameraSession *camera) const
+{
+    for (int i = 0; i < m_cameras.count(); i++) {
+        if (m_cameras.at(i).camera == camera)
+            return i;
+    }
+    return -1;
+}
+
+void FrameSynchronizer::addCamera(CameraSession *camera)
+{
+    QMutexLocker locker(&m_mutex);
+    if (indexOf(camera) >= 0)
+        return;
+    CameraQueue queue;
+    queue.camera = camera;
+    queue.hasLast = false;
+    queue.triggerMode = false;
+    queue.triggerBaseValid = false;
+    queue.triggerBase = 0;
+    queue.offsetSum = 0;
+    queue.offsetCount = 0;
+    m_cameras.append(queue);
+    // sets in progress would miss the new camera
+    clearQueues();
+}
+
+void FrameSynchronizer::removeCamera(CameraSession *camera)
+{
+    QMutexLocker locker(&m_mutex);
+    int index = indexOf(camera);
+    if (index < 0)
+        return;
+    m_cameras.remove(index);
+    clearQueues();
+}
+
+void FrameSynchronizer::setTolerance(qint64 ns)
+{
+    QMutexLocker locker(&m_mutex);
+    m_tolerance = qMax(0LL, ns);
+}
+
+void FrameSynchronizer::setPolicy(int policy)
+{
+    QMutexLocker locker(&m_mutex);
+    m_policy = policy;
+}
+
+void FrameSynchronizer::setTriggerMode(CameraSession *camera, bool enable)
+{
+    QMutexLocker locker(&m_mutex);
+    int index = indexOf(camera);
+    if (index < 0)
+        return;
+    m_cameras[index].triggerMode = enable;
+    // queued frames were keyed for the other mode
+    clearQueues();
+}
+
+/**
+ * @brief FrameSynchronizer::clearQueues - drop the queued frames, on any change of the cameras
+ * or of their trigger mode. The trigger counts of every camera restart from their next frame,
+ * a camera keeping an older base would be off by a constant and never match exactly.
+ */
+void FrameSynchronizer::clearQueues()
+{
+    for (int i = 0; i < m_cameras.count(); i++) {
+        m_cameras[i].frames.clear();
+        m_cameras[i].hasLast = false;
+        m_cameras[i].triggerBaseValid = false;
+    }
+}
+
+bool FrameSynchronizer::exactMatch() const
+{
+    for (int i = 0; i < m_cameras.count(); i++) {
+        if (!m_cameras.at(i).triggerMode)
+            return false;
+    }
+    return !m_cameras.isEmpty();
+}
+
+void FrameSynchronizer::submit(CameraSession *camera, const v4l2_format &format, const v4l2_buffer &buf, qint64 ns)
+{
+    if (!ns) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ns = now.tv_sec * 1000000000LL + now.tv_nsec;
+    }
+
+    SyncFrame frame;
+    frame.camera = camera;
+    frame.ns = ns;
+    frame.sequence = buf.sequence;
+    frame.triggerCount = -1;
+    frame.duplicate = false;
+    frame.pixelformat = format.fmt.pix.pixelformat;
+    frame.width = format.fmt.pix.width;
+    frame.height = format.fmt.pix.height;
+    frame.bytesused = buf.bytesused;
+
+    QList<FrameSet> sets;
+    bool report = false;
+    qreal meanMs = 0, maxMs = 0;
+    int setCount = 0, dropped = 0, duplicated = 0;
+
+    m_mutex.lock();
+    int index = indexOf(camera);
+    if (index < 0) {
+        m_mutex.unlock();
+        return;
+    }
+    CameraQueue &queue = m_cameras[index];
+    if (queue.triggerMode) {
+        if (!queue.triggerBaseValid) {
+            queue.triggerBase = buf.sequence;
+            queue.triggerBaseValid = true;
+        }
+        // driver drops leave a gap in the sequence, the trigger count skips it too
+        frame.triggerCount = (quint32)(buf.sequence - queue.triggerBase);
+    }
+    queue.frames.enqueue(frame);
+
+    match(sets);
+
+    if (!m_statsTimer.isValid()) {
+        m_statsTimer.start();
+    } else if (m_statsTimer.elapsed() >= SYNC_STATS_INTERVAL_MS) {
+        report = true;
+        meanMs = m_sets ? m_skewSum / (qreal)m_sets / 1e6 : 0;
+        maxMs = m_skewMax / 1e6;
+        setCount = m_sets;
+        dropped = m_dropped;
+        duplicated = m_duplicated;
+        m_offsets.resize(m_cameras.count());
+        for (int i = 0; i < m_cameras.count(); i++) {
+            CameraQueue &camQueue = m_cameras[i];
+            m_offsets[i] = camQueue.offsetCount ? camQueue.offsetSum / (qreal)camQueue.offsetCount / 1e6 : 0;
+            camQueue.offsetSum = 0;
+            camQueue.offsetCount = 0;
+        }
+        m_skewSum = m_skewMax = 0;
+        m_sets = m_dropped = m_duplicated = 0;
+        m_statsTimer.restart();
+    }
+    m_mutex.unlock();
+
+    for (int i = 0; i < sets.count(); i++)
+        emit frameSet(sets.at(i));
+    if (report)
+        emit skewStatistics(meanMs, maxMs, setCount, dropped, duplicated);
+}
+
+/**
+ * @brief FrameSynchronizer::match - take sets from the heads of the queues. The oldest head
+ * decides the set, cameras with a head within the tolerance of it are in the set. A camera
+ * without any queued frame is waited for, unless another camera has SYNC_MAX_QUEUE frames
+ * waiting [stopped or much slower camera].
+ */
+void FrameSynchronizer::match(QList<FrameSet> &sets)
+{
+    int count = m_cameras.count();
+    bool exact = exactMatch();
+    qint64 tolerance = exact ? 0 : m_tolerance;
+
+    for (;;) {
+        bool anyEmpty = false, allEmpty = true;
+        int longest = 0;
+        for (int i = 0; i < count; i++) {
+            int queued = m_cameras.at(i).frames.count();
+            anyEmpty |= queued == 0;
+            allEmpty &= queued == 0;
+            longest = qMax(longest, queued);
+        }
+        if (allEmpty || (anyEmpty && longest < SYNC_MAX_QUEUE))
+            return;
+
+        qint64 oldest = 0;
+        bool first = true;
+        for (int i = 0; i < count; i++) {
+            if (m_cameras.at(i).frames.isEmpty())
+                continue;
+            const SyncFrame &head = m_cameras.at(i).frames.head();
+            qint64 key = exact ? head.triggerCount : head.ns;
+            if (first || key < oldest)
+                oldest = key;
+            first = false;
+        }
+
+        FrameSet set(count);
+        QVector<bool> member(count, false);
+        int members = 0;
+        for (int i = 0; i < count; i++) {
+            if (m_cameras.at(i).frames.isEmpty())
+                continue;
+            const SyncFrame &head = m_cameras.at(i).frames.head();
+            qint64 key = exact ? head.triggerCount : head.ns;
+            if (key <= oldest + tolerance) {
+                member[i] = true;
+                members++;
+            }
+        }
+
+        bool complete = members == count;
+        if (!complete && m_policy == SYNC_POLICY_DUPLICATE) {
+            complete = true;
+            for (int i = 0; i < count; i++) {
+                if (!member[i] && !m_cameras.at(i).hasLast)
+                    complete = false;
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (member[i])
+                set[i] = m_cameras[i].frames.dequeue();
+        }
+        if (!complete) {
+            m_dropped += members;
+            continue;
+        }
+        for (int i = 0; i < count; i++) {
+            CameraQueue &queue = m_cameras[i];
+            if (member[i]) {
+                queue.last = set.at(i);
+                queue.hasLast = true;
+            } else {
+                set[i] = queue.last;
+                set[i].duplicate = true;
+                m_duplicated++;
+            }
+        }
+        completeSet(set);
+        sets.append(set);
+    }
+}
+
+void FrameSynchronizer::completeSet(FrameSet &set)
+{
+    qint64 earliest = 0, latest = 0;
+    bool first = true;
+    for (int i = 0; i < set.count(); i++) {
+        const SyncFrame &frame = set.at(i);
+        if (frame.duplicate)
+            continue;
+        if (first || frame.ns < earliest)
+            earliest = frame.ns;
+        if (first || frame.ns > latest)
+            latest = frame.ns;
+        first = false;
+    }
+    if (first)
+        return;
+
+    qint64 skew = latest - earliest;
+    m_skewSum += skew;
+    m_skewMax = qMax(m_skewMax, skew);
+    m_sets++;
+
+    // offsets are measured against the first camera, when it has a frame of its own in the set
+    if (set.at(0).duplicate)
+        return;
+    for (int i = 1; i < set.count(); i++) {
+        if (set.at(i).duplicate)
+            continue;
+        m_cameras[i].offsetSum += set.at(i).ns - set.at(0).ns;
+        m_cameras[i].offsetCount++;
+    }
+}
+
+QVector<qreal> FrameSynchronizer::cameraOffsets() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_offsets;
+}
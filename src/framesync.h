@@ -0,0 +1,150 @@
+/*
+ * framesync.h -- grouping of frames from several cameras by capture time
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FRAMESYNC_H
+#define FRAMESYNC_H
+
+#include <QObject>
+#include <QMutex>
+#include <QQueue>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QMetaType>
+#include <linux/videodev2.h>
+#include "camerasession.h"
+
+#define SYNC_DEFAULT_TOLERANCE_NS   5000000     /* frames this close in capture time form a set */
+#define SYNC_MAX_QUEUE              8           /* frames waiting per camera before a silent camera is given up on */
+#define SYNC_STATS_INTERVAL_MS      1000
+
+// what happens to a set one camera has no frame for
+#define SYNC_POLICY_DROP            0   /* frames of the other cameras are dropped */
+#define SYNC_POLICY_DUPLICATE       1   /* last frame of the missing camera is repeated */
+
+/**
+ * @brief The SyncFrame struct - a captured frame as passed to the synchronizer. Only the frame
+ * description is kept, the image stays in the capture buffer of its camera.
+ */
+struct SyncFrame {
+    CameraSession *camera;
+    qint64 ns;                  // capture time, CLOCK_MONOTONIC
+    quint32 sequence;           // v4l2 buffer sequence
+    qint64 triggerCount;        // frames since the camera entered trigger mode, -1 outside trigger mode
+    bool duplicate;             // repeated from an earlier set
+    __u32 pixelformat;
+    uint width, height;
+    uint bytesused;
+};
+
+typedef QVector<SyncFrame> FrameSet;
+Q_DECLARE_METATYPE(FrameSet)
+
+/**
+ * @brief The FrameSynchronizer class - queues the frames of the cameras added to it and emits
+ * sets of one frame per camera captured within the tolerance of each other, oldest first.
+ * While every camera is in hardware trigger mode frames are matched exactly by trigger count
+ * instead of capture time.
+ */
+class FrameSynchronizer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static FrameSynchronizer *instance();
+
+    void addCamera(CameraSession *camera);
+    void removeCamera(CameraSession *camera);
+
+    /**
+     * @brief setTolerance - largest capture time difference inside a set
+     */
+    void setTolerance(qint64 ns);
+
+    /**
+     * @brief setPolicy - SYNC_POLICY_DROP / SYNC_POLICY_DUPLICATE
+     */
+    void setPolicy(int policy);
+
+    /**
+     * @brief setTriggerMode - camera was switched to hardware trigger/master mode, the trigger
+     * counts of all cameras restart together with their next frame
+     */
+    void setTriggerMode(CameraSession *camera, bool enable);
+
+    /**
+     * @brief submit - queue a frame of a camera and emit the sets it completes
+     * @param ns - capture time, 0 if unknown [time of the call is used]
+     */
+    void submit(CameraSession *camera, const v4l2_format &format, const v4l2_buffer &buf, qint64 ns);
+
+    /**
+     * @brief cameraOffsets - mean capture time of each camera relative to the first one in the
+     * last statistics interval, ms
+     */
+    QVector<qreal> cameraOffsets() const;
+
+signals:
+    /**
+     * @brief frameSet - one frame per camera, in the order the cameras were added
+     */
+    void frameSet(FrameSet frames);
+
+    /**
+     * @brief skewStatistics - every SYNC_STATS_INTERVAL_MS while frames arrive
+     * @param meanMs, maxMs - capture time spread inside the emitted sets
+     * @param sets - sets emitted in the interval
+     * @param dropped - frames dropped for lack of partners
+     * @param duplicated - frames repeated to complete sets
+     */
+    void skewStatistics(qreal meanMs, qreal maxMs, int sets, int dropped, int duplicated);
+
+private:
+    FrameSynchronizer();
+
+    struct CameraQueue {
+        CameraSession *camera;
+        QQueue<SyncFrame> frames;
+        SyncFrame last;
+        bool hasLast;
+        bool triggerMode;
+        bool triggerBaseValid;
+        quint32 triggerBase;    // sequence of the first frame in trigger mode
+        qint64 offsetSum;       // capture time minus the first camera's, summed over the interval
+        int offsetCount;
+    };
+
+    int indexOf(CameraSession *camera) const;
+    bool exactMatch() const;
+    void match(QList<FrameSet> &sets);
+    void completeSet(FrameSet &set);
+    void clearQueues();
+
+    mutable QMutex m_mutex;
+    QVector<CameraQueue> m_cameras;
+    qint64 m_tolerance;
+    int m_policy;
+
+    // statistics of the current interval
+    QElapsedTimer m_statsTimer;
+    qint64 m_skewSum, m_skewMax;
+    int m_sets, m_dropped, m_duplicated;
+    QVector<qreal> m_offsets;
+};
+
+#endif // FRAMESYNC_H
@@ -40,7 +40,7 @@ void FSCAM_CU135::setPreviewSkipCount(){
 bool FSCAM_CU135::setEffectMode(specialEffects specialEffect)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -54,7 +54,7 @@ bool FSCAM_CU135::setEffectMode(specialEffects specialEffect)
     g_out_packet_buf[3] = specialEffect; /* set special effect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
            return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -69,7 +69,7 @@ bool FSCAM_CU135::setEffectMode(specialEffects specialEffect)
 bool FSCAM_CU135::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -81,25 +81,42 @@ bool FSCAM_CU135::getEffectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_FSCAM_CU135; /* set camera control code */
     g_out_packet_buf[2] = GET_SPECIAL_EFFECT_MODE_FSCAM_CU135; /* get special effect code */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
-            g_in_packet_buf[1]==GET_SPECIAL_EFFECT_MODE_FSCAM_CU135 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit effectModeValue(g_in_packet_buf[2]);
-            return true;
-        }
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
+}
+
+/**
+ * @brief FSCAM_CU135::hidReply - reply of a get command queued with uvccamera::sendHidCmdAsync
+ * @param reply - report received from camera, matched to its command by camera id and command id
+ */
+void FSCAM_CU135::hidReply(QByteArray reply)
+{
+    const unsigned char *in = (const unsigned char *)reply.constData();
+
+    if (reply.size() < 7 || in[0] != CAMERA_CONTROL_FSCAM_CU135 || in[6] != GET_SUCCESS)
+        return;
+
+    switch (in[1]) {
+    case GET_SPECIAL_EFFECT_MODE_FSCAM_CU135:
+        emit effectModeValue(in[2]);
+        break;
+    case GET_SCENE_MODE_FSCAM_CU135:
+        emit sceneModeValue(in[2]);
+        break;
+    case GET_ORIENTATION_FSCAM_CU135:
+        emit flipMirrorModeChanged(in[2]);
+        break;
+    case GET_FLICKER_DETECTION:
+        emit flickerDetectionMode(in[2]);
+        break;
     }
-    return false;
 }
 
 bool FSCAM_CU135::setSceneMode(sceneModes sceneMode)
 {
     // hid validation
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
 
         return false;
@@ -114,7 +131,7 @@ bool FSCAM_CU135::setSceneMode(sceneModes sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -129,7 +146,7 @@ bool FSCAM_CU135::setSceneMode(sceneModes sceneMode)
 bool FSCAM_CU135::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -141,25 +158,14 @@ bool FSCAM_CU135::getSceneMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_FSCAM_CU135; /* camera id */
     g_out_packet_buf[2] = GET_SCENE_MODE_FSCAM_CU135; /* get scene mode command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
-            g_in_packet_buf[1]==GET_SCENE_MODE_FSCAM_CU135 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-
-            emit sceneModeValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 bool FSCAM_CU135::setDenoiseValue(uint deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -173,7 +179,7 @@ bool FSCAM_CU135::setDenoiseValue(uint deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -190,7 +196,7 @@ bool FSCAM_CU135::getDenoiseValue()
 
    u_int8_t denoiseVal;
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -221,7 +227,7 @@ bool FSCAM_CU135::getDenoiseValue()
 bool FSCAM_CU135::setQFactor(uint qfactor)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -235,7 +241,7 @@ bool FSCAM_CU135::setQFactor(uint qfactor)
     g_out_packet_buf[3] = qfactor; /* qfactor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -251,7 +257,7 @@ bool FSCAM_CU135::getQFactor()
 {
    u_int8_t qfactor;
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -282,7 +288,7 @@ bool FSCAM_CU135::getQFactor()
 bool FSCAM_CU135::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -298,7 +304,7 @@ bool FSCAM_CU135::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue)
         g_out_packet_buf[4] = iHDRValue;
     }
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -314,7 +320,7 @@ bool FSCAM_CU135::getiHDRMode()
 {
    uint iHDRMode, iHDRValue;
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -346,7 +352,7 @@ bool FSCAM_CU135::getiHDRMode()
 bool FSCAM_CU135::setStreamMode(camStreamMode streamMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
 
         return false;
@@ -360,7 +366,7 @@ bool FSCAM_CU135::setStreamMode(camStreamMode streamMode)
     g_out_packet_buf[3] = streamMode; /* actual stream mode */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
 
             return false;
@@ -379,7 +385,7 @@ bool FSCAM_CU135::getStreamMode()
    uint streamMode;
 
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -421,7 +427,7 @@ bool FSCAM_CU135::setOrientation(bool horzModeSel, bool vertiModeSel)
     }else
         flipMode = SetBothFlipDisable; /* both flip disable */
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -435,7 +441,7 @@ bool FSCAM_CU135::setOrientation(bool horzModeSel, bool vertiModeSel)
     g_out_packet_buf[3] = flipMode; /*flip mode */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -450,9 +456,8 @@ bool FSCAM_CU135::setOrientation(bool horzModeSel, bool vertiModeSel)
 
 bool FSCAM_CU135::getOrientation()
 {
-    uint flipMode;
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -464,27 +469,15 @@ bool FSCAM_CU135::getOrientation()
     g_out_packet_buf[1] = CAMERA_CONTROL_FSCAM_CU135; /* camera control id */
     g_out_packet_buf[2] = GET_ORIENTATION_FSCAM_CU135; /* Get orientation command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
-            g_in_packet_buf[1]==GET_ORIENTATION_FSCAM_CU135 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            flipMode = (g_in_packet_buf[2]);
-            emit flipMirrorModeChanged(flipMode);
-            return true;
-        }
-    }
-    return false;
-
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
 bool FSCAM_CU135::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -518,7 +511,7 @@ bool FSCAM_CU135::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, ui
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -532,7 +525,7 @@ bool FSCAM_CU135::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, ui
 
 bool FSCAM_CU135::getAutoExpROIModeAndWindowSize(){
    uint autoexpROImode, winSize;
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -574,7 +567,7 @@ bool FSCAM_CU135::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData
         embedDataMode = DISABLE_EMBED_DATA_FSCAM_CU135; /* disable embed data */
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -590,7 +583,7 @@ bool FSCAM_CU135::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData
     g_out_packet_buf[5] = overlayRect; /* enable/disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -605,7 +598,7 @@ bool FSCAM_CU135::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData
 bool FSCAM_CU135::getFaceDetectMode(){
    uint faceDetectMode, faceDetectEmbedDataValue, faceOverlayRect;
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -649,7 +642,7 @@ bool FSCAM_CU135::setSmileDetection(bool enableSmileDetect, bool embedData){
         embedDataMode = DISABLE_EMBED_DATA_FSCAM_CU135; /* disable embed data */
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -664,7 +657,7 @@ bool FSCAM_CU135::setSmileDetection(bool enableSmileDetect, bool embedData){
     g_out_packet_buf[4] = embedData; /* disable embed data */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
 
             return false;
@@ -681,7 +674,7 @@ bool FSCAM_CU135::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool FSCAM_CU135::getSmileDetectMode(){
    uint smileDetectMode, smileDetectEmbedDataValue;
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -714,7 +707,7 @@ bool FSCAM_CU135::getSmileDetectMode(){
 bool FSCAM_CU135::setFrameRateCtrlValue(uint frameRateCtrl)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -728,7 +721,7 @@ bool FSCAM_CU135::setFrameRateCtrlValue(uint frameRateCtrl)
     g_out_packet_buf[3] = frameRateCtrl; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -744,7 +737,7 @@ bool FSCAM_CU135::getFrameRateCtrlValue()
 {
    uint frameRateVal;
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -783,7 +776,7 @@ bool FSCAM_CU135::setExposureCompensation(uint exposureCompValue)
    }
 
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -800,7 +793,7 @@ bool FSCAM_CU135::setExposureCompensation(uint exposureCompValue)
    g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
    // send request and get reply from camera
-   if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+   if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
        if (g_in_packet_buf[6]==SET_FAIL) {
            return false;
        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -821,7 +814,7 @@ bool FSCAM_CU135::getExposureCompensation()
 {
    uint expComp;
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -858,7 +851,7 @@ bool FSCAM_CU135::getExposureCompensation()
 bool FSCAM_CU135::setToDefault()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -886,7 +879,7 @@ bool FSCAM_CU135::setToDefault()
 
 bool FSCAM_CU135::storePreviewFrame()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -910,7 +903,7 @@ bool FSCAM_CU135::storePreviewFrame()
 
 bool FSCAM_CU135::storeStillFrame(uint stillformatId, uint stillresolutionId)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -939,7 +932,7 @@ bool FSCAM_CU135::getNumberOfFramesCanStore(uint stillformatId, uint stillresolu
 {
    uint numberOfFrames;
 
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -967,7 +960,7 @@ bool FSCAM_CU135::getNumberOfFramesCanStore(uint stillformatId, uint stillresolu
 
 bool FSCAM_CU135::setStillResolution(uint stillformatId, uint stillresolutionId)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -982,7 +975,7 @@ bool FSCAM_CU135::setStillResolution(uint stillformatId, uint stillresolutionId)
     g_out_packet_buf[4] = stillresolutionId; // still resolution id
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]== GET_SUCCESS) {      
             return true;
         }
@@ -994,7 +987,7 @@ bool FSCAM_CU135::setStillResolution(uint stillformatId, uint stillresolutionId)
 bool FSCAM_CU135::grabStillFrame(uint frameIndex, uint stillformatId, uint stillresolutionId)
 {
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1022,7 +1015,7 @@ bool FSCAM_CU135::grabStillFrame(uint frameIndex, uint stillformatId, uint still
 
 bool FSCAM_CU135::grabPreviewFrame()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1046,7 +1039,7 @@ bool FSCAM_CU135::grabPreviewFrame()
 bool FSCAM_CU135::getStillResolution()
 {
    uint stillformatId, stillResolutionId;
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -1085,14 +1078,14 @@ bool FSCAM_CU135::initFSCAM_CU135(char *hidDeviceName)
         return false;
     }
 
-    if(uvccamera::hid_fd > 0)
+    if(uvc.hidFd() > 0)
     {
-        close(uvccamera::hid_fd);
+        close(uvc.hidFd());
     }
 
-    uvccamera::hid_fd = open(hidDeviceName, O_RDWR|O_NONBLOCK);
+    uvc.hidFd() = open(hidDeviceName, O_RDWR|O_NONBLOCK);
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1104,28 +1097,28 @@ bool FSCAM_CU135::initFSCAM_CU135(char *hidDeviceName)
 
 //    /* Get Report Descriptor */
 //    rpt_desc.size = desc_size;
-//    ret = ioctl(uvccamera::hid_fd, HIDIOCGRDESC, &rpt_desc);
+//    ret = ioctl(uvc.hidFd(), HIDIOCGRDESC, &rpt_desc);
 //    if (ret < 0) {
 //        perror("HIDIOCGRDESC");
 //        return false;
 //    }
 
 //    /* Get Raw Name */
-//    ret = ioctl(uvccamera::hid_fd, HIDIOCGRAWNAME(256), buf);
+//    ret = ioctl(uvc.hidFd(), HIDIOCGRAWNAME(256), buf);
 //    if (ret < 0) {
 //        perror("HIDIOCGRAWNAME");
 //        return false;
 //    }
 
 //    /* Get Physical Location */
-//    ret = ioctl(uvccamera::hid_fd, HIDIOCGRAWPHYS(256), buf);
+//    ret = ioctl(uvc.hidFd(), HIDIOCGRAWPHYS(256), buf);
 //    if (ret < 0) {
 //        perror("HIDIOCGRAWPHYS");
 //        return false;
 //    }
 
 //    /* Get Raw Info */
-//    ret = ioctl(uvccamera::hid_fd, HIDIOCGRAWINFO, &info);
+//    ret = ioctl(uvc.hidFd(), HIDIOCGRAWINFO, &info);
 //    if (ret < 0) {
 //        perror("HIDIOCGRAWINFO");
 //        return false;
@@ -1134,12 +1127,12 @@ bool FSCAM_CU135::initFSCAM_CU135(char *hidDeviceName)
 }
 void FSCAM_CU135::deinitFSCAM_CU135()
 {
-    close(uvccamera::hid_fd);
+    close(uvc.hidFd());
 }
 bool FSCAM_CU135::readFirmwareVersion(uint *pMajorVersion, uint *pMinorVersion1, uint *sdkVersion, uint *svnVersion)
 {
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1181,7 +1174,7 @@ bool FSCAM_CU135::getLedControl()
    bool ledstatus,powerctl,stream,trigger;
 
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -1225,7 +1218,7 @@ bool FSCAM_CU135::getLedControl()
 bool FSCAM_CU135::setLedControl(bool ledstatus,bool powerctl,bool stream,bool trigger)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
 
         return false;
@@ -1257,7 +1250,7 @@ bool FSCAM_CU135::setLedControl(bool ledstatus,bool powerctl,bool stream,bool tr
         g_out_packet_buf[4] = DISABLE_TRIGGERACK_CONTROL_FSCAM_CU135;
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
 
             return false;
@@ -1279,7 +1272,7 @@ bool FSCAM_CU135::setLedControl(bool ledstatus,bool powerctl,bool stream,bool tr
 
 bool FSCAM_CU135::setFlickerDetection(camFlickerMode flickerMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1293,7 +1286,7 @@ bool FSCAM_CU135::setFlickerDetection(camFlickerMode flickerMode){
     g_out_packet_buf[3] = flickerMode; /* flicker detection mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
@@ -1314,7 +1307,7 @@ bool FSCAM_CU135::setFlickerDetection(camFlickerMode flickerMode){
 bool FSCAM_CU135::getFlickerDetection()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1326,24 +1319,14 @@ bool FSCAM_CU135::getFlickerDetection()
     g_out_packet_buf[1] = CAMERA_CONTROL_FSCAM_CU135; /* camera id */
     g_out_packet_buf[2] = GET_FLICKER_DETECTION; /* get flicker detection command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_FSCAM_CU135 &&
-            g_in_packet_buf[1]==GET_FLICKER_DETECTION &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit flickerDetectionMode(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 bool FSCAM_CU135::resetTimeStamp()
 {
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
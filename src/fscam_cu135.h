@@ -275,6 +275,10 @@ signals:
 
 
 
+private slots:
+    // replies of the get commands, see uvccamera::sendHidCmdAsync
+    void hidReply(QByteArray reply);
+
 public slots:
 
     // Added by Sankari: Mar 21, 2019
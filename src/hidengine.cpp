@@ -0,0 +1,269 @@
+/*
+ * hidengine.cpp -- HID command transport running on its own thread
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hidengine.h"
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+HidEngine *HidEngine::instance()
+{
+    static HidEngine *engine = NULL;
+    if (!engine) {
+        engine = new HidEngine();
+        // stop the thread while the event loops still exist, the engine itself is never deleted
+        if (QCoreApplication::instance())
+            connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), engine, SLOT(shutdown()), Qt::DirectConnection);
+    }
+    return engine;
+}
+
+HidEngine::HidEngine()
+{
+    m_pipelineDepth = HID_PIPELINE_DEPTH;
+    m_fd = -1;
+    m_notifier = NULL;
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    connect(m_timer, SIGNAL(timeout()), this, SLOT(expire()));
+    m_clock.start();
+
+    moveToThread(&m_thread);
+    m_thread.start();
+}
+
+HidEngine::~HidEngine()
+{
+    shutdown();
+}
+
+void HidEngine::shutdown()
+{
+    if (!m_thread.isRunning())
+        return;
+    m_thread.quit();
+    m_thread.wait();
+
+    m_mutex.lock();
+    QList<Request *> pending = m_pending + m_inFlight;
+    m_pending.clear();
+    m_inFlight.clear();
+    m_mutex.unlock();
+    for (int i = 0; i < pending.count(); i++)
+        finish(pending.at(i), QByteArray(), false);
+}
+
+void HidEngine::setPipelineDepth(int depth)
+{
+    QMutexLocker locker(&m_mutex);
+    m_pipelineDepth = qMax(1, depth);
+}
+
+HidEngine::Request *HidEngine::enqueue(int fd, const unsigned char *outBuf, int len, int timeoutMs, int matchLength, bool pipelined)
+{
+    Request *req = new Request;
+    req->fd = fd;
+    req->out = QByteArray((const char *)outBuf, len);
+    req->timeoutMs = timeoutMs;
+    req->matchLength = qBound(0, matchLength, len - 1);
+    req->pipelined = pipelined;
+    req->deadline = 0;
+    req->result.reportStarted();
+    return req;
+}
+
+QFuture<QByteArray> HidEngine::submit(int fd, const unsigned char *outBuf, int len, int timeoutMs, int matchLength, bool pipelined)
+{
+    Request *req = enqueue(fd, outBuf, len, timeoutMs, matchLength, pipelined);
+    QFuture<QByteArray> future = req->result.future();
+
+    m_mutex.lock();
+    m_pending.append(req);
+    m_mutex.unlock();
+    QMetaObject::invokeMethod(this, "pump", Qt::QueuedConnection);
+    return future;
+}
+
+bool HidEngine::request(int fd, const unsigned char *outBuf, int len, QObject *receiver, const char *member, int timeoutMs)
+{
+    if (fd < 0 || !m_thread.isRunning())
+        return false;
+
+    Request *req = enqueue(fd, outBuf, len, timeoutMs, 2, true);
+    req->receiver = receiver;
+    req->member = member;
+
+    m_mutex.lock();
+    m_pending.append(req);
+    m_mutex.unlock();
+    QMetaObject::invokeMethod(this, "pump", Qt::QueuedConnection);
+    return true;
+}
+
+bool HidEngine::transact(int fd, const unsigned char *outBuf, unsigned char *inBuf, int len, int timeoutMs, int matchLength)
+{
+    // waiting in the engine thread would never return
+    if (fd < 0 || !m_thread.isRunning() || QThread::currentThread() == &m_thread)
+        return false;
+
+    QFuture<QByteArray> future = submit(fd, outBuf, len, timeoutMs, matchLength, false);
+    if (QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread()) {
+        // keep the preview and the ui painting while the camera answers, without taking new user input
+        QEventLoop loop;
+        QFutureWatcher<QByteArray> watcher;
+        connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+        watcher.setFuture(future);
+        if (!future.isFinished())
+            loop.exec(QEventLoop::ExcludeUserInputEvents);
+    }
+    future.waitForFinished();
+    if (future.resultCount() == 0)
+        return false;
+
+    QByteArray reply = future.result();
+    memset(inBuf, 0, len);
+    memcpy(inBuf, reply.constData(), qMin(len, reply.size()));
+    return true;
+}
+
+/**
+ * @brief HidEngine::pump - write queued commands while the in-flight rules allow it
+ */
+void HidEngine::pump()
+{
+    m_mutex.lock();
+    while (!m_pending.isEmpty()) {
+        Request *req = m_pending.first();
+        if (!m_inFlight.isEmpty()) {
+            Request *last = m_inFlight.last();
+            if (!req->pipelined || !last->pipelined || req->fd != last->fd ||
+                m_inFlight.count() >= m_pipelineDepth)
+                break;
+        }
+        m_pending.removeFirst();
+
+        if (req->fd != m_fd)
+            watch(req->fd);
+        if (::write(req->fd, req->out.constData(), req->out.size()) < 0) {
+            perror("HID write");
+            finish(req, QByteArray(), false);
+            continue;
+        }
+        req->deadline = m_clock.elapsed() + req->timeoutMs;
+        m_inFlight.append(req);
+    }
+    m_mutex.unlock();
+
+    // only listen while replies are expected, some camera classes read the node directly
+    if (m_notifier)
+        m_notifier->setEnabled(!m_inFlight.isEmpty());
+    armTimer();
+}
+
+void HidEngine::watch(int fd)
+{
+    delete m_notifier;
+    m_fd = fd;
+    m_notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(m_notifier, SIGNAL(activated(int)), this, SLOT(readReplies()));
+}
+
+void HidEngine::readReplies()
+{
+    unsigned char buf[HID_MAX_REPORT_SIZE];
+
+    for (;;) {
+        ssize_t count = ::read(m_fd, buf, sizeof(buf));
+        if (count < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                // device is gone, stop polling the node until the next command
+                perror("HID read");
+                m_notifier->setEnabled(false);
+                failInFlight();
+            }
+            break;
+        }
+        if (count == 0)
+            break;
+
+        QByteArray reply((const char *)buf, count);
+        for (int i = 0; i < m_inFlight.count(); i++) {
+            Request *req = m_inFlight.at(i);
+            if (req->fd != m_fd || count < req->matchLength ||
+                memcmp(buf, req->out.constData() + 1, req->matchLength) != 0)
+                continue;
+            m_inFlight.removeAt(i);
+            finish(req, reply, true);
+            break;
+        }
+        // unmatched replies belong to commands which already timed out
+    }
+    pump();
+}
+
+void HidEngine::expire()
+{
+    qint64 now = m_clock.elapsed();
+    for (int i = 0; i < m_inFlight.count();) {
+        Request *req = m_inFlight.at(i);
+        if (req->deadline > now) {
+            i++;
+            continue;
+        }
+        fprintf(stderr, "HID: command 0x%02x 0x%02x timed out after %d ms\n",
+                (unsigned char)req->out.at(1), req->out.size() > 2 ? (unsigned char)req->out.at(2) : 0, req->timeoutMs);
+        m_inFlight.removeAt(i);
+        finish(req, QByteArray(), false);
+    }
+    pump();
+}
+
+void HidEngine::failInFlight()
+{
+    while (!m_inFlight.isEmpty())
+        finish(m_inFlight.takeFirst(), QByteArray(), false);
+}
+
+void HidEngine::armTimer()
+{
+    if (m_inFlight.isEmpty()) {
+        m_timer->stop();
+        return;
+    }
+    qint64 next = m_inFlight.first()->deadline;
+    for (int i = 1; i < m_inFlight.count(); i++)
+        next = qMin(next, m_inFlight.at(i)->deadline);
+    m_timer->start((int)qMax((qint64)0, next - m_clock.elapsed()));
+}
+
+void HidEngine::finish(Request *req, const QByteArray &reply, bool ok)
+{
+    if (ok) {
+        req->result.reportResult(reply);
+        if (req->receiver)
+            QMetaObject::invokeMethod(req->receiver, req->member.constData(), Qt::QueuedConnection, Q_ARG(QByteArray, reply));
+    }
+    req->result.reportFinished();
+    delete req;
+}
@@ -0,0 +1,121 @@
+/*
+ * hidengine.h -- HID command transport running on its own thread
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef HIDENGINE_H
+#define HIDENGINE_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QPointer>
+#include <QTimer>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QSocketNotifier>
+#include <QFuture>
+#include <QFutureInterface>
+
+#define HID_DEFAULT_TIMEOUT_MS  5000
+#define HID_PIPELINE_DEPTH      4       /* requests in flight at once, pipelined requests only */
+#define HID_MAX_REPORT_SIZE     65
+
+/**
+ * @brief The HidEngine class - queue of HID commands written and answered on a worker thread.
+ * A reply is matched to its command by comparing the first bytes of the reply with the
+ * command bytes following the report number [camera id, command id]. Independent get
+ * commands may be written back to back (pipelined), everything else is sent one at a time.
+ */
+class HidEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    static HidEngine *instance();
+
+    /**
+     * @brief submit - queue a command
+     * @param fd - hidraw file descriptor
+     * @param outBuf - report to write, outBuf[0] is the report number
+     * @param len - report length
+     * @param timeoutMs - time to wait for the reply after writing
+     * @param matchLength - reply bytes compared with outBuf[1..], 0 accepts the next reply
+     * @param pipelined - may be in flight together with other pipelined commands
+     * @return future with the reply, no result on write failure or timeout
+     */
+    QFuture<QByteArray> submit(int fd, const unsigned char *outBuf, int len, int timeoutMs = HID_DEFAULT_TIMEOUT_MS,
+                               int matchLength = 2, bool pipelined = false);
+
+    /**
+     * @brief request - queue a pipelined command, the reply is passed to receiver's member
+     * slot [void member(QByteArray reply)] in the receiver's thread. Nothing is called on failure.
+     */
+    bool request(int fd, const unsigned char *outBuf, int len, QObject *receiver, const char *member,
+                 int timeoutMs = HID_DEFAULT_TIMEOUT_MS);
+
+    /**
+     * @brief transact - queue a command and wait for its reply. On the gui thread events other
+     * than user input are processed while waiting, so the window keeps painting.
+     * @param inBuf - receives len bytes of the reply
+     * @return true - reply received /false - failure or timeout
+     */
+    bool transact(int fd, const unsigned char *outBuf, unsigned char *inBuf, int len,
+                  int timeoutMs = HID_DEFAULT_TIMEOUT_MS, int matchLength = 0);
+
+    void setPipelineDepth(int depth);
+
+private slots:
+    void pump();
+    void readReplies();
+    void expire();
+    void shutdown();
+
+private:
+    struct Request {
+        int fd;
+        QByteArray out;
+        int timeoutMs;
+        int matchLength;
+        bool pipelined;
+        qint64 deadline;
+        QPointer<QObject> receiver;
+        QByteArray member;
+        QFutureInterface<QByteArray> result;
+    };
+
+    HidEngine();
+    ~HidEngine();
+
+    Request *enqueue(int fd, const unsigned char *outBuf, int len, int timeoutMs, int matchLength, bool pipelined);
+    void watch(int fd);
+    void finish(Request *req, const QByteArray &reply, bool ok);
+    void failInFlight();
+    void armTimer();
+
+    QThread m_thread;
+    QMutex m_mutex;
+    QList<Request *> m_pending;     // guarded by m_mutex
+    QList<Request *> m_inFlight;    // engine thread only
+    int m_pipelineDepth;
+    int m_fd;
+    QSocketNotifier *m_notifier;
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+};
+
+#endif // HIDENGINE_H
@@ -144,11 +144,13 @@ int main(int argc, char *argv[])
 
     Videostreaming vs;   
     AudioInput audio;
-    viewer.rootContext()->setContextProperty("resolutionModel", &vs.resolution);
-    viewer.rootContext()->setContextProperty("stillOutputFormatModel", &vs.stillOutputFormat);
-    viewer.rootContext()->setContextProperty("videoOutputFormatModel", &vs.videoOutputFormat);
-    viewer.rootContext()->setContextProperty("fpsAvailable", &vs.fpsList);
-    viewer.rootContext()->setContextProperty("encodersModel", &vs.encoderList);
+    // models of the first camera, Videostreaming::selectSession() rebinds them to the selected camera
+    CameraSession *firstSession = vs.cameraSession();
+    viewer.rootContext()->setContextProperty("resolutionModel", &firstSession->resolution);
+    viewer.rootContext()->setContextProperty("stillOutputFormatModel", &firstSession->stillOutputFormat);
+    viewer.rootContext()->setContextProperty("videoOutputFormatModel", &firstSession->videoOutputFormat);
+    viewer.rootContext()->setContextProperty("fpsAvailable", &firstSession->fpsList);
+    viewer.rootContext()->setContextProperty("encodersModel", &firstSession->encoderList);
     viewer.rootContext()->setContextProperty("audioinputDevModel", &audio.audioinputDeviceList);
     viewer.rootContext()->setContextProperty("audioSupportedFormatList", &audio.audiosupportedFmtListModel);
     viewer.rootContext()->setContextProperty("audioChannelCountModel", &audio.audioChannelCountModel);
@@ -0,0 +1,575 @@
+/*
+ * muxwriter.cpp -- muxing and file output of the recording on its own thread
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "muxwriter.h"
+#include <QFileInfo>
+#include <QTextStream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+MuxWriter::MuxWriter()
+{
+    m_queuedBytes = 0;
+    m_error = 0;
+    m_muxMutex = NULL;
+    m_ioFlags = 0;
+    m_firstCtx = NULL;
+    m_current = NULL;
+    m_next = NULL;
+
+    moveToThread(&m_thread);
+    m_thread.start();
+}
+
+MuxWriter::~MuxWriter()
+{
+    close();
+    m_thread.quit();
+    m_thread.wait();
+}
+
+bool MuxWriter::open(AVFormatContext *formatCtx, QString fileName, int ioFlags, QMutex *muxMutex, QString indexFile)
+{
+    close();
+
+    m_ioFlags = ioFlags;
+    m_muxMutex = muxMutex;
+    m_firstCtx = formatCtx;
+    m_fileName = fileName;
+    m_indexFile = indexFile;
+    m_error = 0;
+    m_queuedBytes = 0;
+    m_bytesWritten.store(0);
+    m_reportedBytes = 0;
+    m_maxQueuedPackets = 0;
+    m_maxQueuedBytes = 0;
+    m_longestWriteMs = 0;
+    m_reportTimer.start();
+    m_recordTimer.start();
+
+#if !LIBAVCODEC_VER_AT_LEAST(57,37)
+    if (isSegmented()) {
+        fprintf(stderr, "MUX: segmented recording needs codec parameters, recording one file\n");
+        m_indexFile.clear();
+    }
+#endif
+    if (isSegmented()) {
+        if (formatCtx->oformat->flags & AVFMT_NOFILE) {
+            m_indexFile.clear();
+        } else {
+            QFile index(m_indexFile);
+            if (index.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+                index.write("segment,file,start,duration,bytes\n");
+        }
+    }
+
+    m_current = openFile(formatCtx, isSegmented() ? m_fileName.arg(0, 3, 10, QChar('0')) : m_fileName, 0);
+    return m_current != NULL;
+}
+
+int MuxWriter::writeHeader()
+{
+    if (!m_current)
+        return AVERROR(EINVAL);
+
+    applyMetadata(m_current->ctx);
+    m_muxMutex->lock();
+    int ret = avformat_write_header(m_current->ctx, NULL);
+    m_muxMutex->unlock();
+    if (ret < 0)
+        return ret;
+
+    m_current->headerWritten = true;
+    if (isSegmented())
+        QMetaObject::invokeMethod(this, "prepareSegment", Qt::QueuedConnection);
+    return ret;
+}
+
+/**
+ * @brief MuxWriter::openFile - create the file of one context behind an aligned avio buffer
+ */
+MuxWriter::OutputFile *MuxWriter::openFile(AVFormatContext *ctx, QString fileName, int segment)
+{
+    OutputFile *file = new OutputFile;
+    file->writer = this;
+    file->ctx = ctx;
+    file->ownsContext = false;
+    file->headerWritten = false;
+    file->fileName = fileName;
+    file->segment = segment;
+    file->fd = -1;
+    file->ioBuffer = NULL;
+    file->directOn = false;
+    file->syncStart = 0;
+    file->prevSyncStart = file->prevSyncLength = 0;
+    file->bytes = 0;
+    file->startTime = file->endTime = -1;
+    file->tsBase = AV_NOPTS_VALUE;
+
+    if (ctx->oformat->flags & AVFMT_NOFILE)
+        return file;
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    if (m_ioFlags & MUX_IO_DIRECT)
+        flags |= O_DIRECT;
+    file->fd = ::open(fileName.toLocal8Bit().constData(), flags, 0644);
+    if (file->fd < 0 && (m_ioFlags & MUX_IO_DIRECT)) {
+        // not every file system supports O_DIRECT
+        perror("MUX: O_DIRECT");
+        m_ioFlags &= ~MUX_IO_DIRECT;
+        file->fd = ::open(fileName.toLocal8Bit().constData(), flags & ~O_DIRECT, 0644);
+    }
+    if (file->fd < 0) {
+        fprintf(stderr, "Could not open '%s'\n", fileName.toLocal8Bit().constData());
+        delete file;
+        return NULL;
+    }
+    file->directOn = (m_ioFlags & MUX_IO_DIRECT);
+
+    if (posix_memalign((void **)&file->ioBuffer, MUX_IO_ALIGNMENT, MUX_IO_BUFFER_SIZE) != 0) {
+        ::close(file->fd);
+        delete file;
+        return NULL;
+    }
+    ctx->pb = avio_alloc_context(file->ioBuffer, MUX_IO_BUFFER_SIZE, 1, file, NULL, writeData, seekData);
+    if (!ctx->pb) {
+        free(file->ioBuffer);
+        ::close(file->fd);
+        delete file;
+        return NULL;
+    }
+    ctx->flags |= AVFMT_FLAG_CUSTOM_IO;
+    return file;
+}
+
+/**
+ * @brief MuxWriter::openSegment - new context with the streams of the first file, header written
+ */
+MuxWriter::OutputFile *MuxWriter::openSegment(int segment)
+{
+#if LIBAVCODEC_VER_AT_LEAST(57,37)
+    AVFormatContext *ctx = avformat_alloc_context();
+    if (!ctx)
+        return NULL;
+    ctx->oformat = m_firstCtx->oformat;
+
+    for (unsigned int i = 0; i < m_firstCtx->nb_streams; i++) {
+        AVStream *src = m_firstCtx->streams[i];
+        AVStream *st = avformat_new_stream(ctx, NULL);
+        if (!st || avcodec_parameters_copy(st->codecpar, src->codecpar) < 0) {
+            avformat_free_context(ctx);
+            return NULL;
+        }
+        st->time_base = src->time_base;
+    }
+
+    OutputFile *file = openFile(ctx, m_fileName.arg(segment, 3, 10, QChar('0')), segment);
+    if (!file) {
+        avformat_free_context(ctx);
+        return NULL;
+    }
+    file->ownsContext = true;
+
+    applyMetadata(ctx);
+    int ret = avformat_write_header(ctx, NULL);
+    if (ret < 0) {
+        char errText[128] = "";
+        av_strerror(ret, errText, sizeof(errText));
+        fprintf(stderr, "MUX: header of segment %d: %s\n", segment, errText);
+        QString fileName = file->fileName;
+        freeFile(file);
+        QFile::remove(fileName);
+        return NULL;
+    }
+    file->headerWritten = true;
+    return file;
+#else
+    Q_UNUSED(segment);
+    return NULL;
+#endif
+}
+
+void MuxWriter::prepareSegment()
+{
+    if (!isSegmented() || !m_current || m_next)
+        return;
+    m_next = openSegment(m_current->segment + 1);
+}
+
+void MuxWriter::switchSegment()
+{
+    OutputFile *next = m_next;
+    m_next = NULL;
+    // the writer was too busy to open it ahead
+    if (!next)
+        next = openSegment(m_current->segment + 1);
+    if (!next) {
+        fprintf(stderr, "MUX: could not open segment %d, continuing in %s\n",
+                m_current->segment + 1, m_current->fileName.toLocal8Bit().constData());
+        return;
+    }
+    finishFile(m_current);
+    m_current = next;
+    QMetaObject::invokeMethod(this, "prepareSegment", Qt::QueuedConnection);
+}
+
+void MuxWriter::finishFile(OutputFile *file)
+{
+    if (file->headerWritten) {
+        // mp4 and matroska write their tags with the trailer, so the latest values are kept
+        applyMetadata(file->ctx);
+        m_muxMutex->lock();
+        av_write_trailer(file->ctx);
+        m_muxMutex->unlock();
+    }
+    if (file->ctx->pb)
+        avio_flush(file->ctx->pb);
+    if (isSegmented() && file->headerWritten)
+        writeIndex(file);
+    freeFile(file);
+}
+
+void MuxWriter::freeFile(OutputFile *file)
+{
+    AVIOContext *pb = file->ctx->pb;
+    if (pb && file->fd >= 0) {
+        // avio may have replaced the buffer with its own allocation
+        if (pb->buffer == file->ioBuffer)
+            free(file->ioBuffer);
+        else
+            av_freep(&pb->buffer);
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(57, 80, 100)
+        avio_context_free(&pb);
+#else
+        av_free(pb);
+#endif
+        file->ctx->pb = NULL;
+    }
+    if (file->fd >= 0) {
+        if (m_ioFlags & MUX_IO_SYNC)
+            fdatasync(file->fd);
+        ::close(file->fd);
+    }
+    if (file->ownsContext)
+        avformat_free_context(file->ctx);
+    delete file;
+}
+
+void MuxWriter::writeIndex(OutputFile *file)
+{
+    QFile index(m_indexFile);
+    if (!index.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+        return;
+    QTextStream out(&index);
+    double start = qMax(file->startTime, 0.0);
+    out << file->segment << "," << QFileInfo(file->fileName).fileName() << ","
+        << QString::number(start, 'f', 3) << "," << QString::number(qMax(file->endTime - start, 0.0), 'f', 3) << ","
+        << file->bytes << "\n";
+}
+
+int MuxWriter::write(AVPacket *packet, bool interleaved)
+{
+#if LIBAVCODEC_VER_AT_LEAST(57,12)
+    QueuedPacket item;
+    item.packet = av_packet_alloc();
+    item.interleaved = interleaved;
+    // packets which are not reference counted (camera H264 buffers) are copied here
+    if (!item.packet || av_packet_ref(item.packet, packet) < 0) {
+        av_packet_free(&item.packet);
+        return AVERROR(ENOMEM);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_error < 0) {
+        av_packet_free(&item.packet);
+        return m_error;
+    }
+    // a disk slower than the stream for minutes, hold the encoder rather than run out of memory
+    while (m_queuedBytes > MUX_QUEUE_MAX_BYTES)
+        m_spaceFree.wait(&m_mutex);
+
+    bool wasEmpty = m_queue.isEmpty();
+    m_queue.enqueue(item);
+    m_queuedBytes += item.packet->size;
+    m_maxQueuedPackets = qMax(m_maxQueuedPackets, m_queue.count());
+    m_maxQueuedBytes = qMax(m_maxQueuedBytes, m_queuedBytes);
+    if (wasEmpty)
+        QMetaObject::invokeMethod(this, "writePending", Qt::QueuedConnection);
+    return 0;
+#else
+    // no packet references in this libavcodec, write on the calling thread
+    QMutexLocker locker(m_muxMutex);
+    return interleaved ? av_interleaved_write_frame(m_current->ctx, packet) : av_write_frame(m_current->ctx, packet);
+#endif
+}
+
+void MuxWriter::cut()
+{
+    if (!isSegmented())
+        return;
+    QueuedPacket item;
+    item.packet = NULL;
+    item.interleaved = false;
+
+    QMutexLocker locker(&m_mutex);
+    bool wasEmpty = m_queue.isEmpty();
+    m_queue.enqueue(item);
+    if (wasEmpty)
+        QMetaObject::invokeMethod(this, "writePending", Qt::QueuedConnection);
+}
+
+void MuxWriter::setMetadata(const char *key, QString value)
+{
+    QMutexLocker locker(&m_mutex);
+    m_metadata.insert(QByteArray(key), value);
+}
+
+void MuxWriter::applyMetadata(AVFormatContext *ctx)
+{
+    QMutexLocker locker(&m_mutex);
+    QMap<QByteArray, QString>::const_iterator it;
+    for (it = m_metadata.constBegin(); it != m_metadata.constEnd(); ++it)
+        av_dict_set(&ctx->metadata, it.key().constData(), it.value().toUtf8().constData(), 0);
+}
+
+void MuxWriter::writePending()
+{
+    QElapsedTimer writeTimer;
+
+    for (;;) {
+        m_mutex.lock();
+        if (m_queue.isEmpty()) {
+            m_drained.wakeAll();
+            m_mutex.unlock();
+            break;
+        }
+        // only this thread dequeues, the packet stays counted until it is written
+        QueuedPacket item = m_queue.head();
+        m_mutex.unlock();
+
+        int size = 0;
+        int ret = 0;
+        writeTimer.start();
+        if (!item.packet) {
+            switchSegment();
+        } else {
+            size = item.packet->size;
+            AVStream *st = m_current->ctx->streams[item.packet->stream_index];
+#if LIBAVCODEC_VER_AT_LEAST(57,37)
+            // packets are stamped in the time base of the first file
+            if (m_current->ctx != m_firstCtx)
+                av_packet_rescale_ts(item.packet, m_firstCtx->streams[item.packet->stream_index]->time_base, st->time_base);
+#endif
+            if (item.packet->pts != AV_NOPTS_VALUE) {
+                double start = item.packet->pts * av_q2d(st->time_base);
+                double end = (item.packet->pts + item.packet->duration) * av_q2d(st->time_base);
+                if (m_current->startTime < 0 || start < m_current->startTime)
+                    m_current->startTime = start;
+                m_current->endTime = qMax(m_current->endTime, end);
+            }
+            // segments start at 0, avi pads a dts gap at the start with empty frames
+            if (m_current->segment > 0) {
+                int64_t ts = item.packet->dts != AV_NOPTS_VALUE ? item.packet->dts : item.packet->pts;
+                if (m_current->tsBase == AV_NOPTS_VALUE && ts != AV_NOPTS_VALUE)
+                    m_current->tsBase = av_rescale_q(ts, st->time_base, AV_TIME_BASE_Q);
+                if (m_current->tsBase != AV_NOPTS_VALUE) {
+                    int64_t base = av_rescale_q(m_current->tsBase, AV_TIME_BASE_Q, st->time_base);
+                    if (item.packet->pts != AV_NOPTS_VALUE)
+                        item.packet->pts -= base;
+                    if (item.packet->dts != AV_NOPTS_VALUE)
+                        item.packet->dts -= base;
+                }
+            }
+            m_muxMutex->lock();
+            ret = item.interleaved ? av_interleaved_write_frame(m_current->ctx, item.packet)
+                                   : av_write_frame(m_current->ctx, item.packet);
+            m_muxMutex->unlock();
+        }
+        qint64 writeMs = writeTimer.elapsed();
+
+        m_mutex.lock();
+        m_queue.dequeue();
+        m_queuedBytes -= size;
+        if (ret < 0 && m_error == 0)
+            m_error = ret;
+        m_longestWriteMs = qMax(m_longestWriteMs, writeMs);
+        int queued = m_queue.count();
+        m_spaceFree.wakeAll();
+        m_mutex.unlock();
+
+#if LIBAVCODEC_VER_AT_LEAST(57,12)
+        av_packet_free(&item.packet);
+#endif
+        if (ret < 0) {
+            char errText[128] = "";
+            av_strerror(ret, errText, sizeof(errText));
+            fprintf(stderr, "MUX: write failed: %s\n", errText);
+        }
+        if (writeMs >= MUX_STALL_LOG_MS)
+            fprintf(stderr, "MUX: write stalled %lld ms, %d packets queued\n", (long long)writeMs, queued);
+        reportStatistics(false);
+    }
+}
+
+void MuxWriter::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_queue.isEmpty())
+        m_drained.wait(&m_mutex);
+}
+
+void MuxWriter::finishRecording()
+{
+    if (m_next) {
+        // opened ahead but never used
+        QString fileName = m_next->fileName;
+        freeFile(m_next);
+        m_next = NULL;
+        QFile::remove(fileName);
+    }
+    if (m_current) {
+        finishFile(m_current);
+        m_current = NULL;
+    }
+}
+
+void MuxWriter::close()
+{
+    if (!m_current)
+        return;
+    flush();
+    // the files belong to the writer thread from the first header on
+    if (QThread::currentThread() == &m_thread || !m_thread.isRunning())
+        finishRecording();
+    else
+        QMetaObject::invokeMethod(this, "finishRecording", Qt::BlockingQueuedConnection);
+
+    fprintf(stderr, "MUX: %.1f MB in %.1f s, at most %d packets / %.1f MB queued, longest write %lld ms\n",
+            m_bytesWritten.load() / 1048576.0, m_recordTimer.elapsed() / 1000.0,
+            m_maxQueuedPackets, m_maxQueuedBytes / 1048576.0, (long long)m_longestWriteMs);
+    m_firstCtx = NULL;
+    m_mutex.lock();
+    m_metadata.clear();
+    m_mutex.unlock();
+}
+
+/**
+ * @brief MuxWriter::writeData - avio write callback.
+ * With O_DIRECT only whole aligned blocks bypass the page cache, the tail of the file and the
+ * header rewrites done by the trailer go through the page cache.
+ */
+int MuxWriter::writeData(void *opaque, uint8_t *buf, int size)
+{
+    OutputFile *file = static_cast<OutputFile *>(opaque);
+    MuxWriter *writer = file->writer;
+
+    if (writer->m_ioFlags & MUX_IO_DIRECT) {
+        off_t pos = lseek(file->fd, 0, SEEK_CUR);
+        setDirect(file, pos % MUX_IO_ALIGNMENT == 0 && size % MUX_IO_ALIGNMENT == 0 &&
+                        (uintptr_t)buf % MUX_IO_ALIGNMENT == 0);
+    }
+
+    int done = 0;
+    while (done < size) {
+        ssize_t ret = ::write(file->fd, buf + done, size - done);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("MUX: write");
+            return AVERROR(errno);
+        }
+        done += ret;
+    }
+    file->bytes += size;
+    writer->m_bytesWritten.fetchAndAddRelaxed(size);
+    writer->syncWritten(file);
+    return size;
+}
+
+int64_t MuxWriter::seekData(void *opaque, int64_t offset, int whence)
+{
+    OutputFile *file = static_cast<OutputFile *>(opaque);
+
+    if (whence == AVSEEK_SIZE) {
+        struct stat st;
+        if (fstat(file->fd, &st) < 0)
+            return AVERROR(errno);
+        return st.st_size;
+    }
+    off_t ret = lseek(file->fd, offset, whence & ~AVSEEK_FORCE);
+    return ret < 0 ? AVERROR(errno) : ret;
+}
+
+void MuxWriter::setDirect(OutputFile *file, bool direct)
+{
+    if (direct == file->directOn)
+        return;
+    int flags = fcntl(file->fd, F_GETFL);
+    if (flags < 0 || fcntl(file->fd, F_SETFL, direct ? (flags | O_DIRECT) : (flags & ~O_DIRECT)) < 0)
+        return;
+    file->directOn = direct;
+}
+
+/**
+ * @brief MuxWriter::syncWritten - start writeback of the new data and wait for the previous
+ * range, so dirty pages never pile up into one long flush which blocks the writes
+ */
+void MuxWriter::syncWritten(OutputFile *file)
+{
+    if (!(m_ioFlags & MUX_IO_SYNC))
+        return;
+    off_t end = lseek(file->fd, 0, SEEK_CUR);
+    if (end < 0 || end - file->syncStart < MUX_SYNC_BYTES)
+        return;
+
+    sync_file_range(file->fd, file->syncStart, end - file->syncStart, SYNC_FILE_RANGE_WRITE);
+    if (file->prevSyncLength > 0) {
+        sync_file_range(file->fd, file->prevSyncStart, file->prevSyncLength,
+                        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        posix_fadvise(file->fd, file->prevSyncStart, file->prevSyncLength, POSIX_FADV_DONTNEED);
+    }
+    file->prevSyncStart = file->syncStart;
+    file->prevSyncLength = end - file->syncStart;
+    file->syncStart = end;
+}
+
+void MuxWriter::reportStatistics(bool force)
+{
+    qint64 elapsed = m_reportTimer.elapsed();
+    if (!force && elapsed < MUX_STATS_INTERVAL_MS)
+        return;
+    if (elapsed <= 0)
+        return;
+
+    qint64 written = m_bytesWritten.load();
+    qreal writeMBps = (written - m_reportedBytes) / 1048576.0 * 1000.0 / elapsed;
+    m_reportedBytes = written;
+    m_reportTimer.restart();
+
+    m_mutex.lock();
+    int queuedPackets = m_queue.count();
+    qreal queuedMB = m_queuedBytes / 1048576.0;
+    m_mutex.unlock();
+    emit statistics(writeMBps, queuedPackets, queuedMB);
+}
@@ -0,0 +1,196 @@
+/*
+ * muxwriter.h -- muxing and file output of the recording on its own thread
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MUXWRITER_H
+#define MUXWRITER_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+#include <QFile>
+#include <QMap>
+#include "common.h"
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+#include "libavformat/avformat.h"
+}
+
+#define MUX_IO_BUFFER_SIZE      (4 * 1024 * 1024)   /* avio buffer, one write(2) per buffer */
+#define MUX_IO_ALIGNMENT        4096                /* O_DIRECT offset/size/memory alignment */
+#define MUX_SYNC_BYTES          (32 * 1024 * 1024)  /* writeback started every this many bytes */
+#define MUX_QUEUE_MAX_BYTES     (512 * 1024 * 1024) /* producers wait beyond this */
+#define MUX_STATS_INTERVAL_MS   1000
+#define MUX_STALL_LOG_MS        200
+
+// file output options
+#define MUX_IO_DIRECT           0x1     /* O_DIRECT, page cache bypassed for whole buffers */
+#define MUX_IO_SYNC             0x2     /* sync_file_range behind the write position */
+
+/**
+ * @brief The MuxWriter class - packets of a recording are queued by the encoding threads and
+ * written into the container from a writer thread, so a slow disk delays the file instead of
+ * the encoder. The file is written through a large aligned avio buffer.
+ * A segmented recording is split at cut() into files muxed with the streams of the first one.
+ * The next file is opened and its header written on the writer thread ahead of the cut, the
+ * trailer of the finished file is written there too. Each segment starts at timestamp 0, the
+ * index keeps its start in recording time.
+ */
+class MuxWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    MuxWriter();
+    ~MuxWriter();
+
+    /**
+     * @brief open - create the file and attach it as pb of the format context
+     * @param formatCtx - streams of the recording, stays owned by the caller
+     * @param fileName - file name, contains %1 for the segment number of a segmented recording
+     * @param ioFlags - MUX_IO_DIRECT | MUX_IO_SYNC
+     * @param muxMutex - held around every write into formatCtx
+     * @param indexFile - segment list of a segmented recording, empty for a single file
+     * @return true - success /false - failure
+     */
+    bool open(AVFormatContext *formatCtx, QString fileName, int ioFlags, QMutex *muxMutex,
+              QString indexFile = QString());
+
+    /**
+     * @brief writeHeader - write the header of the first file, before any packet
+     */
+    int writeHeader();
+
+    /**
+     * @brief write - queue a reference of the packet
+     * @return 0 if queued/ -ve error of an earlier write
+     */
+    int write(AVPacket *packet, bool interleaved);
+
+    /**
+     * @brief flush - wait until every queued packet is in the muxer
+     */
+    void flush();
+
+    /**
+     * @brief cut - packets written after this go to the next segment, the caller cuts
+     * before a video keyframe
+     */
+    void cut();
+
+    /**
+     * @brief setMetadata - tag of the recording, written with the header of every file opened
+     * after the call and again before each trailer [avi keeps its header tags]. Kept until close.
+     */
+    void setMetadata(const char *key, QString value);
+
+    /**
+     * @brief close - write every queued packet and the trailer, close the file
+     */
+    void close();
+
+    inline bool isOpen() const { return m_current != NULL; }
+    inline bool isSegmented() const { return !m_indexFile.isEmpty(); }
+    // segment list of the last segmented recording, empty for a single file
+    inline QString indexFile() const { return m_indexFile; }
+
+signals:
+    /**
+     * @brief statistics - emitted from the writer thread every MUX_STATS_INTERVAL_MS while recording
+     * @param writeMBps - bytes written to the file in the last interval
+     * @param queuedPackets - packets waiting for the muxer
+     * @param queuedMB - size of the waiting packets
+     */
+    void statistics(qreal writeMBps, int queuedPackets, qreal queuedMB);
+
+private slots:
+    void writePending();
+    void prepareSegment();
+    void finishRecording();
+
+private:
+    struct QueuedPacket {
+        AVPacket *packet;       // NULL - cut to the next segment
+        bool interleaved;
+    };
+
+    // one output file
+    struct OutputFile {
+        MuxWriter *writer;
+        AVFormatContext *ctx;
+        bool ownsContext;       // segments after the first one
+        bool headerWritten;
+        QString fileName;
+        int segment;
+        int fd;
+        uint8_t *ioBuffer;
+        bool directOn;
+        int64_t syncStart;      // start of the range not yet sent to writeback
+        int64_t prevSyncStart, prevSyncLength;
+        qint64 bytes;
+        double startTime, endTime;  // seconds, recording time
+        int64_t tsBase;             // AV_TIME_BASE_Q, first dts of a segment, subtracted from its packets
+    };
+
+    OutputFile *openFile(AVFormatContext *ctx, QString fileName, int segment);
+    OutputFile *openSegment(int segment);
+    void finishFile(OutputFile *file);
+    void freeFile(OutputFile *file);
+    void switchSegment();
+    void writeIndex(OutputFile *file);
+    void applyMetadata(AVFormatContext *ctx);
+
+    static int writeData(void *opaque, uint8_t *buf, int size);
+    static int64_t seekData(void *opaque, int64_t offset, int whence);
+    static void setDirect(OutputFile *file, bool direct);
+    void syncWritten(OutputFile *file);
+    void reportStatistics(bool force);
+
+    QThread m_thread;
+    QMutex m_mutex;
+    QWaitCondition m_drained;
+    QWaitCondition m_spaceFree;
+    QQueue<QueuedPacket> m_queue;       // guarded by m_mutex
+    qint64 m_queuedBytes;
+    int m_error;                        // first muxer error, sticky until the next open
+
+    QMutex *m_muxMutex;
+    int m_ioFlags;
+    AVFormatContext *m_firstCtx;        // streams and time bases of the queued packets
+    OutputFile *m_current;              // writer thread once packets are queued
+    OutputFile *m_next;                 // pre-opened segment, writer thread
+    QString m_fileName;
+    QString m_indexFile;
+    QMap<QByteArray, QString> m_metadata;   // guarded by m_mutex
+
+    // statistics
+    QAtomicInteger<qint64> m_bytesWritten;
+    qint64 m_reportedBytes;
+    QElapsedTimer m_reportTimer;
+    QElapsedTimer m_recordTimer;
+    int m_maxQueuedPackets;
+    qint64 m_maxQueuedBytes;
+    qint64 m_longestWriteMs;
+};
+
+#endif // MUXWRITER_H
@@ -33,7 +33,7 @@ bool NILECAM30_USB::setSpecialEffectsNileCam30USB(const specialEffects &specialE
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -47,7 +47,7 @@ bool NILECAM30_USB::setSpecialEffectsNileCam30USB(const specialEffects &specialE
     g_out_packet_buf[3] = specialEffect; /* set special effect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -67,7 +67,7 @@ bool NILECAM30_USB::setSpecialEffectsNileCam30USB(const specialEffects &specialE
 bool NILECAM30_USB::setDenoiseValueNileCam30USB(int deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -81,7 +81,7 @@ bool NILECAM30_USB::setDenoiseValueNileCam30USB(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -100,7 +100,7 @@ bool NILECAM30_USB::setDenoiseValueNileCam30USB(int deNoiseVal)
 bool NILECAM30_USB::getSpecialEffectsNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -133,7 +133,7 @@ bool NILECAM30_USB::getSpecialEffectsNileCam30USB()
 bool NILECAM30_USB::getDenoiseValueNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -166,7 +166,7 @@ bool NILECAM30_USB::getDenoiseValueNileCam30USB()
 bool NILECAM30_USB::getSceneModeNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -200,7 +200,7 @@ bool NILECAM30_USB::getSceneModeNileCam30USB()
 bool NILECAM30_USB::setSceneModeNileCam30USB(const sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -214,7 +214,7 @@ bool NILECAM30_USB::setSceneModeNileCam30USB(const sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -239,7 +239,7 @@ bool NILECAM30_USB::setSceneModeNileCam30USB(const sceneModes &sceneMode)
 bool NILECAM30_USB::setExpRoiModeNileCam30USB(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -273,7 +273,7 @@ bool NILECAM30_USB::setExpRoiModeNileCam30USB(camROIAutoExpMode see3camAutoexpRO
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -293,7 +293,7 @@ bool NILECAM30_USB::setExpRoiModeNileCam30USB(camROIAutoExpMode see3camAutoexpRO
 bool NILECAM30_USB::getExpRoiModeNileCam30USB(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -327,7 +327,7 @@ bool NILECAM30_USB::getExpRoiModeNileCam30USB(){
 bool NILECAM30_USB::setBurstLengthNileCam30USB(uint burstLength){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -341,7 +341,7 @@ bool NILECAM30_USB::setBurstLengthNileCam30USB(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -360,7 +360,7 @@ bool NILECAM30_USB::setBurstLengthNileCam30USB(uint burstLength){
 bool NILECAM30_USB::getBurstLengthNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -393,7 +393,7 @@ bool NILECAM30_USB::getBurstLengthNileCam30USB()
  */
 bool NILECAM30_USB::setQFactorNileCam30USB(uint qFactor){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -407,7 +407,7 @@ bool NILECAM30_USB::setQFactorNileCam30USB(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -426,7 +426,7 @@ bool NILECAM30_USB::setQFactorNileCam30USB(uint qFactor){
 bool NILECAM30_USB::getQFactorNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -460,7 +460,7 @@ bool NILECAM30_USB::setFlipModeNileCam30USB(bool horzModeSel, bool vertiModeSel)
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -481,7 +481,7 @@ bool NILECAM30_USB::setFlipModeNileCam30USB(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SET_ORIENTATION_BOTHFLIP_DISABLE_NILECAM30_USB ; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -503,7 +503,7 @@ bool NILECAM30_USB::setFlipModeNileCam30USB(bool horzModeSel, bool vertiModeSel)
 bool NILECAM30_USB::getFlipModeNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -538,7 +538,7 @@ bool NILECAM30_USB::getFlipModeNileCam30USB()
 bool NILECAM30_USB::setFrameRateValueNileCam30USB(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -552,7 +552,7 @@ bool NILECAM30_USB::setFrameRateValueNileCam30USB(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -571,7 +571,7 @@ bool NILECAM30_USB::setFrameRateValueNileCam30USB(uint frameRate)
 bool NILECAM30_USB::getFrameRateValueNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -610,7 +610,7 @@ bool NILECAM30_USB::setExposureCompensationNileCam30USB(unsigned int exposureCom
     }
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -627,7 +627,7 @@ bool NILECAM30_USB::setExposureCompensationNileCam30USB(unsigned int exposureCom
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -647,7 +647,7 @@ bool NILECAM30_USB::setExposureCompensationNileCam30USB(unsigned int exposureCom
  */
 bool NILECAM30_USB::getExposureCompensationNileCam30USB(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -688,7 +688,7 @@ bool NILECAM30_USB::getExposureCompensationNileCam30USB(){
 bool NILECAM30_USB::setFaceDetectionRectNileCam30USB(bool enableFaceDetectRect, bool embedData, bool overlayRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -716,7 +716,7 @@ bool NILECAM30_USB::setFaceDetectionRectNileCam30USB(bool enableFaceDetectRect,
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT_NILECAM30_USB; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -735,7 +735,7 @@ bool NILECAM30_USB::setFaceDetectionRectNileCam30USB(bool enableFaceDetectRect,
 bool NILECAM30_USB::getFaceDetectionRectNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -770,7 +770,7 @@ bool NILECAM30_USB::getFaceDetectionRectNileCam30USB()
  */
 bool NILECAM30_USB::setSmileDetectionStateNileCam30USB(bool enableSmileDetect, bool embedData){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -794,7 +794,7 @@ bool NILECAM30_USB::setSmileDetectionStateNileCam30USB(bool enableSmileDetect, b
         g_out_packet_buf[5] = DISABLE_EMBED_DATA_NILECAM30_USB; /* disable embed data */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set smile detection threshold");
             return false;
@@ -816,7 +816,7 @@ bool NILECAM30_USB::setSmileDetectionStateNileCam30USB(bool enableSmileDetect, b
 bool NILECAM30_USB::getSmileDetectionStateNileCam30USB()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -849,7 +849,7 @@ bool NILECAM30_USB::getSmileDetectionStateNileCam30USB()
 bool NILECAM30_USB::restoreDefaultNileCam30USB(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -884,7 +884,7 @@ bool NILECAM30_USB::restoreDefaultNileCam30USB(){
 bool NILECAM30_USB::enableDisableFaceRectangle(bool enableFaceRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -901,7 +901,7 @@ bool NILECAM30_USB::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_NILECAM30_USB; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -919,7 +919,7 @@ bool NILECAM30_USB::enableDisableFaceRectangle(bool enableFaceRect){
  */
 bool NILECAM30_USB::setFlashNileCam30USB(flashStateValues flashMode)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -931,7 +931,7 @@ bool NILECAM30_USB::setFlashNileCam30USB(flashStateValues flashMode)
     g_out_packet_buf[2] = SETFLASH_STATUS_NILECAM30_USB ; /* set flash status command code */
     g_out_packet_buf[3] = flashMode; /* set flash state [off/torch/storbe] */
 
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_NILECAM30_USB &&
@@ -950,7 +950,7 @@ bool NILECAM30_USB::setFlashNileCam30USB(flashStateValues flashMode)
  */
 bool NILECAM30_USB::getFlashNileCam30USB()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -980,7 +980,7 @@ bool NILECAM30_USB::getFlashNileCam30USB()
 bool NILECAM30_USB::readMCUFirmwareVersion(){
     QString mcuFwVersion;
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -158,6 +158,101 @@ Item {
         }
     }
 
+    // demosaic of the preview on the gpu, white balance gains of the shader
+    CheckBox {
+        id: gpuBayerPreview
+        x: 19
+        y: 345
+        activeFocusOnPress : true
+        text: "GPU Preview Demosaic"
+        style: econ10CUG_BayerCheckBoxStyle
+        onClicked: {
+            setBayerPreview()
+        }
+        Keys.onReturnPressed: {
+            checked = !checked
+            setBayerPreview()
+        }
+    }
+
+    Grid {
+        x: 19
+        y: 380
+        columns: 2
+        spacing: 10
+        enabled: gpuBayerPreview.checked
+        opacity: enabled ? 1 : 0.1
+        Text {
+            text: "Red Gain"
+            font.pixelSize: 14
+            font.family: "Ubuntu"
+            color: "#ffffff"
+            smooth: true
+        }
+        Slider {
+            id: redGainSlider
+            activeFocusOnPress: true
+            width: 140
+            style: econSliderStyle
+            minimumValue: 0.25
+            maximumValue: 4
+            value: 1
+            onValueChanged: setBayerPreview()
+        }
+        Text {
+            text: "Green Gain"
+            font.pixelSize: 14
+            font.family: "Ubuntu"
+            color: "#ffffff"
+            smooth: true
+        }
+        Slider {
+            id: greenGainSlider
+            activeFocusOnPress: true
+            width: 140
+            style: econSliderStyle
+            minimumValue: 0.25
+            maximumValue: 4
+            value: 1
+            onValueChanged: setBayerPreview()
+        }
+        Text {
+            text: "Blue Gain"
+            font.pixelSize: 14
+            font.family: "Ubuntu"
+            color: "#ffffff"
+            smooth: true
+        }
+        Slider {
+            id: blueGainSlider
+            activeFocusOnPress: true
+            width: 140
+            style: econSliderStyle
+            minimumValue: 0.25
+            maximumValue: 4
+            value: 1
+            onValueChanged: setBayerPreview()
+        }
+    }
+
+    Component {
+        id: econ10CUG_BayerCheckBoxStyle
+        CheckBoxStyle {
+            label: Text {
+                text: control.text
+                font.pixelSize: 14
+                font.family: "Ubuntu"
+                color: "#ffffff"
+                smooth: true
+                opacity: 1
+            }
+            background: Rectangle {
+                color: "#222021"
+                border.color: control.activeFocus ? "#ffffff" : "#222021"
+            }
+        }
+    }
+
     Component {
         id: econ10CUG_BayerButtonStyle
         ButtonStyle {
@@ -181,6 +276,10 @@ Item {
     }
 
 
+    function setBayerPreview() {
+        root.vidstreamproperty.setBayerPreview(gpuBayerPreview.checked, redGainSlider.value, greenGainSlider.value, blueGainSlider.value)
+    }
+
     function enableMasterMode() {
         masterModeCapture();
         masterMode = seecam10.enableMasterMode()
@@ -98,6 +98,14 @@ Rectangle {
     property variant audioSettingsRootObject
     property variant captureVideoRecordRootObject
     property variant pciBusCamDetails
+    // camera the side bar works on: the main preview or one of the camera tiles
+    property variant vidstreamproperty: mainStream
+    property variant selectedTile: null
+    property int mainDeviceIndex: 0
+    // camera list is rebuilt on hotplug without selecting a camera
+    property bool cameraListRefreshing: false
+    // camera waited for by the stream recovery, selected again once it is listed
+    property string recoveringCameraName: ""
 
     //Disabling side bar controls - Added below by Dhurka
 	signal sidebarVisibleStatus(variant status);
@@ -313,7 +321,7 @@ Rectangle {
         height: layer_0.height
      }
         Videostreaming {
-            id: vidstreamproperty
+            id: mainStream
             focus: true
 
 	    SequentialAnimation on t {
@@ -370,6 +378,7 @@ Rectangle {
             }
 
             onDeviceUnplugged: {
+                recoveringCameraName = ""
                 // Added by Sankari:12 Feb 2018 - Get the Pci bus info for selected camera
                 keyEvent.stopGetKeyFromCamera()
                 seqAni.stop()
@@ -496,6 +505,13 @@ Rectangle {
                 captureFrameTimeout();
             }
 
+            // capture failed, the preview restarts by itself if the camera comes back
+            onStreamRecovering:{
+                statusText = "Camera lost, reconnecting..."
+                if(device_box.currentIndex > 0)
+                    recoveringCameraName = device_box.currentText
+            }
+
             //  Added by Navya : 23 Apr 2019
             //  In order to maintain Mousearea similar to preview window
             onSignalForPreviewWindow:{
@@ -537,6 +553,102 @@ Rectangle {
           }
         }
 
+    // Further cameras, each previews in a tile with a camera session of its own. The selected
+    // camera gets the side bar, its format lists and extension unit controls.
+    Component {
+        id: cameraTileComponent
+        Rectangle {
+            id: cameraTile
+            property alias stream: tileStream
+            property int deviceIndex: 0
+            width: 256
+            height: 144
+            color: "#000000"
+            border.color: selectedTile === cameraTile ? "#dc6239" : "#dddddd"
+            border.width: 2
+
+            Videostreaming {
+                id: tileStream
+                Component.onCompleted: {
+                    newSession()
+                    // the side bar listens to the main preview
+                    titleTextChanged.connect(mainStream.titleTextChanged)
+                    newControlAdded.connect(mainStream.newControlAdded)
+                    logDebugHandle.connect(mainStream.logDebugHandle)
+                    logCriticalHandle.connect(mainStream.logCriticalHandle)
+                    defaultFrameSize.connect(mainStream.defaultFrameSize)
+                    defaultStillFrameSize.connect(mainStream.defaultStillFrameSize)
+                    defaultOutputFormat.connect(mainStream.defaultOutputFormat)
+                    defaultFrameInterval.connect(mainStream.defaultFrameInterval)
+                    rcdStop.connect(mainStream.rcdStop)
+                    captureSaveTime.connect(mainStream.captureSaveTime)
+                    videoRecord.connect(mainStream.videoRecord)
+                    stillSkipCount.connect(mainStream.stillSkipCount)
+                    stillSkipCountWhenFPSChange.connect(mainStream.stillSkipCountWhenFPSChange)
+                    sendFPSlist.connect(mainStream.sendFPSlist)
+                }
+                onDeviceUnplugged: {
+                    tileStream.stopCapture()
+                    cameraTile.deviceIndex = 0
+                }
+            }
+            function updateTileArea() {
+                var pos = mapToItem(null, 0, 0)
+                tileStream.setTileArea(pos.x + border.width, pos.y + border.width, width - 2*border.width, height - 2*border.width)
+            }
+            onXChanged: updateTileArea()
+            onYChanged: updateTileArea()
+            Connections {
+                target: cameraTiles
+                onXChanged: cameraTile.updateTileArea()
+                onYChanged: cameraTile.updateTileArea()
+            }
+            Component.onCompleted: updateTileArea()
+
+            MouseArea {
+                anchors.fill: parent
+                acceptedButtons: Qt.LeftButton | Qt.RightButton
+                onReleased: {
+                    if (mouse.button == Qt.LeftButton) {
+                        selectStream(tileStream, cameraTile)
+                    } else if (!captureVideoRecordRootObject.recordStopBtnVisible) {
+                        // right click closes the tile
+                        if (selectedTile === cameraTile)
+                            selectStream(mainStream, null)
+                        tileStream.stopCapture()
+                        tileStream.closeDevice()
+                        cameraTile.destroy()
+                    }
+                }
+            }
+        }
+    }
+
+    Column {
+        id: cameraTiles
+        anchors.top: previewBgrndArea.top
+        anchors.right: previewBgrndArea.right
+        anchors.margins: 10
+        spacing: 6
+        Row {
+            spacing: 6
+            Button {
+                text: qsTr("Main camera")
+                tooltip: "Work on the camera of the main preview"
+                onClicked: selectStream(mainStream, null)
+            }
+            Button {
+                text: qsTr("Add camera")
+                tooltip: "Preview one more camera in a tile, pick its camera in the camera list. Right click a tile to close it"
+                enabled: !(captureVideoRecordRootObject && captureVideoRecordRootObject.recordStopBtnVisible)
+                onClicked: {
+                    var tile = cameraTileComponent.createObject(cameraTiles)
+                    selectStream(tile.stream, tile)
+                }
+            }
+        }
+    }
+
     Image {
         id: open_sideBar
         visible: false
@@ -622,6 +734,8 @@ Rectangle {
                 }
             }
             onCurrentIndexChanged: {
+                if(cameraListRefreshing)
+                    return
                 if(currentIndex.toString() != "-1" && currentIndex.toString() != "0") {                    
                     if(oldIndex!=currentIndex) {
                         // when switching camera make "exposureAutoAvailable" as false
@@ -632,6 +746,7 @@ Rectangle {
                         vidstreamproperty.setPreviewBgrndArea(previewBgrndArea.width, previewBgrndArea.height, true)
 
                         oldIndex = currentIndex
+                        recoveringCameraName = ""
 
                         // Added by Sankari: 12 Feb 2018 : stop Getting key from camera.
                         keyEvent.stopGetKeyFromCamera()
@@ -894,6 +1009,37 @@ Rectangle {
             warningDialog.text = qsTr(text)
             warningDialog.open()
         }
+
+        // Refresh the camera list on hotplug
+        onCameraDeviceAdded: {
+            refreshCameraList()
+        }
+        onCameraDeviceRemoved: {
+            // a streaming camera is reported by its capture error first [recovery or deviceUnplugged],
+            // a selected camera which is not streaming is closed here the same way
+            if(camproperty.isCurrentDevice(videoNode) && device_box.currentIndex > 0 && recoveringCameraName == "") {
+                vidstreamproperty.stopCapture()
+                vidstreamproperty.closeDevice()
+                vidstreamproperty.deviceUnplugged("Disconnected", "Device Not Found")
+            }
+            refreshCameraList()
+        }
+    }
+
+    // Rebuild the camera list from the device registry. The selected camera keeps its entry even
+    // when its position changes, a camera being recovered is selected again once it is back.
+    function refreshCameraList(){
+        var selected = device_box.currentIndex > 0 ? device_box.currentText : recoveringCameraName
+        cameraListRefreshing = true
+        camproperty.checkforDevice()
+        var index = selected != "" ? device_box.find(selected) : -1
+        device_box.oldIndex = index > 0 ? index : 0
+        device_box.currentIndex = device_box.oldIndex
+        cameraListRefreshing = false
+        if(index > 0)
+            recoveringCameraName = ""
+        if(!selectedTile)
+            mainDeviceIndex = device_box.currentIndex
     }
 
     // Added by Sankari: 12 Feb 2018 - Get the event from keyEventReceive.cpp
@@ -908,6 +1054,22 @@ Rectangle {
     }
 
 
+    // Hand the side bar to another camera. The camera list shows the camera of the stream without
+    // reopening it, format lists follow its session [Videostreaming::selectSession].
+    function selectStream(stream, tile){
+        if(vidstreamproperty === stream)
+            return
+        if(selectedTile)
+            selectedTile.deviceIndex = device_box.currentIndex
+        else
+            mainDeviceIndex = device_box.currentIndex
+        selectedTile = tile
+        vidstreamproperty = stream
+        stream.selectSession()
+        device_box.oldIndex = tile ? tile.deviceIndex : mainDeviceIndex
+        device_box.currentIndex = device_box.oldIndex
+    }
+
     function enumerateAudioSettings(){
         vidstreamproperty.enumerateAudioProperties()
     }
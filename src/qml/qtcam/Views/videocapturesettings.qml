@@ -253,6 +253,74 @@ Item {
                         }
                     }
 
+                    // 12/16 bit mono preview, window/level and gamma applied in the shader
+                    GridLayout {
+                        id: monoPreviewGrid
+                        columns: 2
+                        columnSpacing: 8
+                        visible: /^Y1[26] /.test(color_comp_box_VideoPin.currentText)
+                        Text {
+                            text: "Level"
+                            font.pixelSize: 14
+                            font.family: "Ubuntu"
+                            color: "#ffffff"
+                            smooth: true
+                        }
+                        Slider {
+                            id: monoLevel_Slider
+                            activeFocusOnPress: true
+                            width: 150
+                            style: econSliderStyle
+                            minimumValue: 0
+                            maximumValue: 1
+                            value: 0.5
+                            onValueChanged: applyMonoPreview()
+                        }
+                        Text {
+                            text: "Window"
+                            font.pixelSize: 14
+                            font.family: "Ubuntu"
+                            color: "#ffffff"
+                            smooth: true
+                        }
+                        Slider {
+                            id: monoWindow_Slider
+                            activeFocusOnPress: true
+                            width: 150
+                            style: econSliderStyle
+                            minimumValue: 0.01
+                            maximumValue: 1
+                            value: 1
+                            onValueChanged: applyMonoPreview()
+                        }
+                        Text {
+                            text: "Gamma"
+                            font.pixelSize: 14
+                            font.family: "Ubuntu"
+                            color: "#ffffff"
+                            smooth: true
+                        }
+                        Slider {
+                            id: monoGamma_Slider
+                            activeFocusOnPress: true
+                            width: 150
+                            style: econSliderStyle
+                            minimumValue: 0.2
+                            maximumValue: 3
+                            value: 1
+                            onValueChanged: applyMonoPreview()
+                        }
+                        Button {
+                            text: qsTr("Default")
+                            tooltip: "Show the full sample range without gamma"
+                            onClicked: {
+                                monoLevel_Slider.value = 0.5
+                                monoWindow_Slider.value = 1
+                                monoGamma_Slider.value = 1
+                            }
+                        }
+                    }
+
                     Text {
                         id: output_size_Video
                         text: "Output Size"
@@ -317,6 +385,16 @@ Item {
                         }
                     }
 
+                    Button {
+                        id: planFormat
+                        text: qsTr("Fit to USB bandwidth")
+                        tooltip: "Pick the color space and frame rate with the lowest cpu load that fits the usb bus at this output size"
+                        activeFocusOnPress: true
+                        onClicked: {
+                            root.vidstreamproperty.planCaptureFormat(output_size_box_Video.currentText.toString(), parseInt(frame_rate_box.currentText))
+                        }
+                    }
+
                     Text {
                         id: extension
                         text: "Video Record Format"
@@ -558,6 +636,34 @@ Item {
         }
     }
 
+    // mode picked by the bandwidth planner, applied with one preview restart
+    Connections
+    {
+        target: root.vidstreamproperty
+        onCaptureFormatPlanned:
+        {
+            colorSpace = false
+            outputSizeBox = false
+            frameRateBox = false
+            root.updateScenePreview(resolution, formatIndex.toString(), fpsIndex)
+            root.vidstreamproperty.displayVideoResolution()
+            color_comp_box_VideoPin.currentIndex = formatIndex
+            output_size_box_Video.currentIndex = output_size_box_Video.find(resolution)
+            root.updateFPS(color_comp_box_VideoPin.currentText.toString(), resolution)
+            videoPinFrameInterval = fpsIndex
+            frame_rate_box.currentIndex = fpsIndex
+            JS.videoCaptureFormat = formatIndex.toString()
+            JS.videoCaptureResolution = resolution
+            JS.videocaptureFps = frame_rate_box.currentText
+            colorSpace = true
+            outputSizeBox = true
+            frameRateBox = true
+            messageDialog.title = qsTr("Capture Format")
+            messageDialog.text = explanation
+            messageDialog.open()
+        }
+    }
+
     Connections
     {
         target: root
@@ -580,6 +686,10 @@ Item {
         }
     }
 
+    function applyMonoPreview() {
+        root.vidstreamproperty.setPreviewWindowLevel(monoLevel_Slider.value, monoWindow_Slider.value, monoGamma_Slider.value)
+    }
+
     function videoPin() {
         outputSizeBox = true
         frameRateBox = true
@@ -3,7 +3,7 @@ folder_01.source = qml/qtcam
 folder_01.target = qml
 DEPLOYMENTFOLDERS = folder_01
 
-QT += widgets concurrent multimedia
+QT += widgets concurrent multimedia network
 TARGET = Qtcam
 
 CONFIG += release
@@ -47,7 +47,20 @@ SOURCES += main.cpp \
     see3cam_cu38.cpp \
     alsa.cpp\
     fscam_cu135.cpp \
-    see3camcu55_mh.cpp
+    see3camcu55_mh.cpp \
+    framepool.cpp \
+    frameexport.cpp \
+    streamserver.cpp \
+    deviceregistry.cpp \
+    hidengine.cpp \
+    controlcache.cpp \
+    muxwriter.cpp \
+    uvcmetadata.cpp \
+    camerasession.cpp \
+    framesync.cpp \
+    bandwidthplanner.cpp \
+    settledetector.cpp \
+    streamrecovery.cpp
 
 # Installation path
 # target.path =
@@ -95,7 +108,21 @@ HEADERS += \
     see3cam_cu38.h \
     alsa.h\
     fscam_cu135.h\
-    see3camcu55_mh.h
+    see3camcu55_mh.h \
+    framepool.h \
+    frameexport.h \
+    shmclient/qtcam_shm.h \
+    streamserver.h \
+    deviceregistry.h \
+    hidengine.h \
+    controlcache.h \
+    muxwriter.h \
+    uvcmetadata.h \
+    camerasession.h \
+    framesync.h \
+    bandwidthplanner.h \
+    settledetector.h \
+    streamrecovery.h
 
 
 INCLUDEPATH +=  $$PWD/v4l2headers/include \
@@ -157,9 +184,15 @@ contains(BOARD_ARM64, arm64):{
         -L/usr/lib/aarch64-linux-gnu/ -levdev
 }
 
+# shm_open for the shared memory frame export
+LIBS += -lrt
+
 #QMAKE_CXX += -ggdb
 QMAKE_CFLAGS_THREAD = -D__STDC_CONSTANT_MACROS      #For Ubuntu 12.04 compilation
 QMAKE_CXXFLAGS_THREAD = -D__STDC_CONSTANT_MACROS    #For Ubuntu 12.04 compilation
 
 OTHER_FILES += \
-    qml/qtcam/Views/qtcam.qml
+    qml/qtcam/Views/qtcam.qml \
+    shmclient/qtcam_shm_client.h \
+    shmclient/qtcam_shm_client.c \
+    shmclient/shm_consumer.c
@@ -32,7 +32,7 @@ See3CAM_130::See3CAM_130(QObject *parent) :
 bool See3CAM_130::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -44,18 +44,74 @@ bool See3CAM_130::getSceneMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_SCENEMODE_130; /* get scene mode command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_SCENEMODE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit sceneModeValue(g_in_packet_buf[2]);
-            return true;
-        }
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
+}
+
+/**
+ * @brief See3CAM_130::hidReply - reply of a get command queued with uvccamera::sendHidCmdAsync
+ * @param reply - report received from camera, matched to its command by camera id and command id
+ */
+void See3CAM_130::hidReply(QByteArray reply)
+{
+    const unsigned char *in = (const unsigned char *)reply.constData();
+
+    if (reply.size() < 7 || in[0] != CAMERA_CONTROL_130 || in[6] != GET_SUCCESS)
+        return;
+
+    switch (in[1]) {
+    case GET_SCENEMODE_130:
+        emit sceneModeValue(in[2]);
+        break;
+    case GET_SPECIALEFFECT_130:
+        emit effectModeValue(in[2]);
+        break;
+    case GET_DENOISE_CONTROL:
+        emit denoiseValueReceived(in[2]);
+        break;
+    case GET_AF_MODE_130:
+        emit afModeValue(in[2]);
+        break;
+    case GET_HDR_MODE_130:
+        emit hDRModeValueReceived(in[2], in[3]);
+        break;
+    case GET_BURST_LENGTH_130:
+        emit burstLengthValue(in[2]);
+        break;
+    case GET_Q_FACTOR_130:
+        emit qFactorValue(in[2]);
+        break;
+    case GET_AF_ROI_MODE_130:
+        emit roiAfModeValue(in[2], in[5]);
+        break;
+    case GET_EXP_ROI_MODE_130:
+        emit roiAutoExpModeValue(in[2], in[5]);
+        break;
+    case GET_AF_RECT_MODE:
+        emit afRectModeValue(in[2]);
+        break;
+    case GET_FLIP_MODE_130:
+        emit flipModeValue(in[2], in[3]);
+        break;
+    case GET_STREAM_MODE_130:
+        emit streamModeValue(in[2]);
+        break;
+    case GET_FACE_DETECT_RECT:
+        emit faceDetectModeValue(in[2], in[3], in[4]);
+        break;
+    case GET_SMILE_DETECTION:
+        emit smileDetectModeValue(in[2], in[4]);
+        break;
+    case GET_EXPOSURE_COMPENSATION:
+        emit exposureCompValueReceived((uint)in[2] << 24 | in[3] << 16 | in[4] << 8 | in[5]);
+        break;
+    case GET_FRAME_RATE_130:
+        emit frameRateCtrlValueReceived(in[2]);
+        break;
+    case GET_FLICKER_DETECTION:
+        emit flickerDetectionMode(in[2]);
+        break;
     }
-    return false;
 }
 
 /**
@@ -65,7 +121,7 @@ bool See3CAM_130::getSceneMode()
 bool See3CAM_130::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -77,18 +133,8 @@ bool See3CAM_130::getEffectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* set camera control code */
     g_out_packet_buf[2] = GET_SPECIALEFFECT_130; /* get special effect code */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_SPECIALEFFECT_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-                emit effectModeValue(g_in_packet_buf[2]);
-                return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -99,7 +145,7 @@ bool See3CAM_130::getEffectMode()
 bool See3CAM_130::setSceneMode(const See3CAM_130::sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -113,7 +159,7 @@ bool See3CAM_130::setSceneMode(const See3CAM_130::sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -134,7 +180,7 @@ bool See3CAM_130::setEffectMode(const See3CAM_130::specialEffects &specialEffect
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -148,7 +194,7 @@ bool See3CAM_130::setEffectMode(const See3CAM_130::specialEffects &specialEffect
     g_out_packet_buf[3] = specialEffect; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -169,7 +215,7 @@ bool See3CAM_130::setEffectMode(const See3CAM_130::specialEffects &specialEffect
 bool See3CAM_130::setDenoiseValue(int deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -183,7 +229,7 @@ bool See3CAM_130::setDenoiseValue(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -203,7 +249,7 @@ bool See3CAM_130::setDenoiseValue(int deNoiseVal)
 bool See3CAM_130::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -215,18 +261,8 @@ bool See3CAM_130::getDenoiseValue()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* set camera control code */
     g_out_packet_buf[2] = GET_DENOISE_CONTROL; /* get denoise code */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_DENOISE_CONTROL &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit denoiseValueReceived(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -237,7 +273,7 @@ bool See3CAM_130::getDenoiseValue()
  */
 bool See3CAM_130::setAutoFocusMode(camAfMode afMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -251,7 +287,7 @@ bool See3CAM_130::setAutoFocusMode(camAfMode afMode){
     g_out_packet_buf[3] = afMode; /* pass af mode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -270,7 +306,7 @@ bool See3CAM_130::setAutoFocusMode(camAfMode afMode){
 bool See3CAM_130::getAutoFocusMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -282,18 +318,8 @@ bool See3CAM_130::getAutoFocusMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_AF_MODE_130; /* get auto focus mode command  */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_AF_MODE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit afModeValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -306,7 +332,7 @@ bool See3CAM_130::getAutoFocusMode()
 bool See3CAM_130::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -322,7 +348,7 @@ bool See3CAM_130::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
         g_out_packet_buf[4] = iHDRValue;
     }
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -341,7 +367,7 @@ bool See3CAM_130::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
 bool See3CAM_130::getiHDRMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -353,18 +379,8 @@ bool See3CAM_130::getiHDRMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_HDR_MODE_130; /* get hdr mode value */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_HDR_MODE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit hDRModeValueReceived(g_in_packet_buf[2], g_in_packet_buf[3]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -374,7 +390,7 @@ bool See3CAM_130::getiHDRMode()
  */
 bool See3CAM_130::setBurstLength(uint burstLength){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -388,7 +404,7 @@ bool See3CAM_130::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -407,7 +423,7 @@ bool See3CAM_130::setBurstLength(uint burstLength){
 bool See3CAM_130::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -419,18 +435,8 @@ bool See3CAM_130::getBurstLength()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_BURST_LENGTH_130; /* get burst length command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_BURST_LENGTH_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit burstLengthValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -441,7 +447,7 @@ bool See3CAM_130::getBurstLength()
 bool See3CAM_130::setQFactor(uint qFactor){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -455,7 +461,7 @@ bool See3CAM_130::setQFactor(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -474,7 +480,7 @@ bool See3CAM_130::setQFactor(uint qFactor){
 bool See3CAM_130::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -486,18 +492,8 @@ bool See3CAM_130::getQFactor()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_Q_FACTOR_130; /* get q factor command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==SET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_Q_FACTOR_130 &&
-            g_in_packet_buf[6]==SET_SUCCESS) {
-            emit qFactorValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -513,7 +509,7 @@ bool See3CAM_130::getQFactor()
 bool See3CAM_130::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {    
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -546,7 +542,7 @@ bool See3CAM_130::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResolnW
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -563,9 +559,10 @@ bool See3CAM_130::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResolnW
  * @brief See3CAM_130::getAutoFocusROIModeAndWindowSize - get ROI auto focus mode and window size
  * return true - success /false - failure
  */
-bool See3CAM_130::getAutoFocusROIModeAndWindowSize(){
+bool See3CAM_130::getAutoFocusROIModeAndWindowSize()
+{
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -577,18 +574,8 @@ bool See3CAM_130::getAutoFocusROIModeAndWindowSize(){
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_AF_ROI_MODE_130; /* get AF ROI mode command  */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_AF_ROI_MODE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-                emit roiAfModeValue(g_in_packet_buf[2], g_in_packet_buf[5]);
-                return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -604,7 +591,7 @@ bool See3CAM_130::getAutoFocusROIModeAndWindowSize(){
 bool See3CAM_130::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -637,7 +624,7 @@ bool See3CAM_130::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, ui
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -654,10 +641,11 @@ bool See3CAM_130::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, ui
  * @brief See3CAM_130::getAutoExpROIModeAndWindowSize - get ROI auto exposure mode and window size
  * return true - success /false - failure
  */
-bool See3CAM_130::getAutoExpROIModeAndWindowSize(){
+bool See3CAM_130::getAutoExpROIModeAndWindowSize()
+{
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -669,18 +657,8 @@ bool See3CAM_130::getAutoExpROIModeAndWindowSize(){
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_EXP_ROI_MODE_130; /* get Auto exposure ROI mode command  */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_EXP_ROI_MODE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-                emit roiAutoExpModeValue(g_in_packet_buf[2], g_in_packet_buf[5]);
-                return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -691,7 +669,7 @@ bool See3CAM_130::getAutoExpROIModeAndWindowSize(){
 bool See3CAM_130::enableDisableAFRectangle(bool enableRFRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -708,7 +686,7 @@ bool See3CAM_130::enableDisableAFRectangle(bool enableRFRect){
         g_out_packet_buf[3] = DISABLE_AF_RECTANGLE_130; /* value to disable AF Rectangle*/
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -727,7 +705,7 @@ bool See3CAM_130::enableDisableAFRectangle(bool enableRFRect){
 bool See3CAM_130::getAFRectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -739,18 +717,8 @@ bool See3CAM_130::getAFRectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_AF_RECT_MODE; /* get af rect mode command  */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_AF_RECT_MODE &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit afRectModeValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -760,7 +728,7 @@ bool See3CAM_130::getAFRectMode()
 bool See3CAM_130::setToDefault(){    
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -791,7 +759,7 @@ bool See3CAM_130::setToDefault(){
  */
 bool See3CAM_130::setFlipHorzMode(bool horizModeSel){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -810,7 +778,7 @@ bool See3CAM_130::setFlipHorzMode(bool horizModeSel){
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING_SUBID)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -831,7 +799,7 @@ bool See3CAM_130::setFlipHorzMode(bool horizModeSel){
 bool See3CAM_130::setFlipVertiMode(bool vertModeSel){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -850,7 +818,7 @@ bool See3CAM_130::setFlipVertiMode(bool vertModeSel){
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING_SUBID)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -870,7 +838,7 @@ bool See3CAM_130::setFlipVertiMode(bool vertModeSel){
 bool See3CAM_130::getFlipMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -882,18 +850,8 @@ bool See3CAM_130::getFlipMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_FLIP_MODE_130; /* get flip mode command  */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_FLIP_MODE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-                emit flipModeValue(g_in_packet_buf[2], g_in_packet_buf[3]);
-                return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -903,7 +861,7 @@ bool See3CAM_130::getFlipMode()
  */
 bool See3CAM_130::setStreamMode(camStreamMode streamMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -917,7 +875,7 @@ bool See3CAM_130::setStreamMode(camStreamMode streamMode){
     g_out_packet_buf[3] = streamMode; /* stream mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -937,7 +895,7 @@ bool See3CAM_130::setStreamMode(camStreamMode streamMode){
 bool See3CAM_130::getStreamMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -949,18 +907,8 @@ bool See3CAM_130::getStreamMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_STREAM_MODE_130; /* get stream mode command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_STREAM_MODE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit streamModeValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -972,7 +920,7 @@ bool See3CAM_130::getStreamMode()
  */
 bool See3CAM_130::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1000,7 +948,7 @@ bool See3CAM_130::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -1020,7 +968,7 @@ bool See3CAM_130::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData
 bool See3CAM_130::getFaceDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1032,18 +980,8 @@ bool See3CAM_130::getFaceDetectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_FACE_DETECT_RECT; /* get face detect mode command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_FACE_DETECT_RECT &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit faceDetectModeValue(g_in_packet_buf[2], g_in_packet_buf[3], g_in_packet_buf[4]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -1056,7 +994,7 @@ bool See3CAM_130::getFaceDetectMode()
  */
 bool See3CAM_130::setSmileDetection(bool enableSmileDetect, bool embedData){
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1075,7 +1013,7 @@ bool See3CAM_130::setSmileDetection(bool enableSmileDetect, bool embedData){
         g_out_packet_buf[5] = DISABLE_EMBED_DATA; /* disable embed data */   
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -1095,7 +1033,7 @@ bool See3CAM_130::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool See3CAM_130::getSmileDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1107,18 +1045,8 @@ bool See3CAM_130::getSmileDetectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* Camera control id */
     g_out_packet_buf[2] = GET_SMILE_DETECTION; /* Get smile detection */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_SMILE_DETECTION &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit smileDetectModeValue(g_in_packet_buf[2], g_in_packet_buf[4]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -1134,7 +1062,7 @@ bool See3CAM_130::setExposureCompensation(unsigned int exposureCompValue){
     }
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1151,7 +1079,7 @@ bool See3CAM_130::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -1170,10 +1098,11 @@ bool See3CAM_130::setExposureCompensation(unsigned int exposureCompValue){
  * @brief See3CAM_130::getExposureCompensation - getting exposure compensation
  * @return true/false
  */
-bool See3CAM_130::getExposureCompensation(){
+bool See3CAM_130::getExposureCompensation()
+{
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1185,24 +1114,8 @@ bool See3CAM_130::getExposureCompensation(){
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* set camera control code */
     g_out_packet_buf[2] = GET_EXPOSURE_COMPENSATION; /* get exposure compensation code */
 
-    unsigned int exposureCompValue;
-
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_EXPOSURE_COMPENSATION &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            exposureCompValue = (((u_int8_t)g_in_packet_buf[2]) << 24)
-                                | (((u_int8_t)g_in_packet_buf[3]) << 16)
-                                | (((u_int8_t)g_in_packet_buf[4]) << 8)
-                                | (((u_int8_t)g_in_packet_buf[5]) << 0);
-            exposureCompValueReceived(exposureCompValue);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -1213,7 +1126,7 @@ bool See3CAM_130::getExposureCompensation(){
 bool See3CAM_130::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1227,7 +1140,7 @@ bool See3CAM_130::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -1247,7 +1160,7 @@ bool See3CAM_130::setFrameRateCtrlValue(uint frameRate)
 bool See3CAM_130::getFrameRateCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1259,18 +1172,8 @@ bool See3CAM_130::getFrameRateCtrlValue()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* set camera control code */
     g_out_packet_buf[2] = GET_FRAME_RATE_130; /* set framerate control code */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_FRAME_RATE_130 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit frameRateCtrlValueReceived(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -1282,7 +1185,7 @@ bool See3CAM_130::getFrameRateCtrlValue()
  */
 bool See3CAM_130::enableDisableFaceRectangle(bool enableFaceRect){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1299,7 +1202,7 @@ bool See3CAM_130::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_130; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -1320,7 +1223,7 @@ bool See3CAM_130::enableDisableFaceRectangle(bool enableFaceRect){
 
 bool See3CAM_130::setFlickerDetection(camFlickerMode flickerMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1334,7 +1237,7 @@ bool See3CAM_130::setFlickerDetection(camFlickerMode flickerMode){
     g_out_packet_buf[3] = flickerMode; /* flicker detection mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
@@ -1355,7 +1258,7 @@ bool See3CAM_130::setFlickerDetection(camFlickerMode flickerMode){
 bool See3CAM_130::getFlickerDetection()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1367,19 +1270,10 @@ bool See3CAM_130::getFlickerDetection()
     g_out_packet_buf[1] = CAMERA_CONTROL_130; /* camera id */
     g_out_packet_buf[2] = GET_FLICKER_DETECTION; /* get flicker detection command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130 &&
-            g_in_packet_buf[1]==GET_FLICKER_DETECTION &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit flickerDetectionMode(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
+
 /**
  * @brief See3CAM_130::initializeBuffers - Initialize input and output buffers
  */
@@ -224,6 +224,10 @@ signals:
      void indicateExposureValueRangeFailure(QString title, QString text);
      void flickerDetectionMode(uint flickerMode);
 
+private slots:
+    // replies of the get commands, see uvccamera::sendHidCmdAsync
+    void hidReply(QByteArray reply);
+
 public slots:
     bool getSceneMode();
     bool setSceneMode(const sceneModes& sceneMode);
@@ -32,7 +32,7 @@ See3CAM_130A::See3CAM_130A(QObject *parent) :
 bool See3CAM_130A::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -65,7 +65,7 @@ bool See3CAM_130A::getSceneMode()
 bool See3CAM_130A::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -99,7 +99,7 @@ bool See3CAM_130A::getEffectMode()
 bool See3CAM_130A::setSceneMode(const See3CAM_130A::sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -113,7 +113,7 @@ bool See3CAM_130A::setSceneMode(const See3CAM_130A::sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -134,7 +134,7 @@ bool See3CAM_130A::setEffectMode(const See3CAM_130A::specialEffects &specialEffe
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -148,7 +148,7 @@ bool See3CAM_130A::setEffectMode(const See3CAM_130A::specialEffects &specialEffe
     g_out_packet_buf[3] = specialEffect; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -169,7 +169,7 @@ bool See3CAM_130A::setEffectMode(const See3CAM_130A::specialEffects &specialEffe
 bool See3CAM_130A::setDenoiseValue(int deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -183,7 +183,7 @@ bool See3CAM_130A::setDenoiseValue(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -203,7 +203,7 @@ bool See3CAM_130A::setDenoiseValue(int deNoiseVal)
 bool See3CAM_130A::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -237,7 +237,7 @@ bool See3CAM_130A::getDenoiseValue()
  */
 bool See3CAM_130A::setAutoFocusMode(camAfMode afMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -251,7 +251,7 @@ bool See3CAM_130A::setAutoFocusMode(camAfMode afMode){
     g_out_packet_buf[3] = afMode; /* pass af mode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -270,7 +270,7 @@ bool See3CAM_130A::setAutoFocusMode(camAfMode afMode){
 bool See3CAM_130A::getAutoFocusMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -306,7 +306,7 @@ bool See3CAM_130A::getAutoFocusMode()
 bool See3CAM_130A::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -322,7 +322,7 @@ bool See3CAM_130A::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
         g_out_packet_buf[4] = iHDRValue;
     }
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -341,7 +341,7 @@ bool See3CAM_130A::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
 bool See3CAM_130A::getiHDRMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -374,7 +374,7 @@ bool See3CAM_130A::getiHDRMode()
  */
 bool See3CAM_130A::setBurstLength(uint burstLength){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -388,7 +388,7 @@ bool See3CAM_130A::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -407,7 +407,7 @@ bool See3CAM_130A::setBurstLength(uint burstLength){
 bool See3CAM_130A::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -441,7 +441,7 @@ bool See3CAM_130A::getBurstLength()
 bool See3CAM_130A::setQFactor(uint qFactor){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -455,7 +455,7 @@ bool See3CAM_130A::setQFactor(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -474,7 +474,7 @@ bool See3CAM_130A::setQFactor(uint qFactor){
 bool See3CAM_130A::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -513,7 +513,7 @@ bool See3CAM_130A::getQFactor()
 bool See3CAM_130A::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {    
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -546,7 +546,7 @@ bool See3CAM_130A::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResoln
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -565,7 +565,7 @@ bool See3CAM_130A::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResoln
  */
 bool See3CAM_130A::getAutoFocusROIModeAndWindowSize(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -604,7 +604,7 @@ bool See3CAM_130A::getAutoFocusROIModeAndWindowSize(){
 bool See3CAM_130A::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -637,7 +637,7 @@ bool See3CAM_130A::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -657,7 +657,7 @@ bool See3CAM_130A::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
 bool See3CAM_130A::getAutoExpROIModeAndWindowSize(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -691,7 +691,7 @@ bool See3CAM_130A::getAutoExpROIModeAndWindowSize(){
 bool See3CAM_130A::enableDisableAFRectangle(bool enableRFRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -708,7 +708,7 @@ bool See3CAM_130A::enableDisableAFRectangle(bool enableRFRect){
         g_out_packet_buf[3] = DISABLE_AF_RECTANGLE_130A; /* value to disable AF Rectangle*/
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -727,7 +727,7 @@ bool See3CAM_130A::enableDisableAFRectangle(bool enableRFRect){
 bool See3CAM_130A::getAFRectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -760,7 +760,7 @@ bool See3CAM_130A::getAFRectMode()
 bool See3CAM_130A::setToDefault(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -791,7 +791,7 @@ bool See3CAM_130A::setToDefault(){
 // */
 //bool See3CAM_130A::setFlipHorzMode(bool horizModeSel){
 //    // hid validation
-//    if(uvccamera::hid_fd < 0)
+//    if(uvc.hidFd() < 0)
 //    {
 //        return false;
 //    }
@@ -831,7 +831,7 @@ bool See3CAM_130A::setToDefault(){
 //bool See3CAM_130A::setFlipVertiMode(bool vertModeSel){
 
 //    // hid validation
-//    if(uvccamera::hid_fd < 0)
+//    if(uvc.hidFd() < 0)
 //    {
 //        return false;
 //    }
@@ -872,7 +872,7 @@ bool See3CAM_130A::setFlipMode(bool horzModeSel, bool vertiModeSel)
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -893,7 +893,7 @@ bool See3CAM_130A::setFlipMode(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SET_FLIP_BOTHFLIP_DISABLE_130A; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -912,7 +912,7 @@ bool See3CAM_130A::setFlipMode(bool horzModeSel, bool vertiModeSel)
 bool See3CAM_130A::getFlipMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -945,7 +945,7 @@ bool See3CAM_130A::getFlipMode()
  */
 bool See3CAM_130A::setStreamMode(camStreamMode streamMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -959,7 +959,7 @@ bool See3CAM_130A::setStreamMode(camStreamMode streamMode){
     g_out_packet_buf[3] = streamMode; /* stream mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -979,7 +979,7 @@ bool See3CAM_130A::setStreamMode(camStreamMode streamMode){
 bool See3CAM_130A::getStreamMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1014,7 +1014,7 @@ bool See3CAM_130A::getStreamMode()
  */
 bool See3CAM_130A::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1042,7 +1042,7 @@ bool See3CAM_130A::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -1062,7 +1062,7 @@ bool See3CAM_130A::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
 bool See3CAM_130A::getFaceDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1098,7 +1098,7 @@ bool See3CAM_130A::getFaceDetectMode()
  */
 bool See3CAM_130A::setSmileDetection(bool enableSmileDetect, bool embedData){
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1117,7 +1117,7 @@ bool See3CAM_130A::setSmileDetection(bool enableSmileDetect, bool embedData){
         g_out_packet_buf[5] = DISABLE_EMBED_DATA; /* disable embed data */   
    
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -1137,7 +1137,7 @@ bool See3CAM_130A::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool See3CAM_130A::getSmileDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1176,7 +1176,7 @@ bool See3CAM_130A::setExposureCompensation(unsigned int exposureCompValue){
     }
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1193,7 +1193,7 @@ bool See3CAM_130A::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -1215,7 +1215,7 @@ bool See3CAM_130A::setExposureCompensation(unsigned int exposureCompValue){
 bool See3CAM_130A::getExposureCompensation(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1255,7 +1255,7 @@ bool See3CAM_130A::getExposureCompensation(){
 bool See3CAM_130A::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1269,7 +1269,7 @@ bool See3CAM_130A::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
@@ -1289,7 +1289,7 @@ bool See3CAM_130A::setFrameRateCtrlValue(uint frameRate)
 bool See3CAM_130A::getFrameRateCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1324,7 +1324,7 @@ bool See3CAM_130A::getFrameRateCtrlValue()
  */
 bool See3CAM_130A::enableDisableFaceRectangle(bool enableFaceRect){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1341,7 +1341,7 @@ bool See3CAM_130A::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_130A; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_130A &&
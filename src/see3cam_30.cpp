@@ -33,7 +33,7 @@ See3CAM_30::See3CAM_30(QObject *parent) :
 bool See3CAM_30::setEffectMode(const specialEffects &specialEffect)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -47,7 +47,7 @@ bool See3CAM_30::setEffectMode(const specialEffects &specialEffect)
     g_out_packet_buf[3] = specialEffect; /* pass special effect value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -67,7 +67,7 @@ bool See3CAM_30::setEffectMode(const specialEffects &specialEffect)
 bool See3CAM_30::setDenoiseValue(int deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -81,7 +81,7 @@ bool See3CAM_30::setDenoiseValue(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* pass denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -100,7 +100,7 @@ bool See3CAM_30::setDenoiseValue(int deNoiseVal)
 bool See3CAM_30::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -133,7 +133,7 @@ bool See3CAM_30::getEffectMode()
 bool See3CAM_30::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -167,7 +167,7 @@ bool See3CAM_30::getDenoiseValue()
 bool See3CAM_30::setAutoFocusMode(camAfMode afMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -181,7 +181,7 @@ bool See3CAM_30::setAutoFocusMode(camAfMode afMode)
     g_out_packet_buf[3] = afMode; /* pass af mode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -201,7 +201,7 @@ bool See3CAM_30::setAutoFocusMode(camAfMode afMode)
 bool See3CAM_30::getAutoFocusMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -235,7 +235,7 @@ bool See3CAM_30::getAutoFocusMode()
 bool See3CAM_30::setQFactor(uint qFactor)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -249,7 +249,7 @@ bool See3CAM_30::setQFactor(uint qFactor)
     g_out_packet_buf[3] = qFactor; /* pass q factor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -268,7 +268,7 @@ bool See3CAM_30::setQFactor(uint qFactor)
 bool See3CAM_30::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -301,7 +301,7 @@ bool See3CAM_30::getQFactor()
 bool See3CAM_30::getOrientation()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -340,7 +340,7 @@ bool See3CAM_30::getOrientation()
 bool See3CAM_30::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -371,7 +371,7 @@ bool See3CAM_30::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResolnWi
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -390,7 +390,7 @@ bool See3CAM_30::setROIAutoFoucs(camROIAfMode see3camAfROIMode, uint vidResolnWi
 bool See3CAM_30::getAutoFocusROIModeAndWindowSize()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -436,7 +436,7 @@ bool See3CAM_30::getAutoFocusROIModeAndWindowSize()
 bool See3CAM_30::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -467,7 +467,7 @@ bool See3CAM_30::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uin
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -486,7 +486,7 @@ bool See3CAM_30::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uin
 bool See3CAM_30::getAutoExpROIModeAndWindowSize()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -526,7 +526,7 @@ bool See3CAM_30::getAutoExpROIModeAndWindowSize()
 bool See3CAM_30::enableDisableAFRectangle(bool enableRFRect)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -544,7 +544,7 @@ bool See3CAM_30::enableDisableAFRectangle(bool enableRFRect)
         g_out_packet_buf[3] = DISABLE_AF_RECTANGLE_30; /* Disable AF Rectangle */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -563,7 +563,7 @@ bool See3CAM_30::enableDisableAFRectangle(bool enableRFRect)
 bool See3CAM_30::getAFRectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -597,7 +597,7 @@ bool See3CAM_30::getAFRectMode()
 bool See3CAM_30::setBurstLength(uint burstLength)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -611,7 +611,7 @@ bool See3CAM_30::setBurstLength(uint burstLength)
     g_out_packet_buf[3] = burstLength; /* pass burst length value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -630,7 +630,7 @@ bool See3CAM_30::setBurstLength(uint burstLength)
 bool See3CAM_30::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -663,7 +663,7 @@ bool See3CAM_30::getBurstLength()
 bool See3CAM_30::setToDefault()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -699,7 +699,7 @@ bool See3CAM_30::setToDefault()
 bool See3CAM_30::setOrientation(bool horzModeSel, bool vertiModeSel)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -720,7 +720,7 @@ bool See3CAM_30::setOrientation(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SET_ORIENTATION_BOTHFLIP_DISABLE_30; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -739,7 +739,7 @@ bool See3CAM_30::setOrientation(bool horzModeSel, bool vertiModeSel)
  */
 bool See3CAM_30::setSceneMode(sceneModes sceneMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -753,7 +753,7 @@ bool See3CAM_30::setSceneMode(sceneModes sceneMode){
     g_out_packet_buf[3] = sceneMode; /* pass sceneMode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -772,7 +772,7 @@ bool See3CAM_30::setSceneMode(sceneModes sceneMode){
 bool See3CAM_30::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -808,7 +808,7 @@ bool See3CAM_30::setExposureCompensation(unsigned int exposureCompValue){
         emit indicateExposureValueRangeFailure("Failure", "Given exposure compensation value is invalid");
         return false;
     }
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -825,7 +825,7 @@ bool See3CAM_30::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -845,7 +845,7 @@ bool See3CAM_30::setExposureCompensation(unsigned int exposureCompValue){
  */
 bool See3CAM_30::getExposureCompensation(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -884,7 +884,7 @@ bool See3CAM_30::getExposureCompensation(){
  * @return true/false
  */
 bool See3CAM_30::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -912,7 +912,7 @@ bool See3CAM_30::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData,
 
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -931,7 +931,7 @@ bool See3CAM_30::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData,
  */
 bool See3CAM_30::getFaceDetectMode()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -970,7 +970,7 @@ bool See3CAM_30::getFaceDetectMode()
  * @return true/false
  */
 bool See3CAM_30::setSmileDetection(bool enableSmileDetect, bool embedData){
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -993,7 +993,7 @@ bool See3CAM_30::setSmileDetection(bool enableSmileDetect, bool embedData){
         g_out_packet_buf[5] = DISABLE_EMBED_DATA; /* disable embed data */
   
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -1011,7 +1011,7 @@ bool See3CAM_30::setSmileDetection(bool enableSmileDetect, bool embedData){
  */
 bool See3CAM_30::getSmileDetectMode()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1050,7 +1050,7 @@ bool See3CAM_30::getSmileDetectMode()
 bool See3CAM_30::enableDisableOverlayRect(bool enableOverlayRect)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1067,7 +1067,7 @@ bool See3CAM_30::enableDisableOverlayRect(bool enableOverlayRect)
         g_out_packet_buf[3] = DISABLE_OVERLAY_RECT_30; /* Disable overlay Rectangle */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -1088,7 +1088,7 @@ bool See3CAM_30::enableDisableOverlayRect(bool enableOverlayRect)
 bool See3CAM_30::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1102,7 +1102,7 @@ bool See3CAM_30::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* pass frame rate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_30 &&
@@ -1120,7 +1120,7 @@ bool See3CAM_30::setFrameRateCtrlValue(uint frameRate)
  */
 bool See3CAM_30::getFrameRateCtrlValue()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
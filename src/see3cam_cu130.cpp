@@ -31,7 +31,7 @@ See3CAM_CU130::See3CAM_CU130(QObject *parent) :
 bool See3CAM_CU130::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -63,7 +63,7 @@ bool See3CAM_CU130::getSceneMode()
 bool See3CAM_CU130::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -97,7 +97,7 @@ bool See3CAM_CU130::getEffectMode()
 bool See3CAM_CU130::setSceneMode(const See3CAM_CU130::sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -111,7 +111,7 @@ bool See3CAM_CU130::setSceneMode(const See3CAM_CU130::sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -131,7 +131,7 @@ bool See3CAM_CU130::setSceneMode(const See3CAM_CU130::sceneModes &sceneMode)
 bool See3CAM_CU130::setEffectMode(const See3CAM_CU130::specialEffects &specialEffect)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -145,7 +145,7 @@ bool See3CAM_CU130::setEffectMode(const See3CAM_CU130::specialEffects &specialEf
     g_out_packet_buf[3] = specialEffect; /* special mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -167,7 +167,7 @@ bool See3CAM_CU130::setEffectMode(const See3CAM_CU130::specialEffects &specialEf
 bool See3CAM_CU130::setOrientation(bool horzModeSel, bool vertiModeSel)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -188,7 +188,7 @@ bool See3CAM_CU130::setOrientation(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SET_ORIENTATION_BOTHFLIP_DISABLE_CU130; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -207,7 +207,7 @@ bool See3CAM_CU130::setOrientation(bool horzModeSel, bool vertiModeSel)
 bool See3CAM_CU130::getOrientation()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -244,7 +244,7 @@ bool See3CAM_CU130::setExposureCompensation(unsigned int exposureCompValue){
         emit indicateExposureValueRangeFailure("Failure", "Given exposure compensation value is invalid");
         return false;
     }
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -261,7 +261,7 @@ bool See3CAM_CU130::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -282,7 +282,7 @@ bool See3CAM_CU130::setExposureCompensation(unsigned int exposureCompValue){
  */
 bool See3CAM_CU130::getExposureCompensation(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -324,7 +324,7 @@ bool See3CAM_CU130::setDenoiseValue(int deNoiseVal)
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -338,7 +338,7 @@ bool See3CAM_CU130::setDenoiseValue(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -358,7 +358,7 @@ bool See3CAM_CU130::setDenoiseValue(int deNoiseVal)
 bool See3CAM_CU130::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -393,7 +393,7 @@ bool See3CAM_CU130::getDenoiseValue()
 bool See3CAM_CU130::setBurstLength(uint burstLength){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -407,7 +407,7 @@ bool See3CAM_CU130::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -426,7 +426,7 @@ bool See3CAM_CU130::setBurstLength(uint burstLength){
 bool See3CAM_CU130::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -461,7 +461,7 @@ bool See3CAM_CU130::getBurstLength()
 bool See3CAM_CU130::setQFactor(uint qFactor){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -475,7 +475,7 @@ bool See3CAM_CU130::setQFactor(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -494,7 +494,7 @@ bool See3CAM_CU130::setQFactor(uint qFactor){
 bool See3CAM_CU130::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -534,7 +534,7 @@ bool See3CAM_CU130::getQFactor()
 bool See3CAM_CU130::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -568,7 +568,7 @@ bool See3CAM_CU130::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode,
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -588,7 +588,7 @@ bool See3CAM_CU130::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode,
 bool See3CAM_CU130::getAutoExpROIModeAndWindowSize(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -621,7 +621,7 @@ bool See3CAM_CU130::getAutoExpROIModeAndWindowSize(){
  */
 bool See3CAM_CU130::setToDefault(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -654,7 +654,7 @@ bool See3CAM_CU130::setToDefault(){
 bool See3CAM_CU130::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -668,7 +668,7 @@ bool See3CAM_CU130::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -688,7 +688,7 @@ bool See3CAM_CU130::setFrameRateCtrlValue(uint frameRate)
 bool See3CAM_CU130::getFrameRateCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -724,7 +724,7 @@ bool See3CAM_CU130::getFrameRateCtrlValue()
  */
 bool See3CAM_CU130::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -752,7 +752,7 @@ bool See3CAM_CU130::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDa
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT_CU130; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -771,7 +771,7 @@ bool See3CAM_CU130::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDa
 bool See3CAM_CU130::getFaceDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -806,7 +806,7 @@ bool See3CAM_CU130::getFaceDetectMode()
  */
 bool See3CAM_CU130::setSmileDetection(bool enableSmileDetect, bool embedData){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -830,7 +830,7 @@ bool See3CAM_CU130::setSmileDetection(bool enableSmileDetect, bool embedData){
 
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
@@ -849,7 +849,7 @@ bool See3CAM_CU130::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool See3CAM_CU130::getSmileDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -883,7 +883,7 @@ bool See3CAM_CU130::getSmileDetectMode()
 bool See3CAM_CU130::enableDisableFaceRectangle(bool enableFaceRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -900,7 +900,7 @@ bool See3CAM_CU130::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_CU130; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU130 &&
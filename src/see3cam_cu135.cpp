@@ -32,7 +32,7 @@ See3CAM_CU135::See3CAM_CU135(QObject *parent) :
 bool See3CAM_CU135::setEffectMode(const specialEffects &specialEffect)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -46,7 +46,7 @@ bool See3CAM_CU135::setEffectMode(const specialEffects &specialEffect)
     g_out_packet_buf[3] = specialEffect; /* set special effect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -66,7 +66,7 @@ bool See3CAM_CU135::setEffectMode(const specialEffects &specialEffect)
 bool See3CAM_CU135::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -101,7 +101,7 @@ bool See3CAM_CU135::getEffectMode()
 bool See3CAM_CU135::setSceneMode(const sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -115,7 +115,7 @@ bool See3CAM_CU135::setSceneMode(const sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -134,7 +134,7 @@ bool See3CAM_CU135::setSceneMode(const sceneModes &sceneMode)
 bool See3CAM_CU135::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -169,7 +169,7 @@ bool See3CAM_CU135::getSceneMode()
 bool See3CAM_CU135::setDenoiseValue(uint deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -183,7 +183,7 @@ bool See3CAM_CU135::setDenoiseValue(uint deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -203,7 +203,7 @@ bool See3CAM_CU135::setDenoiseValue(uint deNoiseVal)
 bool See3CAM_CU135::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -238,7 +238,7 @@ bool See3CAM_CU135::getDenoiseValue()
 bool See3CAM_CU135::setQFactor(uint qFactor){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -252,7 +252,7 @@ bool See3CAM_CU135::setQFactor(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -272,7 +272,7 @@ bool See3CAM_CU135::setQFactor(uint qFactor){
 bool See3CAM_CU135::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -308,7 +308,7 @@ bool See3CAM_CU135::getQFactor()
 bool See3CAM_CU135::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -324,7 +324,7 @@ bool See3CAM_CU135::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
         g_out_packet_buf[4] = iHDRValue;
     }
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -343,7 +343,7 @@ bool See3CAM_CU135::setiHDRMode(camiHDRMode iHDRMode, uint iHDRValue){
 bool See3CAM_CU135::getiHDRMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -377,7 +377,7 @@ bool See3CAM_CU135::getiHDRMode()
 bool See3CAM_CU135::setStreamMode(camStreamMode streamMode){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -391,7 +391,7 @@ bool See3CAM_CU135::setStreamMode(camStreamMode streamMode){
     g_out_packet_buf[3] = streamMode; /* actual stream mode */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -411,7 +411,7 @@ bool See3CAM_CU135::setStreamMode(camStreamMode streamMode){
 bool See3CAM_CU135::getStreamMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -443,7 +443,7 @@ bool See3CAM_CU135::getStreamMode()
 bool See3CAM_CU135::setOrientation(bool horzModeSel, bool vertiModeSel)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -464,7 +464,7 @@ bool See3CAM_CU135::setOrientation(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SetBothFlipDisable; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -483,7 +483,7 @@ bool See3CAM_CU135::setOrientation(bool horzModeSel, bool vertiModeSel)
 bool See3CAM_CU135::getOrientation()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -517,7 +517,7 @@ bool See3CAM_CU135::getOrientation()
  */
 bool See3CAM_CU135::setBurstLength(uint burstLength){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -531,7 +531,7 @@ bool See3CAM_CU135::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -550,7 +550,7 @@ bool See3CAM_CU135::setBurstLength(uint burstLength){
 bool See3CAM_CU135::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -590,7 +590,7 @@ bool See3CAM_CU135::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode,
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -624,7 +624,7 @@ bool See3CAM_CU135::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode,
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -643,7 +643,7 @@ bool See3CAM_CU135::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode,
  */
 bool See3CAM_CU135::getAutoExpROIModeAndWindowSize(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -682,7 +682,7 @@ bool See3CAM_CU135::setExposureCompensation(unsigned int exposureCompValue){
     }
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -699,7 +699,7 @@ bool See3CAM_CU135::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -720,7 +720,7 @@ bool See3CAM_CU135::setExposureCompensation(unsigned int exposureCompValue){
  */
 bool See3CAM_CU135::getExposureCompensation(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -760,7 +760,7 @@ bool See3CAM_CU135::getExposureCompensation(){
 bool See3CAM_CU135::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -774,7 +774,7 @@ bool See3CAM_CU135::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -794,7 +794,7 @@ bool See3CAM_CU135::setFrameRateCtrlValue(uint frameRate)
 bool See3CAM_CU135::getFrameRateCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -829,7 +829,7 @@ bool See3CAM_CU135::getFrameRateCtrlValue()
  */
 bool See3CAM_CU135::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -857,7 +857,7 @@ bool See3CAM_CU135::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDa
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT_CU135; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -876,7 +876,7 @@ bool See3CAM_CU135::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDa
 bool See3CAM_CU135::getFaceDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -911,7 +911,7 @@ bool See3CAM_CU135::getFaceDetectMode()
  */
 bool See3CAM_CU135::setSmileDetection(bool enableSmileDetect, bool embedData){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -934,7 +934,7 @@ bool See3CAM_CU135::setSmileDetection(bool enableSmileDetect, bool embedData){
         g_out_packet_buf[5] = DISABLE_EMBED_DATA_CU135; /* disable embed data */
    
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -953,7 +953,7 @@ bool See3CAM_CU135::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool See3CAM_CU135::getSmileDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -988,7 +988,7 @@ bool See3CAM_CU135::getSmileDetectMode()
 
 bool See3CAM_CU135::setFlickerDetection(camFlickerMode flickerMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1002,7 +1002,7 @@ bool See3CAM_CU135::setFlickerDetection(camFlickerMode flickerMode){
     g_out_packet_buf[3] = flickerMode; /* flicker detection mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
@@ -1022,7 +1022,7 @@ bool See3CAM_CU135::setFlickerDetection(camFlickerMode flickerMode){
 bool See3CAM_CU135::getFlickerDetection()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1055,7 +1055,7 @@ bool See3CAM_CU135::getFlickerDetection()
 bool See3CAM_CU135::setToDefault(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1090,7 +1090,7 @@ bool See3CAM_CU135::setToDefault(){
 bool See3CAM_CU135::enableDisableFaceRectangle(bool enableFaceRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1107,7 +1107,7 @@ bool See3CAM_CU135::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_CU135; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU135 &&
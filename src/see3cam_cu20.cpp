@@ -30,7 +30,7 @@
 bool See3CAM_CU20::setSensorMode(sensorModes  sensorMode)
 {    
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {        
         return false;
     }
@@ -44,7 +44,7 @@ bool See3CAM_CU20::setSensorMode(sensorModes  sensorMode)
     g_out_packet_buf[3] = sensorMode; /* pass camera mode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){        
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){        
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -63,7 +63,7 @@ bool See3CAM_CU20::setSensorMode(sensorModes  sensorMode)
 bool See3CAM_CU20::getSensorMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -97,7 +97,7 @@ bool See3CAM_CU20::getSensorMode()
 bool See3CAM_CU20::setCameraMode(cameraModes  cameraMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {        
         return false;
     }
@@ -111,7 +111,7 @@ bool See3CAM_CU20::setCameraMode(cameraModes  cameraMode)
     g_out_packet_buf[3] = cameraMode; /* pass camera mode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {	    
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -130,7 +130,7 @@ bool See3CAM_CU20::setCameraMode(cameraModes  cameraMode)
 bool See3CAM_CU20::getCameraMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -164,7 +164,7 @@ bool See3CAM_CU20::getCameraMode()
 bool See3CAM_CU20::setSpecialMode(specialModes  specialMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -178,7 +178,7 @@ bool See3CAM_CU20::setSpecialMode(specialModes  specialMode)
     g_out_packet_buf[3] = specialMode; /* pass special mode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -197,7 +197,7 @@ bool See3CAM_CU20::setSpecialMode(specialModes  specialMode)
 bool See3CAM_CU20::getSpecialMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -231,7 +231,7 @@ bool See3CAM_CU20::getSpecialMode()
 bool See3CAM_CU20::setExposureCompensation(unsigned int exposureCompValue){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -245,7 +245,7 @@ bool See3CAM_CU20::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[3] = exposureCompValue;
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -264,7 +264,7 @@ bool See3CAM_CU20::setExposureCompensation(unsigned int exposureCompValue){
 bool See3CAM_CU20::getExposureCompensation(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -299,7 +299,7 @@ bool See3CAM_CU20::getExposureCompensation(){
 bool See3CAM_CU20::setOrientation(bool horzModeSel, bool vertiModeSel)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {        
         return false;
     }
@@ -321,7 +321,7 @@ bool See3CAM_CU20::setOrientation(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SetBothFlipDisable; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -340,7 +340,7 @@ bool See3CAM_CU20::setOrientation(bool horzModeSel, bool vertiModeSel)
 bool See3CAM_CU20::getOrientation()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {        
         return false;
     }
@@ -374,7 +374,7 @@ bool See3CAM_CU20::getOrientation()
  */
 bool See3CAM_CU20::setStrobeMode(strobeValues strobeMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -388,7 +388,7 @@ bool See3CAM_CU20::setStrobeMode(strobeValues strobeMode){
     g_out_packet_buf[3] = strobeMode; /* pass strobe mode value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){        
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){        
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -407,7 +407,7 @@ bool See3CAM_CU20::setStrobeMode(strobeValues strobeMode){
 bool See3CAM_CU20::getStrobeMode(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -445,7 +445,7 @@ bool See3CAM_CU20::getStrobeMode(){
  */
 bool See3CAM_CU20::setROIAutoExposure(uint see3camAeROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize){
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -475,7 +475,7 @@ bool See3CAM_CU20::setROIAutoExposure(uint see3camAeROIMode, uint vidResolnWidth
         g_out_packet_buf[6] = winSize.toUInt(); // window size
     }
 
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -493,7 +493,7 @@ bool See3CAM_CU20::setROIAutoExposure(uint see3camAeROIMode, uint vidResolnWidth
  * @return true/false
  */
 bool See3CAM_CU20::getAutoExpROIModeAndWindowSize(){
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -528,7 +528,7 @@ bool See3CAM_CU20::getAutoExpROIModeAndWindowSize(){
  */
 bool See3CAM_CU20::setColourKill(uint colourKillValue){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -542,7 +542,7 @@ bool See3CAM_CU20::setColourKill(uint colourKillValue){
     g_out_packet_buf[3] = colourKillValue; /* pass colour kill status value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -561,7 +561,7 @@ bool See3CAM_CU20::setColourKill(uint colourKillValue){
 bool See3CAM_CU20::getColourKill(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -594,7 +594,7 @@ bool See3CAM_CU20::getColourKill(){
  */
 bool See3CAM_CU20::setBurstLength(uint burstLength){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -608,7 +608,7 @@ bool See3CAM_CU20::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* set burst length value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -626,7 +626,7 @@ bool See3CAM_CU20::setBurstLength(uint burstLength){
  */
 bool See3CAM_CU20::getBurstLength(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -659,7 +659,7 @@ bool See3CAM_CU20::getBurstLength(){
  */
 bool See3CAM_CU20::setAntiFlickerMode(camAntiFlickerMode antiFlickerMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -672,7 +672,7 @@ bool See3CAM_CU20::setAntiFlickerMode(camAntiFlickerMode antiFlickerMode){
     g_out_packet_buf[2] = SET_ANTIFLICKER_CU20; /* set anti flicker command  */
     g_out_packet_buf[3] = antiFlickerMode; /* anti flicker mode to set */    
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -690,7 +690,7 @@ bool See3CAM_CU20::setAntiFlickerMode(camAntiFlickerMode antiFlickerMode){
  */
 bool See3CAM_CU20::getAntiFlickerMode(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -722,7 +722,7 @@ bool See3CAM_CU20::getAntiFlickerMode(){
  */
 bool See3CAM_CU20::setToDefaultValues(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -756,7 +756,7 @@ bool See3CAM_CU20::setToDefaultValues(){
 bool See3CAM_CU20::setDenoiseCtrlMode(denoiseModes  deNoiseMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {        
         return false;
     }
@@ -770,7 +770,7 @@ bool See3CAM_CU20::setDenoiseCtrlMode(denoiseModes  deNoiseMode)
     g_out_packet_buf[3] = deNoiseMode; /* pass denoise mode value */   
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){        
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){        
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -789,7 +789,7 @@ bool See3CAM_CU20::setDenoiseCtrlMode(denoiseModes  deNoiseMode)
 bool See3CAM_CU20::getDenoiseCtrlMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -822,7 +822,7 @@ bool See3CAM_CU20::getDenoiseCtrlMode()
  */
 bool See3CAM_CU20::setLSCMode(uint lscMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -836,7 +836,7 @@ bool See3CAM_CU20::setLSCMode(uint lscMode){
     g_out_packet_buf[3] = lscMode; /* LSC Mode value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){        
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){        
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU20 &&
@@ -855,7 +855,7 @@ bool See3CAM_CU20::setLSCMode(uint lscMode){
 bool See3CAM_CU20::getLSCMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
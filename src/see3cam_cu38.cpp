@@ -33,7 +33,7 @@ bool See3CAM_CU38::setEffectMode(const specialEffects &specialEffect)
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -47,7 +47,7 @@ bool See3CAM_CU38::setEffectMode(const specialEffects &specialEffect)
     g_out_packet_buf[3] = specialEffect; /* set special effect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -67,7 +67,7 @@ bool See3CAM_CU38::setEffectMode(const specialEffects &specialEffect)
 bool See3CAM_CU38::setDenoiseValue(int deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -81,7 +81,7 @@ bool See3CAM_CU38::setDenoiseValue(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -100,7 +100,7 @@ bool See3CAM_CU38::setDenoiseValue(int deNoiseVal)
 bool See3CAM_CU38::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -133,7 +133,7 @@ bool See3CAM_CU38::getEffectMode()
 bool See3CAM_CU38::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -166,7 +166,7 @@ bool See3CAM_CU38::getDenoiseValue()
 bool See3CAM_CU38::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -200,7 +200,7 @@ bool See3CAM_CU38::getSceneMode()
 bool See3CAM_CU38::setSceneMode(const sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -214,7 +214,7 @@ bool See3CAM_CU38::setSceneMode(const sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -239,7 +239,7 @@ bool See3CAM_CU38::setSceneMode(const sceneModes &sceneMode)
 bool See3CAM_CU38::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -273,7 +273,7 @@ bool See3CAM_CU38::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -293,7 +293,7 @@ bool See3CAM_CU38::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
 bool See3CAM_CU38::getAutoExpROIModeAndWindowSize(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -327,7 +327,7 @@ bool See3CAM_CU38::getAutoExpROIModeAndWindowSize(){
 bool See3CAM_CU38::setBurstLength(uint burstLength){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -341,7 +341,7 @@ bool See3CAM_CU38::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -360,7 +360,7 @@ bool See3CAM_CU38::setBurstLength(uint burstLength){
 bool See3CAM_CU38::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -393,7 +393,7 @@ bool See3CAM_CU38::getBurstLength()
  */
 bool See3CAM_CU38::setQFactor(uint qFactor){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -407,7 +407,7 @@ bool See3CAM_CU38::setQFactor(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -426,7 +426,7 @@ bool See3CAM_CU38::setQFactor(uint qFactor){
 bool See3CAM_CU38::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -459,7 +459,7 @@ bool See3CAM_CU38::getQFactor()
 bool See3CAM_CU38::setOrientation(bool horzModeSel, bool vertiModeSel)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -480,7 +480,7 @@ bool See3CAM_CU38::setOrientation(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SET_ORIENTATION_BOTHFLIP_DISABLE_CU38; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -502,7 +502,7 @@ bool See3CAM_CU38::setOrientation(bool horzModeSel, bool vertiModeSel)
 bool See3CAM_CU38::getOrientation()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -537,7 +537,7 @@ bool See3CAM_CU38::getOrientation()
 bool See3CAM_CU38::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -551,7 +551,7 @@ bool See3CAM_CU38::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -570,7 +570,7 @@ bool See3CAM_CU38::setFrameRateCtrlValue(uint frameRate)
 bool See3CAM_CU38::getFrameRateCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -609,7 +609,7 @@ bool See3CAM_CU38::setExposureCompensation(unsigned int exposureCompValue){
     }
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -626,7 +626,7 @@ bool See3CAM_CU38::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -647,7 +647,7 @@ bool See3CAM_CU38::setExposureCompensation(unsigned int exposureCompValue){
  */
 bool See3CAM_CU38::getExposureCompensation(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -689,7 +689,7 @@ bool See3CAM_CU38::getExposureCompensation(){
 bool See3CAM_CU38::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -717,7 +717,7 @@ bool See3CAM_CU38::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT_CU38; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -736,7 +736,7 @@ bool See3CAM_CU38::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
 bool See3CAM_CU38::getFaceDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -770,7 +770,7 @@ bool See3CAM_CU38::getFaceDetectMode()
  */
 bool See3CAM_CU38::setSmileDetection(bool enableSmileDetect, bool embedData){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -793,7 +793,7 @@ bool See3CAM_CU38::setSmileDetection(bool enableSmileDetect, bool embedData){
         g_out_packet_buf[5] = DISABLE_EMBED_DATA_CU38; /* disable embed data */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -813,7 +813,7 @@ bool See3CAM_CU38::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool See3CAM_CU38::getSmileDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -847,7 +847,7 @@ bool See3CAM_CU38::getSmileDetectMode()
 bool See3CAM_CU38::setToDefault(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -882,7 +882,7 @@ bool See3CAM_CU38::setToDefault(){
 bool See3CAM_CU38::enableDisableFaceRectangle(bool enableFaceRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -899,7 +899,7 @@ bool See3CAM_CU38::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_CU38; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -917,7 +917,7 @@ bool See3CAM_CU38::enableDisableFaceRectangle(bool enableFaceRect){
  */
 bool See3CAM_CU38::setFlashState(flashStateValues flashMode)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -929,7 +929,7 @@ bool See3CAM_CU38::setFlashState(flashStateValues flashMode)
     g_out_packet_buf[2] = SETFLASH_STATUS_CU38; /* set flash status command code */
     g_out_packet_buf[3] = flashMode; /* set flash state [off/torch/storbe] */
 
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU38 &&
@@ -948,7 +948,7 @@ bool See3CAM_CU38::setFlashState(flashStateValues flashMode)
  */
 bool See3CAM_CU38::getFlashState()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
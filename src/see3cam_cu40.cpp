@@ -31,7 +31,7 @@ See3CAM_CU40::See3CAM_CU40(QObject *parent) :
  */
 bool See3CAM_CU40::setFlashState(const flashStateValues &flashMode)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -46,7 +46,7 @@ bool See3CAM_CU40::setFlashState(const flashStateValues &flashMode)
     g_out_packet_buf[2] = SETFLASH_STATUS_CU40; /* set flash status command code */
     g_out_packet_buf[3] = flashMode; /* set flash state [off/torch/storbe] */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
     if (ret < 0) {
         perror("write");
@@ -60,7 +60,7 @@ bool See3CAM_CU40::setFlashState(const flashStateValues &flashMode)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             perror("read");
         } else {
@@ -89,7 +89,7 @@ bool See3CAM_CU40::setFlashState(const flashStateValues &flashMode)
  */
 bool See3CAM_CU40::getFlashState()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -107,7 +107,7 @@ bool See3CAM_CU40::getFlashState()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU40; /* camera control id */
     g_out_packet_buf[2] = GETFLASH_STATUS_CU40; /* get strobe mode */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
     if (ret < 0) {
         perror("write");
@@ -120,7 +120,7 @@ bool See3CAM_CU40::getFlashState()
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
 
         if (ret < 0) {
             //perror("read");
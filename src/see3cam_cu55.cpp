@@ -33,7 +33,7 @@ bool See3CAM_CU55::setEffectMode(const specialEffects &specialEffect)
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -47,7 +47,7 @@ bool See3CAM_CU55::setEffectMode(const specialEffects &specialEffect)
     g_out_packet_buf[3] = specialEffect; /* set special effect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -67,7 +67,7 @@ bool See3CAM_CU55::setEffectMode(const specialEffects &specialEffect)
 bool See3CAM_CU55::setDenoiseValue(int deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -81,7 +81,7 @@ bool See3CAM_CU55::setDenoiseValue(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -100,7 +100,7 @@ bool See3CAM_CU55::setDenoiseValue(int deNoiseVal)
 bool See3CAM_CU55::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -112,18 +112,62 @@ bool See3CAM_CU55::getEffectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* set camera control code */
     g_out_packet_buf[2] = GET_SPECIAL_EFFECT; /* get special effect code */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_SPECIAL_EFFECT &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit sendEffectMode(g_in_packet_buf[2]);
-            return true;
-        }
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
+}
+
+/**
+ * @brief See3CAM_CU55::hidReply - reply of a get command queued with uvccamera::sendHidCmdAsync
+ * @param reply - report received from camera, matched to its command by camera id and command id
+ */
+void See3CAM_CU55::hidReply(QByteArray reply)
+{
+    const unsigned char *in = (const unsigned char *)reply.constData();
+
+    if (reply.size() < 7 || in[0] != CAMERA_CONTROL_CU55 || in[6] != GET_SUCCESS)
+        return;
+
+    switch (in[1]) {
+    case GET_SPECIAL_EFFECT:
+        emit sendEffectMode(in[2]);
+        break;
+    case GET_DENOISE_CONTROL:
+        emit sendDenoiseValue(in[2]);
+        break;
+    case GET_SCENEMODE_CU55:
+        emit sceneModeValue(in[2]);
+        break;
+    case GET_EXP_ROI_MODE_CU55:
+        emit roiAutoExpModeValue(in[2], in[5]);
+        break;
+    case GET_BURST_LENGTH_CU55:
+        emit burstLengthValue(in[2]);
+        break;
+    case GET_Q_FACTOR_CU55:
+        emit qFactorValue(in[2]);
+        break;
+    case GET_ORIENTATION_CU55:
+        emit flipMirrorModeChanged(in[2]);
+        break;
+    case GET_FRAME_RATE_CU55:
+        emit frameRateCtrlValueReceived(in[2]);
+        break;
+    case GET_EXPOSURE_COMPENSATION_CU55:
+        emit exposureCompValueReceived((uint)in[2] << 24 | in[3] << 16 | in[4] << 8 | in[5]);
+        break;
+    case GET_FACE_DETECT_RECT_CU55:
+        emit faceDetectModeValue(in[2], in[3], in[4]);
+        break;
+    case GET_SMILE_DETECTION_CU55:
+        emit smileDetectModeValue(in[2], in[4]);
+        break;
+    case GET_FLICKER_DETECTION:
+        emit flickerDetectionMode(in[2]);
+        break;
+    case GETFLASH_STATUS_CU55:
+        emit flashModeValue(in[2]);
+        break;
     }
-    return false;
 }
 
 /**
@@ -133,7 +177,7 @@ bool See3CAM_CU55::getEffectMode()
 bool See3CAM_CU55::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -145,18 +189,8 @@ bool See3CAM_CU55::getDenoiseValue()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* set camera control code */
     g_out_packet_buf[2] = GET_DENOISE_CONTROL; /* get denoise code */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_DENOISE_CONTROL &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit sendDenoiseValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -166,7 +200,7 @@ bool See3CAM_CU55::getDenoiseValue()
 bool See3CAM_CU55::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -178,18 +212,8 @@ bool See3CAM_CU55::getSceneMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* camera id */
     g_out_packet_buf[2] = GET_SCENEMODE_CU55; /* get scene mode command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_SCENEMODE_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit sceneModeValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -200,7 +224,7 @@ bool See3CAM_CU55::getSceneMode()
 bool See3CAM_CU55::setSceneMode(const sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -214,7 +238,7 @@ bool See3CAM_CU55::setSceneMode(const sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -239,7 +263,7 @@ bool See3CAM_CU55::setSceneMode(const sceneModes &sceneMode)
 bool See3CAM_CU55::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -273,7 +297,7 @@ bool See3CAM_CU55::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -290,10 +314,11 @@ bool See3CAM_CU55::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
  * @brief See3CAM_CU55::getAutoExpROIModeAndWindowSize - get ROI auto exposure mode and window size
  * return true - success /false - failure
  */
-bool See3CAM_CU55::getAutoExpROIModeAndWindowSize(){
+bool See3CAM_CU55::getAutoExpROIModeAndWindowSize()
+{
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -305,18 +330,8 @@ bool See3CAM_CU55::getAutoExpROIModeAndWindowSize(){
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* camera id */
     g_out_packet_buf[2] = GET_EXP_ROI_MODE_CU55; /* get exposure ROI mode  */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_EXP_ROI_MODE_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit roiAutoExpModeValue(g_in_packet_buf[2], g_in_packet_buf[5]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -327,7 +342,7 @@ bool See3CAM_CU55::getAutoExpROIModeAndWindowSize(){
 bool See3CAM_CU55::setBurstLength(uint burstLength){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -341,7 +356,7 @@ bool See3CAM_CU55::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -360,7 +375,7 @@ bool See3CAM_CU55::setBurstLength(uint burstLength){
 bool See3CAM_CU55::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -372,18 +387,8 @@ bool See3CAM_CU55::getBurstLength()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* camera id */
     g_out_packet_buf[2] = GET_BURST_LENGTH_CU55; /* get burst length mode  */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_BURST_LENGTH_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit burstLengthValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -393,7 +398,7 @@ bool See3CAM_CU55::getBurstLength()
  */
 bool See3CAM_CU55::setQFactor(uint qFactor){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -407,7 +412,7 @@ bool See3CAM_CU55::setQFactor(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -426,7 +431,7 @@ bool See3CAM_CU55::setQFactor(uint qFactor){
 bool See3CAM_CU55::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -438,18 +443,8 @@ bool See3CAM_CU55::getQFactor()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* camera id */
     g_out_packet_buf[2] = GET_Q_FACTOR_CU55; /* get qFactor value */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_Q_FACTOR_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit qFactorValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -459,7 +454,7 @@ bool See3CAM_CU55::getQFactor()
 bool See3CAM_CU55::setOrientation(bool horzModeSel, bool vertiModeSel)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -480,7 +475,7 @@ bool See3CAM_CU55::setOrientation(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SET_ORIENTATION_BOTHFLIP_DISABLE_CU55; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -502,7 +497,7 @@ bool See3CAM_CU55::setOrientation(bool horzModeSel, bool vertiModeSel)
 bool See3CAM_CU55::getOrientation()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -515,18 +510,8 @@ bool See3CAM_CU55::getOrientation()
     g_out_packet_buf[2] = GET_ORIENTATION_CU55; /* Get orientation command */
 
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_ORIENTATION_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit flipMirrorModeChanged(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -537,7 +522,7 @@ bool See3CAM_CU55::getOrientation()
 bool See3CAM_CU55::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -551,7 +536,7 @@ bool See3CAM_CU55::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -570,7 +555,7 @@ bool See3CAM_CU55::setFrameRateCtrlValue(uint frameRate)
 bool See3CAM_CU55::getFrameRateCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -582,18 +567,8 @@ bool See3CAM_CU55::getFrameRateCtrlValue()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* set camera control code */
     g_out_packet_buf[2] = GET_FRAME_RATE_CU55; /* get frame rate code */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_FRAME_RATE_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit frameRateCtrlValueReceived(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -609,7 +584,7 @@ bool See3CAM_CU55::setExposureCompensation(unsigned int exposureCompValue){
     }
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -626,7 +601,7 @@ bool See3CAM_CU55::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -645,9 +620,10 @@ bool See3CAM_CU55::setExposureCompensation(unsigned int exposureCompValue){
  * @brief See3CAM_130::getExposureCompensation - getting exposure compensation
  * @return true/false
  */
-bool See3CAM_CU55::getExposureCompensation(){
+bool See3CAM_CU55::getExposureCompensation()
+{
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -659,24 +635,9 @@ bool See3CAM_CU55::getExposureCompensation(){
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* set camera control code */
     g_out_packet_buf[2] = GET_EXPOSURE_COMPENSATION_CU55; /* get exposure compensation code */
 
-    unsigned int exposureCompValue;
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_EXPOSURE_COMPENSATION_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            exposureCompValue = (((u_int8_t)g_in_packet_buf[2]) << 24)
-                                | (((u_int8_t)g_in_packet_buf[3]) << 16)
-                                | (((u_int8_t)g_in_packet_buf[4]) << 8)
-                                | (((u_int8_t)g_in_packet_buf[5]) << 0);
-            emit exposureCompValueReceived(exposureCompValue);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
@@ -689,7 +650,7 @@ bool See3CAM_CU55::getExposureCompensation(){
 bool See3CAM_CU55::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -717,7 +678,7 @@ bool See3CAM_CU55::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT_CU55; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -736,7 +697,7 @@ bool See3CAM_CU55::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
 bool See3CAM_CU55::getFaceDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -748,18 +709,8 @@ bool See3CAM_CU55::getFaceDetectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* camera id */
     g_out_packet_buf[2] = GET_FACE_DETECT_RECT_CU55; /* get face detect mode command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_FACE_DETECT_RECT_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit faceDetectModeValue(g_in_packet_buf[2], g_in_packet_buf[3], g_in_packet_buf[4]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 
@@ -771,7 +722,7 @@ bool See3CAM_CU55::getFaceDetectMode()
  */
 bool See3CAM_CU55::setSmileDetection(bool enableSmileDetect, bool embedData){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -794,7 +745,7 @@ bool See3CAM_CU55::setSmileDetection(bool enableSmileDetect, bool embedData){
         g_out_packet_buf[5] = DISABLE_EMBED_DATA_CU55; /* disable embed data */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -814,7 +765,7 @@ bool See3CAM_CU55::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool See3CAM_CU55::getSmileDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -826,18 +777,8 @@ bool See3CAM_CU55::getSmileDetectMode()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* Camera control id */
     g_out_packet_buf[2] = GET_SMILE_DETECTION_CU55; /* Get smile detection */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_SMILE_DETECTION_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {\
-            emit smileDetectModeValue(g_in_packet_buf[2], g_in_packet_buf[4]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 // Added by Navya - 3rd June 2019
@@ -849,7 +790,7 @@ bool See3CAM_CU55::getSmileDetectMode()
 
 bool See3CAM_CU55::setFlickerDetection(camFlickerMode flickerMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -863,7 +804,7 @@ bool See3CAM_CU55::setFlickerDetection(camFlickerMode flickerMode){
     g_out_packet_buf[3] = flickerMode; /* flicker detection mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -883,7 +824,7 @@ bool See3CAM_CU55::setFlickerDetection(camFlickerMode flickerMode){
 bool See3CAM_CU55::getFlickerDetection()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -895,19 +836,10 @@ bool See3CAM_CU55::getFlickerDetection()
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* camera id */
     g_out_packet_buf[2] = GET_FLICKER_DETECTION; /* get flicker detection command */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GET_FLICKER_DETECTION &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit flickerDetectionMode(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
+
 /**
  * @brief See3CAM_CU55::setToDefault - set all the values to default in camera
  * @return true/false
@@ -915,7 +847,7 @@ bool See3CAM_CU55::getFlickerDetection()
 bool See3CAM_CU55::setToDefault(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -950,7 +882,7 @@ bool See3CAM_CU55::setToDefault(){
 bool See3CAM_CU55::enableDisableFaceRectangle(bool enableFaceRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -967,7 +899,7 @@ bool See3CAM_CU55::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_CU55; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -985,7 +917,7 @@ bool See3CAM_CU55::enableDisableFaceRectangle(bool enableFaceRect){
  */
 bool See3CAM_CU55::setFlashState(flashStateValues flashMode)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -997,7 +929,7 @@ bool See3CAM_CU55::setFlashState(flashStateValues flashMode)
     g_out_packet_buf[2] = SETFLASH_STATUS_CU55; /* set flash status command code */
     g_out_packet_buf[3] = flashMode; /* set flash state [off/torch/storbe] */
 
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
@@ -1016,31 +948,20 @@ bool See3CAM_CU55::setFlashState(flashStateValues flashMode)
  */
 bool See3CAM_CU55::getFlashState()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
 
     //Initialize the buffer
     memset(g_out_packet_buf, 0x00, sizeof(g_out_packet_buf));
-    memset(g_in_packet_buf, 0x00, sizeof(g_in_packet_buf));
 
     //Set the Report Number
     g_out_packet_buf[1] = CAMERA_CONTROL_CU55; /* camera control id */
     g_out_packet_buf[2] = GETFLASH_STATUS_CU55; /* get strobe mode */
 
-    // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
-        if (g_in_packet_buf[6]==GET_FAIL) {
-            return false;
-        } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU55 &&
-            g_in_packet_buf[1]==GETFLASH_STATUS_CU55 &&
-            g_in_packet_buf[6]==GET_SUCCESS) {
-            emit flashModeValue(g_in_packet_buf[2]);
-            return true;
-        }
-    }
-    return false;
+    // send request, reply is handled in hidReply
+    return uvc.sendHidCmdAsync(g_out_packet_buf, BUFFER_LENGTH, this, "hidReply");
 }
 
 /**
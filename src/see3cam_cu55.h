@@ -188,6 +188,10 @@ signals:
     void flickerDetectionMode(uint flickerMode);
 
 
+private slots:
+    // replies of the get commands, see uvccamera::sendHidCmdAsync
+    void hidReply(QByteArray reply);
+
 public slots:
     bool setEffectMode(const specialEffects &specialEffect);
     bool getEffectMode();
@@ -16,7 +16,7 @@ void See3CAM_CU55_MH::initializeBuffers(){
 bool See3CAM_CU55_MH ::setStreamMode(streamModes streamMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -49,7 +49,7 @@ bool See3CAM_CU55_MH::getStreamMode()
    uint streamMode;
 
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -80,7 +80,7 @@ bool See3CAM_CU55_MH::getStreamMode()
 bool See3CAM_CU55_MH ::setFlashMode(flashModes flashMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -111,7 +111,7 @@ bool See3CAM_CU55_MH::getFlashMode()
    uint flashMode;
 
    // hid validation
-   if(uvccamera::hid_fd < 0)
+   if(uvc.hidFd() < 0)
    {
        return false;
    }
@@ -141,7 +141,7 @@ bool See3CAM_CU55_MH::getFlashMode()
 bool See3CAM_CU55_MH::setRollCtrlValue(uint rollValue)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -155,7 +155,7 @@ bool See3CAM_CU55_MH::setRollCtrlValue(uint rollValue)
     g_out_packet_buf[3] = rollValue; /* set rollControl value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_SEE3CAM_CU55_MH &&
@@ -175,7 +175,7 @@ bool See3CAM_CU55_MH::setRollCtrlValue(uint rollValue)
 bool See3CAM_CU55_MH::getRollCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -204,7 +204,7 @@ bool See3CAM_CU55_MH::getRollCtrlValue()
 bool See3CAM_CU55_MH::setToDefault()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -68,7 +68,7 @@ void See3CAM_11CUG::setCroppedVGAMode()
 bool See3CAM_11CUG::enableCroppedVGAMode(u_int8_t *VGAStatus)
 {
     *VGAStatus = 0;
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -83,7 +83,7 @@ bool See3CAM_11CUG::enableCroppedVGAMode(u_int8_t *VGAStatus)
     //Set the Report Number
     g_out_packet_buf[1] = ENABLE_CROPPED_VGA_MODE; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
@@ -92,7 +92,7 @@ bool See3CAM_11CUG::enableCroppedVGAMode(u_int8_t *VGAStatus)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {     
@@ -115,7 +115,7 @@ bool See3CAM_11CUG::enableBinnedVGAMode(u_int8_t *VGAStatus)
 {
     *VGAStatus = 0;
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -130,7 +130,7 @@ bool See3CAM_11CUG::enableBinnedVGAMode(u_int8_t *VGAStatus)
     //Set the Report Number
     g_out_packet_buf[1] = ENABLE_BINNED_VGA_MODE; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
@@ -139,7 +139,7 @@ bool See3CAM_11CUG::enableBinnedVGAMode(u_int8_t *VGAStatus)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {        
@@ -194,7 +194,7 @@ void See3CAM_11CUG::setBinnedVGAMode()
 bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
 {
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -221,7 +221,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
             g_out_packet_buf[3] = rgbColor; /* Report Number */ //0x01 - WB_RED, 0x02 - WB_GREEN, 0x03- WB_BLUE
             g_out_packet_buf[4] = rgbValue; /* Report Number */
 
-            ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+            ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 perror("write");
                 return false;
@@ -230,7 +230,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
             while(timeout)
             {
                 /* Get a report from the device */
-                ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+                ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
                 if (ret < 0) {
                     //perror("read");
                 } else {                    
@@ -267,7 +267,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
 
     uint See3CAM_11CUG::getWbValues(camRGBcolor rgbColor)
     {
-        if(uvccamera::hid_fd < 0)
+        if(uvc.hidFd() < 0)
         {
             return 0;
         }
@@ -287,7 +287,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
             g_out_packet_buf[2] = GET_WB_GAIN; /* Report Number */
             g_out_packet_buf[3] = rgbColor; /* Report Number */
 
-            ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+            ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 perror("write");
                 emit deviceStatus("Failure",tr("Unable to get whitebalance values"));
@@ -296,7 +296,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
             while(timeout)
             {
                 /* Get a report from the device */
-                ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+                ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
                 if (ret < 0) {
                     //perror("read");
                 } else {                    
@@ -328,7 +328,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
 
     bool See3CAM_11CUG::defaultValues()
     {
-        if(uvccamera::hid_fd < 0)
+        if(uvc.hidFd() < 0)
         {
             return false;
         }
@@ -345,7 +345,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
         g_out_packet_buf[1] = WHITE_BAL_CONTROL; /* Report Number */
         g_out_packet_buf[2] = SET_WB_DEFAULTS; /* Report Number */
 
-        ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+        ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             perror("write");
             return false;
@@ -354,7 +354,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
         while(timeout)
         {
             /* Get a report from the device */
-            ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+            ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 //perror("read");
             } else {                
@@ -384,7 +384,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
 
     bool See3CAM_11CUG::setWbMode(camRGBmode rgbMode)
     {
-        if(uvccamera::hid_fd < 0)
+        if(uvc.hidFd() < 0)
         {
             return false;
         }
@@ -403,7 +403,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
         g_out_packet_buf[2] = SET_WB_MODE; /* Report Number */
         g_out_packet_buf[3] = rgbMode; /* Report Number */
 
-        ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+        ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             perror("write");
             return false;
@@ -412,7 +412,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
         while(timeout)
         {
             /* Get a report from the device */
-            ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+            ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 //perror("read");
             } else {                
@@ -443,7 +443,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
 
     bool See3CAM_11CUG::getWbMode()
     {
-        if(uvccamera::hid_fd < 0)
+        if(uvc.hidFd() < 0)
         {
             return false;
         }
@@ -459,7 +459,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
         g_out_packet_buf[1] = WHITE_BAL_CONTROL; /* Report Number */
         g_out_packet_buf[2] = GET_WB_MODE; /* Report Number */
 
-        ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+        ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             perror("write");
             return false;
@@ -468,7 +468,7 @@ bool See3CAM_11CUG::setWbValues(camRGBcolor rgbColor, uint rgbValue)
         while(timeout)
         {
             /* Get a report from the device */
-            ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+            ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 //perror("read");
             } else {                
@@ -83,7 +83,7 @@ void See3CAM_AR130::setCroppedVGAMode()
 bool See3CAM_AR130::enableCroppedVGAMode(u_int8_t *VGAStatus)
 {
     *VGAStatus = 0;
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -98,7 +98,7 @@ bool See3CAM_AR130::enableCroppedVGAMode(u_int8_t *VGAStatus)
     //Set the Report Number
     g_out_packet_buf[1] = ENABLE_CROPPED_VGA_MODE; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
@@ -107,7 +107,7 @@ bool See3CAM_AR130::enableCroppedVGAMode(u_int8_t *VGAStatus)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -130,7 +130,7 @@ bool See3CAM_AR130::enableBinnedVGAMode(u_int8_t *VGAStatus)
 {
     *VGAStatus = 0;
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -145,7 +145,7 @@ bool See3CAM_AR130::enableBinnedVGAMode(u_int8_t *VGAStatus)
     //Set the Report Number
     g_out_packet_buf[1] = ENABLE_BINNED_VGA_MODE; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
@@ -154,7 +154,7 @@ bool See3CAM_AR130::enableBinnedVGAMode(u_int8_t *VGAStatus)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
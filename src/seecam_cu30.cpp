@@ -33,7 +33,7 @@ bool See3CAM_CU30::setEffectMode(const specialEffects &specialEffect)
 {
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -47,7 +47,7 @@ bool See3CAM_CU30::setEffectMode(const specialEffects &specialEffect)
     g_out_packet_buf[3] = specialEffect; /* set special effect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -67,7 +67,7 @@ bool See3CAM_CU30::setEffectMode(const specialEffects &specialEffect)
 bool See3CAM_CU30::setDenoiseValue(int deNoiseVal)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -81,7 +81,7 @@ bool See3CAM_CU30::setDenoiseValue(int deNoiseVal)
     g_out_packet_buf[3] = deNoiseVal; /* set denoise value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -100,7 +100,7 @@ bool See3CAM_CU30::setDenoiseValue(int deNoiseVal)
 bool See3CAM_CU30::getEffectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -133,7 +133,7 @@ bool See3CAM_CU30::getEffectMode()
 bool See3CAM_CU30::getDenoiseValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -166,7 +166,7 @@ bool See3CAM_CU30::getDenoiseValue()
 bool See3CAM_CU30::getSceneMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -200,7 +200,7 @@ bool See3CAM_CU30::getSceneMode()
 bool See3CAM_CU30::setSceneMode(const sceneModes &sceneMode)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -214,7 +214,7 @@ bool See3CAM_CU30::setSceneMode(const sceneModes &sceneMode)
     g_out_packet_buf[3] = sceneMode; /* Scene mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -239,7 +239,7 @@ bool See3CAM_CU30::setSceneMode(const sceneModes &sceneMode)
 bool See3CAM_CU30::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, uint vidResolnWidth, uint vidResolnHeight, uint xCord, uint yCord, QString winSize)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -273,7 +273,7 @@ bool See3CAM_CU30::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
     }
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -293,7 +293,7 @@ bool See3CAM_CU30::setROIAutoExposure(camROIAutoExpMode see3camAutoexpROIMode, u
 bool See3CAM_CU30::getAutoExpROIModeAndWindowSize(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -327,7 +327,7 @@ bool See3CAM_CU30::getAutoExpROIModeAndWindowSize(){
 bool See3CAM_CU30::setBurstLength(uint burstLength){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -341,7 +341,7 @@ bool See3CAM_CU30::setBurstLength(uint burstLength){
     g_out_packet_buf[3] = burstLength; /* burst length value to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -360,7 +360,7 @@ bool See3CAM_CU30::setBurstLength(uint burstLength){
 bool See3CAM_CU30::getBurstLength()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -393,7 +393,7 @@ bool See3CAM_CU30::getBurstLength()
  */
 bool See3CAM_CU30::setQFactor(uint qFactor){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -407,7 +407,7 @@ bool See3CAM_CU30::setQFactor(uint qFactor){
     g_out_packet_buf[3] = qFactor; /* qfactor value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -426,7 +426,7 @@ bool See3CAM_CU30::setQFactor(uint qFactor){
 bool See3CAM_CU30::getQFactor()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -459,7 +459,7 @@ bool See3CAM_CU30::getQFactor()
 bool See3CAM_CU30::setOrientation(bool horzModeSel, bool vertiModeSel)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -480,7 +480,7 @@ bool See3CAM_CU30::setOrientation(bool horzModeSel, bool vertiModeSel)
         g_out_packet_buf[3] = SET_ORIENTATION_BOTHFLIP_DISABLE_CU30; /* both flip disable */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -502,7 +502,7 @@ bool See3CAM_CU30::setOrientation(bool horzModeSel, bool vertiModeSel)
 bool See3CAM_CU30::getOrientation()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -537,7 +537,7 @@ bool See3CAM_CU30::getOrientation()
 bool See3CAM_CU30::setFrameRateCtrlValue(uint frameRate)
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -551,7 +551,7 @@ bool See3CAM_CU30::setFrameRateCtrlValue(uint frameRate)
     g_out_packet_buf[3] = frameRate; /* set framerate value */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -570,7 +570,7 @@ bool See3CAM_CU30::setFrameRateCtrlValue(uint frameRate)
 bool See3CAM_CU30::getFrameRateCtrlValue()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -609,7 +609,7 @@ bool See3CAM_CU30::setExposureCompensation(unsigned int exposureCompValue){
     }
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -626,7 +626,7 @@ bool See3CAM_CU30::setExposureCompensation(unsigned int exposureCompValue){
     g_out_packet_buf[6] = (u_int8_t)((exposureCompValue & 0x000000FF) >> 0);
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             emit indicateCommandStatus("Failure", "Failed to set exposure compensation value");
             return false;
@@ -647,7 +647,7 @@ bool See3CAM_CU30::setExposureCompensation(unsigned int exposureCompValue){
  */
 bool See3CAM_CU30::getExposureCompensation(){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -689,7 +689,7 @@ bool See3CAM_CU30::getExposureCompensation(){
 bool See3CAM_CU30::setFaceDetectionRect(bool enableFaceDetectRect, bool embedData, bool overlayRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -717,7 +717,7 @@ bool See3CAM_CU30::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
         g_out_packet_buf[5] = DISABLE_OVERLAY_RECT_CU30; /* disable overlay rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -736,7 +736,7 @@ bool See3CAM_CU30::setFaceDetectionRect(bool enableFaceDetectRect, bool embedDat
 bool See3CAM_CU30::getFaceDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -771,7 +771,7 @@ bool See3CAM_CU30::getFaceDetectMode()
  */
 bool See3CAM_CU30::setSmileDetection(bool enableSmileDetect, bool embedData){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -794,7 +794,7 @@ bool See3CAM_CU30::setSmileDetection(bool enableSmileDetect, bool embedData){
         g_out_packet_buf[5] = DISABLE_EMBED_DATA_CU30; /* disable embed data */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -814,7 +814,7 @@ bool See3CAM_CU30::setSmileDetection(bool enableSmileDetect, bool embedData){
 bool See3CAM_CU30::getSmileDetectMode()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -849,7 +849,7 @@ bool See3CAM_CU30::getSmileDetectMode()
 
 bool See3CAM_CU30::setFlickerDetection(camFlickerMode flickerMode){
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -863,7 +863,7 @@ bool See3CAM_CU30::setFlickerDetection(camFlickerMode flickerMode){
     g_out_packet_buf[3] = flickerMode; /* flicker detection mode to set */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -884,7 +884,7 @@ bool See3CAM_CU30::setFlickerDetection(camFlickerMode flickerMode){
 bool See3CAM_CU30::getFlickerDetection()
 {
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -916,7 +916,7 @@ bool See3CAM_CU30::getFlickerDetection()
 bool See3CAM_CU30::setToDefault(){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -951,7 +951,7 @@ bool See3CAM_CU30::setToDefault(){
 bool See3CAM_CU30::enableDisableFaceRectangle(bool enableFaceRect){
 
     // hid validation
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -968,7 +968,7 @@ bool See3CAM_CU30::enableDisableFaceRectangle(bool enableFaceRect){
         g_out_packet_buf[3] = DISABLE_FACE_RECTANGLE_CU30; /* disable auto focus rect */
 
     // send request and get reply from camera
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -986,7 +986,7 @@ bool See3CAM_CU30::enableDisableFaceRectangle(bool enableFaceRect){
  */
 bool See3CAM_CU30::setFlashState(flashStateValues flashMode)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -998,7 +998,7 @@ bool See3CAM_CU30::setFlashState(flashStateValues flashMode)
     g_out_packet_buf[2] = SETFLASH_STATUS_CU30; /* set flash status command code */
     g_out_packet_buf[3] = flashMode; /* set flash state [off/torch/storbe] */
 
-    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH)){
+    if(uvc.sendHidCmd(g_out_packet_buf, g_in_packet_buf, BUFFER_LENGTH, HID_SETTING)){
         if (g_in_packet_buf[6]==SET_FAIL) {
             return false;
         } else if(g_in_packet_buf[0] == CAMERA_CONTROL_CU30 &&
@@ -1017,7 +1017,7 @@ bool See3CAM_CU30::setFlashState(flashStateValues flashMode)
  */
 bool See3CAM_CU30::getFlashState()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
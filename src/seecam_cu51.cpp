@@ -42,7 +42,7 @@ void See3CAM_CU51::getTorchLevel() {
 
 void See3CAM_CU51::getExposure()
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
        {
            return void();
        }
@@ -60,7 +60,7 @@ void See3CAM_CU51::getExposure()
         g_out_packet_buf[2] = GET_EXPOSURE_VALUE; 	/* Report Number */
 
         /* Send a Report to the Device */
-        ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+        ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
                     perror("write");
 
@@ -72,7 +72,7 @@ void See3CAM_CU51::getExposure()
         while(timeout)
         {
             /* Get a report from the device */
-            ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+            ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 //perror("read");
             } else {                
@@ -100,7 +100,7 @@ void See3CAM_CU51::getExposure()
 
 void See3CAM_CU51::setExposure(const uint &exposureValue)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
        {
            return void();
        }    
@@ -120,7 +120,7 @@ void See3CAM_CU51::setExposure(const uint &exposureValue)
         g_out_packet_buf[4] = exposureValue>>8; 	/* MSB of exposure value */
 
         /* Send a Report to the Device */
-        ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+        ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
                   perror("write");
                   return void();
@@ -133,7 +133,7 @@ void See3CAM_CU51::setExposure(const uint &exposureValue)
         while(timeout)
         {
             /* Get a report from the device */
-            ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+            ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 //perror("read");
             } else {                
@@ -36,7 +36,7 @@ void See3CAM_80::getTorchLevel() {
 
 void See3CAM_80::getFocusPosition() {
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return void();
     }
@@ -52,7 +52,7 @@ void See3CAM_80::getFocusPosition() {
     //Set the Report Number
     g_out_packet_buf[1] = CAMERA_CONTROL_80; /* Report Number */
     g_out_packet_buf[2] = GET_FOCUS_POSITION; /* Report Number */
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
     if (ret < 0) {
         perror("write");
@@ -63,7 +63,7 @@ void See3CAM_80::getFocusPosition() {
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -88,7 +88,7 @@ void See3CAM_80::getFocusPosition() {
 
 void See3CAM_80::getFocusMode() {
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return void();
     }
@@ -104,7 +104,7 @@ void See3CAM_80::getFocusMode() {
     g_out_packet_buf[1] = CAMERA_CONTROL_80; /* Report Number */
     g_out_packet_buf[2] = GET_FOCUS_MODE; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
     if (ret < 0) {
         perror("write");
@@ -115,7 +115,7 @@ void See3CAM_80::getFocusMode() {
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -135,7 +135,7 @@ void See3CAM_80::getFocusMode() {
 
 void See3CAM_80::setFocusMode(camFocusmode focusMode)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return void();
     }
@@ -154,7 +154,7 @@ void See3CAM_80::setFocusMode(camFocusmode focusMode)
     g_out_packet_buf[2] = SET_FOCUS_MODE; /* Report Number */
     g_out_packet_buf[3] = focusMode; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
     if (ret < 0) {
         perror("write");
@@ -166,7 +166,7 @@ void See3CAM_80::setFocusMode(camFocusmode focusMode)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -193,7 +193,7 @@ void See3CAM_80::setFocusMode(camFocusmode focusMode)
 
 void See3CAM_80::setFocusPosition(int focusPosition)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return void();
     }
@@ -207,7 +207,7 @@ void See3CAM_80::setFocusPosition(int focusPosition)
     g_out_packet_buf[2] = SET_FOCUS_POSITION; /* Report Number */
     g_out_packet_buf[3] = ((focusPosition&0xFF00)>>8); /* MSB of focus postion */
     g_out_packet_buf[4] = (focusPosition&0x00FF); /* LSB of focus postion */
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
     if (ret < 0) {
         perror("write");
@@ -0,0 +1,122 @@
+/*
+ * settledetector.cpp -- exposure/white balance convergence from frame statistics
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "settledetector.h"
+
+SettleDetector::SettleDetector()
+{
+    reset();
+}
+
+void SettleDetector::reset()
+{
+    m_frames = 0;
+    m_changed = false;
+    m_settled = false;
+}
+
+void SettleDetector::addFrame(const FrameStats &stats)
+{
+    if (m_frames > 0) {
+        const FrameStats &last = m_window[(m_frames - 1) % SETTLE_WINDOW];
+        if (qAbs(stats.luma - last.luma) > SETTLE_LUMA_TOLERANCE ||
+            qAbs(stats.cb - last.cb) > SETTLE_CHROMA_TOLERANCE ||
+            qAbs(stats.cr - last.cr) > SETTLE_CHROMA_TOLERANCE)
+            m_changed = true;
+    }
+    m_window[m_frames % SETTLE_WINDOW] = stats;
+    m_frames++;
+    if (m_settled || m_frames < SETTLE_WINDOW)
+        return;
+    if (!m_changed && m_frames < SETTLE_MIN_FRAMES)
+        return;
+
+    FrameStats low = m_window[0], high = m_window[0];
+    for (int i = 1; i < SETTLE_WINDOW; i++) {
+        const FrameStats &s = m_window[i];
+        low.luma = qMin(low.luma, s.luma);      high.luma = qMax(high.luma, s.luma);
+        low.cb = qMin(low.cb, s.cb);            high.cb = qMax(high.cb, s.cb);
+        low.cr = qMin(low.cr, s.cr);            high.cr = qMax(high.cr, s.cr);
+    }
+    m_settled = high.luma - low.luma <= SETTLE_LUMA_TOLERANCE &&
+                high.cb - low.cb <= SETTLE_CHROMA_TOLERANCE &&
+                high.cr - low.cr <= SETTLE_CHROMA_TOLERANCE;
+}
+
+bool SettleDetector::frameStats(__u32 pixelformat, const uint8_t *const planes[3], const int strides[3],
+                                uint width, uint height, FrameStats &stats)
+{
+    if (!planes[0] || width < SETTLE_GRID_COLUMNS || height < SETTLE_GRID_ROWS)
+        return false;
+
+    uint xStep = width / SETTLE_GRID_COLUMNS, yStep = height / SETTLE_GRID_ROWS;
+    qint64 luma = 0, cb = 0, cr = 0;
+
+    for (uint row = 0; row < SETTLE_GRID_ROWS; row++) {
+        uint y = row * yStep + yStep / 2;
+        const uint8_t *line = planes[0] + y * strides[0];
+        for (uint col = 0; col < SETTLE_GRID_COLUMNS; col++) {
+            uint x = col * xStep + xStep / 2;
+            switch (pixelformat) {
+            case V4L2_PIX_FMT_YUYV: {
+                const uint8_t *p = line + (x & ~1u) * 2;
+                luma += p[0]; cb += p[1] - 128; cr += p[3] - 128;
+                break;
+            }
+            case V4L2_PIX_FMT_UYVY: {
+                const uint8_t *p = line + (x & ~1u) * 2;
+                luma += p[1]; cb += p[0] - 128; cr += p[2] - 128;
+                break;
+            }
+            case V4L2_PIX_FMT_GREY:
+                luma += line[x];
+                break;
+            case V4L2_PIX_FMT_RGBA32: {
+                const uint8_t *p = line + x * 4;
+                int l = (77 * p[0] + 150 * p[1] + 29 * p[2]) >> 8;
+                luma += l; cb += ((p[2] - l) * 145) >> 8; cr += ((p[0] - l) * 183) >> 8;
+                break;
+            }
+            case V4L2_PIX_FMT_YUV420:
+                if (!planes[1] || !planes[2])
+                    return false;
+                luma += line[x];
+                cb += planes[1][(y / 2) * strides[1] + x / 2] - 128;
+                cr += planes[2][(y / 2) * strides[2] + x / 2] - 128;
+                break;
+            case V4L2_PIX_FMT_NV12: {
+                if (!planes[1])
+                    return false;
+                const uint8_t *uv = planes[1] + (y / 2) * strides[1] + (x & ~1u);
+                luma += line[x]; cb += uv[0] - 128; cr += uv[1] - 128;
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+    }
+
+    const qreal samples = SETTLE_GRID_COLUMNS * SETTLE_GRID_ROWS;
+    stats.luma = luma / samples;
+    stats.cb = cb / samples;
+    stats.cr = cr / samples;
+    return true;
+}
@@ -0,0 +1,82 @@
+/*
+ * settledetector.h -- exposure/white balance convergence from frame statistics
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SETTLEDETECTOR_H
+#define SETTLEDETECTOR_H
+
+#include <QtGlobal>
+#include <linux/videodev2.h>
+
+#ifndef V4L2_PIX_FMT_RGBA32
+#define V4L2_PIX_FMT_RGBA32     v4l2_fourcc('A', 'B', '2', '4')     /* r, g, b, a bytes */
+#endif
+
+#define SETTLE_GRID_COLUMNS     32      /* samples per row */
+#define SETTLE_GRID_ROWS        24      /* sampled rows */
+#define SETTLE_WINDOW           6       /* frames whose statistics have to agree */
+#define SETTLE_MIN_FRAMES       12      /* a stream that never changed is settled after this many frames */
+#define SETTLE_LUMA_TOLERANCE   2.0     /* spread of mean luma inside the window, of 255 */
+#define SETTLE_CHROMA_TOLERANCE 1.5     /* spread of mean cb/cr inside the window, of 255 */
+
+/**
+ * @brief The FrameStats struct - mean luma and colour difference of a sampled frame
+ */
+struct FrameStats {
+    qreal luma;
+    qreal cb, cr;       // 0 for mono formats
+};
+
+/**
+ * @brief The SettleDetector class - declares the stream settled once mean luma [exposure] and
+ * mean colour difference [white balance] stop changing over SETTLE_WINDOW frames. The first frames
+ * after stream on often repeat before auto exposure starts, so a plateau only counts after the
+ * statistics changed once, or after SETTLE_MIN_FRAMES frames.
+ */
+class SettleDetector
+{
+public:
+    SettleDetector();
+
+    /**
+     * @brief reset - forget the statistics, on stream start/mode switch
+     */
+    void reset();
+
+    void addFrame(const FrameStats &stats);
+    bool isSettled() const { return m_settled; }
+    // frames added since reset
+    uint frames() const { return m_frames; }
+
+    /**
+     * @brief frameStats - statistics on a SETTLE_GRID_COLUMNS x SETTLE_GRID_ROWS grid
+     * @param pixelformat - YUYV, UYVY, GREY, RGBA32, YUV420 or NV12 [u holds the uv plane]
+     * @param planes, strides - planes of the frame, only the first one for packed formats
+     * @return false for formats without statistics
+     */
+    static bool frameStats(__u32 pixelformat, const uint8_t *const planes[3], const int strides[3],
+                           uint width, uint height, FrameStats &stats);
+
+private:
+    FrameStats m_window[SETTLE_WINDOW];
+    uint m_frames;
+    bool m_changed;     // two consecutive frames differed beyond the tolerance
+    bool m_settled;
+};
+
+#endif // SETTLEDETECTOR_H
@@ -0,0 +1,83 @@
+/*
+ * qtcam_shm.h -- shared memory frame ring layout shared by Qtcam and its clients
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Layout of the POSIX shared memory object "/qtcam-<name>":
+ *
+ *   struct qtcam_shm_header
+ *   slot 0 : struct qtcam_shm_slot + frame data
+ *   slot 1 : ...
+ *
+ * Qtcam is the only writer. Frame n is written to slot (n % slot_count).
+ * Each slot is protected by a sequence lock: slot->lock is odd while the
+ * frame is written and is 2 * (n + 1) once frame n is complete. After
+ * writing, header->frame_count is set to n + 1, header->futex is
+ * incremented and all waiters are woken with FUTEX_WAKE.
+ *
+ * Clients map the object read only, wait on header->futex, and read the
+ * newest slot in place. A frame is valid if slot->lock has the same even
+ * value before and after the client used the data.
+ *
+ * When Qtcam recreates the ring (larger frame size) or stops, it sets
+ * header->state to QTCAM_SHM_STATE_CLOSED and wakes all waiters, clients
+ * should unmap and open the name again.
+ */
+
+#ifndef QTCAM_SHM_H
+#define QTCAM_SHM_H
+
+#include <stdint.h>
+
+#define QTCAM_SHM_MAGIC         0x4d435451  /* "QTCM" */
+#define QTCAM_SHM_VERSION       1
+#define QTCAM_SHM_PREFIX        "/qtcam-"
+#define QTCAM_SHM_ALIGN         4096
+
+#define QTCAM_SHM_STATE_ACTIVE  1
+#define QTCAM_SHM_STATE_CLOSED  2
+
+struct qtcam_shm_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t state;
+    uint32_t slot_count;
+    uint64_t slot_size;         /* bytes from one slot to the next */
+    uint64_t data_offset;       /* frame data offset inside a slot */
+    uint64_t frame_count;       /* number of frames published */
+    uint32_t futex;             /* incremented on every publish and on close */
+    uint32_t producer_pid;
+};
+
+struct qtcam_shm_slot {
+    uint64_t lock;              /* sequence lock, odd while writing */
+    uint64_t frame_number;      /* publish counter of this frame */
+    uint64_t timestamp_ns;      /* capture timestamp [CLOCK_MONOTONIC], dequeue time if the camera has none */
+    uint32_t sequence;          /* v4l2 buffer sequence */
+    uint32_t pixelformat;       /* v4l2 fourcc */
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesperline;
+    uint32_t bytesused;
+};
+
+#define QTCAM_SHM_SLOT_HEADER_SIZE  64
+#define QTCAM_SHM_SLOTS_OFFSET      QTCAM_SHM_ALIGN
+
+#endif /* QTCAM_SHM_H */
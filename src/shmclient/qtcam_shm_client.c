@@ -0,0 +1,147 @@
+/*
+ * qtcam_shm_client.c -- client library for the Qtcam shared memory frame ring
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "qtcam_shm_client.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+struct qtcam_shm_client {
+    const struct qtcam_shm_header *header;
+    size_t map_size;
+    uint64_t last_frame;        /* frame_count seen on the last successful wait */
+};
+
+qtcam_shm_client *qtcam_shm_open(const char *name)
+{
+    char shm_name[256];
+    struct stat st;
+    qtcam_shm_client *client;
+    void *base;
+    int fd;
+
+    snprintf(shm_name, sizeof(shm_name), "%s%s", QTCAM_SHM_PREFIX, name);
+    fd = shm_open(shm_name, O_RDONLY, 0);
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < QTCAM_SHM_SLOTS_OFFSET) {
+        close(fd);
+        errno = EINVAL;
+        return NULL;
+    }
+    base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return NULL;
+
+    client = (qtcam_shm_client *)calloc(1, sizeof(*client));
+    if (!client) {
+        munmap(base, st.st_size);
+        return NULL;
+    }
+    client->header = (const struct qtcam_shm_header *)base;
+    client->map_size = st.st_size;
+
+    if (__atomic_load_n(&client->header->magic, __ATOMIC_ACQUIRE) != QTCAM_SHM_MAGIC ||
+        client->header->version != QTCAM_SHM_VERSION ||
+        QTCAM_SHM_SLOTS_OFFSET + client->header->slot_size * client->header->slot_count > client->map_size) {
+        qtcam_shm_close(client);
+        errno = EPROTO;
+        return NULL;
+    }
+    client->last_frame = __atomic_load_n(&client->header->frame_count, __ATOMIC_ACQUIRE);
+    return client;
+}
+
+void qtcam_shm_close(qtcam_shm_client *client)
+{
+    if (!client)
+        return;
+    munmap((void *)client->header, client->map_size);
+    free(client);
+}
+
+static int futex_wait(const uint32_t *addr, uint32_t val, int timeout_ms)
+{
+    struct timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+    return syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout_ms < 0 ? NULL : &ts, NULL, 0);
+}
+
+int qtcam_shm_wait_frame(qtcam_shm_client *client, qtcam_shm_frame *frame, int timeout_ms)
+{
+    const struct qtcam_shm_header *header = client->header;
+
+    for (;;) {
+        uint32_t futex = __atomic_load_n(&header->futex, __ATOMIC_ACQUIRE);
+        uint64_t count;
+
+        if (__atomic_load_n(&header->state, __ATOMIC_ACQUIRE) != QTCAM_SHM_STATE_ACTIVE)
+            return -ESHUTDOWN;
+
+        count = __atomic_load_n(&header->frame_count, __ATOMIC_ACQUIRE);
+        if (count > client->last_frame) {
+            uint64_t number = count - 1;
+            const struct qtcam_shm_slot *slot = (const struct qtcam_shm_slot *)
+                ((const uint8_t *)header + QTCAM_SHM_SLOTS_OFFSET + (number % header->slot_count) * header->slot_size);
+            uint64_t lock = __atomic_load_n(&slot->lock, __ATOMIC_ACQUIRE);
+
+            /* writer already moved on to this slot again, retry with the newer count */
+            if (lock != 2 * number + 2)
+                continue;
+
+            frame->slot = slot;
+            frame->lock = lock;
+            frame->data = (const uint8_t *)slot + header->data_offset;
+            frame->bytesused = slot->bytesused;
+            frame->pixelformat = slot->pixelformat;
+            frame->width = slot->width;
+            frame->height = slot->height;
+            frame->bytesperline = slot->bytesperline;
+            frame->sequence = slot->sequence;
+            frame->timestamp_ns = slot->timestamp_ns;
+            frame->frame_number = number;
+            frame->dropped = number - client->last_frame;
+            client->last_frame = count;
+
+            if (!qtcam_shm_frame_valid(frame))
+                continue;
+            return 0;
+        }
+
+        if (futex_wait(&header->futex, futex, timeout_ms) < 0 && errno == ETIMEDOUT)
+            return -ETIMEDOUT;
+    }
+}
+
+int qtcam_shm_frame_valid(const qtcam_shm_frame *frame)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&frame->slot->lock, __ATOMIC_RELAXED) == frame->lock;
+}
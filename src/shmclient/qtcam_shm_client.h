@@ -0,0 +1,92 @@
+/*
+ * qtcam_shm_client.h -- client library for the Qtcam shared memory frame ring
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Build the library and the sample consumer:
+ *   gcc -O2 -c qtcam_shm_client.c
+ *   gcc -O2 -o shm_consumer shm_consumer.c qtcam_shm_client.o -lrt
+ */
+
+#ifndef QTCAM_SHM_CLIENT_H
+#define QTCAM_SHM_CLIENT_H
+
+#include <stdint.h>
+#include "qtcam_shm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct qtcam_shm_client qtcam_shm_client;
+
+typedef struct qtcam_shm_frame {
+    const void *data;           /* points into the shared ring, no copy */
+    uint32_t bytesused;
+    uint32_t pixelformat;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesperline;
+    uint32_t sequence;
+    uint64_t timestamp_ns;
+    uint64_t frame_number;
+    uint64_t dropped;           /* frames published but not seen since the last call */
+    const struct qtcam_shm_slot *slot;
+    uint64_t lock;
+} qtcam_shm_frame;
+
+/*
+ * qtcam_shm_open - map the ring published by Qtcam read only
+ * args:
+ *   name - ring name [as set in Qtcam, without the "/qtcam-" prefix]
+ *
+ * returns: client handle or NULL [errno set]
+ */
+qtcam_shm_client *qtcam_shm_open(const char *name);
+
+/*
+ * qtcam_shm_close - unmap the ring and free the handle
+ */
+void qtcam_shm_close(qtcam_shm_client *client);
+
+/*
+ * qtcam_shm_wait_frame - wait for a frame newer than the last one returned
+ * args:
+ *   client - handle from qtcam_shm_open
+ *   frame - filled with the newest frame
+ *   timeout_ms - maximum wait, -1 for no limit
+ *
+ * returns: 0 on success
+ *          -ETIMEDOUT if no frame arrived in time
+ *          -ESHUTDOWN if Qtcam closed or recreated the ring [close and open again]
+ */
+int qtcam_shm_wait_frame(qtcam_shm_client *client, qtcam_shm_frame *frame, int timeout_ms);
+
+/*
+ * qtcam_shm_frame_valid - check that the frame was not overwritten while it was used
+ *
+ * returns: 1 if the data read since qtcam_shm_wait_frame is consistent, 0 otherwise
+ */
+int qtcam_shm_frame_valid(const qtcam_shm_frame *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QTCAM_SHM_CLIENT_H */
@@ -0,0 +1,89 @@
+/*
+ * shm_consumer.c -- sample consumer of the Qtcam shared memory frame ring
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Prints format, sequence and mean luma of every frame.
+ * usage: shm_consumer [name]    (default name "video0")
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include "qtcam_shm_client.h"
+
+#define FOURCC_YUYV 0x56595559  /* 'YUYV' */
+#define FOURCC_GREY 0x59455247  /* 'GREY' */
+
+static unsigned mean_luma(const qtcam_shm_frame *frame)
+{
+    const uint8_t *p = (const uint8_t *)frame->data;
+    unsigned step = (frame->pixelformat == FOURCC_YUYV) ? 2 : 1;
+    uint64_t sum = 0, n = 0;
+    uint32_t i;
+
+    for (i = 0; i < frame->bytesused; i += step * 16) {
+        sum += p[i];
+        n++;
+    }
+    return n ? (unsigned)(sum / n) : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *name = argc > 1 ? argv[1] : "video0";
+    qtcam_shm_client *client = NULL;
+    qtcam_shm_frame frame;
+
+    for (;;) {
+        if (!client) {
+            client = qtcam_shm_open(name);
+            if (!client) {
+                sleep(1);
+                continue;
+            }
+            printf("connected to %s%s\n", QTCAM_SHM_PREFIX, name);
+        }
+
+        int ret = qtcam_shm_wait_frame(client, &frame, 2000);
+        if (ret == -ETIMEDOUT)
+            continue;
+        if (ret == -ESHUTDOWN) {
+            printf("ring closed, reconnecting\n");
+            qtcam_shm_close(client);
+            client = NULL;
+            continue;
+        }
+
+        unsigned luma = 0;
+        if (frame.pixelformat == FOURCC_YUYV || frame.pixelformat == FOURCC_GREY)
+            luma = mean_luma(&frame);
+        if (!qtcam_shm_frame_valid(&frame)) {
+            printf("frame %llu overwritten while reading\n", (unsigned long long)frame.frame_number);
+            continue;
+        }
+        printf("frame %llu seq %u %ux%u %.4s %u bytes ts %llu.%06llu luma %u dropped %llu\n",
+               (unsigned long long)frame.frame_number, frame.sequence, frame.width, frame.height,
+               (const char *)&frame.pixelformat, frame.bytesused,
+               (unsigned long long)(frame.timestamp_ns / 1000000000ULL),
+               (unsigned long long)(frame.timestamp_ns % 1000000000ULL) / 1000,
+               luma, (unsigned long long)frame.dropped);
+    }
+    return 0;
+}
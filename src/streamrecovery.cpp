@@ -0,0 +1,136 @@
+/*
+ * streamrecovery.cpp -- waits for a lost camera to come back after a usb reset
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "streamrecovery.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/videodev2.h>
+
+StreamRecovery::StreamRecovery()
+{
+    m_registry = NULL;
+    m_timeout.setSingleShot(true);
+    m_retry.setSingleShot(true);
+    connect(&m_timeout, SIGNAL(timeout()), this, SLOT(stop()));
+    connect(&m_timeout, SIGNAL(timeout()), this, SIGNAL(timedOut()));
+    connect(&m_retry, SIGNAL(timeout()), this, SLOT(scan()));
+}
+
+StreamRecovery::~StreamRecovery()
+{
+    stop();
+}
+
+void StreamRecovery::watch(QString cardName, QString busInfo)
+{
+    stop();
+    m_cardName = cardName;
+    m_busInfo = busInfo;
+    m_outage.start();
+
+    m_registry = DeviceRegistry::instance();
+    if (!m_registry->isRunning()) {
+        // without udev the present nodes are still looked at until the timeout
+        fprintf(stderr, "StreamRecovery: udev not available, polling\n");
+    }
+    // the scan below covers the nodes present now, later ones come as deviceAdded
+    connect(m_registry, SIGNAL(deviceAdded(QString,QString)), this, SLOT(nodeAdded(QString,QString)));
+    m_timeout.start(RECOVERY_TIMEOUT_MS);
+    m_retry.start(0);
+}
+
+void StreamRecovery::stop()
+{
+    m_timeout.stop();
+    m_retry.stop();
+    if (m_registry) {
+        // the registry is shared, only stop listening to it
+        disconnect(m_registry, 0, this, 0);
+        m_registry = NULL;
+    }
+}
+
+void StreamRecovery::retry()
+{
+    if (m_registry)
+        m_retry.start(RECOVERY_RETRY_MS);
+}
+
+void StreamRecovery::nodeAdded(QString videoNode, QString cardName)
+{
+    Q_UNUSED(videoNode);
+    if (m_registry && cardName == m_cardName)
+        scan();
+}
+
+void StreamRecovery::scan()
+{
+    if (!m_registry)
+        return;
+
+    // a registry without udev has no nodes, /dev/videoN are tried directly
+    QList<CameraDeviceInfo> devices = m_registry->isRunning() ? m_registry->devices() : QList<CameraDeviceInfo>();
+    if (!m_registry->isRunning()) {
+        for (int i = 0; i < 64; i++) {
+            CameraDeviceInfo info;
+            info.videoIndex = i;
+            info.videoNode = "/dev/video" + QString::number(i);
+            if (access(info.videoNode.toLatin1().data(), F_OK) == 0)
+                devices.append(info);
+        }
+    }
+
+    for (int i = 0; i < devices.count(); i++) {
+        if (matches(devices.at(i))) {
+            emit deviceReturned(devices.at(i).videoNode);
+            return;
+        }
+    }
+    if (!m_registry->isRunning())
+        retry();
+}
+
+/**
+ * @brief StreamRecovery::matches - same card on the same usb port, and a capture node
+ * [uvc cameras also have a metadata node with the same card and bus]
+ */
+bool StreamRecovery::matches(const CameraDeviceInfo &info)
+{
+    if (!info.cardName.isEmpty() && info.cardName != m_cardName)
+        return false;
+    int fd = ::open(info.videoNode.toLatin1().data(), O_RDWR | O_NONBLOCK);
+    if (fd < 0)
+        return false;
+    struct v4l2_capability cap;
+    memset(&cap, 0, sizeof(cap));
+    int ret = ::ioctl(fd, VIDIOC_QUERYCAP, &cap);
+    ::close(fd);
+    if (ret < 0)
+        return false;
+
+    if (QString::fromUtf8((const char *)cap.card) != m_cardName ||
+        QString::fromUtf8((const char *)cap.bus_info) != m_busInfo)
+        return false;
+    __u32 caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+    return caps & (V4L2_CAP_VIDEO_CAPTURE | V4L2_CAP_VIDEO_CAPTURE_MPLANE);
+}
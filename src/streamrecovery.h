@@ -0,0 +1,82 @@
+/*
+ * streamrecovery.h -- waits for a lost camera to come back after a usb reset
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef STREAMRECOVERY_H
+#define STREAMRECOVERY_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "deviceregistry.h"
+
+#define RECOVERY_TIMEOUT_MS     10000   /* give up and report the camera unplugged after this */
+#define RECOVERY_RETRY_MS       100     /* node present but not usable yet, look again after this */
+
+/**
+ * @brief The StreamRecovery class - after a capture error, watches udev for the video node of
+ * the same camera [card name and usb port, so a new /dev/videoN is followed too] and reports
+ * it once it can capture again. Nodes present at the start are tried first, a transient error
+ * does not remove the node.
+ */
+class StreamRecovery : public QObject
+{
+    Q_OBJECT
+
+public:
+    StreamRecovery();
+    ~StreamRecovery();
+
+    /**
+     * @brief watch - start waiting for the camera
+     * @param cardName, busInfo - querycap of the lost node
+     */
+    void watch(QString cardName, QString busInfo);
+    inline bool isWatching() const { return m_registry != NULL; }
+
+    /**
+     * @brief retry - the reported node could not be streamed, report it again later
+     */
+    void retry();
+
+    // ms since the capture error
+    qint64 outageMs() const { return m_outage.isValid() ? m_outage.elapsed() : 0; }
+
+public slots:
+    void stop();
+
+signals:
+    void deviceReturned(QString videoNode);
+    void timedOut();
+
+private slots:
+    void nodeAdded(QString videoNode, QString cardName);
+    void scan();
+
+private:
+    bool matches(const CameraDeviceInfo &info);
+
+    DeviceRegistry *m_registry;
+    QString m_cardName;
+    QString m_busInfo;
+    QElapsedTimer m_outage;
+    QTimer m_timeout;
+    QTimer m_retry;
+};
+
+#endif // STREAMRECOVERY_H
@@ -0,0 +1,321 @@
+/*
+ * streamserver.cpp -- HTTP endpoint serving compressed camera frames
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "streamserver.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QMutexLocker>
+#include <QMetaObject>
+#include <stdio.h>
+
+#define MJPEG_BOUNDARY          "qtcamframe"
+#define MAX_REQUEST_SIZE        4096
+
+StreamServer::StreamServer()
+{
+    m_server = NULL;
+    m_deliverQueued = false;
+    for (int i = 0; i < STREAM_TYPE_COUNT; i++)
+        m_fresh[i] = false;
+}
+
+StreamServer::~StreamServer()
+{
+    stop();
+    m_thread.quit();
+    m_thread.wait();
+}
+
+bool StreamServer::start(quint16 port, bool loopbackOnly)
+{
+    if (!m_thread.isRunning()) {
+        moveToThread(&m_thread);
+        m_thread.start();
+    }
+    QMetaObject::invokeMethod(this, "startListening", Qt::BlockingQueuedConnection,
+                              Q_ARG(int, port), Q_ARG(bool, loopbackOnly));
+    return isRunning();
+}
+
+void StreamServer::stop()
+{
+    if (!m_thread.isRunning())
+        return;
+    QMetaObject::invokeMethod(this, "stopListening", Qt::BlockingQueuedConnection);
+}
+
+void StreamServer::startListening(int port, bool loopbackOnly)
+{
+    stopListening();
+    m_server = new QTcpServer();
+    connect(m_server, SIGNAL(newConnection()), this, SLOT(newClient()));
+    if (!m_server->listen(loopbackOnly ? QHostAddress::LocalHost : QHostAddress::Any, port)) {
+        fprintf(stderr, "Stream server: cannot listen on port %d: %s\n", port,
+                m_server->errorString().toLatin1().constData());
+        delete m_server;
+        m_server = NULL;
+        return;
+    }
+    m_listening.store(1);
+}
+
+void StreamServer::stopListening()
+{
+    m_listening.store(0);
+    while (!m_clients.isEmpty())
+        removeClient(m_clients.first());
+    if (m_server) {
+        m_server->close();
+        delete m_server;
+        m_server = NULL;
+    }
+}
+
+void StreamServer::pushFrame(StreamType type, const void *data, int size)
+{
+    if (m_viewers[type].load() == 0 || size <= 0)
+        return;
+
+    QMutexLocker locker(&m_frameMutex);
+    m_latest[type] = QByteArray((const char *)data, size);
+    m_fresh[type] = true;
+    if (!m_deliverQueued) {
+        m_deliverQueued = true;
+        QMetaObject::invokeMethod(this, "deliverFrames", Qt::QueuedConnection);
+    }
+}
+
+void StreamServer::setH264Header(const QByteArray &header)
+{
+    QMutexLocker locker(&m_frameMutex);
+    m_h264Header = header;
+}
+
+/**
+ * @brief StreamServer::isH264KeyFrame - look for an IDR slice in an Annex-B access unit
+ * @param hasSps - set if the access unit carries its own SPS
+ */
+bool StreamServer::isH264KeyFrame(const uint8_t *data, int size, bool *hasSps)
+{
+    bool key = false;
+    if (hasSps)
+        *hasSps = false;
+    for (int i = 0; i + 3 < size; i++) {
+        if (data[i] != 0 || data[i + 1] != 0 || data[i + 2] != 1)
+            continue;
+        int nalType = data[i + 3] & 0x1F;
+        if (nalType == 7 && hasSps)
+            *hasSps = true;
+        if (nalType == 5)
+            key = true;
+        // stop at the first coded slice, parameter sets always come before it
+        if (nalType == 1 || nalType == 5)
+            break;
+        i += 2;
+    }
+    return key;
+}
+
+void StreamServer::deliverFrames()
+{
+    QByteArray frames[STREAM_TYPE_COUNT];
+    QByteArray h264Header;
+    {
+        QMutexLocker locker(&m_frameMutex);
+        for (int i = 0; i < STREAM_TYPE_COUNT; i++) {
+            if (m_fresh[i])
+                frames[i] = m_latest[i];
+            m_fresh[i] = false;
+        }
+        h264Header = m_h264Header;
+        m_deliverQueued = false;
+    }
+
+    bool h264Key = false;
+    if (!frames[H264_STREAM].isEmpty()) {
+        bool hasSps;
+        h264Key = isH264KeyFrame((const uint8_t *)frames[H264_STREAM].constData(), frames[H264_STREAM].size(), &hasSps);
+        if (h264Key && !hasSps && !h264Header.isEmpty())
+            frames[H264_STREAM].prepend(h264Header);
+    }
+
+    for (int i = 0; i < m_clients.count(); i++) {
+        StreamClient *client = m_clients.at(i);
+        if (client->type < 0 || frames[client->type].isEmpty())
+            continue;
+        offerFrame(client, frames[client->type], client->type == MJPEG_STREAM || h264Key);
+    }
+}
+
+/**
+ * @brief StreamServer::offerFrame - hand the frame to the socket or keep it as pending
+ * Only one frame is written into the socket at a time, a newer frame replaces the pending one.
+ * For h264 a dropped frame breaks the reference chain, so the client waits for the next key frame.
+ */
+void StreamServer::offerFrame(StreamClient *client, const QByteArray &frame, bool keyFrame)
+{
+    if (client->type == H264_STREAM && client->waitKeyFrame) {
+        if (!keyFrame)
+            return;
+        client->waitKeyFrame = false;
+    }
+
+    if (client->socket->bytesToWrite() == 0 && client->pending.isEmpty()) {
+        sendFrame(client, frame);
+        return;
+    }
+
+    client->dropped++;
+    if (client->type == H264_STREAM) {
+        client->pending.clear();
+        if (keyFrame)
+            client->pending = frame;
+        else
+            client->waitKeyFrame = true;
+    } else {
+        client->pending = frame;
+    }
+}
+
+void StreamServer::sendFrame(StreamClient *client, const QByteArray &frame)
+{
+    QTcpSocket *socket = client->socket;
+    if (client->type == MJPEG_STREAM) {
+        QByteArray header = "--" MJPEG_BOUNDARY "\r\nContent-Type: image/jpeg\r\nContent-Length: ";
+        header += QByteArray::number(frame.size());
+        header += "\r\n\r\n";
+        socket->write(header);
+        socket->write(frame);
+        socket->write("\r\n");
+    } else {
+        socket->write(QByteArray::number(frame.size(), 16) + "\r\n");
+        socket->write(frame);
+        socket->write("\r\n");
+    }
+}
+
+void StreamServer::newClient()
+{
+    while (m_server && m_server->hasPendingConnections()) {
+        QTcpSocket *socket = m_server->nextPendingConnection();
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+        StreamClient *client = new StreamClient;
+        client->socket = socket;
+        client->type = -1;
+        client->waitKeyFrame = true;
+        client->dropped = 0;
+        m_clients.append(client);
+
+        connect(socket, SIGNAL(readyRead()), this, SLOT(readRequest()));
+        connect(socket, SIGNAL(bytesWritten(qint64)), this, SLOT(clientBytesWritten()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(clientDisconnected()));
+    }
+}
+
+void StreamServer::readRequest()
+{
+    StreamClient *client = findClient(qobject_cast<QTcpSocket *>(sender()));
+    if (!client)
+        return;
+    if (client->type >= 0) {     // requests after the stream started are ignored
+        client->socket->readAll();
+        return;
+    }
+    client->request += client->socket->readAll();
+    if (client->request.size() > MAX_REQUEST_SIZE) {
+        removeClient(client);
+        return;
+    }
+    if (!client->request.contains("\r\n\r\n"))
+        return;
+
+    QList<QByteArray> requestLine = client->request.left(client->request.indexOf("\r\n")).split(' ');
+    QByteArray path = requestLine.count() >= 2 ? requestLine.at(1) : QByteArray();
+    QTcpSocket *socket = client->socket;
+
+    if (requestLine.at(0) != "GET") {
+        socket->write("HTTP/1.0 405 Method Not Allowed\r\nConnection: close\r\n\r\n");
+        socket->disconnectFromHost();
+    } else if (path == "/mjpeg") {
+        client->type = MJPEG_STREAM;
+        socket->write("HTTP/1.0 200 OK\r\n"
+                      "Cache-Control: no-cache\r\nPragma: no-cache\r\nConnection: close\r\n"
+                      "Content-Type: multipart/x-mixed-replace; boundary=" MJPEG_BOUNDARY "\r\n\r\n");
+    } else if (path == "/h264") {
+        client->type = H264_STREAM;
+        socket->write("HTTP/1.1 200 OK\r\n"
+                      "Cache-Control: no-cache\r\nConnection: close\r\n"
+                      "Content-Type: video/h264\r\nTransfer-Encoding: chunked\r\n\r\n");
+    } else if (path == "/") {
+        socket->write("HTTP/1.0 200 OK\r\nContent-Type: text/plain\r\nConnection: close\r\n\r\n"
+                      "Qtcam stream server\r\n/mjpeg - MJPEG stream\r\n/h264 - H.264 Annex-B stream\r\n");
+        socket->disconnectFromHost();
+    } else {
+        socket->write("HTTP/1.0 404 Not Found\r\nConnection: close\r\n\r\n");
+        socket->disconnectFromHost();
+    }
+    client->request.clear();
+
+    if (client->type >= 0) {
+        m_viewers[client->type].ref();
+        emit clientCountChanged(m_viewers[MJPEG_STREAM].load() + m_viewers[H264_STREAM].load());
+    }
+}
+
+void StreamServer::clientBytesWritten()
+{
+    StreamClient *client = findClient(qobject_cast<QTcpSocket *>(sender()));
+    if (!client || client->socket->bytesToWrite() != 0 || client->pending.isEmpty())
+        return;
+    QByteArray frame = client->pending;
+    client->pending.clear();
+    sendFrame(client, frame);
+}
+
+void StreamServer::clientDisconnected()
+{
+    StreamClient *client = findClient(qobject_cast<QTcpSocket *>(sender()));
+    if (client)
+        removeClient(client);
+}
+
+StreamServer::StreamClient *StreamServer::findClient(QTcpSocket *socket)
+{
+    for (int i = 0; i < m_clients.count(); i++) {
+        if (m_clients.at(i)->socket == socket)
+            return m_clients.at(i);
+    }
+    return NULL;
+}
+
+void StreamServer::removeClient(StreamClient *client)
+{
+    m_clients.removeOne(client);
+    if (client->type >= 0) {
+        m_viewers[client->type].deref();
+        emit clientCountChanged(m_viewers[MJPEG_STREAM].load() + m_viewers[H264_STREAM].load());
+    }
+    client->socket->disconnect(this);
+    client->socket->abort();
+    client->socket->deleteLater();
+    delete client;
+}
@@ -0,0 +1,117 @@
+/*
+ * streamserver.h -- HTTP endpoint serving compressed camera frames
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef STREAMSERVER_H
+#define STREAMSERVER_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QByteArray>
+#include <QList>
+#include <QAtomicInt>
+
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief The StreamServer class - serves compressed frames over HTTP without re-encoding.
+ *  GET /mjpeg - multipart/x-mixed-replace JPEG stream
+ *  GET /h264  - raw H.264 Annex-B over a chunked response
+ * Network handling runs in its own thread. pushFrame() only stores the newest frame, and
+ * every client holds at most one frame in flight plus one pending [latest frame wins], so a
+ * slow viewer drops frames instead of slowing down capture.
+ * Test on loopback: curl -s http://127.0.0.1:8080/h264 | ffplay -f h264 -
+ */
+class StreamServer : public QObject
+{
+    Q_OBJECT
+public:
+    enum StreamType {
+        MJPEG_STREAM = 0,
+        H264_STREAM,
+        STREAM_TYPE_COUNT
+    };
+
+    StreamServer();
+    ~StreamServer();
+
+    /**
+     * @brief start - listen for clients
+     * @param port - tcp port
+     * @param loopbackOnly - true to accept only local clients
+     * @return true - success /false - failure
+     */
+    bool start(quint16 port, bool loopbackOnly = true);
+    void stop();
+    bool isRunning() const { return m_listening.load() != 0; }
+
+    /**
+     * @brief pushFrame - offer a compressed frame to the clients, thread safe
+     * Does nothing when no client watches this stream type.
+     */
+    void pushFrame(StreamType type, const void *data, int size);
+
+    // SPS/PPS sent before key frames when the encoder keeps them out of band [global header]
+    void setH264Header(const QByteArray &header);
+
+    static bool isH264KeyFrame(const uint8_t *data, int size, bool *hasSps = NULL);
+
+signals:
+    void clientCountChanged(int clients);
+
+private slots:
+    void startListening(int port, bool loopbackOnly);
+    void stopListening();
+    void newClient();
+    void readRequest();
+    void clientBytesWritten();
+    void clientDisconnected();
+    void deliverFrames();
+
+private:
+    struct StreamClient {
+        QTcpSocket *socket;
+        QByteArray request;
+        int type;               // -1 until the request is parsed
+        bool waitKeyFrame;      // h264 - skip until the decoder can resync
+        QByteArray pending;     // newest frame not yet handed to the socket
+        quint64 dropped;
+    };
+
+    StreamClient *findClient(QTcpSocket *socket);
+    void sendFrame(StreamClient *client, const QByteArray &frame);
+    void offerFrame(StreamClient *client, const QByteArray &frame, bool keyFrame);
+    void removeClient(StreamClient *client);
+
+    QThread m_thread;
+    QTcpServer *m_server;
+    QList<StreamClient *> m_clients;
+
+    QMutex m_frameMutex;
+    QByteArray m_latest[STREAM_TYPE_COUNT];
+    bool m_fresh[STREAM_TYPE_COUNT];
+    bool m_deliverQueued;
+    QByteArray m_h264Header;
+
+    QAtomicInt m_viewers[STREAM_TYPE_COUNT];
+    QAtomicInt m_listening;
+};
+
+#endif // STREAMSERVER_H
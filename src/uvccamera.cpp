@@ -19,21 +19,11 @@
  */
 
 #include "uvccamera.h"
+#include "framesync.h"
 #include "QStringList"
 
 QMap<QString, QString> uvccamera::cameraMap;
 QMap<QString, QString> uvccamera::serialNumberMap;
-//Added by Dhurka - 13th Oct 2016
-/**
- * @brief uvccamera::selectedDeviceEnum - This is used to compare camera enum value instead of camera name
- */
-CommonEnums::ECameraNames  uvccamera::selectedDeviceEnum;
-QString uvccamera::hidNode;
-//Modified by Dhurka
-QString uvccamera::openNode;
-
-int uvccamera::hid_fd;
-libusb_device_handle *uvccamera::handle;
 //Added by Dhurka - 14th Oct 2016
 /**
  * @brief econCameraVid - to avoid hard coded value checking in findEconDevice()
@@ -49,7 +39,7 @@ uvccamera::uvccamera()
      * enum value
      */
     initCameraEnumMap();
-    handle = NULL;
+    m_session = NULL;
 }
 
 void uvccamera::initCameraEnumMap()
@@ -208,6 +198,32 @@ int uvccamera::findEconDevice(QString parameter)
     udev_unref(udev);
     return 1;
 }
+
+void uvccamera::updateDeviceMaps(const QList<CameraDeviceInfo> &devices)
+{
+    cameraMap.clear();
+    serialNumberMap.clear();
+    pidVidMap.clear();
+    for (int i = 0; i < devices.count(); i++) {
+        const CameraDeviceInfo &device = devices.at(i);
+        if (device.vid != econCameraVid.toLower() && device.vid != ascellaCameraVid.toLower())
+            continue;
+
+        pidVidMap.insert(device.product, device.vid + "," + device.pid);
+        for (int j = 0; j < device.hidNodes.count(); j++) {
+            const QString &hid_device = device.hidNodes.at(j);
+            // several video nodes of one camera share its hid node
+            if (cameraMap.values(device.product).contains(hid_device))
+                continue;
+            emit logHandle(QtDebugMsg, "HID Device found: "+device.product + ": Available in: "+hid_device);
+            cameraMap.insertMulti(device.product, hid_device);
+            if (device.serialNumber.isEmpty())
+                serialNumberMap.insertMulti(hid_device, tr("Not assigned"));
+            else
+                serialNumberMap.insertMulti(hid_device, device.serialNumber);
+        }
+    }
+}
 //Added by Dhurka - 13th Oct 2016
 /**
  * @brief uvccamera::currentlySelectedDevice - This is used to get the currently selected
@@ -236,21 +252,21 @@ void uvccamera::currentlySelectedDevice(QString deviceName)
         QString selectedCameraVidPid = pidVidMap.value(originalDeviceName);
         //Convert the vid,pid value in the cameraEnum map as lower case and compare with the selected Vid,pid
         QMap<QString, CommonEnums::ECameraNames>::iterator mapIterator;
-        selectedDeviceEnum = CommonEnums::NONE;
+        session()->cameraEnum = CommonEnums::NONE;
         for (mapIterator = cameraEnumMap.begin(); mapIterator != cameraEnumMap.end(); ++mapIterator)
         {
             if(mapIterator.key().toLower() == selectedCameraVidPid)
             {
-                selectedDeviceEnum = mapIterator.value();
+                session()->cameraEnum = mapIterator.value();
                 break;
             }
         }
     }
     else
     {
-        selectedDeviceEnum = CommonEnums::NONE;
+        session()->cameraEnum = CommonEnums::NONE;
     }
-    emit currentlySelectedCameraEnum(selectedDeviceEnum);
+    emit currentlySelectedCameraEnum(session()->cameraEnum);
 }
 
 int uvccamera::initExtensionUnitAscella(){
@@ -260,11 +276,12 @@ int uvccamera::initExtensionUnitAscella(){
 
     //Added by Nithyesh
     ret = -1;
-    kernelDriverDetached = 0;
+    CameraSession *camera = session();
+    camera->kernelDriverDetached = 0;
     libusb_init(NULL);
     libusb_set_debug(NULL, 3);
 
-    handle = libusb_open_device_with_vid_pid(NULL, ASCELLA_VID, ASCELLA_PID);
+    libusb_device_handle *handle = libusb_open_device_with_vid_pid(NULL, ASCELLA_VID, ASCELLA_PID);
 
     if(!handle) {
         emit logHandle(QtCriticalMsg, "\nunable to open the device\n");
@@ -276,7 +293,7 @@ int uvccamera::initExtensionUnitAscella(){
             ret = libusb_detach_kernel_driver(handle, 2);
             if (ret == 0)
             {
-                kernelDriverDetached = 1;
+                camera->kernelDriverDetached = 1;
                 emit logHandle(QtDebugMsg, "driver detachment successful\n");
             }
         }
@@ -290,6 +307,7 @@ int uvccamera::initExtensionUnitAscella(){
         }
 
      }
+     camera->usbHandle = handle;
 
      return ret;
 
@@ -297,6 +315,8 @@ int uvccamera::initExtensionUnitAscella(){
 
 bool uvccamera::closeAscellaDevice(){
     int res;
+    CameraSession *camera = session();
+    libusb_device_handle *handle = camera->usbHandle;
 
     if(handle == NULL){
         return false;
@@ -309,7 +329,7 @@ bool uvccamera::closeAscellaDevice(){
        return false;
     }
 
-    if (kernelDriverDetached)
+    if (camera->kernelDriverDetached)
     {
         libusb_attach_kernel_driver(handle, 2);
         emit logHandle(QtDebugMsg, "Attaching libusb kernel driver\n");
@@ -322,7 +342,8 @@ bool uvccamera::closeAscellaDevice(){
     }
 
     libusb_exit(NULL);
-    handle = NULL;
+    camera->usbHandle = NULL;
+    camera->kernelDriverDetached = 0;
 
     return true;
 }
@@ -330,7 +351,7 @@ bool uvccamera::closeAscellaDevice(){
 bool uvccamera::readFirmwareVersion(quint8 *pMajorVersion, quint8 *pMinorVersion1, quint16 *pMinorVersion2, quint16 *pMinorVersion3) {
 
 
-    if(uvccamera::hid_fd < 0)
+    if(hidFd() < 0)
     {
         return false;
     }
@@ -351,7 +372,7 @@ bool uvccamera::readFirmwareVersion(quint8 *pMajorVersion, quint8 *pMinorVersion
     g_out_packet_buf[1] = READFIRMWAREVERSION; 	/* Report Number */
 
     /* Send a Report to the Device */
-    ret = write(hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         _text = tr("Device not available");
@@ -362,7 +383,7 @@ bool uvccamera::readFirmwareVersion(quint8 *pMajorVersion, quint8 *pMinorVersion
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -395,6 +416,7 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
         return false;
     }
     QString originalDeviceName;
+    CameraSession *camera = session();
 
     QMap<QString, QString>::iterator pidvidmapIterator;
     for (pidvidmapIterator = pidVidMap.begin(); pidvidmapIterator != pidVidMap.end(); ++pidvidmapIterator)
@@ -406,12 +428,13 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
         }
     }
 
-    if(hid_fd >= 0)
+    if(camera->hidFd >= 0)
     {
-        close(hid_fd);
+        close(camera->hidFd);
+        camera->hidFd = -1;
     }
 
-    if(hidNode == "")
+    if(camera->hidNode == "")
     {
         return false;
     }
@@ -426,12 +449,12 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
     /* Open the Device with non-blocking reads. In real life,
            don't use a hard coded path; use libudev instead. */
     QMap<QString, QString>::const_iterator ii = cameraMap.find(originalDeviceName);
-    openNode = "";
+    camera->openNode = "";
     while (ii != cameraMap.end() && ii.key() == originalDeviceName) {
-        hid_fd = open(ii.value().toLatin1().data(), O_RDWR|O_NONBLOCK);
+        camera->hidFd = open(ii.value().toLatin1().data(), O_RDWR|O_NONBLOCK);
         memset(buf, 0x0, sizeof(buf));
         /* Get Physical Location */
-        ret = ioctl(hid_fd, HIDIOCGRAWPHYS(256), buf);
+        ret = ioctl(camera->hidFd, HIDIOCGRAWPHYS(256), buf);
         if (ret < 0) {
             // Added by Sankari: To notify user about hid access
             // 07 Dec 2017
@@ -441,21 +464,21 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
             return false;
         }
         QString tempBuf = buf;
-        if(tempBuf.contains(hidNode)) {
-            openNode = ii.value();
-            close(hid_fd);
+        if(tempBuf.contains(camera->hidNode)) {
+            camera->openNode = ii.value();
+            close(camera->hidFd);
  //          break;
         }
-        close(hid_fd);
+        close(camera->hidFd);
         ++ii;
  }
 
 
-    hid_fd = open(openNode.toLatin1().data(), O_RDWR|O_NONBLOCK);
+    camera->hidFd = open(camera->openNode.toLatin1().data(), O_RDWR|O_NONBLOCK);
     //Directly open from map value
     //fd = open(cameraMap.value(getCameraName()).toLatin1().data(), O_RDWR|O_NONBLOCK);
 
-    if (hid_fd < 0) {
+    if (camera->hidFd < 0) {
         perror("Unable to open device");
         return false;
     }
@@ -464,10 +487,10 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
     memset(&info, 0x0, sizeof(info));
     memset(buf, 0x0, sizeof(buf));
     /* Get Report Descriptor Size */
-    ret = ioctl(hid_fd, HIDIOCGRDESCSIZE, &desc_size);
+    ret = ioctl(camera->hidFd, HIDIOCGRDESCSIZE, &desc_size);
 
     /* Get Report Descriptor Size */
-    ret = ioctl(hid_fd, HIDIOCGRDESCSIZE, &desc_size);
+    ret = ioctl(camera->hidFd, HIDIOCGRDESCSIZE, &desc_size);
     if (ret < 0) {
         perror("HIDIOCGRDESCSIZE");
         return false;
@@ -475,7 +498,7 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
 
     /* Get Report Descriptor */
     rpt_desc.size = desc_size;
-    ret = ioctl(hid_fd, HIDIOCGRDESC, &rpt_desc);
+    ret = ioctl(camera->hidFd, HIDIOCGRDESC, &rpt_desc);
 
     if (ret < 0) {
         perror("HIDIOCGRDESC");
@@ -483,21 +506,21 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
     }
 
     /* Get Raw Name */
-    ret = ioctl(hid_fd, HIDIOCGRAWNAME(256), buf);
+    ret = ioctl(camera->hidFd, HIDIOCGRAWNAME(256), buf);
     if (ret < 0) {
         perror("HIDIOCGRAWNAME");
         return false;
     }
 
     /* Get Physical Location */
-    ret = ioctl(hid_fd, HIDIOCGRAWPHYS(256), buf);
+    ret = ioctl(camera->hidFd, HIDIOCGRAWPHYS(256), buf);
     if (ret < 0) {
         perror("HIDIOCGRAWPHYS");
         return false;
     }    
 
     /* Get Raw Info */
-    ret = ioctl(hid_fd, HIDIOCGRAWINFO, &info);
+    ret = ioctl(camera->hidFd, HIDIOCGRAWINFO, &info);
     if (ret < 0) {
         perror("HIDIOCGRAWINFO");
         return false;
@@ -511,7 +534,7 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
     /*
      * Correcting OS code supported cameras
      */
-    if(selectedDeviceEnum == CommonEnums::SEE3CAM_11CUG || selectedDeviceEnum == CommonEnums::SEE3CAM_12CUNIR || selectedDeviceEnum == CommonEnums::ECON_1MP_BAYER_RGB  || selectedDeviceEnum == CommonEnums::ECON_1MP_MONOCHROME || selectedDeviceEnum == CommonEnums::SEE3CAM_CU51)
+    if(camera->cameraEnum == CommonEnums::SEE3CAM_11CUG || camera->cameraEnum == CommonEnums::SEE3CAM_12CUNIR || camera->cameraEnum == CommonEnums::ECON_1MP_BAYER_RGB  || camera->cameraEnum == CommonEnums::ECON_1MP_MONOCHROME || camera->cameraEnum == CommonEnums::SEE3CAM_CU51)
     {                                
         ret = sendOSCode();
         if (ret == false) {
@@ -520,12 +543,14 @@ bool uvccamera::initExtensionUnit(QString cameraName) {
     }    
     if(desc_size == DESCRIPTOR_SIZE_ENDPOINT)
         {
-            hid_fd = fd;
+            camera->hidFd = fd;
         }
         else if(desc_size == DESCRIPTOR_SIZE_IMU_ENDPOINT)
         {
             hid_imu = fd;
         }
+    // replies cached before the device was reopened may be stale
+    ControlCache::instance()->deviceOpened(camera->hidNode);
       return true;
     }
 
@@ -535,16 +560,18 @@ void uvccamera::getDeviceNodeName(QString hidDeviceNode) {
         emit logHandle(QtCriticalMsg,"hid Device usbAddress Not found as parameter\n");
         return;
     }
-    hidNode = hidDeviceNode;
+    session()->hidNode = hidDeviceNode;
 }
 
 void uvccamera::exitExtensionUnit() {
-        close(hid_fd);
+    if(hidFd() >= 0)
+        close(hidFd());
+    session()->hidFd = -1;
 }
 
 bool uvccamera::exitExtensionUnitAscella(){
     bool ret = false;        
-    if(handle != NULL){        
+    if(usbHandle() != NULL){        
         ret = closeAscellaDevice();
     }
     return ret;
@@ -553,7 +580,7 @@ bool uvccamera::exitExtensionUnitAscella(){
 
 bool uvccamera::sendOSCode() {
 
-    if(hid_fd < 0)
+    if(hidFd() < 0)
     {
         return false;
     }
@@ -569,7 +596,7 @@ bool uvccamera::sendOSCode() {
     g_out_packet_buf[2] = LINUX_OS;	/* Report Number for Linux OS */
 
     /* Send a Report to the Device */
-    ret = write(hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         emit logHandle(QtCriticalMsg, "\nOS Identification Failed\n");
@@ -579,7 +606,7 @@ bool uvccamera::sendOSCode() {
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -620,18 +647,18 @@ void uvccamera::getFirmWareVersion() {
 }
 
 void uvccamera::getSerialNumber(){
-     emit serialNumber("Serial Number: "+serialNumberMap.value(openNode));
+     emit serialNumber("Serial Number: "+serialNumberMap.value(session()->openNode));
 }
 
 QString uvccamera::retrieveSerialNumber()
 {
-    return serialNumberMap.value(openNode);
+    return serialNumberMap.value(session()->openNode);
 }
 
 bool See3CAM_Control::getFlashState(quint8 *flashState) {
 
     *flashState = 0;    
-    if(uvccamera::hid_fd < 0)
+    if(hidFd() < 0)
     {
         return false;
     }
@@ -648,15 +675,15 @@ bool See3CAM_Control::getFlashState(quint8 *flashState) {
      * Added camera enum comparision
      * Before its like camera name comparision
      */
-    if(selectedDeviceEnum == CommonEnums::ECON_8MP_CAMERA)
+    if(session()->cameraEnum == CommonEnums::ECON_8MP_CAMERA)
     {
         g_out_packet_buf[1] = CAMERA_CONTROL_80; /* Report Number */
     }
-    else if(selectedDeviceEnum == CommonEnums::SEE3CAM_CU50)
+    else if(session()->cameraEnum == CommonEnums::SEE3CAM_CU50)
     {
         g_out_packet_buf[1] = CAMERA_CONTROL_50; /* Report Number */
     }
-    else if(selectedDeviceEnum == CommonEnums::SEE3CAM_12CUNIR)
+    else if(session()->cameraEnum == CommonEnums::SEE3CAM_12CUNIR)
     {
         g_out_packet_buf[1] = CAMERA_CONTROL_AR0130; /* Report Number */
     }
@@ -664,7 +691,7 @@ bool See3CAM_Control::getFlashState(quint8 *flashState) {
     //g_out_packet_buf[1] = CAMERA_CONTROL_80; /* Report Number */
     g_out_packet_buf[2] = GET_FLASH_LEVEL; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
     if (ret < 0) {
         perror("write");
@@ -675,7 +702,7 @@ bool See3CAM_Control::getFlashState(quint8 *flashState) {
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -697,7 +724,7 @@ bool See3CAM_Control::getFlashState(quint8 *flashState) {
 
 bool See3CAM_Control::setFlashState(flashTorchState flashState)
 {   
-    if(uvccamera::hid_fd < 0)
+    if(hidFd() < 0)
     {
         return false;
     }
@@ -717,22 +744,22 @@ bool See3CAM_Control::setFlashState(flashTorchState flashState)
          * Added camera enum comparision
          * Before its like camera name comparision
          */
-        if(selectedDeviceEnum == CommonEnums::ECON_8MP_CAMERA)
+        if(session()->cameraEnum == CommonEnums::ECON_8MP_CAMERA)
         {
             g_out_packet_buf[1] = CAMERA_CONTROL_80; /* Report Number */
         }
-        else if(selectedDeviceEnum == CommonEnums::SEE3CAM_CU50)
+        else if(session()->cameraEnum == CommonEnums::SEE3CAM_CU50)
         {
             g_out_packet_buf[1] = CAMERA_CONTROL_50; /* Report Number */
         }
-        else if(selectedDeviceEnum == CommonEnums::SEE3CAM_12CUNIR)
+        else if(session()->cameraEnum == CommonEnums::SEE3CAM_12CUNIR)
         {
             g_out_packet_buf[1] = CAMERA_CONTROL_AR0130; /* Report Number */
         }
         g_out_packet_buf[2] = SET_FLASH_LEVEL; 	/* Report Number */
         g_out_packet_buf[3] = flashState;		/* Flash mode */
 
-        ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+        ret = write(hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
         if (ret < 0) {
             perror("write");
@@ -743,7 +770,7 @@ bool See3CAM_Control::setFlashState(flashTorchState flashState)
         while(timeout)
         {
             /* Get a report from the device */
-            ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+            ret = read(hidFd(), g_in_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 //perror("read");
             } else {                
@@ -776,7 +803,7 @@ bool See3CAM_Control::getTorchState(quint8 *torchState)
 {
 
     *torchState = 0;    
-    if(uvccamera::hid_fd < 0)
+    if(hidFd() < 0)
     {
         return false;
     }
@@ -793,20 +820,20 @@ bool See3CAM_Control::getTorchState(quint8 *torchState)
      * Added camera enum comparision
      * Before its like camera name comparision
      */
-    if(selectedDeviceEnum == CommonEnums::ECON_8MP_CAMERA)
+    if(session()->cameraEnum == CommonEnums::ECON_8MP_CAMERA)
     {
         g_out_packet_buf[1] = CAMERA_CONTROL_80; /* Report Number */
     }
-    else if(selectedDeviceEnum == CommonEnums::SEE3CAM_CU50)
+    else if(session()->cameraEnum == CommonEnums::SEE3CAM_CU50)
     {
         g_out_packet_buf[1] = CAMERA_CONTROL_50; /* Report Number */
     }
-    else if(selectedDeviceEnum == CommonEnums::SEE3CAM_CU51)
+    else if(session()->cameraEnum == CommonEnums::SEE3CAM_CU51)
     {
         g_out_packet_buf[1] = CAMERA_CONTROL_51; /* Report Number */
     }
     g_out_packet_buf[2] = GET_TORCH_LEVEL; /* Report Number */
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
@@ -816,7 +843,7 @@ bool See3CAM_Control::getTorchState(quint8 *torchState)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
             //perror("read");
         } else {            
@@ -838,7 +865,7 @@ bool See3CAM_Control::getTorchState(quint8 *torchState)
 
 bool See3CAM_Control::setTorchState(flashTorchState torchState)
 {    
-    if(uvccamera::hid_fd < 0)
+    if(hidFd() < 0)
     {
         return false;
     }
@@ -858,21 +885,21 @@ bool See3CAM_Control::setTorchState(flashTorchState torchState)
          * Added camera enum comparision
          * Before its like camera name comparision
          */
-        if(selectedDeviceEnum == CommonEnums::ECON_8MP_CAMERA)
+        if(session()->cameraEnum == CommonEnums::ECON_8MP_CAMERA)
         {
             g_out_packet_buf[1] = CAMERA_CONTROL_80; /* Report Number */
         }
-        else if(selectedDeviceEnum == CommonEnums::SEE3CAM_CU50)
+        else if(session()->cameraEnum == CommonEnums::SEE3CAM_CU50)
         {
             g_out_packet_buf[1] = CAMERA_CONTROL_50; /* Report Number */
         }
-        else if(selectedDeviceEnum == CommonEnums::SEE3CAM_CU51)
+        else if(session()->cameraEnum == CommonEnums::SEE3CAM_CU51)
         {
             g_out_packet_buf[1] = CAMERA_CONTROL_51; /* Report Number */
         }
         g_out_packet_buf[2] = SET_TORCH_LEVEL; 	/* Report Number */
 
-        if(selectedDeviceEnum == CommonEnums::SEE3CAM_CU51 && torchState == torchOff)
+        if(session()->cameraEnum == CommonEnums::SEE3CAM_CU51 && torchState == torchOff)
         {
             g_out_packet_buf[3] = 2;		/* Torch mode */
         }
@@ -881,7 +908,7 @@ bool See3CAM_Control::setTorchState(flashTorchState torchState)
              g_out_packet_buf[3] = torchState;		/* Torch mode */
         }
 
-        ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+        ret = write(hidFd(), g_out_packet_buf, BUFFER_LENGTH);
 
         if (ret < 0) {
             perror("write");
@@ -892,7 +919,7 @@ bool See3CAM_Control::setTorchState(flashTorchState torchState)
         while(timeout)
         {
             /* Get a report from the device */
-            ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+            ret = read(hidFd(), g_in_packet_buf, BUFFER_LENGTH);
             if (ret < 0) {
                 //perror("read");
             } else {                
@@ -940,7 +967,7 @@ void See3CAM_Control::setTorchControlState(const int torchState) {
 
 bool See3CAM_GPIOControl::getGpioLevel(camGpioPin gpioPinNumber)
 {    
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }    
@@ -957,7 +984,7 @@ bool See3CAM_GPIOControl::getGpioLevel(camGpioPin gpioPinNumber)
     g_out_packet_buf[3] = gpioPinNumber; 		/* GPIO Pin Number */
 
     /* Send a Report to the Device */
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
@@ -967,7 +994,7 @@ bool See3CAM_GPIOControl::getGpioLevel(camGpioPin gpioPinNumber)
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
 
         if (ret < 0) {
          //   perror("read");
@@ -995,7 +1022,7 @@ bool See3CAM_GPIOControl::getGpioLevel(camGpioPin gpioPinNumber)
 
 bool See3CAM_GPIOControl::setGpioLevel(camGpioPin gpioPin,camGpioValue gpioValue)
 {
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1014,7 +1041,7 @@ bool See3CAM_GPIOControl::setGpioLevel(camGpioPin gpioPin,camGpioValue gpioValue
     g_out_packet_buf[4] = gpioValue; 	/* GPIO Value */
 
     /* Send a Report to the Device */
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
@@ -1024,7 +1051,7 @@ bool See3CAM_GPIOControl::setGpioLevel(camGpioPin gpioPin,camGpioValue gpioValue
     while(timeout)
     {
         /* Get a report from the device */
-        ret = read(uvccamera::hid_fd, g_in_packet_buf, BUFFER_LENGTH);
+        ret = read(uvc.hidFd(), g_in_packet_buf, BUFFER_LENGTH);
         if (ret < 0) {
         //    perror("read");
         } else {
@@ -1055,7 +1082,7 @@ bool See3CAM_ModeControls::enableMasterMode()
 {
     int ret =0;
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1064,11 +1091,12 @@ bool See3CAM_ModeControls::enableMasterMode()
 
     //Set the Report Number
     g_out_packet_buf[1] = ENABLEMASTERMODE; /* Report Number */
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
     }
+    FrameSynchronizer::instance()->setTriggerMode(uvc.session(), false);
     return true;
 }
 
@@ -1077,7 +1105,7 @@ bool See3CAM_ModeControls::enableTriggerMode()
 {
     int ret =0;
 
-    if(uvccamera::hid_fd < 0)
+    if(uvc.hidFd() < 0)
     {
         return false;
     }
@@ -1087,11 +1115,13 @@ bool See3CAM_ModeControls::enableTriggerMode()
     //Set the Report Number
     g_out_packet_buf[1] = ENABLETRIGGERMODE; /* Report Number */
 
-    ret = write(uvccamera::hid_fd, g_out_packet_buf, BUFFER_LENGTH);
+    ret = write(uvc.hidFd(), g_out_packet_buf, BUFFER_LENGTH);
     if (ret < 0) {
         perror("write");
         return false;
     }
+    // frames of the synchronized cameras are paired by trigger from now on
+    FrameSynchronizer::instance()->setTriggerMode(uvc.session(), true);
     return true;
 }
 
@@ -1101,42 +1131,33 @@ bool See3CAM_ModeControls::enableTriggerMode()
  * @param outBuf - Buffer that fills to send into camera
  * @param inBuf  - Buffer to get reply back
  * @param len    - Buffer length
+ * @param kind   - HID_SETTING[_SUBID] journals the command for control profiles
  * return true/false
  * */
-bool uvccamera::sendHidCmd(unsigned char *outBuf, unsigned char *inBuf, int len)
+bool uvccamera::sendHidCmd(unsigned char *outBuf, unsigned char *inBuf, int len, int kind)
 {
-    // Write data into camera
-    int ret = write(hid_fd, outBuf, len);
-    if (ret < 0) {        
-        perror("write");
-        return false;
-    }
-    struct timeval tv;
-    fd_set rfds;
-
-    FD_ZERO(&rfds);
-    FD_SET(hid_fd, &rfds);
-
-    /* Wait up to 5 seconds. */
-    tv.tv_sec = 5;
-    tv.tv_usec = 0;
-
-    // Monitor read file descriptor for 5 secs
-
-    if(0 > select(1, &rfds, NULL, NULL, &tv)){
-
-      perror("select");
+    // Written and answered on the hid engine thread, waits up to HID_DEFAULT_TIMEOUT_MS for the reply
+    // while the gui keeps painting [see HidEngine::transact]
+    if (!HidEngine::instance()->transact(hidFd(), outBuf, inBuf, len))
         return false;
-    }
 
-    // Read data from camera
-    int retval = read(hid_fd, inBuf, len);
-    if (retval < 0) {
-    //    perror("read");
-        return false;
-    }
-    else{
-        return true;
-    }
+    // the command may have changed any control of this camera id
+    ControlCache *cache = ControlCache::instance();
+    if (QThread::currentThread() == cache->thread())
+        cache->commandSent(session()->hidNode, outBuf, len, kind);
+    return true;
+}
 
+/**
+ * @brief sendHidCmdAsync - Queue a hid command without waiting for the reply
+ * @param outBuf - Buffer that fills to send into camera
+ * @param len    - Buffer length
+ * @param receiver - object to get the reply
+ * @param member - slot name of receiver, called as member(QByteArray reply) when the reply
+ *                 with the same camera id and command id arrives
+ * return true/false
+ * */
+bool uvccamera::sendHidCmdAsync(unsigned char *outBuf, int len, QObject *receiver, const char *member)
+{
+    return ControlCache::instance()->request(session()->hidNode, hidFd(), outBuf, len, receiver, member);
 }
@@ -37,8 +37,13 @@
 #include "libudev.h"
 #include <libusb.h>
 #include <QMap>
+#include "controlcache.h"
 
 #include "common_enums.h"
+#include "deviceregistry.h"
+#include "hidengine.h"
+#include "controlcache.h"
+#include "camerasession.h"
 
 /* Report Numbers */
 #define APPLICATION_READY 	0x12
@@ -170,20 +175,27 @@ public:
      * int uvccamera::findEconDevice(QStringList, QString)
      */
     int findEconDevice(QString);
+    /**
+     * @brief updateDeviceMaps - fill the hid, serial number and vid/pid maps from the device registry
+     * instead of scanning udev with findEconDevice()
+     */
+    void updateDeviceMaps(const QList<CameraDeviceInfo> &devices);
     void getDeviceNodeName(QString);
     bool closeAscellaDevice();
 
-    static libusb_device_handle* handle;  /* handle for USB device */
-    int kernelDriverDetached;
-
     static QMap<QString, QString> cameraMap;
     static QMap<QString, QString> serialNumberMap;
-    static int hid_fd;
-    static QString hidNode;
+
     /**
-     * @brief selectedDeviceEnum - This contains selected camera device Enum value
+     * @brief session - camera this object controls, the selected session unless bound with setSession
      */
-    static CommonEnums::ECameraNames  selectedDeviceEnum;
+    CameraSession *session() const { return m_session ? m_session : CameraSession::selected(); }
+    void setSession(CameraSession *session) { m_session = session; }
+
+    // hidraw node of the extension unit, -1 if not opened
+    int hidFd() const { return session()->hidFd; }
+    // libusb handle of Ascella cameras
+    libusb_device_handle *usbHandle() const { return session()->usbHandle; }
 
 private:
     /**
@@ -209,7 +221,7 @@ private:
      */
     void initCameraEnumMap();
 
-    static QString openNode;
+    CameraSession *m_session;
     /**
      * @brief pidVidMap - This map contains the deviceName and Vid,Pid value
      */
@@ -257,8 +269,19 @@ public slots:
      * @param outBuf - Buffer that fills to send into camera
      * @param inBuf  - Buffer to get reply back
      * @param len    - Buffer length
+     * @param kind   - HID_SETTING[_SUBID] for commands which set a control, journaled for control profiles
      */
-    bool sendHidCmd(unsigned char *outBuf, unsigned char *inBuf, int len);
+    bool sendHidCmd(unsigned char *outBuf, unsigned char *inBuf, int len, int kind = HID_COMMAND);
+
+    /**
+     * @brief sendHidCmdAsync - Queue a get command, the reply is passed to receiver's member slot.
+     * Replies are cached per camera until a command is sent with sendHidCmd
+     * @param outBuf - Buffer that fills to send into camera
+     * @param len    - Buffer length
+     * @param receiver - object to get the reply
+     * @param member - slot name, called as member(QByteArray reply)
+     */
+    bool sendHidCmdAsync(unsigned char *outBuf, int len, QObject *receiver, const char *member);
 
     /**
      * @brief Get the firmware version of the camera
@@ -447,6 +470,7 @@ class See3CAM_ModeControls {
 private:
     unsigned char g_out_packet_buf[BUFFER_LENGTH];
     unsigned char g_in_packet_buf[BUFFER_LENGTH];
+    uvccamera uvc;
 public:
     /**
      * @brief Enable Camera in Master Mode
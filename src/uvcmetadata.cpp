@@ -0,0 +1,409 @@
+/*
+ * uvcmetadata.cpp -- frame capture time from the UVC metadata node
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uvcmetadata.h"
+#include <QDir>
+#include <QtEndian>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* bmHeaderInfo of the UVC payload header */
+#define UVC_HEADER_PTS      0x04
+#define UVC_HEADER_SCR      0x08
+
+/* struct uvc_meta_buf without the payload header */
+#define UVC_META_ENTRY_SIZE 10
+
+void UvcClock::reset()
+{
+    m_samples.clear();
+    m_next = 0;
+    m_lastStc = 0;
+    m_lastUnwrapped = 0;
+    m_started = false;
+    m_valid = false;
+}
+
+void UvcClock::addSample(quint32 stc, quint16 deviceSof, qint64 hostNs, quint16 hostSof)
+{
+    qint64 unwrapped = m_started ? m_lastUnwrapped + (qint32)(stc - m_lastStc) : stc;
+    bool repeated = m_started && unwrapped == m_lastUnwrapped;
+    m_started = true;
+    m_lastStc = stc;
+    m_lastUnwrapped = unwrapped;
+
+    // both frame numbers count the 1 ms frames of the same bus
+    int delay = (hostSof - deviceSof) & 0x7ff;
+    if (repeated || delay > UVC_MAX_SOF_DELAY)
+        return;
+
+    Sample sample;
+    sample.stc = unwrapped;
+    sample.ns = hostNs - delay * 1000000LL;
+    if (m_samples.size() < UVC_CLOCK_SAMPLES) {
+        m_samples.append(sample);
+    } else {
+        m_samples[m_next] = sample;
+        m_next = (m_next + 1) % UVC_CLOCK_SAMPLES;
+    }
+    fit();
+}
+
+/**
+ * @brief UvcClock::fit - least squares line through the samples, relative to the first one
+ * to keep the sums in double precision
+ */
+void UvcClock::fit()
+{
+    int n = m_samples.size();
+    m_valid = false;
+    if (n < 2)
+        return;
+
+    m_stc0 = m_samples.at(0).stc;
+    m_ns0 = m_samples.at(0).ns;
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int i = 0; i < n; i++) {
+        double x = m_samples.at(i).stc - m_stc0;
+        double y = m_samples.at(i).ns - m_ns0;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double var = n * sxx - sx * sx;
+    if (var <= 0)
+        return;
+    m_slope = (n * sxy - sx * sy) / var;
+    m_offset = (sy - m_slope * sx) / n;
+    m_valid = m_slope > 0;
+}
+
+bool UvcClock::hostTime(quint32 pts, qint64 &ns) const
+{
+    if (!m_valid)
+        return false;
+    qint64 unwrapped = m_lastUnwrapped + (qint32)(pts - m_lastStc);
+    ns = m_ns0 + (qint64)(m_offset + m_slope * (unwrapped - m_stc0));
+    return true;
+}
+
+double UvcClock::frequency() const
+{
+    return m_valid ? 1e9 / m_slope : 0;
+}
+
+UvcMetadata::UvcMetadata()
+{
+    m_notifier = NULL;
+    m_active = false;
+    m_streamOk = false;
+    m_replaying = false;
+    m_lastSequence = 0;
+
+    moveToThread(&m_thread);
+    m_thread.start();
+}
+
+UvcMetadata::~UvcMetadata()
+{
+    stop();
+    m_thread.quit();
+    m_thread.wait();
+}
+
+bool UvcMetadata::start(const QString &busInfo)
+{
+    stop();
+
+    // the metadata node is a separate video node of the same usb interface
+    QStringList nodes = QDir("/dev").entryList(QStringList() << "video*", QDir::System);
+    m_node.clear();
+    for (int i = 0; i < nodes.count() && m_node.isEmpty(); i++) {
+        v4l2 node;
+        v4l2_capability cap;
+        if (!node.open("/dev/" + nodes.at(i), false))
+            continue;
+        if ((node.caps() & V4L2_CAP_META_CAPTURE) && node.querycap(cap) &&
+                busInfo == QString((const char *)cap.bus_info))
+            m_node = "/dev/" + nodes.at(i);
+        node.close();
+    }
+    if (m_node.isEmpty())
+        return false;
+
+    m_clock.reset();
+    m_mutex.lock();
+    m_times.clear();
+    m_mutex.unlock();
+
+    QMetaObject::invokeMethod(this, "startStreaming", Qt::BlockingQueuedConnection);
+    m_active = m_streamOk;
+    return m_active;
+}
+
+bool UvcMetadata::startReplay(const QString &fileName)
+{
+    stop();
+
+    m_replay.setFileName(fileName);
+    if (!m_replay.open(QIODevice::ReadOnly))
+        return false;
+    QByteArray magic = m_replay.read(strlen(UVC_META_DUMP_MAGIC));
+    if (magic != UVC_META_DUMP_MAGIC) {
+        fprintf(stderr, "%s is not a recorded metadata stream\n", fileName.toLocal8Bit().constData());
+        m_replay.close();
+        return false;
+    }
+
+    m_node = fileName;
+    m_clock.reset();
+    m_mutex.lock();
+    m_times.clear();
+    m_mutex.unlock();
+    m_replaying = true;
+    m_active = true;
+    return true;
+}
+
+void UvcMetadata::stop()
+{
+    if (!m_active)
+        return;
+    m_active = false;
+    if (m_replaying) {
+        m_replay.close();
+        m_replaying = false;
+        return;
+    }
+    QMetaObject::invokeMethod(this, "stopStreaming", Qt::BlockingQueuedConnection);
+}
+
+void UvcMetadata::setDumpFile(const QString &fileName)
+{
+    m_dumpName = fileName;
+}
+
+void UvcMetadata::startStreaming()
+{
+    m_streamOk = false;
+    if (!m_device.open(m_node, false))
+        return;
+
+    v4l2_format fmt;
+    memset(&fmt, 0, sizeof(fmt));
+    fmt.type = V4L2_BUF_TYPE_META_CAPTURE;
+    // struct v4l2_meta_format, not in the headers of older kernels
+    __u32 dataformat = V4L2_META_FMT_UVC;
+    memcpy(fmt.fmt.raw_data, &dataformat, sizeof(dataformat));
+    if (!m_device.s_fmt(fmt))
+        fprintf(stderr, "UVC metadata: using the default format of %s\n", m_node.toLatin1().constData());
+
+    v4l2_requestbuffers req;
+    if (!m_device.reqbufs_mmap(req, V4L2_BUF_TYPE_META_CAPTURE, UVC_META_BUFFERS) || req.count < 2) {
+        m_device.close();
+        return;
+    }
+    for (uint i = 0; i < req.count; i++) {
+        v4l2_buffer buf;
+        memset(&buf, 0, sizeof(buf));
+        buf.type = V4L2_BUF_TYPE_META_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = i;
+        if (m_device.ioctl(VIDIOC_QUERYBUF, &buf) < 0) {
+            perror("UVC metadata: VIDIOC_QUERYBUF");
+            stopStreaming();
+            return;
+        }
+        MetaBuffer meta;
+        meta.length = buf.length;
+        meta.start = m_device.mmap(buf.length, buf.m.offset);
+        if (meta.start == MAP_FAILED) {
+            perror("UVC metadata: mmap");
+            stopStreaming();
+            return;
+        }
+        m_buffers.append(meta);
+        m_device.qbuf_mmap(i, V4L2_BUF_TYPE_META_CAPTURE);
+    }
+    if (!m_device.streamon(V4L2_BUF_TYPE_META_CAPTURE)) {
+        stopStreaming();
+        return;
+    }
+
+    if (!m_dumpName.isEmpty()) {
+        m_dump.setFileName(m_dumpName);
+        if (m_dump.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            m_dump.write(UVC_META_DUMP_MAGIC);
+    }
+
+    m_notifier = new QSocketNotifier(m_device.fd(), QSocketNotifier::Read, this);
+    connect(m_notifier, SIGNAL(activated(int)), this, SLOT(readBuffers()));
+    m_streamOk = true;
+}
+
+void UvcMetadata::stopStreaming()
+{
+    delete m_notifier;
+    m_notifier = NULL;
+    if (m_device.fd() >= 0) {
+        m_device.streamoff(V4L2_BUF_TYPE_META_CAPTURE);
+        for (int i = 0; i < m_buffers.count(); i++)
+            m_device.munmap(m_buffers.at(i).start, m_buffers.at(i).length);
+        v4l2_requestbuffers req;
+        m_device.reqbufs_mmap(req, V4L2_BUF_TYPE_META_CAPTURE, 0);
+        m_device.close();
+    }
+    m_buffers.clear();
+    if (m_dump.isOpen())
+        m_dump.close();
+}
+
+void UvcMetadata::readBuffers()
+{
+    v4l2_buffer buf;
+    bool again;
+
+    for (;;) {
+        buf.length = 0;
+        buf.m.planes = NULL;
+        if (!m_device.dqbuf_mmap(buf, V4L2_BUF_TYPE_META_CAPTURE, again)) {
+            // device is gone, the video side reports the unplug
+            m_notifier->setEnabled(false);
+            return;
+        }
+        if (again)
+            return;
+
+        const uint8_t *data = (const uint8_t *)m_buffers.at(buf.index).start;
+        qint64 ns;
+        if (!(buf.flags & V4L2_BUF_FLAG_ERROR) && parseBuffer(data, buf.bytesused, m_clock, ns))
+            storeTime(buf.sequence, ns);
+        if (m_dump.isOpen()) {
+            quint32 record[2] = { qToLittleEndian((quint32)buf.sequence), qToLittleEndian((quint32)buf.bytesused) };
+            m_dump.write((const char *)record, sizeof(record));
+            m_dump.write((const char *)data, buf.bytesused);
+        }
+        m_device.qbuf_mmap(buf.index, V4L2_BUF_TYPE_META_CAPTURE);
+    }
+}
+
+/**
+ * @brief UvcMetadata::parseBuffer - a buffer holds one uvc_meta_buf per payload header the
+ * driver kept [ns, sof, header], the PTS is the same in all headers of a frame
+ */
+bool UvcMetadata::parseBuffer(const uint8_t *data, uint size, UvcClock &clock, qint64 &ns)
+{
+    const uint8_t *p = data;
+    const uint8_t *end = data + size;
+    qint64 firstNs = -1;
+    quint32 pts = 0;
+    bool havePts = false;
+
+    while (end - p >= UVC_META_ENTRY_SIZE + 2) {
+        qint64 hostNs = qFromLittleEndian<qint64>(p);
+        quint16 hostSof = qFromLittleEndian<quint16>(p + 8);
+        uint8_t length = p[10];
+        uint8_t flags = p[11];
+        if (length < 2 || end - p < UVC_META_ENTRY_SIZE + length)
+            break;
+        const uint8_t *header = p + UVC_META_ENTRY_SIZE + 2;
+        int available = length - 2;
+        int offset = 0;
+
+        if (firstNs < 0)
+            firstNs = hostNs;
+        if (flags & UVC_HEADER_PTS) {
+            if (available >= 4 && !havePts) {
+                pts = qFromLittleEndian<quint32>(header);
+                havePts = true;
+            }
+            offset = 4;
+        }
+        if ((flags & UVC_HEADER_SCR) && available >= offset + 6) {
+            quint32 stc = qFromLittleEndian<quint32>(header + offset);
+            quint16 deviceSof = qFromLittleEndian<quint16>(header + offset + 4) & 0x7ff;
+            clock.addSample(stc, deviceSof, hostNs, hostSof & 0x7ff);
+        }
+        p += UVC_META_ENTRY_SIZE + length;
+    }
+    if (firstNs < 0)
+        return false;
+    if (!havePts || !clock.hostTime(pts, ns))
+        ns = firstNs;
+    return true;
+}
+
+void UvcMetadata::storeTime(quint32 sequence, qint64 ns)
+{
+    QMutexLocker locker(&m_mutex);
+    m_times.insert(sequence, ns);
+    m_lastSequence = sequence;
+    // frames which were never asked for (skipped, dropped by the video side)
+    if (m_times.count() > UVC_META_KEEP_FRAMES) {
+        QHash<quint32, qint64>::iterator it = m_times.begin();
+        while (it != m_times.end()) {
+            if ((qint32)(sequence - it.key()) >= UVC_META_KEEP_FRAMES)
+                it = m_times.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+bool UvcMetadata::frameTime(quint32 sequence, qint64 &ns)
+{
+    if (!m_active)
+        return false;
+    if (m_replaying)
+        replayUntil(sequence);
+
+    QMutexLocker locker(&m_mutex);
+    QHash<quint32, qint64>::iterator it = m_times.find(sequence);
+    if (it == m_times.end())
+        return false;
+    ns = it.value();
+    m_times.erase(it);
+    return true;
+}
+
+/**
+ * @brief UvcMetadata::replayUntil - decode the recorded buffers up to the one of this sequence
+ */
+bool UvcMetadata::replayUntil(quint32 sequence)
+{
+    while (!m_replay.atEnd()) {
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_times.isEmpty() && (qint32)(m_lastSequence - sequence) >= 0)
+                return true;
+        }
+        quint32 record[2];
+        if (m_replay.read((char *)record, sizeof(record)) != sizeof(record))
+            break;
+        quint32 recordSequence = qFromLittleEndian(record[0]);
+        QByteArray data = m_replay.read(qFromLittleEndian(record[1]));
+        qint64 ns;
+        if (parseBuffer((const uint8_t *)data.constData(), data.size(), m_clock, ns))
+            storeTime(recordSequence, ns);
+    }
+    return false;
+}
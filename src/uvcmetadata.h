@@ -0,0 +1,175 @@
+/*
+ * uvcmetadata.h -- frame capture time from the UVC metadata node
+ * Copyright © 2015  e-con Systems India Pvt. Limited
+ *
+ * This file is part of Qtcam.
+ *
+ * Qtcam is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * Qtcam is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Qtcam. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UVCMETADATA_H
+#define UVCMETADATA_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QHash>
+#include <QFile>
+#include <QVector>
+#include <QSocketNotifier>
+#include "v4l2-api.h"
+
+/* kernels before 4.16 don't define the metadata interface */
+#ifndef V4L2_BUF_TYPE_META_CAPTURE
+#define V4L2_BUF_TYPE_META_CAPTURE  13
+#endif
+#ifndef V4L2_CAP_META_CAPTURE
+#define V4L2_CAP_META_CAPTURE       0x00800000
+#endif
+#ifndef V4L2_META_FMT_UVC
+#define V4L2_META_FMT_UVC           v4l2_fourcc('U', 'V', 'C', 'H')
+#endif
+
+#define UVC_META_BUFFERS        8
+#define UVC_META_KEEP_FRAMES    64      /* capture times kept for frames not asked for yet */
+#define UVC_CLOCK_SAMPLES       32      /* SCR samples in the device clock fit */
+#define UVC_MAX_SOF_DELAY       32      /* ms between STC sample and host timestamp to trust the SOF correction */
+
+/* recorded metadata stream: magic, then per buffer [u32 sequence, u32 bytesused, data] */
+#define UVC_META_DUMP_MAGIC     "QTCMETA1"
+
+/**
+ * @brief The UvcClock class - maps the device clock (PTS/SCR of the UVC payload headers) to
+ * CLOCK_MONOTONIC. Each SCR gives the device clock (STC) at a USB frame number, the host
+ * timestamp of the same packet is moved back to that frame with its own frame number, and a
+ * line is fitted through the last UVC_CLOCK_SAMPLES pairs.
+ */
+class UvcClock
+{
+public:
+    UvcClock() { reset(); }
+
+    void reset();
+    void addSample(quint32 stc, quint16 deviceSof, qint64 hostNs, quint16 hostSof);
+    /**
+     * @brief hostTime - CLOCK_MONOTONIC ns of a device clock value near the last sample
+     * @return false until two samples are known
+     */
+    bool hostTime(quint32 pts, qint64 &ns) const;
+    // device clock frequency from the fit, 0 if unknown
+    double frequency() const;
+
+private:
+    struct Sample {
+        qint64 stc;         // unwrapped device clock
+        qint64 ns;
+    };
+    QVector<Sample> m_samples;
+    int m_next;
+    quint32 m_lastStc;
+    qint64 m_lastUnwrapped;
+    bool m_started;
+    // fit, ns = m_ns0 + m_offset + m_slope * (stc - m_stc0)
+    qint64 m_stc0, m_ns0;
+    double m_slope, m_offset;
+    bool m_valid;
+
+    void fit();
+};
+
+/**
+ * @brief The UvcMetadata class - streams the metadata node of a uvcvideo camera on its own
+ * thread and keeps the capture time of each frame by sequence number, for pairing with the
+ * video buffer of the same sequence.
+ * A recorded metadata stream can be replayed instead of the device, frames are then taken
+ * from the file as their sequence is asked for.
+ */
+class UvcMetadata : public QObject
+{
+    Q_OBJECT
+
+public:
+    UvcMetadata();
+    ~UvcMetadata();
+
+    /**
+     * @brief start - find the metadata node of the camera and stream it
+     * @param busInfo - bus_info of the video node
+     * @return false if the camera has no metadata node
+     */
+    bool start(const QString &busInfo);
+
+    /**
+     * @brief startReplay - use a stream recorded with setDumpFile instead of a device
+     */
+    bool startReplay(const QString &fileName);
+    void stop();
+
+    /**
+     * @brief setDumpFile - record the metadata buffers of the next start, empty to disable
+     */
+    void setDumpFile(const QString &fileName);
+
+    /**
+     * @brief frameTime - capture time of the video frame with this sequence number
+     * @param ns - CLOCK_MONOTONIC nanoseconds, start of exposure if the camera sends PTS/SCR,
+     * otherwise arrival of the first packet of the frame
+     * @return false if no metadata arrived for the frame
+     */
+    bool frameTime(quint32 sequence, qint64 &ns);
+
+    inline bool isActive() const { return m_active; }
+    inline const QString &node() const { return m_node; }
+
+    /**
+     * @brief parseBuffer - decode one V4L2_META_FMT_UVC buffer
+     * @param clock - updated from the SCR of the buffer
+     * @param ns - capture time of the frame
+     * @return false if the buffer has no usable header
+     */
+    static bool parseBuffer(const uint8_t *data, uint size, UvcClock &clock, qint64 &ns);
+
+private slots:
+    void startStreaming();
+    void stopStreaming();
+    void readBuffers();
+
+private:
+    struct MetaBuffer {
+        void *start;
+        size_t length;
+    };
+
+    void storeTime(quint32 sequence, qint64 ns);
+    bool replayUntil(quint32 sequence);
+
+    QThread m_thread;
+    v4l2 m_device;
+    QString m_node;
+    QSocketNotifier *m_notifier;
+    QVector<MetaBuffer> m_buffers;
+    bool m_active;
+    bool m_streamOk;
+
+    UvcClock m_clock;               // metadata thread, or caller's thread in replay
+    QMutex m_mutex;
+    QHash<quint32, qint64> m_times; // guarded by m_mutex
+    quint32 m_lastSequence;
+
+    QString m_dumpName;
+    QFile m_dump;
+    QFile m_replay;
+    bool m_replaying;
+};
+
+#endif // UVCMETADATA_H
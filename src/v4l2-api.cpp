@@ -30,6 +30,7 @@ bool v4l2::open(const QString &device, bool useWrapper)
 
 	m_device = device;
 	m_useWrapper = useWrapper;
+	m_controls.clear();
     m_fd = ::open(device.toLatin1(), O_RDWR | O_NONBLOCK);
     //m_fd = ::v4l2_open(device.toLatin1(), O_RDWR | O_NONBLOCK);
 	if (m_fd < 0) {
@@ -63,6 +64,7 @@ void v4l2::close()
     //    ::v4l2_close(m_fd);
     }
 	m_fd = -1;
+	m_controls.clear();
 }
 
 int v4l2::ioctl(unsigned cmd, void *arg)
@@ -149,6 +151,120 @@ bool v4l2::querymenu(v4l2_querymenu &qm)
 	return ioctl(VIDIOC_QUERYMENU, &qm) >= 0;
 }
 
+bool v4l2::query_controls(bool force)
+{
+	if (!m_controls.isEmpty() && !force)
+		return true;
+
+	v4l2_queryctrl qc;
+	m_controls.clear();
+	memset(&qc, 0, sizeof(qc));
+	qc.id = V4L2_CTRL_FLAG_NEXT_CTRL;
+	while (queryctrl(qc)) {
+		if (qc.type != V4L2_CTRL_TYPE_CTRL_CLASS)
+			m_controls.insert(qc.id, qc);
+		qc.id |= V4L2_CTRL_FLAG_NEXT_CTRL;
+	}
+	return !m_controls.isEmpty();
+}
+
+bool v4l2::control(__u32 id, v4l2_queryctrl &qc) const
+{
+	QMap<__u32, v4l2_queryctrl>::const_iterator it = m_controls.find(id);
+	if (it == m_controls.constEnd())
+		return false;
+	qc = it.value();
+	return true;
+}
+
+bool v4l2::g_ext_ctrls(QList<v4l2_ext_control> &ctrls)
+{
+	bool ok = true;
+	int first = 0;
+
+	// the list is split into runs of the same class, each run is one ioctl
+	while (first < ctrls.count()) {
+		__u32 ctrlClass = V4L2_CTRL_ID2CLASS(ctrls.at(first).id);
+		int last = first;
+		while (last < ctrls.count() && V4L2_CTRL_ID2CLASS(ctrls.at(last).id) == ctrlClass)
+			last++;
+
+		v4l2_ext_controls ext;
+		memset(&ext, 0, sizeof(ext));
+		ext.ctrl_class = ctrlClass;
+		ext.count = last - first;
+		ext.controls = &ctrls[first];
+		if (ioctl(VIDIOC_G_EXT_CTRLS, &ext) < 0) {
+			error(QString("VIDIOC_G_EXT_CTRLS: ") + strerror(errno));
+			ok = false;
+		}
+		first = last;
+	}
+	return ok;
+}
+
+/**
+ * s_ext_ctrls - apply all controls with one VIDIOC_S_EXT_CTRLS per class.
+ * Controls the driver refuses are left out and the rest of the class is applied
+ * again, refused controls get one more try afterwards since some of them only
+ * become writable once an auto control was switched off in the same batch.
+ * Returns false if any control was not applied, those are appended to failed.
+ */
+bool v4l2::s_ext_ctrls(QList<v4l2_ext_control> &ctrls, QList<v4l2_ext_control> *failed)
+{
+	QMap<__u32, QList<v4l2_ext_control> > byClass;
+	QList<v4l2_ext_control> refused;
+
+	for (int i = 0; i < ctrls.count(); i++)
+		byClass[V4L2_CTRL_ID2CLASS(ctrls.at(i).id)].append(ctrls.at(i));
+
+	QMap<__u32, QList<v4l2_ext_control> >::iterator it;
+	for (it = byClass.begin(); it != byClass.end(); ++it)
+		s_ext_ctrls_class(it.value(), refused);
+
+	if (!refused.isEmpty()) {
+		QList<v4l2_ext_control> retry = refused;
+		refused.clear();
+		byClass.clear();
+		for (int i = 0; i < retry.count(); i++)
+			byClass[V4L2_CTRL_ID2CLASS(retry.at(i).id)].append(retry.at(i));
+		for (it = byClass.begin(); it != byClass.end(); ++it)
+			s_ext_ctrls_class(it.value(), refused);
+	}
+
+	if (failed)
+		*failed += refused;
+	return refused.isEmpty();
+}
+
+void v4l2::s_ext_ctrls_class(QList<v4l2_ext_control> &ctrls, QList<v4l2_ext_control> &failed)
+{
+	while (!ctrls.isEmpty()) {
+		v4l2_ext_controls ext;
+		memset(&ext, 0, sizeof(ext));
+		ext.ctrl_class = V4L2_CTRL_ID2CLASS(ctrls.first().id);
+		ext.count = ctrls.count();
+		ext.controls = &ctrls[0];
+		if (ioctl(VIDIOC_S_EXT_CTRLS, &ext) >= 0)
+			return;
+
+		if (ext.error_idx < ext.count) {
+			// drivers roll the whole batch back, drop the offending control and try again
+			failed.append(ctrls.takeAt(ext.error_idx));
+			continue;
+		}
+
+		// the error is not tied to one control, find the refused ones one by one
+		for (int i = 0; i < ctrls.count(); i++) {
+			ext.count = 1;
+			ext.controls = &ctrls[i];
+			if (ioctl(VIDIOC_S_EXT_CTRLS, &ext) < 0)
+				failed.append(ctrls.at(i));
+		}
+		return;
+	}
+}
+
 bool v4l2::g_tuner(v4l2_tuner &tuner, unsigned index)
 {
 	memset(&tuner, 0, sizeof(tuner));
@@ -312,8 +428,8 @@ bool v4l2::g_fmt_sliced_vbi(v4l2_format &fmt)
 bool v4l2::try_fmt(v4l2_format &fmt)
 {
 	if (V4L2_TYPE_IS_MULTIPLANAR(fmt.type)) {
-		fmt.fmt.pix_mp.plane_fmt[0].bytesperline = 0;
-		fmt.fmt.pix_mp.plane_fmt[1].bytesperline = 0;
+		for (unsigned p = 0; p < VIDEO_MAX_PLANES; p++)
+			fmt.fmt.pix_mp.plane_fmt[p].bytesperline = 0;
 	} else {
 		fmt.fmt.pix.bytesperline = 0;
 	}
@@ -323,14 +439,43 @@ bool v4l2::try_fmt(v4l2_format &fmt)
 bool v4l2::s_fmt(v4l2_format &fmt)
 {
 	if (V4L2_TYPE_IS_MULTIPLANAR(fmt.type)) {
-		fmt.fmt.pix_mp.plane_fmt[0].bytesperline = 0;
-		fmt.fmt.pix_mp.plane_fmt[1].bytesperline = 0;
+		for (unsigned p = 0; p < VIDEO_MAX_PLANES; p++)
+			fmt.fmt.pix_mp.plane_fmt[p].bytesperline = 0;
 	} else {
 		fmt.fmt.pix.bytesperline = 0;
 	}    
 	return ioctl("Set Capture Format", VIDIOC_S_FMT, &fmt);
 }
 
+void v4l2::mplane_to_pix(const v4l2_format &mp, v4l2_format &pix)
+{
+	const v4l2_pix_format_mplane &src = mp.fmt.pix_mp;
+
+	memset(&pix, 0, sizeof(pix));
+	pix.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+	pix.fmt.pix.width = src.width;
+	pix.fmt.pix.height = src.height;
+	pix.fmt.pix.pixelformat = src.pixelformat;
+	pix.fmt.pix.field = src.field;
+	pix.fmt.pix.colorspace = src.colorspace;
+	pix.fmt.pix.bytesperline = src.plane_fmt[0].bytesperline;
+	for (unsigned p = 0; p < src.num_planes && p < VIDEO_MAX_PLANES; p++)
+		pix.fmt.pix.sizeimage += src.plane_fmt[p].sizeimage;
+}
+
+void v4l2::pix_to_mplane(const v4l2_format &pix, v4l2_format &mp)
+{
+	v4l2_pix_format_mplane &dst = mp.fmt.pix_mp;
+
+	memset(&mp, 0, sizeof(mp));
+	mp.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+	dst.width = pix.fmt.pix.width;
+	dst.height = pix.fmt.pix.height;
+	dst.pixelformat = pix.fmt.pix.pixelformat;
+	dst.field = pix.fmt.pix.field;
+	dst.colorspace = pix.fmt.pix.colorspace;
+}
+
 bool v4l2::enum_input(v4l2_input &in, bool init, int index)
 {
 	if (init) {
@@ -463,6 +608,26 @@ bool v4l2::reqbufs_mmap(v4l2_requestbuffers &reqbuf, __u32 buftype, int count)
 	return ioctl(VIDIOC_REQBUFS, &reqbuf) >= 0;
 }
 
+bool v4l2::reqbufs_dmabuf(v4l2_requestbuffers &reqbuf, __u32 buftype, int count)
+{
+	memset(&reqbuf, 0, sizeof (reqbuf));
+	reqbuf.type = buftype;
+	reqbuf.memory = V4L2_MEMORY_DMABUF;
+	reqbuf.count = count;
+
+	return ioctl(VIDIOC_REQBUFS, &reqbuf) >= 0;
+}
+
+bool v4l2::create_bufs_mmap(v4l2_create_buffers &createbuf, const v4l2_format &fmt, int count)
+{
+	memset(&createbuf, 0, sizeof (createbuf));
+	createbuf.memory = V4L2_MEMORY_MMAP;
+	createbuf.count = count;
+	createbuf.format = fmt;
+
+	return ioctl(VIDIOC_CREATE_BUFS, &createbuf) >= 0;
+}
+
 bool v4l2::dqbuf_mmap(v4l2_buffer &buf, __u32 buftype, bool &again)
 {
 	v4l2_plane *planes = buf.m.planes;
@@ -495,6 +660,22 @@ bool v4l2::dqbuf_user(v4l2_buffer &buf, __u32 buftype, bool &again)
 	return res >= 0 || again;
 }
 
+bool v4l2::dqbuf_dmabuf(v4l2_buffer &buf, __u32 buftype, bool &again)
+{
+	v4l2_plane *planes = buf.m.planes;
+	unsigned length = buf.length;
+	int res;
+
+	memset(&buf, 0, sizeof(buf));
+	buf.length = length;
+	buf.m.planes = planes;
+	buf.type = buftype;
+	buf.memory = V4L2_MEMORY_DMABUF;
+	res = ioctl(VIDIOC_DQBUF, &buf);
+	again = res < 0 && errno == EAGAIN;
+	return res >= 0 || again;
+}
+
 bool v4l2::qbuf(v4l2_buffer &buf)
 {
 	return ioctl(VIDIOC_QBUF, &buf) >= 0;
@@ -506,10 +687,11 @@ bool v4l2::qbuf_mmap(int index, __u32 buftype)
 	v4l2_buffer buf;
 
 	memset(&buf, 0, sizeof(buf));
+	memset(planes, 0, sizeof(planes));
 	buf.type = buftype;
 	buf.memory = V4L2_MEMORY_MMAP;
 	buf.index = index;
-	buf.length = 2;
+	buf.length = VIDEO_MAX_PLANES;
 	buf.m.planes = planes;
 	return qbuf(buf);
 }
@@ -537,6 +719,29 @@ bool v4l2::qbuf_user(int index, __u32 buftype, void *ptr[], size_t length[])
 	return qbuf(buf);
 }
 
+bool v4l2::qbuf_dmabuf(int index, __u32 buftype, int fd[], size_t length[])
+{
+	v4l2_plane planes[VIDEO_MAX_PLANES];
+	v4l2_buffer buf;
+
+	memset(&buf, 0, sizeof(buf));
+	buf.type = buftype;
+	buf.memory = V4L2_MEMORY_DMABUF;
+	if (V4L2_TYPE_IS_MULTIPLANAR(buftype)) {
+		buf.length = 2;
+		buf.m.planes = planes;
+		planes[0].length = length[0];
+		planes[0].m.fd = fd[0];
+		planes[1].length = length[1];
+		planes[1].m.fd = fd[1];
+	} else {
+		buf.m.fd = fd[0];
+		buf.length = length[0];
+	}
+	buf.index = index;
+	return qbuf(buf);
+}
+
 bool v4l2::streamon(__u32 buftype)
 {
 	return ioctl("Start Streaming", VIDIOC_STREAMON, &buftype);
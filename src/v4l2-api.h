@@ -21,6 +21,8 @@
 #define V4L2_API_H
 
 #include <QString>
+#include <QList>
+#include <QMap>
 #include <linux/videodev2.h>
 #include <linux/uvcvideo.h>
 #include <libv4lconvert.h>
@@ -33,7 +35,8 @@ public:
 		m_fd(old.m_fd),
 		m_device(old.m_device),
 		m_useWrapper(old.m_useWrapper),
-		m_capability(old.m_capability)
+		m_capability(old.m_capability),
+		m_controls(old.m_controls)
 	{}
 
 	bool open(const QString &device, bool useWrapper = true);
@@ -61,6 +64,15 @@ public:
 	bool queryctrl(v4l2_queryctrl &qc);
 	bool extQueryCtrl(uvc_xu_control_query &ctrl);
 	bool querymenu(v4l2_querymenu &qm);
+
+	/* Extended controls. The descriptors are enumerated once per open with
+	 * V4L2_CTRL_FLAG_NEXT_CTRL, values are read and written with one
+	 * VIDIOC_G/S_EXT_CTRLS per control class. */
+	bool query_controls(bool force = false);
+	inline const QMap<__u32, v4l2_queryctrl> &controls() const { return m_controls; }
+	bool control(__u32 id, v4l2_queryctrl &qc) const;
+	bool g_ext_ctrls(QList<v4l2_ext_control> &ctrls);
+	bool s_ext_ctrls(QList<v4l2_ext_control> &ctrls, QList<v4l2_ext_control> *failed = 0);
 	bool g_tuner(v4l2_tuner &tuner, unsigned index = 0);
 	bool s_tuner(v4l2_tuner &tuner);
 	bool g_modulator(v4l2_modulator &modulator);
@@ -88,6 +100,9 @@ public:
 	bool g_fmt_sliced_vbi(v4l2_format &fmt);
 	bool try_fmt(v4l2_format &fmt);
 	bool s_fmt(v4l2_format &fmt);
+	// single-planar view of a multi-planar format: bytesperline of plane 0, sizeimage of all planes
+	static void mplane_to_pix(const v4l2_format &mp, v4l2_format &pix);
+	static void pix_to_mplane(const v4l2_format &pix, v4l2_format &mp);
 	bool enum_input(v4l2_input &in, bool init = false, int index = 0);
 	bool enum_output(v4l2_output &out, bool init = false, int index = 0);
 	bool enum_audio(v4l2_audio &audio, bool init = false);
@@ -101,11 +116,15 @@ public:
 
 	bool reqbufs_mmap(v4l2_requestbuffers &reqbuf, __u32 buftype, int count = 0);
 	bool reqbufs_user(v4l2_requestbuffers &reqbuf, __u32 buftype, int count = 0);
+	bool reqbufs_dmabuf(v4l2_requestbuffers &reqbuf, __u32 buftype, int count = 0);
+	bool create_bufs_mmap(v4l2_create_buffers &createbuf, const v4l2_format &fmt, int count);
 	bool dqbuf_mmap(v4l2_buffer &buf, __u32 buftype, bool &again);
 	bool dqbuf_user(v4l2_buffer &buf, __u32 buftype, bool &again);
+	bool dqbuf_dmabuf(v4l2_buffer &buf, __u32 buftype, bool &again);
 	bool qbuf(v4l2_buffer &buf);
 	bool qbuf_mmap(int index, __u32 buftype);
 	bool qbuf_user(int index, __u32 buftype, void *ptr[], size_t length[]);
+	bool qbuf_dmabuf(int index, __u32 buftype, int fd[], size_t length[]);
 	bool streamon(__u32 buftype);
 	bool streamoff(__u32 buftype);
 	v4l2_fract g_pixel_aspect(unsigned type);
@@ -155,12 +174,14 @@ public:
 	bool get_interval(unsigned type, v4l2_fract &interval);
 private:
 	void clear() { error(QString()); }
+	void s_ext_ctrls_class(QList<v4l2_ext_control> &ctrls, QList<v4l2_ext_control> &failed);
 
 private:
 	int 		m_fd;
 	QString 	m_device;
 	bool 		m_useWrapper;		// true if using the libv4l2 wrappers
 	v4l2_capability m_capability;
+	QMap<__u32, v4l2_queryctrl> m_controls;	// control descriptors by id, empty until query_controls()
 };
 
 #endif
@@ -22,6 +22,7 @@
 #include "videoencoder.h"
 #include <sys/time.h>
 #include <QDebug>
+#include <QFileInfo>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -31,6 +32,8 @@
 using namespace std;
 static int64_t audioPts = 0;
 
+QAtomicInt VideoEncoder::s_openEncoders;
+
 
 /**
   gop: maximal interval in frames between keyframes
@@ -39,7 +42,14 @@ VideoEncoder::VideoEncoder()
 {
     initVars();
     initCodec();
+    m_muxMutex = QSharedPointer<QMutex>(new QMutex);
+    m_muxWriter = QSharedPointer<MuxWriter>(new MuxWriter);
     frameCount = 0;
+    m_sentFrames = 0;
+    m_lastPts = AV_NOPTS_VALUE;
+    m_frameTimeNs = m_firstFrameTimeNs = 0;
+    memset(m_srcPlanes, 0, sizeof(m_srcPlanes));
+    memset(m_srcStrides, 0, sizeof(m_srcStrides));
     pAudioFrame = 0;
     samples = 0;  
 
@@ -48,6 +58,7 @@ VideoEncoder::VideoEncoder()
     pkt.size = 0;
     videoPacketReceived = false;
     m_recStop = false;
+    m_streamServer = NULL;
 }
 
 unsigned int VideoEncoder::getTickCount()
@@ -65,9 +76,9 @@ VideoEncoder::~VideoEncoder()
 }
 
 #if LIBAVCODEC_VER_AT_LEAST(54,25)
-bool VideoEncoder::createFile(QString fileName,AVCodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitrate, int audioDeviceIndex, int sampleRate, int channels)
+bool VideoEncoder::createFile(QString fileName,AVCodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitrate, int audioDeviceIndex, int sampleRate, int channels, const EncoderSettings &settings)
 #else
-bool VideoEncoder::createFile(QString fileName,CodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitrate, int audioDeviceIndex, int sampleRate, int channels)
+bool VideoEncoder::createFile(QString fileName,CodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitrate, int audioDeviceIndex, int sampleRate, int channels, const EncoderSettings &settings)
 #endif
 {
     // If we had an open video, close it.
@@ -76,6 +87,13 @@ bool VideoEncoder::createFile(QString fileName,CodecID encodeType, unsigned widt
     Width=width;
     Height=height;
     Bitrate=bitrate;
+    m_settings = settings;
+    m_sentFrames = 0;
+    m_firstFrameTimeNs = 0;
+    m_lastPts = AV_NOPTS_VALUE;
+    m_segmentBytes.store(0);
+    m_keyRequested = false;
+    m_cutRequested.store(0);
 
 #if 0
     if(!isSizeValid())
@@ -163,19 +181,27 @@ bool VideoEncoder::createFile(QString fileName,CodecID encodeType, unsigned widt
             pCodecCtx->time_base = (AVRational){1, 15};
         }
 
-        pCodecCtx->qmax = 4;
-        pCodecCtx->qmin = 1;
+        if(m_settings.rateControl == ENCODER_RC_DEFAULT){
+            pCodecCtx->qmax = 4;
+            pCodecCtx->qmin = 1;
+        }
+
+        pCodecCtx->gop_size = m_settings.gop > 0 ? m_settings.gop : 12;
 
-        pCodecCtx->gop_size = 12; // mjpg
+        // frame and slice threads, the codec uses whichever it supports
+        int encoders = s_openEncoders.load() + 1;
+        pCodecCtx->thread_count = m_settings.threads > 0 ? m_settings.threads :
+                qBound(1, QThread::idealThreadCount() / encoders, ENCODER_MAX_THREADS);
+        pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
         pVideoStream->time_base.den = pCodecCtx->time_base.den;
         pVideoStream->time_base.num = pCodecCtx->time_base.num;
 
 
         tempExtensionCheck = fileName.mid(fileName.length()-3);
 #if !LIBAVCODEC_VER_AT_LEAST(54, 25)
-        if(pOutputFormat->video_codec == CODEC_ID_H264) {
+        if(pOutputFormat->video_codec == CODEC_ID_H264 && m_settings.rateControl == ENCODER_RC_DEFAULT) {
 #else
-        if(pOutputFormat->video_codec == AV_CODEC_ID_H264) {
+        if(pOutputFormat->video_codec == AV_CODEC_ID_H264 && m_settings.rateControl == ENCODER_RC_DEFAULT) {
 #endif
             pCodecCtx->qmin = 15; // qmin = 10*
             pCodecCtx->qmax = 30; //qmax = 51 **
@@ -191,11 +217,20 @@ bool VideoEncoder::createFile(QString fileName,CodecID encodeType, unsigned widt
 	// Added by Sankari: Mar 11, 2019
 	// Dictionary options are set to make audio video sync(especially in H264 encoder)
         AVDictionary *opts = NULL;
-        av_dict_set(&opts, "tune", "zerolatency", 0);
-        av_dict_set(&opts, "preset","ultrafast",0);
+        if(!m_settings.tune.isEmpty())
+            av_dict_set(&opts, "tune", m_settings.tune.toLatin1().constData(), 0);
+        if(!m_settings.preset.isEmpty())
+            av_dict_set(&opts, "preset", m_settings.preset.toLatin1().constData(), 0);
+        setupRateControl(&opts);
+        // a keyframe asked for at a segment cut must be an IDR for the segment to play on its own
+        if(m_settings.segmentSeconds > 0 || m_settings.segmentBytes > 0)
+            av_dict_set(&opts, "forced-idr", "1", 0);
 #if LIBAVCODEC_VER_AT_LEAST(53,6)
-        if (avcodec_open2(pCodecCtx, pCodec,&opts) < 0)
+        int openRet = avcodec_open2(pCodecCtx, pCodec,&opts);
+        av_dict_free(&opts);
+        if (openRet < 0)
 #else
+        av_dict_free(&opts);
         if (avcodec_open(pCodecCtx, pCodec) < 0)
 #endif
         {
@@ -238,30 +273,90 @@ bool VideoEncoder::createFile(QString fileName,CodecID encodeType, unsigned widt
     }
 
 
-    if (!(pOutputFormat->flags & AVFMT_NOFILE)) {
-        if (avio_open(&pFormatCtx->pb, fileName.toStdString().c_str(), AVIO_FLAG_WRITE) < 0) {
-            fprintf(stderr, "Could not open '%s'\n", fileName.toStdString().c_str());
-            return 1;
-        }
+    // segments are named <name>_000.<ext>, <name>_001.<ext>.. and listed in <name>.csv
+    QString outputName = fileName;
+    QString indexFile;
+    if(m_settings.segmentSeconds > 0 || m_settings.segmentBytes > 0){
+        QString suffix = QFileInfo(fileName).suffix();
+        QString baseName = fileName.left(fileName.length() - suffix.length() - 1);
+        outputName = baseName + "_%1." + suffix;
+        indexFile = baseName + ".csv";
+    }
+    if (!m_muxWriter->open(pFormatCtx, outputName, m_settings.ioFlags, m_muxMutex.data(), indexFile)) {
+        return false;
     }
 
-    int ret = avformat_write_header(pFormatCtx,NULL);
+    int ret = m_muxWriter->writeHeader();
     if(ret<0) {
         return false;
     }
     ok=true;
+    s_openEncoders.ref();
+    m_segmentClock.start();
 
     frameCount = 0; // recording frame count - initialization
     return true;
 }
 
 
+/**
+ * @brief VideoEncoder::setupRateControl - bitrate, quantizer and private options of the video codec
+ * @param opts - options passed to avcodec_open2
+ */
+void VideoEncoder::setupRateControl(AVDictionary **opts)
+{
+#if !LIBAVCODEC_VER_AT_LEAST(54, 25)
+    bool h264 = (pCodecCtx->codec_id == CODEC_ID_H264);
+#else
+    bool h264 = (pCodecCtx->codec_id == AV_CODEC_ID_H264);
+#endif
+    int64_t bitRate = m_settings.bitRate ? (int64_t)m_settings.bitRate : pCodecCtx->bit_rate;
+    int quality = qBound(h264 ? 0 : 1, m_settings.quality, h264 ? 51 : 31);
+
+    switch(m_settings.rateControl){
+    case ENCODER_RC_CBR:
+        pCodecCtx->bit_rate = bitRate;
+        pCodecCtx->rc_min_rate = bitRate;
+        pCodecCtx->rc_max_rate = bitRate;
+        // one second of vbv buffer
+        pCodecCtx->rc_buffer_size = bitRate;
+        if(h264)
+            av_dict_set(opts, "nal-hrd", "cbr", 0);
+        break;
+    case ENCODER_RC_VBR:
+        pCodecCtx->bit_rate = bitRate;
+        pCodecCtx->rc_max_rate = bitRate * 2;
+        pCodecCtx->rc_buffer_size = bitRate * 2;
+        break;
+    case ENCODER_RC_CRF:
+    case ENCODER_RC_CQP:
+        if(h264){
+            av_dict_set(opts, m_settings.rateControl == ENCODER_RC_CRF ? "crf" : "qp", QByteArray::number(quality).constData(), 0);
+        }else{
+            // mjpeg has no rate control of its own, a fixed quantizer scale is the nearest
+            pCodecCtx->flags |= CODEC_FLAG_QSCALE;
+            pCodecCtx->global_quality = FF_QP2LAMBDA * quality;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 bool VideoEncoder::closeFile()
 {
     if(!isOk())
         return false;
 
-    av_write_trailer(pFormatCtx);
+#if LIBAVCODEC_VER_AT_LEAST(57,37)
+    // frame threads and lookahead hold frames back, drain them before the trailer
+    if(m_sentFrames > 0 && avcodec_send_frame(pCodecCtx, NULL) == 0)
+        receivePackets();
+#endif
+
+    // queued packets and the trailer of the last file
+    m_muxWriter->close();
+    s_openEncoders.deref();
 
     // close_video
     avcodec_close(pVideoStream->codec);
@@ -285,9 +380,6 @@ bool VideoEncoder::closeFile()
 
     sws_freeContext(img_convert_ctx);    
 
-    // Close file
-    avio_close(pFormatCtx->pb);
-
     // Free the stream
     av_free(pFormatCtx);
 
@@ -318,6 +410,80 @@ int VideoEncoder::encodeImage(uint8_t *buffer, bool rgbBufferformat)
  * @return 0 if success/ -ve if failure
  */
 
+#if LIBAVCODEC_VER_AT_LEAST(57,37)
+int VideoEncoder::encodePacket(uint8_t *buffer, bool rgbBufferformat){
+    if(!isOk())
+        return -1;
+
+    if(m_sentFrames == 0){
+        time1 = QTime::currentTime();
+        m_firstFrameTimeNs = m_frameTimeNs;
+    }
+
+    convertImage_sws(buffer, rgbBufferformat);
+
+    // capture time in the codec time base, the encoder derives pts/dts of reordered frames from it
+    int64_t pts = captureTimePts(av_rescale_q(time1.msecsTo(QTime::currentTime()), (AVRational){1, 1000}, pCodecCtx->time_base));
+    if(m_lastPts != AV_NOPTS_VALUE && pts <= m_lastPts)
+        pts = m_lastPts + 1;
+    ppicture->pts = m_lastPts = pts;
+    // the cut waits for a keyframe, ask for one instead of waiting for the end of the gop
+    if(!m_keyRequested && segmentDue()){
+        ppicture->pict_type = AV_PICTURE_TYPE_I;
+        m_keyRequested = true;
+    }
+
+    int ret = avcodec_send_frame(pCodecCtx, ppicture);
+    if (ret < 0) {
+        char errText[999]="";
+        av_strerror(ret, errText, 999);
+        fprintf(stderr, "Error encoding a video frame: %s\n", errText);
+        return -1;
+    }
+    m_sentFrames++;
+    ppicture->pict_type = AV_PICTURE_TYPE_NONE;
+    return receivePackets();
+}
+
+/**
+ * @brief VideoEncoder::receivePackets - pass the packets the encoder has finished to the muxer
+ * @return 0 if success/ -ve if failure
+ */
+int VideoEncoder::receivePackets(){
+    int out_size = 0;
+
+    if(pkt.data != NULL && pkt.size != 0){
+        av_packet_unref(&pkt);
+    }
+
+    for(;;){
+        int ret = avcodec_receive_packet(pCodecCtx, &pkt);
+        if(ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+            break;
+        if(ret < 0){
+            fprintf(stderr, "Error receiving a video packet\n");
+            out_size = -1;
+            break;
+        }
+
+        frameCount++;
+        pkt.stream_index = pVideoStream->index;
+        av_packet_rescale_ts(&pkt, pCodecCtx->time_base, pVideoStream->time_base);
+
+        // live view gets the packet before the muxer takes it over
+        streamPacket(pkt.data, pkt.size);
+        out_size = writeFrame(&pkt, true);
+        if(out_size == 0){
+            videoPacketReceived = true;
+            m_recStop = false;
+        }
+        av_packet_unref(&pkt);
+    }
+    pkt.data = NULL;
+    pkt.size = 0;
+    return out_size;
+}
+#else
 int VideoEncoder::encodePacket(uint8_t *buffer, bool rgbBufferformat){
     double fps, recordTimeDurationInSec, millisecondsDiff;
     if(frameCount == 0){
@@ -392,8 +558,10 @@ int VideoEncoder::encodePacket(uint8_t *buffer, bool rgbBufferformat){
         pts_prev = pkt.pts;
         if(pCodecCtx->coded_frame->key_frame)
             pkt.flags |= AV_PKT_FLAG_KEY;
+        // live view gets the packet before the muxer takes it over
+        streamPacket(pkt.data, pkt.size);
         /* Write the compressed frame to the media file. */
-        out_size = av_interleaved_write_frame(pFormatCtx, &pkt);
+        out_size = writeFrame(&pkt, true);
         if(out_size == 0){
             videoPacketReceived = true;
             m_recStop = false;
@@ -401,6 +569,7 @@ int VideoEncoder::encodePacket(uint8_t *buffer, bool rgbBufferformat){
     }
     return out_size;
 }
+#endif
 #else
 int VideoEncoder::encodeImage(uint8_t *buffer, bool rgbBufferformat)
 {
@@ -452,8 +621,9 @@ int VideoEncoder::encodeImage(uint8_t *buffer, bool rgbBufferformat)
        pkt.stream_index = pVideoStream->index;
        pkt.data = outbuf;
        pkt.size = out_size;       
+       streamPacket(outbuf, out_size);
        /* write the compressed frame in the media file */
-       ret = av_write_frame(pFormatCtx, &pkt);
+       ret = writeFrame(&pkt, false);
 
        if(ret == 0){
         videoPacketReceived = true;
@@ -470,6 +640,94 @@ int VideoEncoder::encodeImage(uint8_t *buffer, bool rgbBufferformat)
 #endif
 
 
+/**
+ * @brief VideoEncoder::streamPacket - offer an encoded MJPEG/H264 packet to the stream server
+ * The H264 stream needs SPS/PPS from extradata when the container wants global headers.
+ */
+void VideoEncoder::streamPacket(const uint8_t *data, int size)
+{
+    if(m_streamServer == NULL || !m_streamServer->isRunning() || pCodecCtx == NULL)
+        return;
+#if !LIBAVCODEC_VER_AT_LEAST(54, 25)
+    if(pCodecCtx->codec_id == CODEC_ID_MJPEG){
+#else
+    if(pCodecCtx->codec_id == AV_CODEC_ID_MJPEG){
+#endif
+        m_streamServer->pushFrame(StreamServer::MJPEG_STREAM, data, size);
+#if !LIBAVCODEC_VER_AT_LEAST(54, 25)
+    }else if(pCodecCtx->codec_id == CODEC_ID_H264){
+#else
+    }else if(pCodecCtx->codec_id == AV_CODEC_ID_H264){
+#endif
+        if(frameCount <= 1)   // new recording - replace parameter sets of the last one
+            m_streamServer->setH264Header(QByteArray((const char *)pCodecCtx->extradata, pCodecCtx->extradata_size));
+        m_streamServer->pushFrame(StreamServer::H264_STREAM, data, size);
+    }
+}
+
+/**
+ * @brief VideoEncoder::writeFrame - hand one packet to the muxer.
+ * Audio packets come from the audio encode thread and video from the capture or jpeg decode
+ * thread. Both are queued to the writer thread, the caller keeps ownership of the packet.
+ * @param packet - encoded packet
+ * @param interleaved - use av_interleaved_write_frame
+ * @return 0 if queued/ -ve if writing failed earlier
+ */
+int VideoEncoder::writeFrame(AVPacket *packet, bool interleaved)
+{
+    if(m_muxWriter->isSegmented() && pVideoStream && packet->stream_index == pVideoStream->index &&
+            (packet->flags & AV_PKT_FLAG_KEY) && segmentDue()){
+        m_muxWriter->cut();
+        m_segmentBytes.store(0);
+        m_segmentClock.restart();
+        m_keyRequested = false;
+        m_cutRequested.store(0);
+    }
+    m_segmentBytes.fetchAndAddRelaxed(packet->size);
+    return m_muxWriter->write(packet, interleaved);
+}
+
+bool VideoEncoder::segmentDue()
+{
+    if(m_cutRequested.load())
+        return true;
+    if(m_settings.segmentSeconds > 0 && m_segmentClock.elapsed() >= m_settings.segmentSeconds * 1000LL)
+        return true;
+    return m_settings.segmentBytes > 0 && m_segmentBytes.load() >= m_settings.segmentBytes;
+}
+
+bool VideoEncoder::requestSegment()
+{
+    if(!m_muxWriter->isSegmented())
+        return false;
+    m_cutRequested.store(1);
+    return true;
+}
+
+/**
+ * @brief VideoEncoder::isH264KeyFrame - access unit contains an IDR slice
+ * @param data - annex B byte stream
+ */
+bool VideoEncoder::isH264KeyFrame(const uint8_t *data, int size)
+{
+    for(int i = 0; i + 3 < size; i++){
+        if(data[i] == 0 && data[i+1] == 0 && data[i+2] == 1){
+            int nalType = data[i+3] & 0x1f;
+            if(nalType == 5)
+                return true;
+            if(nalType == 1)    // non IDR slice
+                return false;
+            i += 2;
+        }
+    }
+    return false;
+}
+
+void VideoEncoder::setMetadata(const char *key, QString value)
+{
+    m_muxWriter->setMetadata(key, value);
+}
+
 void VideoEncoder::initVars()
 {
     ok=false;
@@ -583,8 +841,37 @@ void VideoEncoder::freeFrame()
     }
 }
 
+/**
+ * @brief VideoEncoder::encodeYUV420 - planar capture formats skip the packed yuyv buffer, the
+ * planes are scaled straight into the codec frame [a plain copy for yuv420p codecs]
+ */
+int VideoEncoder::encodeYUV420(uint8_t *planes[3], int strides[3])
+{
+    for(int i = 0; i < 3; i++){
+        m_srcPlanes[i] = planes[i];
+        m_srcStrides[i] = strides[i];
+    }
+    int ret = encodeImage(NULL, false);
+    memset(m_srcPlanes, 0, sizeof(m_srcPlanes));
+    return ret;
+}
+
 bool VideoEncoder::convertImage_sws(uint8_t *buffer, bool rgbBufferformat)
 {
+    if(!buffer){
+        if(!m_srcPlanes[0])
+            return false;
+#if !LIBAVCODEC_VER_AT_LEAST(54, 25)
+        img_convert_ctx = sws_getCachedContext(img_convert_ctx,getWidth(),getHeight(), PIX_FMT_YUV420P,getWidth(),getHeight(),pCodecCtx->pix_fmt,SWS_FAST_BILINEAR, NULL, NULL, NULL);
+#else
+        img_convert_ctx = sws_getCachedContext(img_convert_ctx,getWidth(),getHeight(),AV_PIX_FMT_YUV420P,getWidth(),getHeight(),pCodecCtx->pix_fmt,SWS_FAST_BILINEAR, NULL, NULL, NULL);
+#endif
+        if (img_convert_ctx == NULL)
+            return false;
+        sws_scale(img_convert_ctx, m_srcPlanes, m_srcStrides, 0, getHeight(), ppicture->data, ppicture->linesize);
+        return true;
+    }
+
     if(rgbBufferformat){
 #if !LIBAVCODEC_VER_AT_LEAST(54, 25)
         img_convert_ctx = sws_getCachedContext(img_convert_ctx,getWidth(),getHeight(), PIX_FMT_RGBA,getWidth(),getHeight(),pCodecCtx->pix_fmt,SWS_FAST_BILINEAR, NULL, NULL, NULL);
@@ -629,14 +916,26 @@ bool VideoEncoder::convertImage_sws(uint8_t *buffer, bool rgbBufferformat)
    @param : buffer - raw h264 buffer
    @param : bytesused - bytes in buffer
 **/
-int VideoEncoder::writeH264Image(void *buffer, int bytesused){    
+int VideoEncoder::writeH264Image(void *buffer, int bytesused, AVBufferRef *ref){    
     int ret = -1;    
-    ret = encodeH264Packet(buffer, bytesused);
+    ret = encodeH264Packet(buffer, bytesused, ref);
     return ret;
 }
 
 
-int VideoEncoder::encodeH264Packet(void *buffer, int bytesused){
+/**
+ * @brief VideoEncoder::captureTimePts - pts of the next frame from its capture time, relative to
+ * the first frame of the recording
+ * @param fallback - pts from the arrival clock, used without a capture time
+ */
+int64_t VideoEncoder::captureTimePts(int64_t fallback)
+{
+    if(m_frameTimeNs <= 0 || m_firstFrameTimeNs <= 0 || m_frameTimeNs < m_firstFrameTimeNs)
+        return fallback;
+    return av_rescale_q(m_frameTimeNs - m_firstFrameTimeNs, (AVRational){1, 1000000000}, pCodecCtx->time_base);
+}
+
+int VideoEncoder::encodeH264Packet(void *buffer, int bytesused, AVBufferRef *ref){
 
     double fps, recordTimeDurationInSec, millisecondsDiff;
     if(frameCount == 0){
@@ -652,21 +951,32 @@ int VideoEncoder::encodeH264Packet(void *buffer, int bytesused){
         fps = (frameCount)/ recordTimeDurationInSec; // calculate fps
     }
 
-    if(!isOk())
+    if(!isOk()){
+        av_buffer_unref(&ref);
         return -1;
+    }
    
     int out_size = 0;
     pkt.data = (u_int8_t *) buffer;
     pkt.size = bytesused;
 
     av_init_packet(&pkt);
+#if LIBAVCODEC_VER_AT_LEAST(57,12)
+    // reference counted packet, the mux writer references it instead of copying
+    pkt.buf = ref;
+#else
+    av_buffer_unref(&ref);
+#endif
 
     pkt.stream_index = pVideoStream->index;
 
-    if(pCodecCtx->coded_frame->key_frame)
+    // the camera stream is not produced by pCodecCtx, look at the nal units
+    if(isH264KeyFrame((const uint8_t *)buffer, bytesused))
         pkt.flags |= AV_PKT_FLAG_KEY;
 
-    pkt.pts  = (frameCount*(pCodecCtx->time_base.den/fps)) / pCodecCtx->time_base.num;
+    if(frameCount == 0)
+        m_firstFrameTimeNs = m_frameTimeNs;
+    pkt.pts  = captureTimePts((frameCount*(pCodecCtx->time_base.den/fps)) / pCodecCtx->time_base.num);
     pkt.dts = pkt.pts;
 
     // Added by Navya -- 18 Oct 2019
@@ -679,7 +989,7 @@ int VideoEncoder::encodeH264Packet(void *buffer, int bytesused){
     pts_prev = pkt.pts;
     /* Write the compressed frame to the media file. */
 
-    out_size = av_write_frame(pFormatCtx, &pkt);
+    out_size = writeFrame(&pkt, false);
     if(out_size == 0){
          frameCount++;
          videoPacketReceived = true;
@@ -874,7 +1184,7 @@ int VideoEncoder::encodeAudio(void *data){
 
         if(!m_recStop){
             /* Write the compressed frame to the media file. */
-            out_size = av_write_frame(pFormatCtx, &audioPkt);
+            out_size = writeFrame(&audioPkt, false);
         }
 
         av_free_packet(&audioPkt);
@@ -911,7 +1221,7 @@ int VideoEncoder::encodeAudio(void *data)
        audioPkt.size = out_size;
        pAudioCodecCtx->gop_size = pCodecCtx->gop_size;
        /* write the compressed frame in the media file */
-          ret = av_write_frame(pFormatCtx, &audioPkt);
+          ret = writeFrame(&audioPkt, false);
           av_free_packet(&audioPkt);
    } else
    {
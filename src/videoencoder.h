@@ -24,9 +24,16 @@
 #include <QFile>
 #include <QImage>
 #include <QDateTime>
+#include <QMutex>
+#include <QThread>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
 
 
 #include "common.h"
+#include "streamserver.h"
+#include "muxwriter.h"
 /* checking version compatibility */
 
 #define LIBAVUTIL_VER_AT_LEAST(major,minor)  (LIBAVUTIL_VERSION_MAJOR > major || \
@@ -51,6 +58,37 @@ extern "C" {
 #define MAX_DELAYED_FRAMES 50
 #define VIDEO_FRAME_RATE_HEADER_OFFSET 112
 
+// video rate control
+#define ENCODER_RC_DEFAULT  0   /* bitrate from the frame size, fixed qmin/qmax (previous behaviour) */
+#define ENCODER_RC_CBR      1   /* constant bitrate, bitRate */
+#define ENCODER_RC_VBR      2   /* average bitrate, bitRate */
+#define ENCODER_RC_CRF      3   /* constant quality, quality */
+#define ENCODER_RC_CQP      4   /* constant quantizer, quality */
+
+#define ENCODER_MAX_THREADS 16
+
+/**
+ * @brief The EncoderSettings struct - tuning of the video encoder.
+ * preset and tune are passed to H264 only. quality is the crf/qp for H264
+ * and the quantizer scale (1 - 31) for MJPEG.
+ */
+struct EncoderSettings {
+    QString preset;
+    QString tune;
+    int gop;
+    int rateControl;
+    unsigned bitRate;   // bits/s, 0 - derived from the frame size
+    int quality;
+    int threads;        // 0 - one per core
+    int ioFlags;        // MUX_IO_DIRECT | MUX_IO_SYNC
+    int segmentSeconds; // start a new file after this long, 0 - never
+    qint64 segmentBytes;// start a new file after this size, 0 - never
+
+    EncoderSettings() : preset("ultrafast"), tune("zerolatency"), gop(12),
+        rateControl(ENCODER_RC_DEFAULT), bitRate(0), quality(23), threads(0), ioFlags(MUX_IO_SYNC),
+        segmentSeconds(0), segmentBytes(0) {}
+};
+
 struct AVIStreamHeader {
     uint32_t  fccType;
     uint32_t  fccHandler;
@@ -91,9 +129,11 @@ public:
 
  
 #if LIBAVCODEC_VER_AT_LEAST(54,25)
-   bool createFile(QString filename, AVCodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitRate,  int audioDeviceIndex, int sampleRate, int channels);
+   bool createFile(QString filename, AVCodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitRate,  int audioDeviceIndex, int sampleRate, int channels,
+                   const EncoderSettings &settings = EncoderSettings());
 #else
-   bool createFile(QString filename, CodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitRate,  int audioDeviceIndex, int sampleRate, int channels);
+   bool createFile(QString filename, CodecID encodeType, unsigned width,unsigned height,unsigned fpsDenominator, unsigned fpsNumerator, unsigned bitRate,  int audioDeviceIndex, int sampleRate, int channels,
+                   const EncoderSettings &settings = EncoderSettings());
 #endif
 
    // audio
@@ -112,6 +152,12 @@ public:
    bool closeFile();
    int encodeImage(uint8_t *buffer, bool rgbBufferformat);
    int encodePacket(uint8_t *buffer, bool rgbBufferformat);
+
+   /**
+    * @brief encodeYUV420 - encode one frame given as separate y, u, v planes [4:2:0]
+    * @param planes, strides - plane pointers and bytes per line, as captured
+    */
+   int encodeYUV420(uint8_t *planes[3], int strides[3]);
    bool isOk();
 
 // Added by Sankari : 8 Oct 2018
@@ -120,10 +166,36 @@ public:
 
    @param : buffer - raw h264 buffer
    @param : bytesused - bytes in buffer
+   @param : ref - reference owning buffer, taken over. The muxer keeps the frame through it
+                  instead of copying it [capture pool frames].
 **/
-   int writeH264Image(void *buffer, int bytesUsed);
+   int writeH264Image(void *buffer, int bytesUsed, struct AVBufferRef *ref = NULL);
+
+   int encodeH264Packet(void *buffer, int bytesused, struct AVBufferRef *ref = NULL);
+
+   /**
+    * @brief setFrameTime - capture time of the next frame passed to encodeImage/writeH264Image
+    * @param ns - CLOCK_MONOTONIC nanoseconds, 0 to time the frame on arrival
+    */
+   void setFrameTime(qint64 ns) { m_frameTimeNs = ns; }
 
-   int encodeH264Packet(void *buffer, int bytesused);
+   // Encoded MJPEG/H264 packets are also offered to this server for live viewing
+   void setStreamServer(StreamServer *server) { m_streamServer = server; }
+
+   /**
+    * @brief setMetadata - add a tag to the container, written with each following header and trailer
+    */
+   void setMetadata(const char *key, QString value);
+
+   /**
+    * @brief requestSegment - continue a segmented recording in a new file from the next keyframe,
+    * after a gap in the stream
+    * @return false for a recording in a single file
+    */
+   bool requestSegment();
+
+   // writer thread of the recordings, emits the write statistics
+   MuxWriter *muxWriter() { return m_muxWriter.data(); }
 
 protected:
     unsigned Width,Height;
@@ -135,6 +207,24 @@ protected:
 
     int frameCount;
 
+    EncoderSettings m_settings;
+    int64_t m_sentFrames;       // frames passed to the encoder
+    int64_t m_lastPts;          // pts of the last frame sent, codec time base
+    qint64 m_frameTimeNs;       // capture time of the next frame, 0 - unknown
+    qint64 m_firstFrameTimeNs;  // capture time of the first frame of the recording
+    int64_t captureTimePts(int64_t first);
+
+    // segmented recording, the file is cut before the first video keyframe once a limit is reached
+    QElapsedTimer m_segmentClock;
+    QAtomicInteger<qint64> m_segmentBytes;
+    bool m_keyRequested;        // keyframe forced for the pending cut
+    QAtomicInt m_cutRequested;  // requestSegment, cut without a limit reached
+
+    // recordings of all cameras share the cores, default thread counts are split between them
+    static QAtomicInt s_openEncoders;
+    bool segmentDue();
+    static bool isH264KeyFrame(const uint8_t *data, int size);
+
     // FFmpeg stuff
     AVFormatContext *pFormatCtx;
     
@@ -152,6 +242,8 @@ protected:
 
       // Conversion
       SwsContext *img_convert_ctx;
+      uint8_t *m_srcPlanes[3];    // source of encodeYUV420, used when no packed buffer is given
+      int m_srcStrides[3];
 
     // Packet
     AVPacket pkt, audioPkt;
@@ -187,6 +279,20 @@ protected:
       // Frame conversion
       bool convertImage(const QImage &img);
       bool convertImage_sws(uint8_t *buffer, bool rgbBufferformat);
+
+      // apply m_settings to the codec context before opening it
+      void setupRateControl(AVDictionary **opts);
+      // write every packet the encoder has ready
+      int receivePackets();
+
+      // offer one encoded packet to the stream server
+      void streamPacket(const uint8_t *data, int size);
+      StreamServer *m_streamServer;
+
+      // packets are queued to the writer thread, both are shared by copies of this encoder
+      int writeFrame(AVPacket *packet, bool interleaved);
+      QSharedPointer<QMutex> m_muxMutex;
+      QSharedPointer<MuxWriter> m_muxWriter;
 };
 #endif // VideoEncoder_H
 
@@ -28,14 +28,23 @@
 #include <QMessageBox>
 #include <QRectF>
 #include <fcntl.h>
+#include <time.h>
 #include <QString>
 #include <QTimer>
 #include <QtQuick/qquickwindow.h>
+#include <QQmlEngine>
+#include <QQmlContext>
 #include <QOpenGLShaderProgram>
 #include <QtGui/QOpenGLContext>
 #include <QtConcurrent>
+#include <QSettings>
 #include "fscam_cu135.h"
 #include "uvccamera.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 #define CLEAR(x) memset(&(x), 0, sizeof(x))
 
@@ -60,24 +69,23 @@
  #define min(a,b) ((a)<(b)?(a):(b))
 #endif
 
+/* Capture buffer count limits */
+#define MIN_CAPTURE_BUFFERS         3
+#define MAX_CAPTURE_BUFFERS         VIDEO_MAX_FRAME
+#define CAPTURE_BUFFER_LATENCY_MS   100     // initial count covers this much time of frames
+#define CAPTURE_BUFFER_BUDGET       (128 * 1024 * 1024)
+#define CAPTURE_BUFFER_GROW_STEP    2
+#define ADAPT_WINDOW_FRAMES         60      // frames per adaptation decision
+#define ADAPT_SHRINK_WINDOWS        10      // quiet windows before giving a buffer back
+
+/* Frames kept in the shared memory export ring */
+#define FRAME_EXPORT_SLOTS          8
+
 
-QStringListModel Videostreaming::resolution;
-QStringListModel Videostreaming::stillOutputFormat;
-QStringListModel Videostreaming::videoOutputFormat;
-QStringListModel Videostreaming::fpsList;
-QStringListModel Videostreaming::encoderList;
-int Videostreaming::deviceNumber;
-QString Videostreaming::camDeviceName;
 bool isStillFrame = false;
 
 typedef void (*ftopict) (int * out, uint8_t *pic, int width) ;
 
-//Added by Dhurka
-/**
- * @brief Videostreaming::currentlySelectedCameraEnum - This contains currenly selected camera enum value
- */
-CommonEnums::ECameraNames Videostreaming::currentlySelectedCameraEnum;
-CommonEnums::ECameraNames FrameRenderer::currentlySelectedEnumValue;
 
 static GLfloat mVerticesDataPosition[] = {
     -1.f, 1.f, 0.0f, // Position 0
@@ -136,6 +144,8 @@ Videostreaming::Videostreaming() : m_t(0)
     previewFrameSkipCount = 1;
     previewFrameToSkip = 1;
     skippingPreviewFrame = false;
+    m_settleDetection = true;
+    m_bayerPreview = false;
 
     fpsChangedForStill = false;
     imgSaveSuccessCount = 0;   
@@ -153,16 +163,60 @@ Videostreaming::Videostreaming() : m_t(0)
     frameSkip = false;
     tempSrcBuffer = NULL;
 
+    m_buffers = NULL;
+    m_nbuffers = 0;
+    m_captureBufferCount = 0;
+    m_adaptiveBuffers = true;
+    m_bufferMemoryBudget = CAPTURE_BUFFER_BUDGET;
+    m_learnedBufferCount = 0;
+    m_queuedBuffers = 0;
+    m_parkRequest = 0;
+    m_framePeriodNsecs = 33333333;
+    m_captureMemory = V4L2_MEMORY_MMAP;
+    m_bufferMemory = V4L2_MEMORY_MMAP;
+    m_currentSlot = -1;
+    m_decodeSlot = -1;
+    m_frameExportEnabled = false;
+    m_recordIoFlags = MUX_IO_SYNC;
+    m_segmentMinutes = 0;
+    m_segmentMegabytes = 0;
+    m_hwTimestamps = false;
+    m_session = CameraSession::selected();
+    m_ownSession = NULL;
+    m_frameSync = false;
+    m_frameCaptureNs = m_decodeFrameNs = m_recordFrameNs = 0;
+    m_latencySum = m_latencyMax = 0;
+    m_latencyFrames = 0;
+    m_fastStillSwitch = true;
+    m_stillSwitchValid = false;
+    m_stillSwitchFrameSize = 0;
+    m_renderBufferPixels = 0;
+    memset(&m_planeFormat, 0, sizeof(m_planeFormat));
+    memset(m_framePlane, 0, sizeof(m_framePlane));
+    memset(m_framePlaneStride, 0, sizeof(m_framePlaneStride));
+    m_usbLinkValid = false;
+    m_recoveryEnabled = true;
+    m_recoveryFirstFrame = false;
+
     connect(this, &QQuickItem::windowChanged, this, &Videostreaming::handleWindowChanged);
-    connect(&audioinput, SIGNAL(captureAudio()), this, SLOT(doEncodeAudio()));
+    m_audioEncodeWorker = new AudioEncodeWorker(&audioinput);
     connect(this, SIGNAL(captureVideo()), this, SLOT(recordVideo()));
     videoEncoder=new VideoEncoder();
+    videoEncoder->setStreamServer(&m_streamServer);
+    connect(&m_streamServer, SIGNAL(clientCountChanged(int)), this, SIGNAL(streamClientCount(int)));
+    connect(videoEncoder->muxWriter(), SIGNAL(statistics(qreal,int,qreal)), this, SIGNAL(recordWriteStats(qreal,int,qreal)), Qt::QueuedConnection);
+    connect(&m_recovery, SIGNAL(deviceReturned(QString)), this, SLOT(recoverDevice(QString)));
+    connect(&m_recovery, SIGNAL(timedOut()), this, SLOT(recoveryTimedOut()));
 }
 
 Videostreaming::~Videostreaming()
 {
+    delete m_audioEncodeWorker;
+    m_audioEncodeWorker = NULL;
     delete videoEncoder;
     videoEncoder=NULL;
+    setFrameSync(false);
+    delete m_ownSession;
 }
 
 void Videostreaming::fillRenderBuffer(){
@@ -199,7 +253,9 @@ void FrameRenderer::fillBuffer(){
             renderMutex.unlock();
         }
     }
-    else if(renderBufferFormat == CommonEnums::RGB_BUFFER_RENDER){
+    else if(renderBufferFormat == CommonEnums::RGB_BUFFER_RENDER || renderBufferFormat == CommonEnums::YUV420_BUFFER_RENDER ||
+            renderBufferFormat == CommonEnums::MONO_BUFFER_RENDER || renderBufferFormat == CommonEnums::MONO16_BUFFER_RENDER ||
+            renderBufferFormat == CommonEnums::BAYER_BUFFER_RENDER){
         if(gotFrame){
             updateStop = false;
         }else{
@@ -263,11 +319,13 @@ void Videostreaming::sync()
 {    
     if (!m_renderer) {
         m_renderer = new FrameRenderer();
+        m_renderer->m_session = m_session;
         m_renderer->videoResolutionwidth = 640; // need to check this assignment is needed.
         m_renderer->videoResolutionHeight = 480;
         connect(window(), &QQuickWindow::afterRendering, m_renderer, &FrameRenderer::paint, Qt::DirectConnection);
     }
     m_renderer->setViewportSize(QSize(window()->width(),window()->height()));
+    m_renderer->tileArea = m_tileArea;
     m_renderer->setT(m_t);
     m_renderer->setWindow(window());
 }
@@ -280,18 +338,27 @@ FrameRenderer::~FrameRenderer()
     if(uBuffer){ free(uBuffer); uBuffer = NULL;}
     if(vBuffer){ free(vBuffer); vBuffer = NULL;}
     if(yuvBuffer){free(yuvBuffer); yuvBuffer = NULL;}
+    if(y16Buffer){free(y16Buffer); y16Buffer = NULL;}
     if(rgbaDestBuffer){free(rgbaDestBuffer); rgbaDestBuffer = NULL;}
     delete m_programRGB;
     delete m_programYUYV;
+    delete m_programMono;
+    delete m_programBayer;
 }
 
 
-FrameRenderer::FrameRenderer(): m_t(0), m_programRGB(0),  m_programYUYV(0){    
+FrameRenderer::FrameRenderer(): m_t(0), m_programRGB(0),  m_programYUYV(0), m_programMono(0), m_programBayer(0){    
     yBuffer = NULL;
     uBuffer = NULL;
     vBuffer = NULL;
     yuvBuffer = NULL;
+    y16Buffer = NULL;
     rgbaDestBuffer = NULL;   
+    monoBlack = 0.0f;
+    monoWhite = 1.0f;
+    monoGamma = 1.0f;
+    bayerGain[0] = bayerGain[1] = bayerGain[2] = 1.0f;
+    m_session = NULL;
     gotFrame = false;
     updateStop = true;
 }
@@ -403,23 +470,7 @@ void FrameRenderer::drawRGBBUffer(){
     glTexParameterf(GL_TEXTURE_2D,        GL_TEXTURE_MIN_FILTER,        GL_LINEAR);
     glTexParameterf(GL_TEXTURE_2D,        GL_TEXTURE_MAG_FILTER,        GL_LINEAR);
 
-    int xMargin = 250; // [left margin + right margin ]
-    int sidebarwidth;
-
-    if(sidebarAvailable){  //Fixed sidebarwidth,to avoid getting large values,which leads to change the preview position
-        sidebarwidth = 222;
-    }else{
-        sidebarwidth = 0;
-    }
-
-    int x, y, destWindowWidth, destWindowHeight;
-    if(previewBgrdAreaHeight == 0){
-		calculateViewport(videoResolutionwidth, videoResolutionHeight, previewBgrdAreaWidth-xMargin, m_viewportSize.height(), &x, &y, &destWindowWidth, &destWindowHeight);
-    }else{
-		calculateViewport(videoResolutionwidth, videoResolutionHeight, previewBgrdAreaWidth-xMargin, previewBgrdAreaHeight, &x, &y, &destWindowWidth, &destWindowHeight);
-    }
-    glViewport(sidebarwidth+x+(xMargin/2),  y+(viewportHeight-previewBgrdAreaHeight), destWindowWidth, destWindowHeight);
-      xcord =sidebarwidth+x+(xMargin/2);
+    setPreviewViewport();
     QMutexLocker locker(&renderMutex);
 
     if(rgbaDestBuffer){
@@ -440,10 +491,6 @@ void FrameRenderer::drawRGBBUffer(){
     // mixing with raw OpenGL.
     m_window->resetOpenGLState();
 }
-void FrameRenderer::selectedCameraEnum(CommonEnums::ECameraNames selectedDeviceEnum)
-{
-    currentlySelectedEnumValue = selectedDeviceEnum;
-}
 
 /**
  * @brief FrameRenderer::drawYUYVBUffer - Shader for yuyv to RGB conversion and render buffer
@@ -543,36 +590,20 @@ void FrameRenderer::drawYUYVBUffer(){
         m_programYUYV->enableAttributeArray(1);
 
 
-    int xMargin = 250; // [left margin + right margin ]
-    int sidebarwidth;
     int skipFrames = 4;
 
-    if(sidebarAvailable){  //Fixed sidebarwidth,to avoid getting large values,which leads to change the preview position
-        sidebarwidth = 222;
-    }else{
-        sidebarwidth = 0;
-    }
-	
-	// calculate view port 
-	int x, y, destWindowWidth, destWindowHeight;
-	if(previewBgrdAreaHeight == 0){
-		calculateViewport(videoResolutionwidth, videoResolutionHeight, previewBgrdAreaWidth-xMargin, m_viewportSize.height(), &x, &y, &destWindowWidth, &destWindowHeight);
-	}else{
-		calculateViewport(videoResolutionwidth, videoResolutionHeight, previewBgrdAreaWidth-xMargin, previewBgrdAreaHeight, &x, &y, &destWindowWidth, &destWindowHeight);
-	}
-
-        // set view port
-    glViewport(sidebarwidth+x+(xMargin/2), y+(viewportHeight-previewBgrdAreaHeight), destWindowWidth, destWindowHeight);
-
-    xcord =sidebarwidth+x+(xMargin/2);
+    // set view port
+    setPreviewViewport();
 
     if (yBuffer != NULL && uBuffer != NULL && vBuffer != NULL){
-          if(currentlySelectedEnumValue == CommonEnums::ECAM22_USB){
+          if(m_session && m_session->cameraEnum == CommonEnums::ECAM22_USB){
                skipFrames = frame;
            }else{
               skipFrames = 4;
           }
             if(gotFrame && !updateStop && skipFrames >3){
+            // chroma planes are half height for 4:2:0 formats, full height for yuyv
+            __u32 chromaHeight = (renderBufferFormat == CommonEnums::YUV420_BUFFER_RENDER) ? videoResolutionHeight/2 : videoResolutionHeight;
 	     // set active texture and give input y buffer
             glActiveTexture(GL_TEXTURE1);
             glUniform1i(samplerLocY, 1);
@@ -585,7 +616,7 @@ void FrameRenderer::drawYUYVBUffer(){
 	    // set active texture and give input u buffer
             glActiveTexture(GL_TEXTURE2);
             glUniform1i(samplerLocU, 2);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, videoResolutionwidth/2, videoResolutionHeight, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, uBuffer);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, videoResolutionwidth/2, chromaHeight, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, uBuffer);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -594,7 +625,7 @@ void FrameRenderer::drawYUYVBUffer(){
 	    // set active texture and give input v buffer
             glActiveTexture(GL_TEXTURE3);
             glUniform1i(samplerLocV, 3);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, videoResolutionwidth/2, videoResolutionHeight, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, vBuffer);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, videoResolutionwidth/2, chromaHeight, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, vBuffer);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -617,6 +648,237 @@ void FrameRenderer::drawYUYVBUffer(){
     renderyuyvMutex.unlock();
 }
 
+/**
+ * @brief FrameRenderer::setPreviewViewport - viewport of the preview area [or of the tile], keeping the aspect ratio
+ */
+void FrameRenderer::setPreviewViewport(){
+    int xMargin = 250; // [left margin + right margin ]
+    int sidebarwidth = sidebarAvailable ? 222 : 0;
+
+    int x, y, destWindowWidth, destWindowHeight;
+    if(!tileArea.isEmpty()){
+        // gl window coordinates start at the bottom
+        calculateViewport(videoResolutionwidth, videoResolutionHeight, tileArea.width(), tileArea.height(), &x, &y, &destWindowWidth, &destWindowHeight);
+        glViewport(tileArea.x()+x, m_viewportSize.height()-tileArea.y()-tileArea.height()+y, destWindowWidth, destWindowHeight);
+        xcord = tileArea.x()+x;
+        return;
+    }
+    if(previewBgrdAreaHeight == 0){
+        calculateViewport(videoResolutionwidth, videoResolutionHeight, previewBgrdAreaWidth-xMargin, m_viewportSize.height(), &x, &y, &destWindowWidth, &destWindowHeight);
+    }else{
+        calculateViewport(videoResolutionwidth, videoResolutionHeight, previewBgrdAreaWidth-xMargin, previewBgrdAreaHeight, &x, &y, &destWindowWidth, &destWindowHeight);
+    }
+    glViewport(sidebarwidth+x+(xMargin/2), y+(viewportHeight-previewBgrdAreaHeight), destWindowWidth, destWindowHeight);
+    xcord = sidebarwidth+x+(xMargin/2);
+}
+
+/**
+ * @brief FrameRenderer::drawMonoBuffer - Shader for luma only frames, the y buffer is the single texture.
+ * 12 bit samples are uploaded as 16 bit luminance, u_scale brings their range to 0.0 - 1.0 before
+ * the window [u_black - u_white] and the gamma are applied.
+ */
+void FrameRenderer::drawMonoBuffer(){
+    if (!m_programMono) {
+        initializeOpenGLFunctions();
+        m_programMono = new QOpenGLShaderProgram();
+        m_programMono->addShaderFromSourceCode(QOpenGLShader::Vertex,
+                                               "attribute vec4 a_position;\n"
+                                               "attribute vec2 a_texCoord;\n"
+                                               "varying vec2 v_texCoord;\n"
+                                               "void main()\n"
+                                               "{\n"
+                                               "gl_Position = a_position;\n"
+                                               "v_texCoord = a_texCoord;\n"
+                                               "}\n");
+        m_programMono->addShaderFromSourceCode(QOpenGLShader::Fragment,
+                                               "#ifdef GL_ES\n"
+                                               "precision mediump float;\n"
+                                               "#endif\n"
+                                               "varying vec2 v_texCoord;\n"
+                                               "uniform sampler2D y_texture;\n"
+                                               "uniform float u_scale;\n"
+                                               "uniform float u_black;\n"
+                                               "uniform float u_white;\n"
+                                               "uniform float u_gamma;\n"
+                                               "void main()\n"
+                                               "{\n"
+                                               "float y = texture2D(y_texture, v_texCoord).r * u_scale;\n"
+                                               "y = clamp((y - u_black) / max(u_white - u_black, 0.0001), 0.0, 1.0);\n"
+                                               "y = pow(y, 1.0 / u_gamma);\n"
+                                               "gl_FragColor = vec4(y, y, y, 1.0);\n"
+                                               "}\n");
+        m_programMono->bindAttributeLocation("a_position", 0);
+        m_programMono->bindAttributeLocation("a_texCoord", 1);
+        m_programMono->link();
+
+        mPositionLoc = m_programMono->attributeLocation("a_position");
+        mTexCoordLoc = m_programMono->attributeLocation("a_texCoord");
+        samplerLocMono = m_programMono->uniformLocation("y_texture");
+        monoScaleLoc = m_programMono->uniformLocation("u_scale");
+        monoBlackLoc = m_programMono->uniformLocation("u_black");
+        monoWhiteLoc = m_programMono->uniformLocation("u_white");
+        monoGammaLoc = m_programMono->uniformLocation("u_gamma");
+        glGenTextures(1, &m_monoTexture);
+#ifdef GL_LUMINANCE16
+        m_luminance16 = !QOpenGLContext::currentContext()->isOpenGLES();
+#else
+        m_luminance16 = false;
+#endif
+    }
+
+    renderyuyvMutex.lock();
+    m_programMono->bind();
+
+    glVertexAttribPointer(mPositionLoc, 3, GL_FLOAT, false, 12, mVerticesDataPosition);
+    glVertexAttribPointer(mTexCoordLoc, 2, GL_FLOAT, false, 8, mVerticesDataTextCord);
+    m_programMono->enableAttributeArray(0);
+    m_programMono->enableAttributeArray(1);
+
+    setPreviewViewport();
+
+    bool samples16 = renderBufferFormat == CommonEnums::MONO16_BUFFER_RENDER;
+    if(yBuffer != NULL && (!samples16 || y16Buffer != NULL) && gotFrame && !updateStop){
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_monoTexture);
+        glUniform1i(samplerLocMono, 1);
+        glUniform1f(monoBlackLoc, monoBlack);
+        glUniform1f(monoWhiteLoc, monoWhite);
+        glUniform1f(monoGammaLoc, monoGamma > 0.0f ? monoGamma : 1.0f);
+        // rows of odd widths are not 4 byte aligned
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if(samples16 && m_luminance16){
+#ifdef GL_LUMINANCE16
+            glUniform1f(monoScaleLoc, 65535.0f / 4095.0f);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE16, videoResolutionwidth, videoResolutionHeight, 0, GL_LUMINANCE, GL_UNSIGNED_SHORT, y16Buffer);
+#endif
+        }else{
+            if(samples16){
+                // no 16 bit textures, the top 8 of the 12 bits
+                const size_t pixels = (size_t)videoResolutionwidth * videoResolutionHeight;
+                for(size_t i = 0; i < pixels; i++)
+                    yBuffer[i] = y16Buffer[i] >> 4;
+            }
+            glUniform1f(monoScaleLoc, 1.0f);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, videoResolutionwidth, videoResolutionHeight, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, yBuffer);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, mIndicesData);
+    }
+
+    m_programMono->disableAttributeArray(0);
+    m_programMono->disableAttributeArray(1);
+    m_programMono->release();
+
+    m_window->resetOpenGLState();
+    renderyuyvMutex.unlock();
+}
+
+/**
+ * @brief FrameRenderer::drawBayerBuffer - Shader demosaic of the grbg plane in the y buffer. Each
+ * fragment finds its pixel and bayer phase from the texture size and averages the missing colours
+ * of the neighbours [bilinear]. Textures are sampled GL_NEAREST, texel centres through u_texel.
+ * GLSL 1.10 without integer ops, so it runs on software GL [llvmpipe] as well.
+ */
+void FrameRenderer::drawBayerBuffer(){
+    if (!m_programBayer) {
+        initializeOpenGLFunctions();
+        m_programBayer = new QOpenGLShaderProgram();
+        m_programBayer->addShaderFromSourceCode(QOpenGLShader::Vertex,
+                                                "attribute vec4 a_position;\n"
+                                                "attribute vec2 a_texCoord;\n"
+                                                "varying vec2 v_texCoord;\n"
+                                                "void main()\n"
+                                                "{\n"
+                                                "gl_Position = a_position;\n"
+                                                "v_texCoord = a_texCoord;\n"
+                                                "}\n");
+        m_programBayer->addShaderFromSourceCode(QOpenGLShader::Fragment,
+                                                "#ifdef GL_ES\n"
+                                                "#ifdef GL_FRAGMENT_PRECISION_HIGH\n"
+                                                "precision highp float;\n"   // pixel positions of large frames
+                                                "#else\n"
+                                                "precision mediump float;\n"
+                                                "#endif\n"
+                                                "#endif\n"
+                                                "varying vec2 v_texCoord;\n"
+                                                "uniform sampler2D bayer_texture;\n"
+                                                "uniform vec2 u_size;\n"
+                                                "uniform vec2 u_texel;\n"
+                                                "uniform vec3 u_gain;\n"
+                                                "float raw(vec2 p, float dx, float dy)\n"   // neighbours beyond the edge are mirrored, same colour site
+                                                "{\n"
+                                                "vec2 q = abs(p + vec2(dx, dy));\n"
+                                                "q = min(q, 2.0 * (u_size - 1.0) - q);\n"
+                                                "return texture2D(bayer_texture, (q + 0.5) * u_texel).r;\n"
+                                                "}\n"
+                                                "void main()\n"
+                                                "{\n"
+                                                "vec2 p = min(floor(v_texCoord * u_size), u_size - 1.0);\n"
+                                                "vec2 phase = mod(p, 2.0);\n"
+                                                "float centre = raw(p, 0.0, 0.0);\n"
+                                                "float horz = (raw(p, -1.0, 0.0) + raw(p, 1.0, 0.0)) * 0.5;\n"
+                                                "float vert = (raw(p, 0.0, -1.0) + raw(p, 0.0, 1.0)) * 0.5;\n"
+                                                "float plus = (horz + vert) * 0.5;\n"
+                                                "float diag = (raw(p, -1.0, -1.0) + raw(p, 1.0, -1.0) + raw(p, -1.0, 1.0) + raw(p, 1.0, 1.0)) * 0.25;\n"
+                                                "vec3 rgb;\n"
+                                                "if (phase.y < 0.5) {\n"     // g r row
+                                                "    rgb = phase.x < 0.5 ? vec3(horz, centre, vert) : vec3(centre, plus, diag);\n"
+                                                "} else {\n"                 // b g row
+                                                "    rgb = phase.x < 0.5 ? vec3(diag, plus, centre) : vec3(vert, centre, horz);\n"
+                                                "}\n"
+                                                "gl_FragColor = vec4(clamp(rgb * u_gain, 0.0, 1.0), 1.0);\n"
+                                                "}\n");
+        m_programBayer->bindAttributeLocation("a_position", 0);
+        m_programBayer->bindAttributeLocation("a_texCoord", 1);
+        m_programBayer->link();
+
+        mPositionLoc = m_programBayer->attributeLocation("a_position");
+        mTexCoordLoc = m_programBayer->attributeLocation("a_texCoord");
+        samplerLocBayer = m_programBayer->uniformLocation("bayer_texture");
+        bayerSizeLoc = m_programBayer->uniformLocation("u_size");
+        bayerTexelLoc = m_programBayer->uniformLocation("u_texel");
+        bayerGainLoc = m_programBayer->uniformLocation("u_gain");
+        glGenTextures(1, &m_bayerTexture);
+    }
+
+    renderyuyvMutex.lock();
+    m_programBayer->bind();
+
+    glVertexAttribPointer(mPositionLoc, 3, GL_FLOAT, false, 12, mVerticesDataPosition);
+    glVertexAttribPointer(mTexCoordLoc, 2, GL_FLOAT, false, 8, mVerticesDataTextCord);
+    m_programBayer->enableAttributeArray(0);
+    m_programBayer->enableAttributeArray(1);
+
+    setPreviewViewport();
+
+    if(yBuffer != NULL && gotFrame && !updateStop){
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_bayerTexture);
+        glUniform1i(samplerLocBayer, 1);
+        glUniform2f(bayerSizeLoc, videoResolutionwidth, videoResolutionHeight);
+        glUniform2f(bayerTexelLoc, 1.0f / videoResolutionwidth, 1.0f / videoResolutionHeight);
+        glUniform3f(bayerGainLoc, bayerGain[0], bayerGain[1], bayerGain[2]);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, videoResolutionwidth, videoResolutionHeight, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, yBuffer);
+        // filtering would mix the colours of neighbouring sites
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, mIndicesData);
+    }
+
+    m_programBayer->disableAttributeArray(0);
+    m_programBayer->disableAttributeArray(1);
+    m_programBayer->release();
+
+    m_window->resetOpenGLState();
+    renderyuyvMutex.unlock();
+}
+
 /**
 * paint in Quick painted item (qml)
 */
@@ -624,18 +886,34 @@ void FrameRenderer::paint()
 {    
     if(renderBufferFormat == CommonEnums::RGB_BUFFER_RENDER){ // RGBA
         drawRGBBUffer();
-    }else if(renderBufferFormat == CommonEnums::YUYV_BUFFER_RENDER){ // YUYV
+    }else if(renderBufferFormat == CommonEnums::YUYV_BUFFER_RENDER || renderBufferFormat == CommonEnums::YUV420_BUFFER_RENDER){ // YUYV, YUV420
         drawYUYVBUffer();
+    }else if(renderBufferFormat == CommonEnums::MONO_BUFFER_RENDER || renderBufferFormat == CommonEnums::MONO16_BUFFER_RENDER){ // GREY, Y12, Y16
+        drawMonoBuffer();
+    }else if(renderBufferFormat == CommonEnums::BAYER_BUFFER_RENDER){ // SGRBG8, shader demosaic
+        drawBayerBuffer();
     }
 }
 
 void Videostreaming::setDevice(QString deviceName) {    
+    // a camera picked while waiting for the lost one
+    m_recovery.stop();
+    m_recoveryFirstFrame = false;
+    openDevice(deviceName);
+}
+
+bool Videostreaming::openDevice(QString deviceName) {
     close();
-    deviceName.append(QString::number(deviceNumber,10));
+    deviceName.append(QString::number(m_session->deviceNumber,10));
     if(open(deviceName,false)) {
         emit logDebugHandle("Device Opened - "+deviceName);
         m_convertData = v4lconvert_create(fd());
-        m_buftype= V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        // devices with only multi-planar capture [isp, csi receivers] stream through the _MPLANE type
+        if (!(caps() & V4L2_CAP_VIDEO_CAPTURE) && (caps() & V4L2_CAP_VIDEO_CAPTURE_MPLANE))
+            m_buftype = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+        else
+            m_buftype = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        m_usbLinkValid = BandwidthPlanner::usbLink(m_session->deviceNumber, m_usbLink);
         openSuccess = true;
 
         // Added by Sankari: 12 Feb 2018
@@ -643,19 +921,87 @@ void Videostreaming::setDevice(QString deviceName) {
         struct v4l2_capability querycapability;
         if (querycap(querycapability)) {
             QString bus(reinterpret_cast< char* >(querycapability.bus_info));
+            m_busInfo = bus;
+            m_cardName = QString(reinterpret_cast< char* >(querycapability.card));
             emit pciDeviceBus(bus);
         }
+        return true;
     } else {
         emit logCriticalHandle("Device Opening Failed - "+deviceName);
+        return false;
     }
 }
 
+// camera picked in the camera list, for the selected session
 void Videostreaming::getFirstDevice(int deviceNode) {    
-    deviceNumber = deviceNode;
+    CameraSession::selected()->deviceNumber = deviceNode;
 }
 
 void Videostreaming::getCameraName(QString deviceName){    
-    camDeviceName=deviceName;
+    CameraSession::selected()->cameraName = deviceName;
+}
+
+void Videostreaming::newSession()
+{
+    if (!m_ownSession) {
+        m_ownSession = new CameraSession();
+        m_session = m_ownSession;
+        if (m_renderer)
+            m_renderer->m_session = m_session;
+        emit sessionChanged();
+    }
+    CameraSession::select(m_session);
+    bindSessionModels();
+}
+
+void Videostreaming::selectSession()
+{
+    CameraSession::select(m_session);
+    bindSessionModels();
+}
+
+/**
+ * @brief Videostreaming::bindSessionModels - point the format lists of the settings pages at the
+ * camera of this item, main.cpp binds them to the first session
+ */
+void Videostreaming::bindSessionModels()
+{
+    QQmlEngine *engine = qmlEngine(this);
+    if (!engine)
+        return;
+    QQmlContext *context = engine->rootContext();
+    context->setContextProperty("resolutionModel", &m_session->resolution);
+    context->setContextProperty("stillOutputFormatModel", &m_session->stillOutputFormat);
+    context->setContextProperty("videoOutputFormatModel", &m_session->videoOutputFormat);
+    context->setContextProperty("fpsAvailable", &m_session->fpsList);
+    context->setContextProperty("encodersModel", &m_session->encoderList);
+}
+
+void Videostreaming::setTileArea(int x, int y, int width, int height)
+{
+    m_tileArea = QRect(x, y, width, height);
+}
+
+void Videostreaming::setFrameSync(bool enable)
+{
+    if (enable == m_frameSync)
+        return;
+    m_frameSync = enable;
+    FrameSynchronizer *synchronizer = FrameSynchronizer::instance();
+    if (enable) {
+        synchronizer->addCamera(m_session);
+        connect(synchronizer, SIGNAL(skewStatistics(qreal,qreal,int,int,int)), this, SIGNAL(frameSyncStats(qreal,qreal,int,int,int)));
+    } else {
+        synchronizer->removeCamera(m_session);
+        disconnect(synchronizer, SIGNAL(skewStatistics(qreal,qreal,int,int,int)), this, SIGNAL(frameSyncStats(qreal,qreal,int,int,int)));
+    }
+}
+
+void Videostreaming::setFrameSyncSettings(qreal toleranceMs, bool duplicateMissing)
+{
+    FrameSynchronizer *synchronizer = FrameSynchronizer::instance();
+    synchronizer->setTolerance(toleranceMs * 1000000);
+    synchronizer->setPolicy(duplicateMissing ? SYNC_POLICY_DUPLICATE : SYNC_POLICY_DROP);
 }
 
 
@@ -740,10 +1086,26 @@ void Videostreaming::setPreviewBgrndArea(int width, int height, bool sidebarAvai
 
 
 
+/**
+ * @brief contiguousPixelFormat - format of the planes of a multi-plane format packed one after
+ * another, as known to libv4lconvert and frame consumers
+ */
+static __u32 contiguousPixelFormat(__u32 pixelformat)
+{
+    switch (pixelformat) {
+    case V4L2_PIX_FMT_NV12M:    return V4L2_PIX_FMT_NV12;
+    case V4L2_PIX_FMT_NV21M:    return V4L2_PIX_FMT_NV21;
+    case V4L2_PIX_FMT_YUV420M:  return V4L2_PIX_FMT_YUV420;
+    case V4L2_PIX_FMT_YVU420M:  return V4L2_PIX_FMT_YVU420;
+    case V4L2_PIX_FMT_NV16M:    return V4L2_PIX_FMT_NV16;
+    case V4L2_PIX_FMT_NV61M:    return V4L2_PIX_FMT_NV61;
+    }
+    return pixelformat;
+}
+
 void Videostreaming::capFrame()
 {
-     unsigned char *temp_Buffer=NULL;
-    __u32 buftype = m_buftype;
+     unsigned char *frameData=NULL;
     v4l2_plane planes[VIDEO_MAX_PLANES];
     v4l2_buffer buf;
     bool again;
@@ -751,30 +1113,26 @@ void Videostreaming::capFrame()
     memset(planes, 0, sizeof(planes));
     buf.length = VIDEO_MAX_PLANES;
     buf.m.planes = planes;
-    if (!dqbuf_mmap(buf, buftype, again)) {
+    if (!dequeueCaptureBuffer(buf, again)) {
         // stop the timer when device is unplugged
         if(!retrieveFrame)
         m_timer.stop();
         closeDevice();
         // Added by Sankari:19 Dec 2017.
         //Bug Fix: 1. Streaming is not available for higher resolution when unplug and plug cu130 camera without closing application
-        v4l2_requestbuffers reqbufs;
         if (m_buffers == NULL){
 
            return;}
 
-        for (uint i = 0; i < m_nbuffers; ++i)
-            for (unsigned p = 0; p < m_buffers[i].planes; p++)
-                if (-1 == munmap(m_buffers[i].start[p], m_buffers[i].length[p]))
-                    perror("munmap");
-
         // Free all buffers.
-        reqbufs_mmap(reqbufs, V4L2_BUF_TYPE_VIDEO_CAPTURE, 1);  // videobuf workaround
-        reqbufs_mmap(reqbufs, V4L2_BUF_TYPE_VIDEO_CAPTURE, 0);
+        freeCaptureBuffers();
 
         // When device is unplugged, Stop rendering.
         m_renderer->updateStop = true;
 
+        if (beginRecovery())
+            return;
+
         emit deviceUnplugged("Disconnected","Device Not Found");
         emit logCriticalHandle("Device disconnected");
 
@@ -785,20 +1143,42 @@ void Videostreaming::capFrame()
       return;
     }
 
+    if (m_recoveryFirstFrame) {
+        m_recoveryFirstFrame = false;
+        qint64 outageMs = m_recovery.outageMs(), recoveryMs = m_recoveryTimer.elapsed();
+        emit logCriticalHandle(QString("Stream recovered: outage %1 ms, restarted in %2 ms after the camera came back")
+                               .arg(outageMs).arg(recoveryMs));
+        emit streamRecovered(outageMs, recoveryMs);
+    }
+
     if (buf.flags & V4L2_BUF_FLAG_ERROR) {   
-        qbuf(buf);
+        queueCaptureBuffer(buf);
         usleep(100000);
         emit signalTograbPreviewFrame(retrieveframeStoreCamInCross,true);
        return;
     }
 
+    updateFrameTime(buf);
+
+    // separate planes are only packed for consumers which need the frame in one block
+    bool contiguous = m_frameExport.isOpen() || m_streamServer.isRunning() || m_snapShot || m_burstShot;
+    void *frame = mapFramePlanes(buf, contiguous);
+    v4l2_format frameFormat = m_capSrcFormat;
+    if (isMultiPlanar() && m_planeFormat.fmt.pix_mp.num_planes > 1)
+        frameFormat.fmt.pix.pixelformat = contiguousPixelFormat(frameFormat.fmt.pix.pixelformat);
+
     previewFrameSkipCount++;
     if(skippingPreviewFrame && previewFrameSkipCount <= previewFrameToSkip){
-
-        qbuf(buf);
-        retrieveFrame=true;
-        emit signalTograbPreviewFrame(retrieveframeStoreCamInCross,true);
-        return;
+        if(m_settleDetection)
+            updateSettle(frame, false);
+        if(!m_settleDetection || !m_settle.isSettled()){
+            queueCaptureBuffer(buf);
+            retrieveFrame=true;
+            emit signalTograbPreviewFrame(retrieveframeStoreCamInCross,true);
+            return;
+        }
+        // settled before the count ran out, preview from this frame on
+        previewFrameSkipCount = previewFrameToSkip + 1;
     }
 
     switch(m_capSrcFormat.fmt.pix.pixelformat) {
@@ -830,20 +1210,38 @@ void Videostreaming::capFrame()
     }
 
     if (validFrame != true){
-        qbuf(buf);
+        queueCaptureBuffer(buf);
         emit signalTograbPreviewFrame(retrieveframeStoreCam,true); //Added by Navya ---  Inorder to get the preview
         return;
     }
 
+    // capture time and sequence of the frame for pairing with the other cameras
+    if(m_frameSync){
+        FrameSynchronizer::instance()->submit(m_session, frameFormat, buf, m_frameCaptureNs);
+    }
+
     // prepare yuyv/rgba buffer and give to shader.
 
-    if(!prepareBuffer(m_capSrcFormat.fmt.pix.pixelformat, m_buffers[buf.index].start[0], buf.bytesused)){
-        qbuf(buf);
+    if(!prepareBuffer(m_capSrcFormat.fmt.pix.pixelformat, frame, buf.bytesused)){
+        queueCaptureBuffer(buf);
         emit signalTograbPreviewFrame(retrieveframeStoreCam,true);  //Added by Navya  ---Querying the buffer again
         return;
     }
 
 
+    if(m_frameExport.isOpen()){
+        m_frameExport.publish(frame, frameFormat, buf, m_frameCaptureNs);
+    }
+
+    // compressed formats are served as they come from the camera, no re-encoding
+    if(m_streamServer.isRunning()){
+        if(m_capSrcFormat.fmt.pix.pixelformat == V4L2_PIX_FMT_MJPEG){
+            m_streamServer.pushFrame(StreamServer::MJPEG_STREAM, frame, buf.bytesused);
+        }else if(m_capSrcFormat.fmt.pix.pixelformat == V4L2_PIX_FMT_H264){
+            m_streamServer.pushFrame(StreamServer::H264_STREAM, frame, buf.bytesused);
+        }
+    }
+
     if(!m_snapShot && !retrieveShot){  // Checking for retrieveshot flag inorder to avoid, updating still frame to UI
         m_renderer->gotFrame = true;    
     }
@@ -854,6 +1252,7 @@ void Videostreaming::capFrame()
         if(!y16BayerFormat){ //  y16 bayer format means these conversions are not needed. Calculations are done in "prepareBuffer" function itself.
             // Ex: cu40 camera
             if(m_capSrcFormat.fmt.pix.pixelformat == V4L2_PIX_FMT_Y16){ // y16
+                monoStillSource();
                 copy = m_capSrcFormat;
                 copy.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
                 err = v4lconvert_convert(m_convertData, &copy, &m_capDestFormat,
@@ -864,7 +1263,7 @@ void Videostreaming::capFrame()
             }else if(m_capSrcFormat.fmt.pix.pixelformat == V4L2_PIX_FMT_Y12){
                 err = 0;
                 if(formatType == "raw"){
-                    void *inputBuffer = m_buffers[buf.index].start[0] ;
+                    void *inputBuffer = frame;
                     onY12Format = true;
                     uint8_t *pfmb = yuyvBuffer_Y12;
                     for(__u32 l=0; l<(width *height * 3)/2; l+=3){
@@ -882,6 +1281,7 @@ void Videostreaming::capFrame()
                     // Added by Navya: 12 Aug 2019 -- Fixed sizeimage and bytesperline values for incoming Src Buffer as they are updated with improper values.
                     m_capSrcFormat.fmt.pix.sizeimage = width*height*2; // Initially it was width*height*1.5
                     m_capSrcFormat.fmt.pix.bytesperline = width *2;  // Initially it was width *1.5
+                    monoStillSource();
                     copy = m_capSrcFormat;
                     copy.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
 
@@ -897,18 +1297,14 @@ void Videostreaming::capFrame()
                                          (unsigned char *)yuv420pdestBuffer, (width* height * 3)/2,
                                          m_capImage->bits(), m_capDestFormat.fmt.pix.sizeimage); // yuv420p to rgb conversion
             }else{
-                err = v4lconvert_convert(m_convertData, &m_capSrcFormat, &m_capDestFormat,
-                                         (unsigned char *)m_buffers[buf.index].start[0], buf.bytesused,
+                err = v4lconvert_convert(m_convertData, &frameFormat, &m_capDestFormat,
+                                         (unsigned char *)frame, buf.bytesused,
                         m_capImage->bits(), m_capDestFormat.fmt.pix.sizeimage); // src format to rgb conversion
             }
             if(err == -1){
                 logCriticalHandle(v4lconvert_get_error_message(m_convertData));
-                if(retrieveframeStoreCam){
-                    for(int i=0; i<m_bufReqCount; i++){
-                        dqbuf_mmap(buf, buftype, again);
-                    }
-                }
-                qbuf(buf);
+                if(!retrieveframeStoreCam || drainCaptureBuffers(buf))
+                    queueCaptureBuffer(buf);
                 emit signalTograbPreviewFrame(retrieveframeStoreCam,true);
 
                 return;
@@ -916,19 +1312,23 @@ void Videostreaming::capFrame()
         }
     }
     
+    if((m_snapShot || m_burstShot) && m_settleDetection){
+        updateSettle(frame, true);
+    }
+
     // Taking single shot or burst shot - Skip frames if needed
 
-       if(((m_frame > frameToSkip) && m_snapShot) || ((m_frame > frameToSkip) && m_burstShot)){
+       if((stillFrameReady() && m_snapShot) || (stillFrameReady() && m_burstShot)){
          getFileName(getFilePath(),getImageFormatType());
 
          /*Added by Navya: 27 Mar 2019
            Checking whether the frame is still/preview. */
 
-         temp_Buffer = (unsigned char *)malloc(width * height * 2);
-         memcpy(temp_Buffer,(unsigned char *)m_buffers[buf.index].start[0],buf.bytesused);
+         // read the still/preview marker directly from the capture buffer, no need to copy the frame
+         frameData = (unsigned char *)frame;
 
          if(buf.bytesused>0){
-             if(((uint8_t *)temp_Buffer)[(buf.bytesused)-3] == 0xDC)
+             if(((uint8_t *)frameData)[(buf.bytesused)-3] == 0xDC)
              {
                  if(retrieveframeStoreCam || retrieveframeStoreCamInCross)
                  {
@@ -939,7 +1339,7 @@ void Videostreaming::capFrame()
                      OnMouseClick=true;
                  }
              }
-             else if(((uint8_t *)temp_Buffer)[(buf.bytesused)-3] == 0xDD)
+             else if(((uint8_t *)frameData)[(buf.bytesused)-3] == 0xDD)
                 {
 
                 }
@@ -952,7 +1352,7 @@ void Videostreaming::capFrame()
                     onY12Format = false;
                 }
             }
-            else if(saveRawFile(m_buffers[buf.index].start[0], buf.bytesused))
+            else if(saveRawFile(frame, buf.bytesused))
             {
                 imgSaveSuccessCount++;
             }
@@ -1038,14 +1438,10 @@ void Videostreaming::capFrame()
 	free(bayerIRBuffer);
 	bayerIRBuffer = NULL;
     }   
-    if(retrieveframeStoreCam){
-        for(int i=0; i<m_bufReqCount; i++){
-            dqbuf_mmap(buf, buftype, again);
-        }
-    }
-    qbuf(buf);
+    if(!retrieveframeStoreCam || drainCaptureBuffers(buf))
+        queueCaptureBuffer(buf);
 
-    if(m_frame >frameToSkip)
+    if(stillFrameReady())
     {
       emit signalTograbPreviewFrame(retrieveframeStoreCam,false);
       retrieveframeStoreCam=false;
@@ -1054,7 +1450,6 @@ void Videostreaming::capFrame()
     else{
       emit signalTograbPreviewFrame(retrieveframeStoreCamInCross,false);
     }
-    freeBuffer(temp_Buffer);
 
     // Added by Navya :23 Apr 2019
     // Call for previewwindow inorder to set mousearea in qml.
@@ -1092,12 +1487,8 @@ int Videostreaming::jpegDecode(Videostreaming *obj, unsigned char **pic, unsigne
 
     srcSize = bytesUsed;
 
-    if((srcbuf=(unsigned char *)malloc(srcSize))==NULL){
-        obj->logDebugHandle("allocating memory");
-	goto bailout;
-    }
-
-    memcpy(srcbuf,buf,srcSize);
+    // decode in place - buf is a retained pool slot or tempSrcBuffer, neither changes until the decode is over
+    srcbuf = buf;
 
     if((handle = tjInitTransform()) == NULL){
         obj->logDebugHandle("executing tjInitTransform()");
@@ -1141,7 +1532,9 @@ int Videostreaming::jpegDecode(Videostreaming *obj, unsigned char **pic, unsigne
 
         memset(jpegsize, 0, sizeof(unsigned long)*ntilesw*ntilesh);
 
-        if((obj->flags&TJFLAG_NOREALLOC)!=0 || !obj->dotile)
+        if(!obj->dotile)
+            jpegbuf[0] = srcbuf; // single tile is the frame itself
+        else if((obj->flags&TJFLAG_NOREALLOC)!=0)
             for(i=0; i<ntilesw*ntilesh; i++)
             {
                 if((jpegbuf[i] = (unsigned char *)tjAlloc(tjBufSize(tilew, tileh,
@@ -1158,7 +1551,8 @@ int Videostreaming::jpegDecode(Videostreaming *obj, unsigned char **pic, unsigne
         _h = h;
 
         jpegsize[0] = srcSize;
-        memcpy(jpegbuf[0], srcbuf, srcSize); /* Important Step */
+        if(obj->dotile)
+            memcpy(jpegbuf[0], srcbuf, srcSize); /* Important Step */
 
         if(w == tilew)
             _tilew = _w;
@@ -1176,7 +1570,8 @@ int Videostreaming::jpegDecode(Videostreaming *obj, unsigned char **pic, unsigne
 
         for(i=0; i<ntilesw*ntilesh; i++)
         {
-            tjFree(jpegbuf[i]);
+            if(obj->dotile)
+                tjFree(jpegbuf[i]);
             jpegbuf[i] = NULL;
         }
         free(jpegbuf);
@@ -1195,6 +1590,7 @@ int Videostreaming::jpegDecode(Videostreaming *obj, unsigned char **pic, unsigne
         if(obj->videoEncoder!=NULL) {
             QMutexLocker lockerRecord(&obj->recordMutex);
             if(obj->videoEncoder->ok){
+                obj->videoEncoder->setFrameTime(obj->m_decodeFrameNs);
                 obj->videoEncoder->encodeImage(*pic, true);
             }
             lockerRecord.unlock();
@@ -1213,7 +1609,7 @@ bailout:
     {
         for(i=0; i<ntilesw*ntilesh; i++)
         {
-            if(jpegbuf[i])
+            if(jpegbuf[i] && obj->dotile)
                 tjFree(jpegbuf[i]);
 
             jpegbuf[i] = NULL;
@@ -1225,10 +1621,6 @@ bailout:
         free(jpegsize);
         jpegsize = NULL;
     }
-    if(srcbuf) {
-        free(srcbuf);
-        srcbuf = NULL;
-    }
     if(t) {
         free(t);
         t = NULL;
@@ -1238,6 +1630,10 @@ bailout:
         handle = NULL;
     }
 
+   if(obj->m_decodeSlot >= 0){
+       obj->m_framePool.release(obj->m_decodeSlot);
+       obj->m_decodeSlot = -1;
+   }
    locker.unlock();
 
    obj->frameSkip = false;
@@ -1678,6 +2074,79 @@ void rgb2yuyv(uint8_t *prgb, uint8_t *pyuv, int width, int height)
 }
 
 // Added by Sankari: Nov 8 2017 . prepare yuv buffer and give to shader.
+/**
+ * @brief unpackY12 - packed 12 bit mono to one 16 bit sample per pixel. Each 3 byte group holds
+ * the msb of two pixels followed by their lsb nibbles [second pixel in the high nibble].
+ * @param pixels - even
+ */
+static void unpackY12(uint16_t *dst, const uint8_t *src, uint pixels)
+{
+    uint i = 0;
+#if defined(__SSE2__)
+    // 4 groups [8 pixels] per iteration, the 16 byte load reads 4 bytes past them
+    const __m128i lsb = _mm_set1_epi32(0xFF);
+    const __m128i nibble = _mm_set1_epi32(0xF);
+    for (; i + 12 <= pixels; i += 8, src += 12) {
+        __m128i v = _mm_loadu_si128((const __m128i *)src);
+        // group n to 32 bit lane n
+        __m128i g = _mm_unpacklo_epi64(_mm_unpacklo_epi32(v, _mm_srli_si128(v, 3)),
+                                       _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9)));
+        __m128i p0 = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(g, lsb), 4),
+                                  _mm_and_si128(_mm_srli_epi32(g, 16), nibble));
+        __m128i p1 = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(g, 8), lsb), 4),
+                                  _mm_and_si128(_mm_srli_epi32(g, 20), nibble));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(p0, _mm_slli_epi32(p1, 16)));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    // 16 groups [32 pixels] per iteration
+    for (; i + 32 <= pixels; i += 32, src += 48) {
+        uint8x16x3_t g = vld3q_u8(src);
+        uint8x16_t lo0 = vandq_u8(g.val[2], vdupq_n_u8(0xF));
+        uint8x16_t lo1 = vshrq_n_u8(g.val[2], 4);
+        uint16x8x2_t out;
+        out.val[0] = vorrq_u16(vshll_n_u8(vget_low_u8(g.val[0]), 4), vmovl_u8(vget_low_u8(lo0)));
+        out.val[1] = vorrq_u16(vshll_n_u8(vget_low_u8(g.val[1]), 4), vmovl_u8(vget_low_u8(lo1)));
+        vst2q_u16(dst + i, out);
+        out.val[0] = vorrq_u16(vshll_n_u8(vget_high_u8(g.val[0]), 4), vmovl_u8(vget_high_u8(lo0)));
+        out.val[1] = vorrq_u16(vshll_n_u8(vget_high_u8(g.val[1]), 4), vmovl_u8(vget_high_u8(lo1)));
+        vst2q_u16(dst + i + 16, out);
+    }
+#endif
+    for (; i + 1 < pixels; i += 2, src += 3) {
+        dst[i] = src[0] << 4 | (src[2] & 0xF);
+        dst[i + 1] = src[1] << 4 | src[2] >> 4;
+    }
+}
+
+/**
+ * @brief releasePoolFrame - AVBuffer free callback of poolFrameRef
+ */
+static void releasePoolFrame(void *opaque, uint8_t *data)
+{
+    FramePool *pool = (FramePool *)opaque;
+    pool->release(pool->slotOf(data));
+}
+
+/**
+ * @brief Videostreaming::poolFrameRef - reference to the pool frame being processed, so the
+ * muxer can keep it after the buffer is requeued. NULL for mmap capture [the packet is copied].
+ */
+AVBufferRef *Videostreaming::poolFrameRef(void *data, __u32 bytesUsed)
+{
+#if LIBAVCODEC_VER_AT_LEAST(57,12)
+    if (m_currentSlot < 0)
+        return NULL;
+    AVBufferRef *ref = av_buffer_create((uint8_t *)data, bytesUsed, releasePoolFrame, &m_framePool, AV_BUFFER_FLAG_READONLY);
+    if (ref)
+        m_framePool.retain(m_currentSlot);
+    return ref;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(bytesUsed);
+    return NULL;
+#endif
+}
+
 bool Videostreaming::prepareBuffer(__u32 pixformat, void *inputbuffer, __u32 bytesUsed){
     if(pixformat == V4L2_PIX_FMT_MJPEG){
         m_renderer->renderBufferFormat = CommonEnums::RGB_BUFFER_RENDER;
@@ -1690,10 +2159,23 @@ bool Videostreaming::prepareBuffer(__u32 pixformat, void *inputbuffer, __u32 byt
                 if(!frameSkip){       		    
                      getFrameRates();
                      frameSkip = true;
+                    if(m_currentSlot >= 0){
+                        // pool frame - decode directly from capture memory, slot is released after decode
+                        if(m_renderer && m_renderer->rgbaDestBuffer){
+                            m_framePool.retain(m_currentSlot);
+                            m_decodeSlot = m_currentSlot;
+                            m_decodeFrameNs = m_frameCaptureNs;
+                            QtConcurrent::run(jpegDecode, this, &m_renderer->rgbaDestBuffer, (unsigned char *)inputbuffer, bytesUsed);
+                        }else{
+                            frameSkip = false;
+                        }
+                    }else{
                     memcpy(tempSrcBuffer, (unsigned char *)inputbuffer, bytesUsed);
 		    if(m_renderer && m_renderer->rgbaDestBuffer){
+                        m_decodeFrameNs = m_frameCaptureNs;
                     	QtConcurrent::run(jpegDecode, this, &m_renderer->rgbaDestBuffer, tempSrcBuffer, bytesUsed);
 		    }
+                    }
                 }else{                
                 }
             }
@@ -1704,7 +2186,6 @@ bool Videostreaming::prepareBuffer(__u32 pixformat, void *inputbuffer, __u32 byt
 
         return true;
     }else{
-        uint8_t *srcBuffer = NULL;
         uint8_t *destBuffer = NULL;
         getFrameRates();
         m_renderer->renderyuyvMutex.lock();
@@ -1749,7 +2230,15 @@ bool Videostreaming::prepareBuffer(__u32 pixformat, void *inputbuffer, __u32 byt
                 break;
 
                 case V4L2_PIX_FMT_SGRBG8:{  // BA8 to yuyv conversion
-                    m_renderer->renderBufferFormat = CommonEnums::YUYV_BUFFER_RENDER;
+                    if(m_bayerPreview){
+                        // raw plane to the demosaic shader, the yuyv below only feeds the recording
+                        m_renderer->renderBufferFormat = CommonEnums::BAYER_BUFFER_RENDER;
+                        memcpy(m_renderer->yBuffer, inputbuffer, width*height);
+                        if(!m_VideoRecord)
+                            break;
+                    }else{
+                        m_renderer->renderBufferFormat = CommonEnums::YUYV_BUFFER_RENDER;
+                    }
                     destBuffer = (uint8_t *)malloc(width * height * 3);
                     bayer_to_rgbbgr24((uint8_t *)inputbuffer, destBuffer, width, height, 1, 1);
                     rgb2yuyv(destBuffer, yuyvBuffer, width, height);
@@ -1758,19 +2247,9 @@ bool Videostreaming::prepareBuffer(__u32 pixformat, void *inputbuffer, __u32 byt
                 }
                 break;
 
-                case V4L2_PIX_FMT_GREY:{ // grey to yuyv conversion
-                    m_renderer->renderBufferFormat = CommonEnums::YUYV_BUFFER_RENDER;
-                    uint8_t *pfmb = yuyvBuffer;
-                    for(int h=0;h<height;h++)
-                    {
-                        int offset = width * h;
-                        for(int w=0;w<width;w++)
-                        {
-                            *pfmb++=(((uint8_t *) inputbuffer)[w + offset]); // y
-                            *pfmb++=0x80;                  //U or V
-                        }
-                    }
-		    memcpy(m_renderer->yuvBuffer, yuyvBuffer, width*height*2);                    
+                case V4L2_PIX_FMT_GREY:{ // luma goes to the mono texture as it is
+                    m_renderer->renderBufferFormat = CommonEnums::MONO_BUFFER_RENDER;
+                    memcpy(m_renderer->yBuffer, inputbuffer, width*height);
                 }
                 break;
 
@@ -1804,40 +2283,43 @@ bool Videostreaming::prepareBuffer(__u32 pixformat, void *inputbuffer, __u32 byt
                 }
                 break;
 
-                case V4L2_PIX_FMT_Y16:{
-                    m_renderer->renderBufferFormat = CommonEnums::YUYV_BUFFER_RENDER;
-                    srcBuffer = (uint8_t *)malloc(width * height * 2);
-
-                    uint8_t *pfmb = yuyvBuffer;
-                    memcpy(srcBuffer, inputbuffer, (width * height * 2));
-                    for(__u32 l=0; l<(width * height*2); l=l+2) /* Y16 to YUYV conversion */
-                    {
-                       *pfmb++ = (((srcBuffer[l] & 0xF0) >> 4) | (srcBuffer[l+1] & 0x0F) << 4);
-                       *pfmb++ = 0x80;
-                    }
-                    memcpy(m_renderer->yuvBuffer, yuyvBuffer, width*height*2);                    
-                    freeBuffer(srcBuffer);
+                case V4L2_PIX_FMT_Y16:{ // 12 bit samples, to the 16 bit mono texture as they are
+                    m_renderer->renderBufferFormat = CommonEnums::MONO16_BUFFER_RENDER;
+                    memcpy(m_renderer->y16Buffer, inputbuffer, width*height*2);
                 }
                 break;
-            case V4L2_PIX_FMT_Y12:{
-                m_renderer->renderBufferFormat = CommonEnums::YUYV_BUFFER_RENDER;
-                srcBuffer = (uint8_t *)malloc((width * height *3)/2);
-                uint8_t *pfmb = yuyvBuffer;
-                memcpy(srcBuffer, inputbuffer, ((width * height *3)/2));
-                for( __u32 l=0; l<(width* height * 3)/2; l=l+3) /* Y12 to YUYV conversion */
-                {
-                    *pfmb++ = (((uint8_t *)srcBuffer)[l]);
-                    *pfmb++ = 0x80;
-                    *pfmb++ = (((uint8_t *)srcBuffer)[l+1]);
-                    *pfmb++ = 0x80;
+            case V4L2_PIX_FMT_Y12:{ // packed 12 bit samples, to the 16 bit mono texture
+                m_renderer->renderBufferFormat = CommonEnums::MONO16_BUFFER_RENDER;
+                unpackY12(m_renderer->y16Buffer, (const uint8_t *)inputbuffer, width*height);
+            }
+                break;
+            case V4L2_PIX_FMT_NV12:
+            case V4L2_PIX_FMT_NV21:
+            case V4L2_PIX_FMT_NV12M:
+            case V4L2_PIX_FMT_NV21M:
+            case V4L2_PIX_FMT_YUV420:
+            case V4L2_PIX_FMT_YVU420:
+            case V4L2_PIX_FMT_YUV420M:
+            case V4L2_PIX_FMT_YVU420M:{ // 4:2:0 planes go to the y, u, v textures without yuyv packing
+                if(!m_framePlane[0] || !m_framePlane[1]){
+                    m_renderer->renderyuyvMutex.unlock();
+                    return false;
                 }
-                memcpy(m_renderer->yuvBuffer, yuyvBuffer, width*height*2);
-                freeBuffer(srcBuffer);
+                m_renderer->renderBufferFormat = CommonEnums::YUV420_BUFFER_RENDER;
+                copyYUV420Planes(pixformat);
             }
                 break;
             }
         }
-        if(m_renderer->renderBufferFormat == CommonEnums::YUYV_BUFFER_RENDER){
+        if(m_renderer->renderBufferFormat == CommonEnums::YUV420_BUFFER_RENDER ||
+           m_renderer->renderBufferFormat == CommonEnums::MONO_BUFFER_RENDER ||
+           m_renderer->renderBufferFormat == CommonEnums::MONO16_BUFFER_RENDER){
+            if(m_VideoRecord && videoEncoder!=NULL){
+                m_recordFrameNs = m_frameCaptureNs;
+                QtConcurrent::run(captureVideoInThread, this);
+            }
+        }else if(m_renderer->renderBufferFormat == CommonEnums::YUYV_BUFFER_RENDER ||
+                 m_renderer->renderBufferFormat == CommonEnums::BAYER_BUFFER_RENDER){
             if(m_VideoRecord){
                 if(videoEncoder!=NULL) {
         #if LIBAVCODEC_VER_AT_LEAST(54,25)
@@ -1845,8 +2327,10 @@ bool Videostreaming::prepareBuffer(__u32 pixformat, void *inputbuffer, __u32 byt
         #else
                         if(pixformat == V4L2_PIX_FMT_H264 && videoEncoder->pOutputFormat->video_codec == CODEC_ID_H264){
         #endif
-                            videoEncoder->writeH264Image(inputbuffer, bytesUsed);
+                            videoEncoder->setFrameTime(m_frameCaptureNs);
+                            videoEncoder->writeH264Image(inputbuffer, bytesUsed, poolFrameRef(inputbuffer, bytesUsed));
                         }else{
+                             m_recordFrameNs = m_frameCaptureNs;
                              QtConcurrent::run(captureVideoInThread, this);
                         }
                 }
@@ -1951,98 +2435,922 @@ bool Videostreaming::startCapture()
 
     memset(&req, 0, sizeof(req));
 
-    if (!reqbufs_mmap(req, buftype, 3)) {
-        emit logCriticalHandle("Cannot capture");
-        return false;
-    }
-
-    if (req.count < 2) {
-        emit logCriticalHandle("Too few buffers");
-        reqbufs_mmap(req, buftype);
-        return false;
-    }
-
-    m_buffers = (buffer *)calloc(req.count, sizeof(*m_buffers));
-
-    if (!m_buffers) {
-        emit logCriticalHandle("Out of memory");
-        reqbufs_mmap(req, buftype);
-        return false;
+    m_bufferMemory = V4L2_MEMORY_MMAP;
+    m_currentSlot = -1;
+    // pool frames are one contiguous block, formats with separate planes need driver buffers
+    if (m_captureMemory != V4L2_MEMORY_MMAP && (!isMultiPlanar() || m_planeFormat.fmt.pix_mp.num_planes <= 1)) {
+        if (requestPoolBuffers(initialCaptureBufferCount()))
+            m_bufferMemory = m_captureMemory;
+        else
+            emit logDebugHandle("Capture into frame pool not supported, using mmap buffers");
     }
 
-    for (m_nbuffers = 0; m_nbuffers < req.count; ++m_nbuffers) {
-        v4l2_plane planes[VIDEO_MAX_PLANES];
-        v4l2_buffer buf;
+    if (m_bufferMemory == V4L2_MEMORY_MMAP) {
+        if (!reqbufs_mmap(req, buftype, initialCaptureBufferCount())) {
+            emit logCriticalHandle("Cannot capture");
+            return false;
+        }
 
-        memset(&buf, 0, sizeof(buf));
+        if (req.count < 2) {
+            emit logCriticalHandle("Too few buffers");
+            reqbufs_mmap(req, buftype);
+            return false;
+        }
 
-        buf.type        = buftype;
-        buf.memory      = V4L2_MEMORY_MMAP;
-        buf.index       = m_nbuffers;
-        buf.length      = VIDEO_MAX_PLANES;
-        buf.m.planes    = planes;
+        m_buffers = (buffer *)calloc(req.count, sizeof(*m_buffers));
 
-        if (-1 == ioctl(VIDIOC_QUERYBUF, &buf)) {
-            perror("VIDIOC_QUERYBUF");
+        if (!m_buffers) {
+            emit logCriticalHandle("Out of memory");
+            reqbufs_mmap(req, buftype);
             return false;
         }
 
-        m_buffers[m_nbuffers].planes = 1;
-        m_buffers[m_nbuffers].length[0] = buf.length;
-        m_buffers[m_nbuffers].start[0] = mmap(buf.length, buf.m.offset);
-        if (MAP_FAILED == m_buffers[m_nbuffers].start[0]) {
-            perror("mmap");
+        m_nbuffers = 0;
+        if (!mapCaptureBuffers(0, req.count))
             return false;
-        }
     }
+
+    m_queuedBuffers = 0;
+    m_parkRequest = 0;
+    m_parkedBuffers.clear();
+    m_starvedBuffers.clear();
     for (i = 0; i < m_nbuffers; ++i) {
-        if (!qbuf_mmap(i, buftype)) {
+        if (!queueBufferIndex(i)) {
             emit logCriticalHandle("Querying Buffer failed");
             perror("VIDIOC_QBUF");
             return false;
         }
+        m_queuedBuffers++;
     }
     if (!streamon(buftype)) {
         emit logCriticalHandle("Stream ON failed");
         perror("VIDIOC_STREAMON");
         return false;
     }
+    emit logDebugHandle("Capture buffers: "+QString::number(m_nbuffers));
+
+    if (m_usbLinkValid) {
+        v4l2_fract curInterval;
+        uint fps = 30;
+        if (get_interval(m_buftype, curInterval) && curInterval.numerator && curInterval.denominator)
+            fps = curInterval.denominator / curInterval.numerator;
+        qint64 needed = BandwidthPlanner::estimateBandwidth(m_capSrcFormat.fmt.pix.pixelformat, m_capSrcFormat.fmt.pix.width,
+                                                            m_capSrcFormat.fmt.pix.height, fps);
+        qint64 usable = BandwidthPlanner::instance()->available(m_session, m_usbLink);
+        if (!BandwidthPlanner::instance()->fits(m_session, m_usbLink, needed))
+            emit logCriticalHandle("Stream needs about "+QString::number(needed / 1e6, 'f', 1)+" MB/s, "+
+                                   QString::number(qMax(usable, 0LL) / 1e6, 'f', 1)+" MB/s left on usb bus "+
+                                   QString::number(m_usbLink.bus)+" - frames may be lost");
+        BandwidthPlanner::instance()->reserve(m_session, m_usbLink, needed);
+    }
+
+    m_frameCaptureNs = 0;
+    m_latencyTimer.invalidate();
+    m_latencySum = m_latencyMax = 0;
+    m_latencyFrames = 0;
+    if (m_hwTimestamps) {
+        v4l2_capability cap;
+        bool started;
+        if (!m_metadataReplay.isEmpty())
+            started = m_uvcMetadata.startReplay(m_metadataReplay);
+        else
+            started = querycap(cap) && m_uvcMetadata.start(QString((const char *)cap.bus_info));
+        if (started)
+            emit logDebugHandle("Frame capture time from "+m_uvcMetadata.node());
+        else
+            emit logDebugHandle("No UVC metadata node, using driver timestamps");
+    }
+
+    if (m_frameExportEnabled)
+        openFrameExport();
+
+    m_sequenceValid = false;
+    m_adaptFrames = m_sequenceGaps = m_idleWindows = 0;
+    m_processingNsecs = 0;
+    m_processingTimer.invalidate();
+    v4l2_fract curInterval;
+    m_framePeriodNsecs = 33333333;
+    if (get_interval(m_buftype, curInterval) && curInterval.numerator && curInterval.denominator)
+        m_framePeriodNsecs = (qint64)1000000000 * curInterval.numerator / curInterval.denominator;
 
     previewFrameSkipCount = 1;
+    m_settle.reset();
     return true;
 }
 
-int Videostreaming::findMax(QList<int> *list) {
+/**
+ * @brief Videostreaming::initialCaptureBufferCount - number of buffers to request on stream start
+ * User selected count is used if set, otherwise the count learned in the last stream or enough
+ * buffers to hold CAPTURE_BUFFER_LATENCY_MS of frames. Result is limited by the memory budget.
+ */
+uint Videostreaming::initialCaptureBufferCount()
+{
+    uint count;
+    size_t frameSize = m_capSrcFormat.fmt.pix.sizeimage;
 
-    int array[list->count()];
-    for(int j=0;j<list->count();j++)
-        array[j] = list->at(j);
-    int index_of_min = 0;
-    for(int x=0; x<list->count(); x++)
-    {
-        index_of_min = x;
-        for(int y=x; y<list->count(); y++)
-        {
-            if(array[index_of_min] > array[y])
-            {
-                index_of_min = y;
-            }
-        }
-        int temp = array[x];
-        array[x] = array[index_of_min];
-        array[index_of_min] = temp;
+    if (m_captureBufferCount) {
+        count = m_captureBufferCount;
+    } else if (m_learnedBufferCount) {
+        count = m_learnedBufferCount;
+    } else {
+        v4l2_fract curInterval;
+        uint fps = 30;
+        if (get_interval(m_buftype, curInterval) && curInterval.numerator && curInterval.denominator)
+            fps = curInterval.denominator / curInterval.numerator;
+        count = (fps * CAPTURE_BUFFER_LATENCY_MS + 999) / 1000 + 1;
     }
-    return array[index_of_min];
+
+    if (frameSize && count * frameSize > m_bufferMemoryBudget)
+        count = m_bufferMemoryBudget / frameSize;
+    if (count < MIN_CAPTURE_BUFFERS)
+        count = MIN_CAPTURE_BUFFERS;
+    if (count > MAX_CAPTURE_BUFFERS)
+        count = MAX_CAPTURE_BUFFERS;
+    return count;
 }
 
 /**
- * @brief Videostreaming::updateFrameToSkip
- * @param stillSkip
+ * @brief Videostreaming::getCaptureFormat - current capture format, single-planar view
+ * For multi-planar devices the plane layout is kept in m_planeFormat, the view has the
+ * bytesperline of the first plane and the sizeimage of all planes.
+ */
+bool Videostreaming::getCaptureFormat(v4l2_format &fmt)
+{
+    if (!isMultiPlanar())
+        return g_fmt_cap(m_buftype, fmt);
+    if (!g_fmt_cap(m_buftype, m_planeFormat))
+        return false;
+    mplane_to_pix(m_planeFormat, fmt);
+    return true;
+}
+
+bool Videostreaming::setCaptureFormat(v4l2_format &fmt)
+{
+    if (!isMultiPlanar())
+        return s_fmt(fmt);
+    v4l2_format planeFormat;
+    pix_to_mplane(fmt, planeFormat);
+    if (!s_fmt(planeFormat))
+        return false;
+    m_planeFormat = planeFormat;
+    mplane_to_pix(planeFormat, fmt);
+    return true;
+}
+
+bool Videostreaming::tryCaptureFormat(v4l2_format &fmt)
+{
+    if (!isMultiPlanar())
+        return try_fmt(fmt);
+    v4l2_format planeFormat;
+    pix_to_mplane(fmt, planeFormat);
+    if (!try_fmt(planeFormat))
+        return false;
+    mplane_to_pix(planeFormat, fmt);
+    return true;
+}
+
+/**
+ * @brief Videostreaming::mapFramePlanes - locate the planes of a dequeued buffer
+ * Sets buf.bytesused to the payload of all planes and fills m_framePlane/m_framePlaneStride
+ * for 4:2:0 formats, so those are rendered and recorded straight from the capture buffer.
+ * @param contiguous - pack the planes of a multi-plane buffer into one block
+ * @return frame data as one block, NULL for a multi-plane buffer without contiguous
+ */
+void *Videostreaming::mapFramePlanes(v4l2_buffer &buf, bool contiguous)
+{
+    const buffer &mem = m_buffers[buf.index];
+    uint8_t *start[VIDEO_MAX_PLANES];
+    uint used[VIDEO_MAX_PLANES];
+    int stride[VIDEO_MAX_PLANES];
+    uint count = 1;
+
+    start[0] = (uint8_t *)mem.start[0];
+    used[0] = buf.bytesused;
+    stride[0] = m_capSrcFormat.fmt.pix.bytesperline ? m_capSrcFormat.fmt.pix.bytesperline : width;
+    if (isMultiPlanar()) {
+        count = qMin((uint)buf.length, mem.planes);
+        buf.bytesused = 0;
+        for (uint p = 0; p < count; p++) {
+            const v4l2_plane &plane = buf.m.planes[p];
+            start[p] = (uint8_t *)mem.start[p] + plane.data_offset;
+            used[p] = plane.bytesused > plane.data_offset ? plane.bytesused - plane.data_offset : 0;
+            stride[p] = m_planeFormat.fmt.pix_mp.plane_fmt[p].bytesperline;
+            buf.bytesused += used[p];
+        }
+    }
+
+    memset(m_framePlane, 0, sizeof(m_framePlane));
+    switch (m_capSrcFormat.fmt.pix.pixelformat) {
+    case V4L2_PIX_FMT_NV12:
+    case V4L2_PIX_FMT_NV21:
+        m_framePlane[0] = start[0];
+        m_framePlane[1] = start[0] + stride[0] * height;
+        m_framePlaneStride[0] = m_framePlaneStride[1] = stride[0];
+        break;
+    case V4L2_PIX_FMT_YUV420:
+    case V4L2_PIX_FMT_YVU420:
+        m_framePlane[0] = start[0];
+        m_framePlane[1] = start[0] + stride[0] * height;
+        m_framePlane[2] = m_framePlane[1] + (stride[0] / 2) * (height / 2);
+        m_framePlaneStride[0] = stride[0];
+        m_framePlaneStride[1] = m_framePlaneStride[2] = stride[0] / 2;
+        break;
+    case V4L2_PIX_FMT_NV12M:
+    case V4L2_PIX_FMT_NV21M:
+        if (count < 2)
+            break;
+        for (uint p = 0; p < 2; p++) {
+            m_framePlane[p] = start[p];
+            m_framePlaneStride[p] = stride[p];
+        }
+        break;
+    case V4L2_PIX_FMT_YUV420M:
+    case V4L2_PIX_FMT_YVU420M:
+        if (count < 3)
+            break;
+        for (uint p = 0; p < 3; p++) {
+            m_framePlane[p] = start[p];
+            m_framePlaneStride[p] = stride[p];
+        }
+        break;
+    }
+    // u before v in m_framePlane
+    if (m_capSrcFormat.fmt.pix.pixelformat == V4L2_PIX_FMT_YVU420 ||
+        m_capSrcFormat.fmt.pix.pixelformat == V4L2_PIX_FMT_YVU420M)
+        qSwap(m_framePlane[1], m_framePlane[2]);
+
+    if (count == 1)
+        return start[0];
+    if (!contiguous)
+        return NULL;
+    m_planeCopy.resize(buf.bytesused);
+    char *dest = m_planeCopy.data();
+    for (uint p = 0; p < count; p++) {
+        memcpy(dest, start[p], used[p]);
+        dest += used[p];
+    }
+    return m_planeCopy.data();
+}
+
+/**
+ * @brief Videostreaming::monoStillSource - yuyv of the current y12/y16 frame for the still conversion,
+ * the preview keeps the samples in the y16 buffer only. Top 8 of the 12 bits, neutral chroma.
+ */
+void Videostreaming::monoStillSource()
+{
+    m_renderer->renderyuyvMutex.lock();
+    const uint16_t *src = m_renderer->y16Buffer;
+    uint8_t *dst = m_renderer->yuvBuffer;
+    if(src && dst){
+        for(__u32 i = 0; i < width*height; i++){
+            *dst++ = src[i] >> 4;
+            *dst++ = 0x80;
+        }
+    }
+    m_renderer->renderyuyvMutex.unlock();
+}
+
+/**
+ * @brief Videostreaming::copyYUV420Planes - copy the planes found by mapFramePlanes to the
+ * y, u, v textures of the renderer, chroma of nv12/nv21 is split on the way
+ */
+void Videostreaming::copyYUV420Planes(__u32 pixformat)
+{
+    uint chromaWidth = width / 2, chromaHeight = height / 2;
+
+    for (uint h = 0; h < height; h++)
+        memcpy(m_renderer->yBuffer + h * width, m_framePlane[0] + h * m_framePlaneStride[0], width);
+
+    if (m_framePlane[2]) {
+        for (uint h = 0; h < chromaHeight; h++) {
+            memcpy(m_renderer->uBuffer + h * chromaWidth, m_framePlane[1] + h * m_framePlaneStride[1], chromaWidth);
+            memcpy(m_renderer->vBuffer + h * chromaWidth, m_framePlane[2] + h * m_framePlaneStride[2], chromaWidth);
+        }
+        return;
+    }
+
+    bool vFirst = (pixformat == V4L2_PIX_FMT_NV21 || pixformat == V4L2_PIX_FMT_NV21M);
+    uint8_t *u = vFirst ? m_renderer->vBuffer : m_renderer->uBuffer;
+    uint8_t *v = vFirst ? m_renderer->uBuffer : m_renderer->vBuffer;
+    for (uint h = 0; h < chromaHeight; h++) {
+        const uint8_t *uv = m_framePlane[1] + h * m_framePlaneStride[1];
+        for (uint w = 0; w < chromaWidth; w++) {
+            *u++ = uv[2 * w];
+            *v++ = uv[2 * w + 1];
+        }
+    }
+}
+
+/**
+ * @brief Videostreaming::mapCaptureBuffers - query and mmap driver buffers [first, first+count)
+ * m_buffers must already be large enough. m_nbuffers is advanced for each mapped buffer.
+ */
+bool Videostreaming::mapCaptureBuffers(uint first, uint count)
+{
+    for (m_nbuffers = first; m_nbuffers < first + count; ++m_nbuffers) {
+        v4l2_plane planes[VIDEO_MAX_PLANES];
+        v4l2_buffer buf;
+
+        memset(&buf, 0, sizeof(buf));
+
+        buf.type        = m_buftype;
+        buf.memory      = V4L2_MEMORY_MMAP;
+        buf.index       = m_nbuffers;
+        buf.length      = VIDEO_MAX_PLANES;
+        buf.m.planes    = planes;
+
+        if (-1 == ioctl(VIDIOC_QUERYBUF, &buf)) {
+            perror("VIDIOC_QUERYBUF");
+            return false;
+        }
+
+        if (!isMultiPlanar()) {
+            m_buffers[m_nbuffers].planes = 1;
+            m_buffers[m_nbuffers].length[0] = buf.length;
+            m_buffers[m_nbuffers].start[0] = mmap(buf.length, buf.m.offset);
+            if (MAP_FAILED == m_buffers[m_nbuffers].start[0]) {
+                perror("mmap");
+                return false;
+            }
+            continue;
+        }
+
+        // every plane of a multi-planar buffer is mapped on its own
+        m_buffers[m_nbuffers].planes = 0;
+        for (unsigned p = 0; p < buf.length && p < VIDEO_MAX_PLANES; p++) {
+            void *start = mmap(planes[p].length, planes[p].m.mem_offset);
+            if (MAP_FAILED == start) {
+                perror("mmap");
+                return false;
+            }
+            m_buffers[m_nbuffers].start[p] = start;
+            m_buffers[m_nbuffers].length[p] = planes[p].length;
+            m_buffers[m_nbuffers].planes++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Videostreaming::growCaptureBuffers - give more buffers to the driver while streaming
+ * Parked buffers are returned first, then new ones are added with VIDIOC_CREATE_BUFS.
+ * @param count - number of buffers to add
+ */
+bool Videostreaming::growCaptureBuffers(uint count)
+{
+    m_parkRequest = 0;
+    while (count && !m_parkedBuffers.isEmpty()) {
+        if (!queueBufferIndex(m_parkedBuffers.takeFirst()))
+            return false;
+        m_queuedBuffers++;
+        count--;
+    }
+    // new buffers are only created for driver allocated memory, the frame pool has a fixed size
+    if (!count || m_bufferMemory != V4L2_MEMORY_MMAP)
+        return !count;
+
+    size_t frameSize = m_capSrcFormat.fmt.pix.sizeimage;
+    if (m_nbuffers + count > MAX_CAPTURE_BUFFERS)
+        count = MAX_CAPTURE_BUFFERS - m_nbuffers;
+    if (frameSize && (m_nbuffers + count) * frameSize > m_bufferMemoryBudget)
+        count = (m_bufferMemoryBudget / frameSize > m_nbuffers) ? m_bufferMemoryBudget / frameSize - m_nbuffers : 0;
+    if (!count)
+        return false;
+
+    v4l2_create_buffers createbuf;
+    v4l2_format format = isMultiPlanar() ? m_planeFormat : m_capSrcFormat;
+    format.type = m_buftype;
+    if (!create_bufs_mmap(createbuf, format, count) || createbuf.count == 0) {
+        emit logDebugHandle("VIDIOC_CREATE_BUFS not supported, keeping "+QString::number(m_nbuffers)+" buffers");
+        return false;
+    }
+
+    buffer *newBuffers = (buffer *)realloc(m_buffers, (createbuf.index + createbuf.count) * sizeof(*m_buffers));
+    if (!newBuffers) {
+        emit logCriticalHandle("Out of memory");
+        return false;
+    }
+    m_buffers = newBuffers;
+    memset(&m_buffers[createbuf.index], 0, createbuf.count * sizeof(*m_buffers));
+
+    if (!mapCaptureBuffers(createbuf.index, createbuf.count))
+        return false;
+    for (uint i = createbuf.index; i < m_nbuffers; ++i) {
+        if (!qbuf_mmap(i, m_buftype)) {
+            perror("VIDIOC_QBUF");
+            return false;
+        }
+        m_queuedBuffers++;
+    }
+    emit logDebugHandle("Capture buffers increased to "+QString::number(m_nbuffers));
+    return true;
+}
+
+/**
+ * @brief Videostreaming::dequeueCaptureBuffer - dequeue a filled buffer and account it as userspace owned
+ */
+bool Videostreaming::dequeueCaptureBuffer(v4l2_buffer &buf, bool &again)
+{
+    bool ret;
+    if (m_bufferMemory == V4L2_MEMORY_USERPTR)
+        ret = dqbuf_user(buf, m_buftype, again);
+    else if (m_bufferMemory == V4L2_MEMORY_DMABUF)
+        ret = dqbuf_dmabuf(buf, m_buftype, again);
+    else
+        ret = dqbuf_mmap(buf, m_buftype, again);
+    if (!ret)
+        return false;
+    if (!again) {
+        m_currentSlot = (m_bufferMemory == V4L2_MEMORY_MMAP) ? -1 : m_bufferSlot.at(buf.index);
+        m_queuedBuffers--;
+        m_processingTimer.start();
+        adaptCaptureBuffers(buf);
+    }
+    return true;
+}
+
+/**
+ * @brief Videostreaming::queueCaptureBuffer - hand a buffer back to the driver, or park it if shrinking
+ */
+bool Videostreaming::queueCaptureBuffer(v4l2_buffer &buf)
+{
+    if (m_processingTimer.isValid()) {
+        m_processingNsecs += m_processingTimer.nsecsElapsed();
+        m_processingTimer.invalidate();
+    }
+    m_currentSlot = -1;
+    if (m_parkRequest) {
+        m_parkRequest--;
+        m_parkedBuffers.append(buf.index);
+        emit logDebugHandle("Capture buffers reduced to "+QString::number(m_nbuffers - m_parkedBuffers.count()));
+        return true;
+    }
+    if (m_bufferMemory == V4L2_MEMORY_MMAP) {
+        if (!qbuf(buf))
+            return false;
+        m_queuedBuffers++;
+        return true;
+    }
+
+    // retry buffers which found no free pool frame earlier
+    while (!m_starvedBuffers.isEmpty() && queueBufferIndex(m_starvedBuffers.first())) {
+        m_starvedBuffers.removeFirst();
+        m_queuedBuffers++;
+    }
+    if (!queueBufferIndex(buf.index)) {
+        m_starvedBuffers.append(buf.index);
+        return false;
+    }
+    m_queuedBuffers++;
+    return true;
+}
+
+/**
+ * @brief Videostreaming::drainCaptureBuffers - skip the frames the camera stored before a triggered still
+ * Each stale frame is queued back before the next one is dequeued, so buffer accounting stays exact.
+ * @return true - buf holds the newest frame and must be queued /false - every buffer is back with the driver
+ */
+bool Videostreaming::drainCaptureBuffers(v4l2_buffer &buf)
+{
+    bool again = false;
+    for (int i = 0; i < m_bufReqCount; i++) {
+        queueCaptureBuffer(buf);
+        if (!dequeueCaptureBuffer(buf, again) || again)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Videostreaming::queueBufferIndex - queue a buffer index to the driver
+ * In frame pool mode a frame still referenced by a consumer is kept, and a fresh
+ * pool frame is queued in its place.
+ * @return false on failure or when no free pool frame is left
+ */
+bool Videostreaming::queueBufferIndex(uint index)
+{
+    if (m_bufferMemory == V4L2_MEMORY_MMAP)
+        return qbuf_mmap(index, m_buftype);
+
+    int slot = m_bufferSlot.at(index);
+    if (slot < 0 || m_framePool.refCount(slot) > 1) {
+        int fresh = m_framePool.acquire();
+        if (fresh < 0)
+            return false;
+        if (slot >= 0)
+            m_framePool.release(slot);
+        slot = fresh;
+        m_bufferSlot[index] = slot;
+        m_buffers[index].planes = 1;
+        m_buffers[index].start[0] = m_framePool.data(slot);
+        m_buffers[index].length[0] = m_framePool.slotSize();
+    }
+
+    size_t length[VIDEO_MAX_PLANES] = { m_framePool.slotSize(), 0 };
+    if (m_bufferMemory == V4L2_MEMORY_DMABUF) {
+        int fds[VIDEO_MAX_PLANES] = { m_framePool.dmabufFd(slot), -1 };
+        return qbuf_dmabuf(index, m_buftype, fds, length);
+    }
+    void *ptr[VIDEO_MAX_PLANES] = { m_buffers[index].start[0], NULL };
+    return qbuf_user(index, m_buftype, ptr, length);
+}
+
+/**
+ * @brief Videostreaming::requestPoolBuffers - request USERPTR/DMABUF buffers backed by the frame pool
+ * The pool holds twice the buffer count so consumers can keep frames while all buffers are queued.
+ */
+bool Videostreaming::requestPoolBuffers(uint count)
+{
+    v4l2_requestbuffers req;
+    bool ret;
+
+    if (m_captureMemory == V4L2_MEMORY_USERPTR)
+        ret = reqbufs_user(req, m_buftype, count);
+    else
+        ret = reqbufs_dmabuf(req, m_buftype, count);
+    if (!ret)
+        return false;
+
+    // with a prepared still switch the pool is sized once for both still and preview
+    size_t frameSize = m_capSrcFormat.fmt.pix.sizeimage;
+    if (m_stillSwitchValid && m_stillSwitchFrameSize > frameSize)
+        frameSize = m_stillSwitchFrameSize;
+    bool exportDmabuf = (m_captureMemory == V4L2_MEMORY_DMABUF);
+    bool reusePool = m_framePool.isValid() && m_framePool.slotSize() >= frameSize &&
+            m_framePool.count() >= req.count * 2 && m_framePool.hasDmabuf() == exportDmabuf;
+    if (req.count < 2 ||
+        (!reusePool && !m_framePool.init(frameSize, req.count * 2, exportDmabuf))) {
+        req.count = 0;
+        ioctl(VIDIOC_REQBUFS, &req);
+        return false;
+    }
+
+    m_buffers = (buffer *)calloc(req.count, sizeof(*m_buffers));
+    if (!m_buffers) {
+        m_framePool.deinit();
+        return false;
+    }
+    m_bufferSlot.fill(-1, req.count);
+    m_nbuffers = req.count;
+    return true;
+}
+
+/**
+ * @brief Videostreaming::freeCaptureBuffers - unmap/release all capture buffers and the frame pool
+ * @param keepPool - only return the slots of the buffers, the pool is reused by the next stream
+ */
+void Videostreaming::freeCaptureBuffers(bool keepPool)
+{
+    v4l2_requestbuffers reqbufs;
+
+    if (m_bufferMemory == V4L2_MEMORY_MMAP) {
+        for (uint i = 0; i < m_nbuffers; ++i)
+            for (unsigned p = 0; p < m_buffers[i].planes; p++)
+                if (-1 == munmap(m_buffers[i].start[p], m_buffers[i].length[p]))
+                    perror("munmap");
+        reqbufs_mmap(reqbufs, m_buftype, 1);  // videobuf workaround
+        reqbufs_mmap(reqbufs, m_buftype, 0);
+    } else {
+        if (m_bufferMemory == V4L2_MEMORY_USERPTR)
+            reqbufs_user(reqbufs, m_buftype, 0);
+        else
+            reqbufs_dmabuf(reqbufs, m_buftype, 0);
+        if (keepPool) {
+            for (int i = 0; i < m_bufferSlot.count(); i++)
+                m_framePool.release(m_bufferSlot.at(i));
+        } else {
+            // queued H264 packets may still reference pool frames
+            if (videoEncoder != NULL && m_VideoRecord)
+                videoEncoder->muxWriter()->flush();
+            // wait for a running decode which may still read from a pool frame
+            m_renderer->renderMutex.lock();
+            m_framePool.deinit();
+            m_decodeSlot = -1;
+            m_renderer->renderMutex.unlock();
+        }
+        m_bufferSlot.clear();
+        m_starvedBuffers.clear();
+    }
+    BandwidthPlanner::instance()->release(m_session);
+    free(m_buffers);
+    m_buffers = NULL;
+    m_nbuffers = m_queuedBuffers = 0;
+    m_currentSlot = -1;
+    m_parkedBuffers.clear();
+}
+
+/**
+ * @brief Videostreaming::setFrameExport - enable/disable publishing frames to shared memory
+ * The ring is created on next stream start, or now if streaming.
+ */
+void Videostreaming::setFrameExport(bool enable, QString name)
+{
+    m_frameExportEnabled = enable;
+    m_frameExportName = name;
+    if (!enable) {
+        m_frameExport.close();
+        return;
+    }
+    if (m_buffers != NULL)
+        openFrameExport();
+}
+
+void Videostreaming::setRecordFileIo(bool directIo, bool periodicSync)
+{
+    m_recordIoFlags = (directIo ? MUX_IO_DIRECT : 0) | (periodicSync ? MUX_IO_SYNC : 0);
+}
+
+void Videostreaming::setRecordSegments(int minutes, int megabytes)
+{
+    m_segmentMinutes = qMax(0, minutes);
+    m_segmentMegabytes = qMax(0, megabytes);
+}
+
+void Videostreaming::setHardwareTimestamps(bool enable, QString replayFile)
+{
+    m_hwTimestamps = enable;
+    m_metadataReplay = replayFile;
+}
+
+void Videostreaming::setMetadataDump(QString fileName)
+{
+    m_uvcMetadata.setDumpFile(fileName);
+}
+
+/**
+ * @brief Videostreaming::updateFrameTime - capture time of the dequeued frame, from the UVC
+ * metadata of the same sequence or from the driver timestamp if that is CLOCK_MONOTONIC
+ */
+void Videostreaming::updateFrameTime(const v4l2_buffer &buf)
+{
+    qint64 ns = 0;
+    if (!m_uvcMetadata.isActive() || !m_uvcMetadata.frameTime(buf.sequence, ns)) {
+        if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+            ns = buf.timestamp.tv_sec * 1000000000LL + buf.timestamp.tv_usec * 1000LL;
+    }
+    m_frameCaptureNs = ns;
+    if (!ns)
+        return;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    qint64 latency = now.tv_sec * 1000000000LL + now.tv_nsec - ns;
+    m_latencySum += latency;
+    m_latencyMax = qMax(m_latencyMax, latency);
+    m_latencyFrames++;
+    if (!m_latencyTimer.isValid()) {
+        m_latencyTimer.start();
+    } else if (m_latencyTimer.elapsed() >= 1000) {
+        emit frameLatency(m_latencySum / m_latencyFrames / 1e6, m_latencyMax / 1e6);
+        m_latencySum = m_latencyMax = 0;
+        m_latencyFrames = 0;
+        m_latencyTimer.restart();
+    }
+}
+
+/**
+ * @brief Videostreaming::startStreamServer - start HTTP endpoint for live viewing
+ */
+bool Videostreaming::startStreamServer(uint port, bool loopbackOnly)
+{
+    if (!m_streamServer.start(port, loopbackOnly)) {
+        emit logCriticalHandle("Stream server failed to listen on port "+QString::number(port));
+        return false;
+    }
+    emit logDebugHandle("Stream server listening on port "+QString::number(port));
+    return true;
+}
+
+void Videostreaming::stopStreamServer()
+{
+    m_streamServer.stop();
+}
+
+/**
+ * @brief Videostreaming::openFrameExport - create/resize the export ring for the current format
+ */
+void Videostreaming::openFrameExport()
+{
+    QString exportName = m_frameExportName.isEmpty() ? QFileInfo(device()).fileName() : m_frameExportName;
+    if (!m_frameExport.open(exportName, m_capSrcFormat.fmt.pix.sizeimage, FRAME_EXPORT_SLOTS))
+        emit logCriticalHandle("Frame export to shared memory failed - "+QString(QTCAM_SHM_PREFIX)+exportName+
+                               " may be published by another camera, pick another export name");
+}
+
+/**
+ * @brief Videostreaming::setCaptureMemory - select where the driver writes frames, used on next stream start
+ * @param memoryType - "mmap" [driver buffers], "userptr" or "dmabuf" [frame pool]
+ */
+void Videostreaming::setCaptureMemory(QString memoryType)
+{
+    if (memoryType == "userptr")
+        m_captureMemory = V4L2_MEMORY_USERPTR;
+    else if (memoryType == "dmabuf")
+        m_captureMemory = V4L2_MEMORY_DMABUF;
+    else
+        m_captureMemory = V4L2_MEMORY_MMAP;
+}
+
+/**
+ * @brief Videostreaming::adaptCaptureBuffers - track sequence gaps and processing latency
+ * Every ADAPT_WINDOW_FRAMES frames the buffer status is reported. In adaptive mode the buffer
+ * count grows when the driver dropped frames or processing takes more than half a frame period,
+ * and shrinks by one after ADAPT_SHRINK_WINDOWS quiet windows.
+ */
+void Videostreaming::adaptCaptureBuffers(const v4l2_buffer &buf)
+{
+    if (m_sequenceValid && buf.sequence > m_lastSequence + 1)
+        m_sequenceGaps += buf.sequence - m_lastSequence - 1;
+    m_lastSequence = buf.sequence;
+    m_sequenceValid = true;
+
+    if (++m_adaptFrames < ADAPT_WINDOW_FRAMES)
+        return;
+
+    uint active = m_nbuffers - m_parkedBuffers.count() - m_parkRequest;
+    emit captureBufferStatus(m_queuedBuffers, userspaceBufferCount(), active);
+
+    if (m_adaptiveBuffers && !m_captureBufferCount) {
+        qint64 periodNsecs = m_framePeriodNsecs;
+        qint64 avgNsecs = m_processingNsecs / m_adaptFrames;
+
+        if (m_sequenceGaps || avgNsecs > periodNsecs / 2) {
+            m_idleWindows = 0;
+            if (growCaptureBuffers(CAPTURE_BUFFER_GROW_STEP))
+                m_learnedBufferCount = m_nbuffers - m_parkedBuffers.count();
+        } else if (avgNsecs < periodNsecs / 4 && active > MIN_CAPTURE_BUFFERS) {
+            if (++m_idleWindows >= ADAPT_SHRINK_WINDOWS) {
+                m_idleWindows = 0;
+                m_parkRequest++;
+                m_learnedBufferCount = active - 1;
+            }
+        } else {
+            m_idleWindows = 0;
+        }
+    }
+
+    m_adaptFrames = m_sequenceGaps = 0;
+    m_processingNsecs = 0;
+}
+
+/**
+ * @brief Videostreaming::setCaptureBufferCount - fixed capture buffer count, 0 for automatic
+ */
+void Videostreaming::setCaptureBufferCount(uint count)
+{
+    m_captureBufferCount = count;
+    m_learnedBufferCount = 0;
+}
+
+/**
+ * @brief Videostreaming::setAdaptiveBufferCount - enable/disable adapting buffer count while streaming
+ */
+void Videostreaming::setAdaptiveBufferCount(bool adaptive)
+{
+    m_adaptiveBuffers = adaptive;
+}
+
+/**
+ * @brief Videostreaming::setBufferMemoryBudget - memory limit for all capture buffers
+ */
+void Videostreaming::setBufferMemoryBudget(uint megaBytes)
+{
+    m_bufferMemoryBudget = (size_t)megaBytes * 1024 * 1024;
+}
+
+int Videostreaming::findMax(QList<int> *list) {
+
+    int array[list->count()];
+    for(int j=0;j<list->count();j++)
+        array[j] = list->at(j);
+    int index_of_min = 0;
+    for(int x=0; x<list->count(); x++)
+    {
+        index_of_min = x;
+        for(int y=x; y<list->count(); y++)
+        {
+            if(array[index_of_min] > array[y])
+            {
+                index_of_min = y;
+            }
+        }
+        int temp = array[x];
+        array[x] = array[index_of_min];
+        array[index_of_min] = temp;
+    }
+    return array[index_of_min];
+}
+
+/**
+ * @brief Videostreaming::updateFrameToSkip
+ * @param stillSkip
  */
 void Videostreaming::updateFrameToSkip(uint stillSkip){
     frameToSkip = stillSkip;
 }
 
+void Videostreaming::setSettleDetection(bool enable){
+    m_settleDetection = enable;
+}
+
+void Videostreaming::setPreviewWindowLevel(qreal level, qreal window, qreal gamma){
+    window = qBound(0.001, window, 1.0);
+    m_renderer->monoBlack = level - window / 2;
+    m_renderer->monoWhite = level + window / 2;
+    m_renderer->monoGamma = gamma > 0 ? gamma : 1.0;
+}
+
+void Videostreaming::setBayerPreview(bool enable, qreal redGain, qreal greenGain, qreal blueGain){
+    m_bayerPreview = enable;
+    m_renderer->bayerGain[0] = redGain;
+    m_renderer->bayerGain[1] = greenGain;
+    m_renderer->bayerGain[2] = blueGain;
+}
+
+/**
+ * @brief Videostreaming::stillFrameReady - the frame count passed the skip count, or the stream
+ * settled earlier
+ */
+bool Videostreaming::stillFrameReady()
+{
+    if (m_frame > frameToSkip)
+        return true;
+    return m_settleDetection && m_settle.isSettled();
+}
+
+/**
+ * @brief Videostreaming::updateSettle - add the statistics of a frame to the settle detector
+ * @param decoded - prepareBuffer ran, decoded mjpeg/h264 frames are available
+ */
+void Videostreaming::updateSettle(const void *frame, bool decoded)
+{
+    if (m_settle.isSettled())
+        return;
+
+    const uint8_t *planes[3] = { (const uint8_t *)frame, NULL, NULL };
+    int strides[3] = { (int)m_capSrcFormat.fmt.pix.bytesperline, 0, 0 };
+    __u32 format = m_capSrcFormat.fmt.pix.pixelformat;
+    FrameStats stats;
+    bool ok = false;
+
+    switch (format) {
+    case V4L2_PIX_FMT_YUYV:
+    case V4L2_PIX_FMT_UYVY:
+        if (!strides[0])
+            strides[0] = width * 2;
+        ok = SettleDetector::frameStats(format, planes, strides, width, height, stats);
+        break;
+    case V4L2_PIX_FMT_GREY:
+        if (!strides[0])
+            strides[0] = width;
+        ok = SettleDetector::frameStats(format, planes, strides, width, height, stats);
+        break;
+    case V4L2_PIX_FMT_NV12:
+    case V4L2_PIX_FMT_NV21:
+    case V4L2_PIX_FMT_NV12M:
+    case V4L2_PIX_FMT_NV21M:
+    case V4L2_PIX_FMT_YUV420:
+    case V4L2_PIX_FMT_YVU420:
+    case V4L2_PIX_FMT_YUV420M:
+    case V4L2_PIX_FMT_YVU420M:
+        for (int i = 0; i < 3; i++) {
+            planes[i] = m_framePlane[i];
+            strides[i] = m_framePlaneStride[i];
+        }
+        ok = SettleDetector::frameStats(m_framePlane[2] ? V4L2_PIX_FMT_YUV420 : V4L2_PIX_FMT_NV12,
+                                        planes, strides, width, height, stats);
+        break;
+    case V4L2_PIX_FMT_H264:
+        if (!decoded || !yuv420pdestBuffer)
+            return;
+        planes[0] = yuv420pdestBuffer;
+        planes[1] = yuv420pdestBuffer + width * height;
+        planes[2] = planes[1] + (width / 2) * (height / 2);
+        strides[0] = width;
+        strides[1] = strides[2] = width / 2;
+        ok = SettleDetector::frameStats(V4L2_PIX_FMT_YUV420, planes, strides, width, height, stats);
+        break;
+    case V4L2_PIX_FMT_MJPEG:
+        // last decoded frame, skipped while the decoder writes it
+        if (!decoded || !m_renderer->renderMutex.tryLock())
+            return;
+        if (m_renderer->rgbaDestBuffer) {
+            planes[0] = m_renderer->rgbaDestBuffer;
+            strides[0] = width * 4;
+            ok = SettleDetector::frameStats(V4L2_PIX_FMT_RGBA32, planes, strides, width, height, stats);
+        }
+        m_renderer->renderMutex.unlock();
+        break;
+    }
+    if (!ok)
+        return;
+
+    m_settle.addFrame(stats);
+    if (m_settle.isSettled())
+        emit logDebugHandle("Stream settled after "+QString::number(m_settle.frames())+" frames, luma "+
+                            QString::number(stats.luma, 'f', 1));
+}
+
 /**
  * @brief Videostreaming::updatePreviewFrameSkip - To skip frame to render preview
  * @param previewSkip
@@ -2082,11 +3390,13 @@ void Videostreaming::makeShot(QString filePath,QString imgFormatType) {
     if (!((stillSize == lastPreviewSize) && (stillOutFormat == lastFormat)))
     {
         m_renderer->updateStop = true;
-        stopCapture();
-        vidCapFormatChanged(stillOutFormat);
-        setResoultion(stillSize);
         stopRenderOnMakeShot = true;
-        startAgain();
+        if (!fastStillSwitch(true)) {
+            stopCapture();
+            vidCapFormatChanged(stillOutFormat);
+            setResoultion(stillSize);
+            startAgain();
+        }
     }
 }
 
@@ -2246,10 +3556,12 @@ void Videostreaming::makeBurstShot(QString filePath,QString imgFormatType, uint
         // Added by Sankari: disable paint in preview while capturing image when still and preview resolution
         //are different
         m_renderer->updateStop = true;
-        stopCapture();
-        vidCapFormatChanged(stillOutFormat);
-        setResoultion(stillSize);
-        startAgain();
+        if (!fastStillSwitch(true)) {
+            stopCapture();
+            vidCapFormatChanged(stillOutFormat);
+            setResoultion(stillSize);
+            startAgain();
+        }
     }
 }
 
@@ -2294,10 +3606,10 @@ void Videostreaming::displayFrame() {
     emit averageFPS(m_fps);
 
     __u32 buftype = m_buftype;
-    g_fmt_cap(buftype, m_capSrcFormat);
+    getCaptureFormat(m_capSrcFormat);
 
     // if (try_fmt(m_capSrcFormat)) {
-    if(!s_fmt(m_capSrcFormat)) {
+    if(!setCaptureFormat(m_capSrcFormat)) {
         emit titleTextChanged("Error", "Device or Resource is busy");
         emit logCriticalHandle("Device or Resource is busy");
         if (fd() >= 0) {
@@ -2337,11 +3649,11 @@ void Videostreaming::displayFrame() {
      * Added camera enum comparision
      * Before its like camera name comparision
      */
-    if(currentlySelectedCameraEnum == CommonEnums::ECON_1MP_BAYER_RGB) {
+    if(m_session->cameraEnum == CommonEnums::ECON_1MP_BAYER_RGB) {
         m_capSrcFormat.fmt.pix.pixelformat = V4L2_PIX_FMT_SGRBG8;
     }
 
-    if(currentlySelectedCameraEnum == CommonEnums::SEE3CAM_CU40) {
+    if(m_session->cameraEnum == CommonEnums::SEE3CAM_CU40) {
         y16BayerFormat = true;
     }
 
@@ -2352,6 +3664,7 @@ void Videostreaming::displayFrame() {
     }
 
     if (startCapture()) {
+        saveRecoveryControls();
         sprintf(header,"P6\n%d %d 255\n",width,height);
         m_capNotifier = new QSocketNotifier(fd(), QSocketNotifier::Read);
         connect(m_capNotifier, SIGNAL(activated(int)), this, SLOT(capFrame()));
@@ -2366,6 +3679,8 @@ void Videostreaming::stopCapture() {
         h264Decode=NULL;
     }  
 
+    // render buffers are reallocated on next start, some of them are only freed below
+    m_renderBufferPixels = 0;
     if(yuyvBuffer != NULL ){
         free(yuyvBuffer);
         yuyvBuffer = NULL;
@@ -2394,20 +3709,15 @@ void Videostreaming::stopCapture() {
 
     if (fd() >= 0) {
         emit logDebugHandle("Stop Previewing...");
-        v4l2_requestbuffers reqbufs;
         if (m_buffers == NULL)
             return;
-        if (!streamoff(V4L2_BUF_TYPE_VIDEO_CAPTURE)) {
+        m_uvcMetadata.stop();
+        if (!streamoff(m_buftype)) {
             perror("VIDIOC_STREAMOFF");
             emit logCriticalHandle("Stream OFF failed");
         }
-        for (uint i = 0; i < m_nbuffers; ++i)
-            for (unsigned p = 0; p < m_buffers[i].planes; p++)
-                if (-1 == munmap(m_buffers[i].start[p], m_buffers[i].length[p]))
-                    perror("munmap");
         // Free all buffers.
-        reqbufs_mmap(reqbufs, V4L2_BUF_TYPE_VIDEO_CAPTURE, 1);  // videobuf workaround
-        reqbufs_mmap(reqbufs, V4L2_BUF_TYPE_VIDEO_CAPTURE, 0);
+        freeCaptureBuffers();
         emit logDebugHandle("Value of FD is:"+ QString::number(fd(),10));
         if (m_capNotifier) {           
             delete m_capNotifier;
@@ -2436,6 +3746,11 @@ void Videostreaming::stopCapture() {
         m_renderer->vBuffer = NULL;
     }
 
+    if(m_renderer->y16Buffer != NULL){
+        free(m_renderer->y16Buffer);
+        m_renderer->y16Buffer = NULL;
+    }
+
     m_renderer->renderMutex.lock();
 
     if(m_renderer->rgbaDestBuffer != NULL){
@@ -2466,23 +3781,8 @@ void Videostreaming::closeDevice() {
 
 void Videostreaming::startAgain() {
 
-    m_renderer->videoResolutionwidth = m_width;
-    m_renderer->videoResolutionHeight = m_height;
-
-    int buffLength = m_width * m_height;
-    int buffHalfLength = (m_width * m_height)/ 2;
+    allocRenderBuffers(m_width, m_height);
 
-    m_renderer->yBuffer = (uint8_t*)malloc(buffLength);
-    m_renderer->uBuffer = (uint8_t*)malloc(buffHalfLength);
-    m_renderer->vBuffer = (uint8_t*)malloc(buffHalfLength);
-    m_renderer->yuvBuffer = (uint8_t*)malloc(buffLength*2);
-
-    m_renderer->rgbaDestBuffer = (unsigned char *)malloc(m_renderer->videoResolutionwidth * (m_renderer->videoResolutionHeight) * 4);
-    tempSrcBuffer = (unsigned char *)malloc(m_renderer->videoResolutionwidth * (m_renderer->videoResolutionHeight) * 2);
-   
-    yuyvBuffer = (uint8_t *)malloc(m_renderer->videoResolutionwidth * m_renderer->videoResolutionHeight * 2);
-    yuyvBuffer_Y12 = (uint8_t *)malloc(m_renderer->videoResolutionwidth * m_renderer->videoResolutionHeight * 2);
-      
     if(openSuccess) {
         displayFrame();
     }
@@ -2491,6 +3791,188 @@ void Videostreaming::startAgain() {
 
 }
 
+/**
+ * @brief Videostreaming::allocRenderBuffers - allocate renderer and conversion buffers for a resolution
+ * Buffers are only reallocated when they are too small. With a prepared still switch they are
+ * allocated for the larger of still and preview, so switching back and forth does not reallocate.
+ */
+void Videostreaming::allocRenderBuffers(uint bufWidth, uint bufHeight)
+{
+    m_renderer->videoResolutionwidth = bufWidth;
+    m_renderer->videoResolutionHeight = bufHeight;
+
+    size_t pixels = (size_t)bufWidth * bufHeight;
+    if (pixels <= m_renderBufferPixels)
+        return;
+    if (m_stillSwitchValid) {
+        for (int i = 0; i < 2; i++)
+            pixels = qMax(pixels, (size_t)m_stillSwitchFormat[i].fmt.pix.width * m_stillSwitchFormat[i].fmt.pix.height);
+    }
+
+    m_renderer->renderMutex.lock();
+    free(m_renderer->yBuffer);
+    free(m_renderer->uBuffer);
+    free(m_renderer->vBuffer);
+    free(m_renderer->yuvBuffer);
+    free(m_renderer->y16Buffer);
+    free(m_renderer->rgbaDestBuffer);
+    free(tempSrcBuffer);
+    free(yuyvBuffer);
+    free(yuyvBuffer_Y12);
+
+    m_renderer->yBuffer = (uint8_t*)malloc(pixels);
+    m_renderer->uBuffer = (uint8_t*)malloc(pixels / 2);
+    m_renderer->vBuffer = (uint8_t*)malloc(pixels / 2);
+    m_renderer->yuvBuffer = (uint8_t*)malloc(pixels * 2);
+    m_renderer->y16Buffer = (uint16_t*)malloc(pixels * 2);
+    m_renderer->rgbaDestBuffer = (unsigned char *)malloc(pixels * 4);
+    tempSrcBuffer = (unsigned char *)malloc(pixels * 2);
+    yuyvBuffer = (uint8_t *)malloc(pixels * 2);
+    yuyvBuffer_Y12 = (uint8_t *)malloc(pixels * 2);
+    m_renderBufferPixels = pixels;
+    m_renderer->renderMutex.unlock();
+}
+
+/**
+ * @brief Videostreaming::prepareStillSwitch - validate still and preview formats with the driver
+ * Formats are validated once for each still/preview combination.
+ * @return true if both formats are accepted unchanged and the fast switch can be used
+ */
+bool Videostreaming::prepareStillSwitch()
+{
+    QString key = stillSize + "/" + stillOutFormat + "/" + lastPreviewSize + "/" + lastFormat;
+    if (key == m_stillSwitchKey)
+        return m_stillSwitchValid;
+
+    m_stillSwitchKey = key;
+    m_stillSwitchValid = false;
+    m_stillSwitchFrameSize = 0;
+
+    // these cameras override the source format while starting the preview
+    if (m_session->cameraEnum == CommonEnums::ECON_1MP_BAYER_RGB ||
+        m_session->cameraEnum == CommonEnums::SEE3CAM_CU40)
+        return false;
+
+    QString formats[2] = { lastFormat, stillOutFormat };
+    QString sizes[2] = { lastPreviewSize, stillSize };
+    for (int i = 0; i < 2; i++) {
+        v4l2_fmtdesc desc;
+        if (!enum_fmt_cap(desc, m_buftype, true, formats[i].toInt()))
+            return false;
+        // h264 decoder is created for one resolution, keep the full restart for it
+        if (desc.pixelformat == V4L2_PIX_FMT_H264)
+            return false;
+
+        QStringList res = sizes[i].split('x');
+        uint reqWidth = res.value(0).toUInt();
+        uint reqHeight = res.value(1).toUInt();
+        v4l2_format &fmt = m_stillSwitchFormat[i];
+        getCaptureFormat(fmt);
+        fmt.fmt.pix.pixelformat = desc.pixelformat;
+        fmt.fmt.pix.width = reqWidth;
+        fmt.fmt.pix.height = reqHeight;
+        if (!tryCaptureFormat(fmt) || fmt.fmt.pix.pixelformat != desc.pixelformat ||
+            fmt.fmt.pix.width != reqWidth || fmt.fmt.pix.height != reqHeight) {
+            emit logDebugHandle("Still switch: "+sizes[i]+" not accepted by driver, using full restart");
+            return false;
+        }
+        m_stillSwitchFrameSize = qMax(m_stillSwitchFrameSize, (size_t)fmt.fmt.pix.sizeimage);
+    }
+    m_stillSwitchValid = true;
+    return true;
+}
+
+/**
+ * @brief Videostreaming::fastStillSwitch - switch to still or preview format on the running stream
+ * Only STREAMOFF, REQBUFS(0), S_FMT, REQBUFS and STREAMON are done; the notifier, converter,
+ * frame pool and renderer buffers are kept.
+ * @param stillSettings - true - switch to still /false - switch to preview
+ * @return false if the caller has to do the full stop/start sequence
+ */
+bool Videostreaming::fastStillSwitch(bool stillSettings)
+{
+    if (!m_fastStillSwitch || fd() < 0 || m_buffers == NULL || m_capNotifier == NULL || m_capImage == NULL)
+        return false;
+    if (!prepareStillSwitch())
+        return false;
+
+    QElapsedTimer switchTimer;
+    switchTimer.start();
+
+    m_capNotifier->setEnabled(false);
+    if (!streamoff(m_buftype)) {
+        perror("VIDIOC_STREAMOFF");
+        emit logCriticalHandle("Stream OFF failed");
+    }
+    freeCaptureBuffers(true);
+
+    m_renderer->gotFrame = false;
+    m_renderer->updateStop = true;
+
+    v4l2_format fmt = m_stillSwitchFormat[stillSettings ? 1 : 0];
+    bool switched = setCaptureFormat(fmt) && applyStillSwitchFormat(fmt);
+    if (switched) {
+        // uvcvideo resets the frame interval on S_FMT
+        v4l2_fract interval;
+        if (getInterval(interval))
+            set_interval(m_buftype, interval);
+        switched = startCapture();
+    }
+    if (!switched) {
+        // release what a failed start left behind, the full restart sequence takes over from here
+        emit logCriticalHandle("Still switch failed, restarting preview");
+        m_stillSwitchValid = false;
+        if (m_buffers != NULL) {
+            m_uvcMetadata.stop();
+            streamoff(m_buftype);
+            freeCaptureBuffers();
+        }
+        delete m_capNotifier;
+        m_capNotifier = NULL;
+        delete m_capImage;
+        m_capImage = NULL;
+        return false;
+    }
+    m_capNotifier->setEnabled(true);
+    if(retrieveFrame)
+        m_timer.start(2000);
+
+    int elapsed = switchTimer.elapsed();
+    emit logDebugHandle("Switched to "+QString(stillSettings ? "still" : "preview")+" settings in "+QString::number(elapsed)+" ms");
+    emit stillSwitchTime(stillSettings, elapsed);
+    return true;
+}
+
+/**
+ * @brief Videostreaming::applyStillSwitchFormat - update capture state for the format set by S_FMT
+ */
+bool Videostreaming::applyStillSwitchFormat(const v4l2_format &fmt)
+{
+    m_capSrcFormat = fmt;
+    m_pixelformat = fmt.fmt.pix.pixelformat;
+    m_width = width = fmt.fmt.pix.width;
+    m_height = height = fmt.fmt.pix.height;
+    m_capDestFormat.fmt.pix.width = width;
+    m_capDestFormat.fmt.pix.height = height;
+    m_capDestFormat.fmt.pix.sizeimage = width*height*3;
+    sprintf(header,"P6\n%d %d 255\n",width,height);
+    if ((uint)m_capImage->width() != width || (uint)m_capImage->height() != height) {
+        delete m_capImage;
+        m_capImage = new QImage(width, height, QImage::Format_RGB888);
+        if (m_capImage->isNull())
+            return false;
+    }
+
+    allocRenderBuffers(m_width, m_height);
+    m_renderer->frame = m_frame = m_lastFrame = m_fps = 0;
+    return true;
+}
+
+void Videostreaming::setFastStillSwitch(bool enable)
+{
+    m_fastStillSwitch = enable;
+}
+
 void Videostreaming::lastPreviewResolution(QString resolution,QString format) {    
     lastPreviewSize = resolution;
     lastFormat = format;
@@ -2514,13 +3996,13 @@ void Videostreaming::setResoultion(QString resolution)
     QStringList tempResList = resolution.split('x');
     width = tempResList.value(0).toInt();
     height = tempResList.value(1).toInt();
-    g_fmt_cap(V4L2_BUF_TYPE_VIDEO_CAPTURE, fmt);
+    getCaptureFormat(fmt);
     fmt.fmt.pix.width = width;
     fmt.fmt.pix.height = height;
     m_width = width;
     m_height = height;
-    try_fmt(fmt);
-    s_fmt(fmt);
+    tryCaptureFormat(fmt);
+    setCaptureFormat(fmt);
 }
 
 /**
@@ -2533,7 +4015,7 @@ QString Videostreaming::getResoultion()
     v4l2_format fmt;
     unsigned int width, height;
     QString resolutionStr;
-    g_fmt_cap(V4L2_BUF_TYPE_VIDEO_CAPTURE, fmt);
+    getCaptureFormat(fmt);
     width = fmt.fmt.pix.width;
     height = fmt.fmt.pix.height;
 
@@ -2545,7 +4027,7 @@ QString Videostreaming::getResoultion()
 }
 
 void Videostreaming::displayStillResolution() {
-    g_fmt_cap(V4L2_BUF_TYPE_VIDEO_CAPTURE, fmt);
+    getCaptureFormat(fmt);
 
     QStringList dispStillRes;
 
@@ -2566,7 +4048,7 @@ void Videostreaming::displayStillResolution() {
             }
         } while (enum_framesizes(frmsize));
     }
-    stillOutputFormat.setStringList(dispStillRes);
+    m_session->stillOutputFormat.setStringList(dispStillRes);
     emit logDebugHandle("Supported still Resolution: " +dispStillRes.join(", "));
 }
 
@@ -2575,12 +4057,12 @@ void Videostreaming::displayEncoderList(){
     encoders.clear();    
     encoders<<"MJPG"<<"H264";
     emit ubuntuVersionSelectedLessThan16(); // signal to qml that ubuntu version selected is less than 16.04
-    encoderList.setStringList(encoders);
+    m_session->encoderList.setStringList(encoders);
 }
 
 void Videostreaming::displayVideoResolution() {
 
-    g_fmt_cap(V4L2_BUF_TYPE_VIDEO_CAPTURE, fmt);
+    getCaptureFormat(fmt);
 
     QStringList dispVideoRes;
 
@@ -2607,7 +4089,7 @@ void Videostreaming::displayVideoResolution() {
         } while (enum_framesizes(frmsize));
     }
 
-    videoOutputFormat.setStringList(dispVideoRes);
+    m_session->videoOutputFormat.setStringList(dispVideoRes);
     emit logDebugHandle("Supported video Resolution: " +dispVideoRes.join(", "));
 }
 
@@ -2616,10 +4098,10 @@ void Videostreaming::vidCapFormatChanged(QString idx)
     v4l2_fmtdesc desc;
     enum_fmt_cap(desc, m_buftype, true, idx.toInt());
     v4l2_format fmt;
-    g_fmt_cap(m_buftype, fmt);
+    getCaptureFormat(fmt);
     fmt.fmt.pix.pixelformat = desc.pixelformat;
-    try_fmt(fmt);
-    s_fmt(fmt);
+    tryCaptureFormat(fmt);
+    setCaptureFormat(fmt);
     if(!makeSnapShot){
         updateVidOutFormat();       
     }
@@ -2629,7 +4111,7 @@ void Videostreaming::updateVidOutFormat()
 {
     v4l2_fmtdesc desc;
     v4l2_format fmt;
-    g_fmt_cap(m_buftype, fmt);
+    getCaptureFormat(fmt);
     m_pixelformat = fmt.fmt.pix.pixelformat;
     m_width       = fmt.fmt.pix.width;
     m_height      = fmt.fmt.pix.height;
@@ -2649,7 +4131,7 @@ void Videostreaming::displayOutputFormat() {
     QStringList dispOutFormat;
     v4l2_fmtdesc fmt;
     pixFormat.clear();
-    if (enum_fmt_cap(fmt, V4L2_BUF_TYPE_VIDEO_CAPTURE, true)) {
+    if (enum_fmt_cap(fmt, m_buftype, true)) {
         do {
             QString s(pixfmt2s(fmt.pixelformat) + " (");
             pixFormat.insert(pixfmt2s(fmt.pixelformat), QString::number(fmt.pixelformat));
@@ -2658,11 +4140,11 @@ void Videostreaming::displayOutputFormat() {
             else {
                 dispOutFormat.append(s + (const char *)fmt.description + ")");
             }
-        } while (enum_fmt_cap(fmt, V4L2_BUF_TYPE_VIDEO_CAPTURE));
+        } while (enum_fmt_cap(fmt, m_buftype));
 
     }
     emit logDebugHandle("Output format supported: " +dispOutFormat.join(", "));
-    resolution.setStringList(dispOutFormat);
+    m_session->resolution.setStringList(dispOutFormat);
     updateVidOutFormat();
 }
 
@@ -2699,9 +4181,53 @@ void Videostreaming::updateFrameInterval(QString pixelFormat, QString frameSize)
 
 }
 
+/**
+ * @brief Videostreaming::planCaptureFormat - list every format/frame interval the camera offers at
+ * the size and let the bandwidth planner pick one
+ */
+bool Videostreaming::planCaptureFormat(QString resolution, uint fps)
+{
+    QStringList res = resolution.split('x');
+    uint reqWidth = res.value(0).toUInt();
+    uint reqHeight = res.value(1).toUInt();
+    QVector<CaptureMode> modes;
+    v4l2_fmtdesc desc;
+
+    if (enum_fmt_cap(desc, m_buftype, true)) {
+        do {
+            v4l2_frmivalenum frmival;
+            if (!enum_frameintervals(frmival, desc.pixelformat, reqWidth, reqHeight) ||
+                frmival.type != V4L2_FRMIVAL_TYPE_DISCRETE)
+                continue;
+            do {
+                if (!frmival.discrete.numerator)
+                    continue;
+                CaptureMode mode;
+                mode.pixelformat = desc.pixelformat;
+                mode.formatIndex = desc.index;
+                mode.width = reqWidth;
+                mode.height = reqHeight;
+                mode.fps = (frmival.discrete.denominator + frmival.discrete.numerator / 2) / frmival.discrete.numerator;
+                mode.fpsIndex = frmival.index;
+                modes.append(mode);
+            } while (enum_frameintervals(frmival));
+        } while (enum_fmt_cap(desc, m_buftype));
+    }
+
+    // without a usb link [not usb, no sysfs] only the frame rate and cpu cost decide
+    UsbLink link = m_usbLinkValid ? m_usbLink : UsbLink();
+    QString explanation;
+    int chosen = BandwidthPlanner::instance()->plan(m_session, link, fps, modes, explanation);
+    emit logDebugHandle(explanation);
+    if (chosen < 0)
+        return false;
+    emit captureFormatPlanned(modes.at(chosen).formatIndex, resolution, modes.at(chosen).fpsIndex, explanation);
+    return true;
+}
+
 // Added by Sankari: setting stringlist model is moved from updateFrameInterval() as a separate function
 void Videostreaming::enumerateFPSList(){
-    fpsList.setStringList(availableFPS);
+    m_session->fpsList.setStringList(availableFPS);
 }
 
 void Videostreaming::frameIntervalChanged(int idx)
@@ -2723,9 +4249,19 @@ void Videostreaming::cameraFilterControls(bool actualValue) {
     v4l2_queryctrl qctrl;
     v4l2_querymenu qmenu;
     int indexValue;
-    qctrl.id = V4L2_CTRL_FLAG_NEXT_CTRL;
+    QMap<__u32, QString> currentValues;
+
+    // descriptors are enumerated once per open, the current values are read with one ioctl per class
+    query_controls();
+    if (actualValue)
+        currentValues = getAllSettings();
+
+    // copy, the QML handlers of newControlAdded may reopen the device
+    const QMap<__u32, v4l2_queryctrl> descriptors = controls();
     emit logDebugHandle("Available Controls:");
-    while(queryctrl(qctrl)) {
+    QMap<__u32, v4l2_queryctrl>::const_iterator it;
+    for (it = descriptors.constBegin(); it != descriptors.constEnd(); ++it) {
+        qctrl = it.value();
         emit logDebugHandle((char*)qctrl.name);
         switch (qctrl.type) {
         case V4L2_CTRL_TYPE_BOOLEAN:
@@ -2734,7 +4270,7 @@ void Videostreaming::cameraFilterControls(bool actualValue) {
             ctrlID = QString::number(qctrl.id,10);
             ctrlStepSize = QString::number(qctrl.step,10);
             if(actualValue) {
-                emit newControlAdded(ctrlName,ctrlType,ctrlID,ctrlStepSize,QString::number(0,10),QString::number(1,10),getSettings(qctrl.id));
+                emit newControlAdded(ctrlName,ctrlType,ctrlID,ctrlStepSize,QString::number(0,10),QString::number(1,10),currentValues.value(qctrl.id, "0"));
             } else {
                 emit newControlAdded(ctrlName,ctrlType,ctrlID,ctrlStepSize,QString::number(0,10),QString::number(1,10),QString::number(qctrl.default_value,10));
             }
@@ -2748,7 +4284,7 @@ void Videostreaming::cameraFilterControls(bool actualValue) {
             ctrlDefaultValue = QString::number(qctrl.default_value,10);
             ctrlStepSize = QString::number(qctrl.step,10);
             if(actualValue) {
-                emit newControlAdded(ctrlName,ctrlType,ctrlID,ctrlStepSize,ctrlMinValue,ctrlMaxValue,getSettings(qctrl.id));
+                emit newControlAdded(ctrlName,ctrlType,ctrlID,ctrlStepSize,ctrlMinValue,ctrlMaxValue,currentValues.value(qctrl.id, "0"));
             } else {
                 emit newControlAdded(ctrlName,ctrlType,ctrlID,ctrlStepSize,ctrlMinValue,ctrlMaxValue,QString::number(qctrl.default_value,10));
             }
@@ -2771,7 +4307,7 @@ void Videostreaming::cameraFilterControls(bool actualValue) {
                     //menuItems.append(qmenu.value);
                 }
             }
-            indexValue =  getSettings(qctrl.id).toInt();
+            indexValue =  currentValues.value(qctrl.id, "0").toInt();
             if(actualValue) {
                 emit newControlAdded(ctrlName,ctrlType,ctrlID,ctrlStepSize,ctrlMinValue,ctrlMaxValue,QString::number(getMenuIndex(qctrl.id,indexValue),10));
             } else {
@@ -2789,10 +4325,43 @@ void Videostreaming::cameraFilterControls(bool actualValue) {
         case V4L2_CTRL_TYPE_CTRL_CLASS:
             break;
         }
-        qctrl.id |= V4L2_CTRL_FLAG_NEXT_CTRL;
     }
 }
 
+/**
+ * @brief Videostreaming::getAllSettings - current value of every readable control
+ * @return control id, value
+ */
+QMap<__u32, QString> Videostreaming::getAllSettings() {
+    QList<v4l2_ext_control> ctrls;
+    QMap<__u32, QString> values;
+
+    QMap<__u32, v4l2_queryctrl>::const_iterator it;
+    for (it = controls().constBegin(); it != controls().constEnd(); ++it) {
+        const v4l2_queryctrl &qctrl = it.value();
+        // a write only control fails the whole class
+        if (qctrl.flags & (V4L2_CTRL_FLAG_DISABLED | V4L2_CTRL_FLAG_WRITE_ONLY))
+            continue;
+        if (qctrl.type != V4L2_CTRL_TYPE_INTEGER && qctrl.type != V4L2_CTRL_TYPE_BOOLEAN &&
+            qctrl.type != V4L2_CTRL_TYPE_MENU && qctrl.type != V4L2_CTRL_TYPE_INTEGER_MENU)
+            continue;
+        v4l2_ext_control ctrl;
+        memset(&ctrl, 0, sizeof(ctrl));
+        ctrl.id = qctrl.id;
+        ctrls.append(ctrl);
+    }
+
+    if (g_ext_ctrls(ctrls)) {
+        for (int i = 0; i < ctrls.count(); i++)
+            values.insert(ctrls.at(i).id, QString::number(ctrls.at(i).value, 10));
+    } else {
+        // driver without extended controls for some class
+        for (int i = 0; i < ctrls.count(); i++)
+            values.insert(ctrls.at(i).id, getSettings(ctrls.at(i).id));
+    }
+    return values;
+}
+
 QString Videostreaming::getSettings(unsigned int id) {
     struct v4l2_control c;
     c.id = id;
@@ -2820,12 +4389,40 @@ QString Videostreaming::getSettings(unsigned int id) {
 }
 
 void Videostreaming::changeSettings(unsigned int id, QString value) {
-    struct v4l2_control c;
-    c.id = id;
-    c.value = value.toInt();
-    if (ioctl(VIDIOC_S_CTRL, &c)) {
-        emit logCriticalHandle("Error in setting the Value");
+    QMap<unsigned int, int> values;
+    values.insert(id, value.toInt());
+    applyControls(values);
+}
+
+/**
+ * @brief Videostreaming::applyControls - set the controls with one VIDIOC_S_EXT_CTRLS per control class
+ * @param values - control id, value
+ * @return true - all applied /false - the refused controls are logged
+ */
+bool Videostreaming::applyControls(const QMap<unsigned int, int> &values) {
+    QList<v4l2_ext_control> ctrls, failed;
+    QMap<unsigned int, int>::const_iterator it;
+    for (it = values.constBegin(); it != values.constEnd(); ++it) {
+        v4l2_ext_control ctrl;
+        memset(&ctrl, 0, sizeof(ctrl));
+        ctrl.id = it.key();
+        ctrl.value = it.value();
+        ctrls.append(ctrl);
+    }
+
+    if (s_ext_ctrls(ctrls, &failed)) {
+        for (it = values.constBegin(); it != values.constEnd(); ++it)
+            m_recoveryControls.insert(it.key(), it.value());
+        return true;
+    }
+
+    query_controls();
+    for (int i = 0; i < failed.count(); i++) {
+        v4l2_queryctrl qctrl;
+        QString name = control(failed.at(i).id, qctrl) ? QString((char *)qctrl.name) : QString::number(failed.at(i).id);
+        emit logCriticalHandle("Error in setting the Value of " + name + ": " + QString::number(failed.at(i).value));
     }
+    return false;
 }
 
 
@@ -2833,7 +4430,8 @@ void Videostreaming::selectMenuIndex(unsigned int id, int value) {
     v4l2_queryctrl qctrl;
     v4l2_querymenu qmenu;
     qctrl.id = id;
-    queryctrl(qctrl);
+    if (!query_controls() || !control(id, qctrl))
+        queryctrl(qctrl);
     int i;
     for (i = qctrl.minimum; i <= qctrl.maximum; i++) {
         qmenu.id = qctrl.id;
@@ -2850,7 +4448,8 @@ int Videostreaming::getMenuIndex(unsigned int id,int value) {
     v4l2_queryctrl qctrl;
     v4l2_querymenu qmenu;
     qctrl.id = id;
-    queryctrl(qctrl);
+    if (!query_controls() || !control(id, qctrl))
+        queryctrl(qctrl);
     int i, j = 0;
     for (i = qctrl.minimum; i <= qctrl.maximum; i++) {
         qmenu.id = qctrl.id;
@@ -2866,6 +4465,95 @@ int Videostreaming::getMenuIndex(unsigned int id,int value) {
     return j;
 }
 
+/**
+ * @brief Videostreaming::saveControlProfile - V4L2 controls are read back from the device, the
+ * extension unit state is the journal of hid commands sent to this camera
+ */
+bool Videostreaming::saveControlProfile(QString fileName) {
+    if (fd() < 0 || fileName.isEmpty())
+        return false;
+
+    QSettings profile(fileName, QSettings::IniFormat);
+    profile.clear();
+    profile.setValue("camera", m_session->cameraName);
+
+    query_controls();
+    QMap<__u32, QString> values = getAllSettings();
+    profile.beginGroup("v4l2");
+    QMap<__u32, QString>::const_iterator it;
+    for (it = values.constBegin(); it != values.constEnd(); ++it) {
+        v4l2_queryctrl qctrl;
+        if (control(it.key(), qctrl) && !(qctrl.flags & V4L2_CTRL_FLAG_READ_ONLY))
+            profile.setValue(QString::number(it.key()), it.value().toInt());
+    }
+    profile.endGroup();
+
+    QList<HidSetting> settings = ControlCache::instance()->journal(m_session->hidNode);
+    profile.beginWriteArray("extension", settings.count());
+    for (int i = 0; i < settings.count(); i++) {
+        profile.setArrayIndex(i);
+        profile.setValue("command", QString::fromLatin1(settings.at(i).command.toHex()));
+        profile.setValue("subid", settings.at(i).kind == HID_SETTING_SUBID);
+    }
+    profile.endArray();
+
+    profile.sync();
+    if (profile.status() != QSettings::NoError) {
+        emit logCriticalHandle("Unable to write control profile: " + fileName);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Videostreaming::loadControlProfile - the V4L2 controls are applied with one ioctl per control class,
+ * the extension unit settings are sent without waiting, extensionProfileApplied reports them
+ */
+bool Videostreaming::loadControlProfile(QString fileName) {
+    if (fd() < 0 || !QFile::exists(fileName))
+        return false;
+
+    QSettings profile(fileName, QSettings::IniFormat);
+    if (profile.value("camera").toString() != m_session->cameraName)
+        emit logDebugHandle("Control profile was saved for " + profile.value("camera").toString());
+
+    QMap<unsigned int, int> values;
+    profile.beginGroup("v4l2");
+    QStringList ids = profile.childKeys();
+    for (int i = 0; i < ids.count(); i++)
+        values.insert(ids.at(i).toUInt(), profile.value(ids.at(i)).toInt());
+    profile.endGroup();
+    bool controlsApplied = applyControls(values);
+
+    QList<HidSetting> settings;
+    int count = profile.beginReadArray("extension");
+    for (int i = 0; i < count; i++) {
+        profile.setArrayIndex(i);
+        HidSetting setting;
+        setting.command = QByteArray::fromHex(profile.value("command").toString().toLatin1());
+        setting.kind = profile.value("subid", false).toBool() ? HID_SETTING_SUBID : HID_SETTING;
+        settings.append(setting);
+    }
+    profile.endArray();
+
+    ControlCache *cache = ControlCache::instance();
+    connect(cache, SIGNAL(replayFinished(QString,int,int)), this, SLOT(extensionProfileApplied(QString,int,int)), Qt::UniqueConnection);
+    int sent = cache->replay(m_session->hidNode, m_session->hidFd, settings);
+    if (sent < settings.count())
+        emit logCriticalHandle("Extension unit settings sent: " + QString::number(sent) + " of " + QString::number(settings.count()));
+
+    return controlsApplied && sent == settings.count();
+}
+
+void Videostreaming::extensionProfileApplied(QString device, int answered, int sent) {
+    if (device != m_session->hidNode)
+        return;
+    if (answered < sent)
+        emit logCriticalHandle("Extension unit settings restored: " + QString::number(answered) + " of " + QString::number(sent));
+    else
+        emit logDebugHandle("Extension unit settings restored: " + QString::number(answered));
+}
+
 void Videostreaming::setStillVideoSize(QString stillValue, QString stillFormat) {
     stillSize = stillValue;
     stillOutFormat = stillFormat;
@@ -2885,10 +4573,33 @@ void Videostreaming::setSampleRate(uint index){
 }
 
 void Videostreaming::recordVideo(){
+    videoEncoder->setFrameTime(m_recordFrameNs);
+    bool samples16 = m_renderer->renderBufferFormat == CommonEnums::MONO16_BUFFER_RENDER;
+    if(samples16){
+        // recorded with 8 bits, the top of the 12
+        const uint16_t *src = m_renderer->y16Buffer;
+        for(__u32 i = 0; i < width*height; i++)
+            m_renderer->yBuffer[i] = src[i] >> 4;
+    }
+    if(samples16 || m_renderer->renderBufferFormat == CommonEnums::MONO_BUFFER_RENDER){
+        // neutral chroma for the encoder, used as u and v
+        memset(m_renderer->uBuffer, 0x80, (width/2) * (height/2));
+        uint8_t *planes[3] = { m_renderer->yBuffer, m_renderer->uBuffer, m_renderer->uBuffer };
+        int strides[3] = { (int)width, (int)width/2, (int)width/2 };
+        videoEncoder->encodeYUV420(planes, strides);
+        return;
+    }
+    if(m_renderer->renderBufferFormat == CommonEnums::YUV420_BUFFER_RENDER){
+        uint8_t *planes[3] = { m_renderer->yBuffer, m_renderer->uBuffer, m_renderer->vBuffer };
+        int strides[3] = { (int)width, (int)width/2, (int)width/2 };
+        videoEncoder->encodeYUV420(planes, strides);
+        return;
+    }
     videoEncoder->encodeImage(m_renderer->yuvBuffer, false /* other than rgba format means, false */);
 }
 
-void Videostreaming::recordBegin(int videoEncoderType, QString videoFormatType, QString fileLocation, int audioDeviceIndex, unsigned sampleRate, int channels) { 
+void Videostreaming::recordBegin(int videoEncoderType, QString videoFormatType, QString fileLocation, int audioDeviceIndex, unsigned sampleRate, int channels,
+                                 QString encoderPreset, int gop, int rateControl, int bitRate, int quality) {
     m_VideoRecord = true;
     videoEncoder->pts_prev = 0;     // To clear the previously stored pts value before recording video,so that video lag can be avoided in h264 encoder type.
     if(videoFormatType.isEmpty()) {
@@ -2930,23 +4641,43 @@ void Videostreaming::recordBegin(int videoEncoderType, QString videoFormatType,
 
     if((audioDeviceIndex-1) >= 0){
         audioinput.audio_set_pulseaudio_device(audioDeviceIndex-1);
-        audioinput.audio_start_pulseaudio(videoEncoderObj);
+        if(audioinput.audio_start_pulseaudio(videoEncoderObj) < 0){
+            emit rcdStop("Unable to capture audio from the selected device");
+            return;
+        }
         audio_buffer_data = audioinput.audio_get_buffer();
         audiorecordStart = true;
     }
 
+    EncoderSettings encoderSettings;
+    encoderSettings.preset = encoderPreset;
+    encoderSettings.gop = gop;
+    encoderSettings.rateControl = rateControl;
+    encoderSettings.bitRate = bitRate > 0 ? bitRate : 0;
+    encoderSettings.quality = quality;
+    encoderSettings.ioFlags = m_recordIoFlags;
+    encoderSettings.segmentSeconds = m_segmentMinutes * 60;
+    encoderSettings.segmentBytes = (qint64)m_segmentMegabytes * 1024 * 1024;
+
 #if LIBAVCODEC_VER_AT_LEAST(54,25)
-    bool tempRet = videoEncoder->createFile(fileName,(AVCodecID)videoEncoderType, m_capDestFormat.fmt.pix.width,m_capDestFormat.fmt.pix.height,temp_interval.denominator,temp_interval.numerator,10000000, audioDeviceIndex, sampleRate, channels);
+    bool tempRet = videoEncoder->createFile(fileName,(AVCodecID)videoEncoderType, m_capDestFormat.fmt.pix.width,m_capDestFormat.fmt.pix.height,temp_interval.denominator,temp_interval.numerator,10000000, audioDeviceIndex, sampleRate, channels, encoderSettings);
 #else
-    bool tempRet = videoEncoder->createFile(fileName,(CodecID)videoEncoderType, m_capDestFormat.fmt.pix.width,m_capDestFormat.fmt.pix.height,temp_interval.denominator,temp_interval.numerator,10000000, audioDeviceIndex, sampleRate, channels);
+    bool tempRet = videoEncoder->createFile(fileName,(CodecID)videoEncoderType, m_capDestFormat.fmt.pix.width,m_capDestFormat.fmt.pix.height,temp_interval.denominator,temp_interval.numerator,10000000, audioDeviceIndex, sampleRate, channels, encoderSettings);
 #endif
     if(!tempRet){
         emit rcdStop("Unable to record the video");
     }
+    else if(audiorecordStart){
+        m_audioEncodeWorker->start(videoEncoder, audio_buffer_data);
+    }
 }
 
 void Videostreaming::recordStop() {    
-    emit videoRecord(fileName);
+    // a segmented recording is saved as <name>_NNN files listed in the index
+    QString savedName = fileName;
+    if(videoEncoder != NULL && videoEncoder->muxWriter()->isSegmented())
+        savedName = videoEncoder->muxWriter()->indexFile();
+    emit videoRecord(savedName);
     m_VideoRecord = false;
     videoEncoder->m_recStop = true;
 
@@ -2954,7 +4685,10 @@ void Videostreaming::recordStop() {
         if(audioinput.audio_context->stream_flag == AUDIO_STRM_ON)
             audioinput.audio_stop_pulseaudio();
 
+        // waits for an encode in progress on the audio thread
+        m_audioEncodeWorker->stop();
         audioinput.audio_delete_buffer(audio_buffer_data);
+        audio_buffer_data = NULL;
     }
 
     audiorecordStart = false;
@@ -2965,20 +4699,6 @@ void Videostreaming::recordStop() {
     }
 }
 
-void Videostreaming::doEncodeAudio(){
-    if(m_VideoRecord){        
-        if(audio_buffer_data != NULL){            
-            int ret = audioinput.audio_get_next_buffer(audio_buffer_data);
-            if(ret > 0){
-
-            }
-            if(ret== 0){                
-                videoEncoder->encodeAudio(audio_buffer_data->data);
-            }
-        }
-    }
-}
-
 
 void Videostreaming::stopUpdatePreview() {
     m_renderer->updateStop = true;
@@ -2997,7 +4717,7 @@ void Videostreaming::masterModeEnabled() {
  */
 void Videostreaming::selectedCameraEnum(CommonEnums::ECameraNames selectedDeviceEnum)
 {
-    currentlySelectedCameraEnum = selectedDeviceEnum;
+    CameraSession::selected()->cameraEnum = selectedDeviceEnum;
 }
 
 /**
@@ -3044,27 +4764,143 @@ void Videostreaming::switchToStillPreviewSettings(bool stillSettings){
 
     if (!((stillSize == lastPreviewSize) && (stillOutFormat == lastFormat)))
     {
-        resolnSwitch();   //Replaced stopCapture() with resolnSwitch() inorder to get preview in higher resolns while using Retrieve button.
         if(stillSettings){
             makeSnapShot = true;
             retrieveShot =true;
             m_renderer->updateStop = true;
-            vidCapFormatChanged(stillOutFormat);
-
-            setResoultion(stillSize);
-            m_renderer->renderBufferFormat = CommonEnums::NO_RENDER;
         }
         else{
             retrieveShot = false;
+        }
+        m_renderer->renderBufferFormat = CommonEnums::NO_RENDER;
+        if(fastStillSwitch(stillSettings))
+            return void();
 
+        resolnSwitch();   //Replaced stopCapture() with resolnSwitch() inorder to get preview in higher resolns while using Retrieve button.
+        if(stillSettings){
+            vidCapFormatChanged(stillOutFormat);
+            setResoultion(stillSize);
+        }
+        else{
             vidCapFormatChanged(lastFormat);
             setResoultion(lastPreviewSize);
-            m_renderer->renderBufferFormat = CommonEnums::NO_RENDER;
         }
+        m_renderer->renderBufferFormat = CommonEnums::NO_RENDER;
          startAgain();
     }
 }
 
+void Videostreaming::setStreamRecovery(bool enable)
+{
+    m_recoveryEnabled = enable;
+    if (!enable && m_recovery.isWatching()) {
+        m_recovery.stop();
+        recoveryTimedOut();
+    }
+}
+
+/**
+ * @brief Videostreaming::beginRecovery - the capture buffers are already freed, wait for the
+ * camera instead of reporting it unplugged. A recording stays open.
+ * @return false if recovery is disabled
+ */
+bool Videostreaming::beginRecovery()
+{
+    if (!m_recoveryEnabled || m_cardName.isEmpty())
+        return false;
+    m_recoveryFirstFrame = false;
+    m_recoveryTimer.invalidate();
+    m_recovery.watch(m_cardName, m_busInfo);
+    emit logCriticalHandle("Capture failed, waiting for " + m_cardName + " to come back");
+    emit streamRecovering();
+    return true;
+}
+
+/**
+ * @brief Videostreaming::recoverDevice - open the returned node and start streaming with the
+ * format, frame interval and controls of the lost stream
+ * @param videoNode - /dev/videoN, N may differ from the lost node
+ */
+void Videostreaming::recoverDevice(QString videoNode)
+{
+    // from the first time the camera was seen back, attempts on a node still going away included
+    if (!m_recoveryTimer.isValid())
+        m_recoveryTimer.start();
+    // decoder and render buffers of the lost stream
+    stopCapture();
+
+    m_session->deviceNumber = videoNode.mid(QString("/dev/video").length()).toInt();
+    if (!openDevice("/dev/video")) {
+        m_recovery.retry();
+        return;
+    }
+
+    v4l2_format fmt;
+    bool formatSet = getCaptureFormat(fmt);
+    if (formatSet) {
+        fmt.fmt.pix.pixelformat = m_pixelformat;
+        fmt.fmt.pix.width = m_width;
+        fmt.fmt.pix.height = m_height;
+        formatSet = tryCaptureFormat(fmt) && setCaptureFormat(fmt) &&
+                    fmt.fmt.pix.pixelformat == m_pixelformat && fmt.fmt.pix.width == m_width && fmt.fmt.pix.height == m_height;
+    }
+    if (!formatSet) {
+        emit logCriticalHandle("Recovery: " + videoNode + " refused the format, trying again");
+        closeDevice();
+        m_recovery.retry();
+        return;
+    }
+
+    // copy, applyControls updates m_recoveryControls
+    QMap<unsigned int, int> values = m_recoveryControls;
+    applyControls(values);
+
+    // the interval is set again by displayFrame
+    m_renderer->renderBufferFormat = CommonEnums::NO_RENDER;
+    startAgain();
+    if (m_buffers == NULL) {
+        closeDevice();
+        m_recovery.retry();
+        return;
+    }
+    m_recovery.stop();
+    m_recoveryFirstFrame = true;
+
+    if (m_VideoRecord) {
+        if (videoEncoder->requestSegment())
+            emit logDebugHandle("Recording continues in a new segment");
+        else
+            emit logDebugHandle("Recording continues in the same file");
+    }
+}
+
+void Videostreaming::recoveryTimedOut()
+{
+    emit logCriticalHandle("Camera did not come back in " + QString::number(RECOVERY_TIMEOUT_MS) + " ms");
+    emit deviceUnplugged("Disconnected","Device Not Found");
+    emit logCriticalHandle("Device disconnected");
+}
+
+/**
+ * @brief Videostreaming::saveRecoveryControls - values of the writable controls, they can't be
+ * read once the camera is lost. Inactive controls [manual values under an auto mode] are left out.
+ */
+void Videostreaming::saveRecoveryControls()
+{
+    if (!m_recoveryEnabled)
+        return;
+    m_recoveryControls.clear();
+    query_controls();
+    QMap<__u32, QString> values = getAllSettings();
+    QMap<__u32, QString>::const_iterator it;
+    for (it = values.constBegin(); it != values.constEnd(); ++it) {
+        v4l2_queryctrl qctrl;
+        if (control(it.key(), qctrl) &&
+            !(qctrl.flags & (V4L2_CTRL_FLAG_READ_ONLY | V4L2_CTRL_FLAG_INACTIVE | V4L2_CTRL_FLAG_VOLATILE)))
+            m_recoveryControls.insert(it.key(), it.value().toInt());
+    }
+}
+
 // To emit a signal that capture frame time out
 void Videostreaming::doCaptureFrameTimeout()
 {
@@ -38,10 +38,21 @@
 #include "h264decoder.h"
 #include "audioinput.h"
 #include "uvccamera.h"
+#include "camerasession.h"
+#include "framesync.h"
+#include "bandwidthplanner.h"
+#include "settledetector.h"
+#include "streamrecovery.h"
 #include "common_enums.h"
 #include"fscam_cu135.h"
+#include "framepool.h"
+#include "frameexport.h"
+#include "streamserver.h"
+#include "uvcmetadata.h"
 #include <linux/uvcvideo.h>
 
+#include <QElapsedTimer>
+
 #include <QtQuick/QQuickItem>
 #include <QtGui/QOpenGLFunctions>
 #include <QOpenGLShaderProgram>
@@ -77,6 +88,12 @@ public:
     // Convert YUYV  to RGB and draw
     void drawYUYVBUffer();
 
+    // Draw the y buffer [y16 buffer for MONO16] as grey, one texture, window/level and gamma applied
+    void drawMonoBuffer();
+
+    // Demosaic the grbg plane of the y buffer in the shader, white balance gains applied
+    void drawBayerBuffer();
+
     // opengl context
     QOpenGLContext *m_context;
 
@@ -85,6 +102,7 @@ public:
     uint8_t *uBuffer;
     uint8_t *vBuffer;
     uint8_t *yuvBuffer;
+    uint16_t *y16Buffer;    // 12 bit mono samples, MONO16_BUFFER_RENDER
       __u32 xcord;
     unsigned frame;
 
@@ -122,7 +140,6 @@ public slots:
 
     // spilit yuyv buffer to y,u,v buffer
     void fillBuffer();
-    void selectedCameraEnum(CommonEnums::ECameraNames selectedDeviceEnum);
 
 public:
     QSize m_viewportSize;
@@ -130,13 +147,22 @@ public:
     int previewBgrdAreaWidth;
 
     bool sidebarAvailable; // left sidebar items [settings] availability in UI
+    QRect tileArea;        // preview tile of a further camera, window coordinates. Empty for the main preview
     int sidebarWidth;      // left side bar width
     bool updateStop;
     bool getPreviewFrameWindow;
 
+    // mono preview mapping, fractions of the sample range: black and white end of the window, gamma
+    float monoBlack, monoWhite, monoGamma;
+
+    // white balance of the bayer preview, r g b
+    float bayerGain[3];
+
     // shader programs
     QOpenGLShaderProgram *m_programRGB; // RGBA shader
     QOpenGLShaderProgram *m_programYUYV; // YUYV shader
+    QOpenGLShaderProgram *m_programMono; // luma only shader
+    QOpenGLShaderProgram *m_programBayer; // grbg demosaic shader
 
 private:    
     qreal m_t;
@@ -153,14 +179,26 @@ private:
     GLint samplerLocV;
 
     GLint samplerLocRGB;
+    GLint samplerLocMono;
+    GLint monoScaleLoc, monoBlackLoc, monoWhiteLoc, monoGammaLoc;
+    GLuint m_monoTexture;
+    bool m_luminance16;     // 16 bit luminance textures, not on OpenGL ES
 
-     static CommonEnums::ECameraNames currentlySelectedEnumValue;
+    GLint samplerLocBayer;
+    GLint bayerSizeLoc, bayerTexelLoc, bayerGainLoc;
+    GLuint m_bayerTexture;
+
+    void setPreviewViewport();
+
+    // camera of the Videostreaming item this renderer draws
+    CameraSession *m_session;
 };
 
 class Videostreaming :  public QQuickItem, public v4l2
 {
     Q_OBJECT
     Q_PROPERTY(qreal t READ t WRITE setT NOTIFY tChanged)
+    Q_PROPERTY(QObject *session READ session NOTIFY sessionChanged)
 public:
     struct buffer {
         unsigned planes;
@@ -176,11 +214,9 @@ public:
 
     QString fileName;
 
-    static QStringListModel resolution;
-    static QStringListModel stillOutputFormat;
-    static QStringListModel videoOutputFormat;
-    static QStringListModel fpsList;    
-    static QStringListModel encoderList;
+    // camera previewed by this item, its format lists are the models of the settings pages
+    QObject *session() const { return m_session; }
+    CameraSession *cameraSession() const { return m_session; }
      QTimer m_timer;
 
     void displayFrame();
@@ -211,6 +247,10 @@ public:
 
     bool findNativeFormat(__u32 format, QImage::Format &dstFmt);
     bool startCapture();
+
+    // capture buffer accounting - queued to driver vs owned by userspace
+    uint queuedBufferCount() const { return m_queuedBuffers; }
+    uint userspaceBufferCount() const { return m_nbuffers - m_queuedBuffers - m_parkedBuffers.count(); }
     bool retrieveFrame;
 
     bool getPreviewWindow;
@@ -236,6 +276,7 @@ public:
     H264Decoder *h264Decode;
     AudioInput audioinput;
     audio_buff_t *audio_buffer_data;
+    AudioEncodeWorker *m_audioEncodeWorker; // encodes captured audio off the GUI thread
     bool audiorecordStart;
     bool SkipIfPreviewFrame;
     QMutex recordMutex;
@@ -258,6 +299,16 @@ public:
     uint previewFrameToSkip;
     bool skippingPreviewFrame;
 
+    // frames are taken once exposure and white balance settled, the skip counts are the upper bound
+    SettleDetector m_settle;
+    bool m_settleDetection;
+
+    // sgrbg8 preview demosaiced by the renderer, the cpu demosaics only for recording
+    bool m_bayerPreview;
+
+    // CLOCK_MONOTONIC ns of the frame being processed, 0 if unknown
+    qint64 frameCaptureTime() const { return m_frameCaptureNs; }
+
 private:
     qreal m_t;
     __u8 m_bufReqCount;
@@ -314,6 +365,24 @@ private:
     struct v4l2_fract interval;
     struct v4l2_format m_capSrcFormat;
     struct v4l2_format m_capDestFormat;
+
+    // multi-planar capture - m_capSrcFormat holds the single-planar view of m_planeFormat
+    struct v4l2_format m_planeFormat;
+    uint8_t *m_framePlane[3];       // y, u, v of the frame being prepared [u holds uv of nv12/nv21]
+    int m_framePlaneStride[3];
+    QByteArray m_planeCopy;         // planes of a frame packed for consumers of contiguous frames
+
+    // usb bus of the camera, bandwidth of the running stream is reserved on it
+    UsbLink m_usbLink;
+    bool m_usbLinkValid;
+
+    // the stream is restarted when the camera comes back after a capture error [usb reset]
+    StreamRecovery m_recovery;
+    bool m_recoveryEnabled;
+    bool m_recoveryFirstFrame;          // restarted, the outage is logged with the first frame
+    QElapsedTimer m_recoveryTimer;      // camera back -> first frame
+    QString m_cardName, m_busInfo;      // querycap of the open node, identify it after a reset
+    QMap<unsigned int, int> m_recoveryControls;     // writable controls of the running stream
     v4l2_format copy;
 
     struct v4lconvert_data *m_convertData;
@@ -341,16 +410,72 @@ private:
     unsigned m_size;
 
     uint m_nbuffers;    
-    static int deviceNumber;
-    static QString camDeviceName;
+
+    // Added for adaptive capture buffer count
+    uint m_captureBufferCount;      // requested buffer count, 0 - derive from fps and frame size
+    bool m_adaptiveBuffers;         // grow/shrink the buffer count while streaming
+    size_t m_bufferMemoryBudget;    // upper limit of memory used by capture buffers
+    uint m_learnedBufferCount;      // count settled by the adaptive logic, reused on next stream start
+    uint m_queuedBuffers;           // buffers currently owned by the driver
+    QList<uint> m_parkedBuffers;    // buffers held back from the driver after shrinking
+    uint m_parkRequest;             // number of buffers still to be parked
+    __u32 m_lastSequence;
+    bool m_sequenceValid;
+    uint m_adaptFrames;             // frames seen in the current adaptation window
+    uint m_sequenceGaps;            // frames dropped by the driver in the current window
+    qint64 m_processingNsecs;       // total capFrame processing time in the current window
+    uint m_idleWindows;             // consecutive windows without drops and with low latency
+    qint64 m_framePeriodNsecs;      // frame interval of the running stream
+    QElapsedTimer m_processingTimer;
+
+    // Added for capture into pool owned memory [USERPTR/DMABUF]
+    __u32 m_captureMemory;          // memory type requested for next stream start
+    __u32 m_bufferMemory;           // memory type of the running stream
+    FramePool m_framePool;
+    QVector<int> m_bufferSlot;      // pool slot currently attached to each buffer index
+    QList<uint> m_starvedBuffers;   // buffer indexes waiting for a free pool slot
+    int m_currentSlot;              // pool slot of the frame being processed in capFrame
+    int m_decodeSlot;               // pool slot retained by the running jpeg decode
+
+    // Added for exporting frames to other processes through shared memory
+    FrameExport m_frameExport;
+    bool m_frameExportEnabled;
+    int m_recordIoFlags;                // MUX_IO_* of the next recording
+    int m_segmentMinutes;               // segment limits of the next recording, 0 - unlimited
+    int m_segmentMegabytes;
+    QString m_frameExportName;
+
+    // Added for capture time of frames [UVC metadata node or driver timestamp]
+    UvcMetadata m_uvcMetadata;
+    bool m_hwTimestamps;                // stream the metadata node with the video
+    QString m_metadataReplay;           // recorded metadata stream used instead of the device
+    qint64 m_frameCaptureNs;            // CLOCK_MONOTONIC capture time of the frame in capFrame, 0 - unknown
+    qint64 m_decodeFrameNs;             // capture time of the frame handed to jpegDecode
+    qint64 m_recordFrameNs;             // capture time of the frame handed to recordVideo
+    qint64 m_latencySum, m_latencyMax;
+    uint m_latencyFrames;
+    QElapsedTimer m_latencyTimer;
+    void updateFrameTime(const v4l2_buffer &buf);
+
+    // Added for serving compressed frames over HTTP
+    StreamServer m_streamServer;
+
+    // Added for switching between still and preview settings without a full restart
+    bool m_fastStillSwitch;             // use the fast switch when both formats validate
+    bool m_stillSwitchValid;            // m_stillSwitchFormat matches m_stillSwitchKey
+    QString m_stillSwitchKey;           // still/preview size and format the formats were validated for
+    v4l2_format m_stillSwitchFormat[2]; // validated formats: [0] preview, [1] still
+    size_t m_stillSwitchFrameSize;      // larger sizeimage of the two formats
+    size_t m_renderBufferPixels;        // pixels the renderer/conversion buffers are allocated for
+
+    CameraSession *m_session;
+    CameraSession *m_ownSession;        // created by newSession, NULL while on the first session
+    QRect m_tileArea;                   // see setTileArea
+    bool m_frameSync;                   // frames go to the FrameSynchronizer
 
     unsigned char  *y16BayerDestBuffer;
 	bool y16BayerFormat;
     unsigned char* rgb_image;
- /**
-     * @brief currentlySelectedCameraEnum - This contains currently selected camera enum value
-     */
-    static CommonEnums::ECameraNames currentlySelectedCameraEnum;
 
     uint m_burstLength;
     uint m_burstNumber;
@@ -365,12 +490,43 @@ private:
     bool frameSkip;
 
     QString getSettings(unsigned int);
+    QMap<__u32, QString> getAllSettings();
     void getFrameRates();
     void updateVidOutFormat();
     void tmpMsgBox(QString);
     bool getInterval(struct v4l2_fract &interval);
 
     int findMax(QList<int> *llist);
+
+    uint initialCaptureBufferCount();
+    bool mapCaptureBuffers(uint first, uint count);
+    bool isMultiPlanar() const { return V4L2_TYPE_IS_MULTIPLANAR(m_buftype); }
+    bool getCaptureFormat(v4l2_format &fmt);
+    bool setCaptureFormat(v4l2_format &fmt);
+    bool tryCaptureFormat(v4l2_format &fmt);
+    void *mapFramePlanes(v4l2_buffer &buf, bool contiguous);
+    void copyYUV420Planes(__u32 pixformat);
+    void monoStillSource();
+    void updateSettle(const void *frame, bool decoded);
+    bool stillFrameReady();
+    bool openDevice(QString deviceName);
+    void bindSessionModels();
+    bool beginRecovery();
+    void saveRecoveryControls();
+    bool growCaptureBuffers(uint count);
+    bool dequeueCaptureBuffer(v4l2_buffer &buf, bool &again);
+    bool queueCaptureBuffer(v4l2_buffer &buf);
+    bool drainCaptureBuffers(v4l2_buffer &buf);
+    bool queueBufferIndex(uint index);
+    AVBufferRef *poolFrameRef(void *data, __u32 bytesUsed);
+    bool requestPoolBuffers(uint count);
+    void freeCaptureBuffers(bool keepPool = false);
+    void openFrameExport();
+    bool prepareStillSwitch();
+    bool fastStillSwitch(bool stillSettings);
+    bool applyStillSwitchFormat(const v4l2_format &fmt);
+    void allocRenderBuffers(uint bufWidth, uint bufHeight);
+    void adaptCaptureBuffers(const v4l2_buffer &buf);
     void freeBuffers(unsigned char *destBuffer,unsigned char *copyBuffer);
 
     void getFileName(QString filePath,QString imgFormatType);
@@ -389,6 +545,9 @@ private:
 
 private slots:
     void handleWindowChanged(QQuickWindow *win); 
+    void recoverDevice(QString videoNode);
+    void recoveryTimedOut();
+    void extensionProfileApplied(QString device, int answered, int sent);
 
 public slots:
      void switchToStillPreviewSettings(bool stillSettings);
@@ -396,6 +555,11 @@ public slots:
     void sync();
     void cleanup();   
     void setPreviewBgrndArea(int width, int height, bool sidebarAvailable);
+    /**
+     * @brief setTileArea - draw the preview of this item into a tile of the window instead of the
+     * preview area, for items with a session of their own
+     */
+    void setTileArea(int x, int y, int width, int height);
     void enumerateAudioProperties();
     void setChannelCount(uint index);
     void setSampleRate(uint index);
@@ -543,6 +707,27 @@ public slots:
      */
     void selectMenuIndex(unsigned int id, int value);
 
+    /**
+     * @brief applyControls - set several camera controls at once, one ioctl per control class
+     * @param values - control id, value
+     */
+    bool applyControls(const QMap<unsigned int, int> &values);
+
+    /**
+     * @brief saveControlProfile - save the camera controls and the extension unit settings
+     * sent so far to a profile file
+     * @param fileName - ini file to write
+     * @return true - saved /false - failure
+     */
+    bool saveControlProfile(QString fileName);
+
+    /**
+     * @brief loadControlProfile - apply a profile written by saveControlProfile
+     * @param fileName - ini file to read
+     * @return true - every control applied /false - failure
+     */
+    bool loadControlProfile(QString fileName);
+
 
     void vidCapFormatChanged(QString idx);
     void setStillVideoSize(QString stillValue,QString stillFormat);
@@ -570,8 +755,14 @@ public slots:
      *
      * @param fileLocation - Location where the recorded file is saved
      * @param - audioDeviceIndex  - audio device index
+     * @param encoderPreset - x264 preset of the H264 encoder
+     * @param gop - maximal interval in frames between keyframes
+     * @param rateControl - ENCODER_RC_DEFAULT/CBR/VBR/CRF/CQP
+     * @param bitRate - bits/s for CBR and VBR, 0 - derived from the frame size
+     * @param quality - crf/qp for H264, quantizer scale for MJPEG
      */
-    void recordBegin(int videoEncoderType, QString videoFormatType, QString fileLocation, int audioDeviceIndex, unsigned sampleRate, int channels);
+    void recordBegin(int videoEncoderType, QString videoFormatType, QString fileLocation, int audioDeviceIndex, unsigned sampleRate, int channels,
+                     QString encoderPreset = "ultrafast", int gop = 12, int rateControl = ENCODER_RC_DEFAULT, int bitRate = 0, int quality = 23);
 
     /**
      * @brief This function should be called to stop the video recording
@@ -597,8 +788,74 @@ public slots:
      */
     void selectedCameraEnum(CommonEnums::ECameraNames selectedDeviceEnum);
 
+    /**
+     * @brief Give this item a camera session of its own and select it, the camera picked next
+     * in the camera list and its extension unit controls go to this item. Other items keep
+     * streaming their cameras.
+     */
+    void newSession();
+
+    /**
+     * @brief Point the camera list and the extension unit control pages at the camera of this item
+     */
+    void selectSession();
+
+    /**
+     * @brief Pass the frames of this camera to the frame synchronizer, which groups them with
+     * the frames of the other cameras taking part [FrameSynchronizer::frameSet]
+     */
+    void setFrameSync(bool enable);
+
+    /**
+     * @brief Settings of the frame synchronizer, shared by all cameras
+     * @param toleranceMs - largest capture time difference inside a frame set
+     * @param duplicateMissing - repeat the last frame of a camera missing from a set instead of
+     * dropping the frames of the others
+     */
+    void setFrameSyncSettings(qreal toleranceMs, bool duplicateMissing);
+
+    /**
+     * @brief Pick the format for a frame size and rate which fits the usb bandwidth left by the
+     * other cameras on the bus with the least cpu work. The choice and the reason are sent
+     * with captureFormatPlanned, the format/fps lists are not changed.
+     * @param resolution - "<width>x<height>"
+     * @param fps - requested frame rate, a lower rate is picked if nothing fits at it
+     * @return false if the camera offers no format at this size
+     */
+    bool planCaptureFormat(QString resolution, uint fps);
+
     void updateFrameToSkip(uint stillSkip);
 
+    /**
+     * @brief Take stills and end the preview frame skip as soon as luma and colour statistics
+     * of the frames stop changing, instead of always waiting the full skip count
+     */
+    void setSettleDetection(bool enable);
+
+    /**
+     * @brief Window/level and gamma of the mono preview [grey, y12, y16], applied in the shader
+     * to the full sample depth. Stills and recordings are not changed.
+     * @param level - centre of the window, 0.0 - 1.0 of the sample range
+     * @param window - width of the window, 1.0 - whole range
+     * @param gamma - 1.0 linear, > 1.0 brightens the shadows
+     */
+    void setPreviewWindowLevel(qreal level, qreal window, qreal gamma);
+
+    /**
+     * @brief Demosaic the preview of bayer [sgrbg8] cameras in the shader instead of on the cpu.
+     * Stills are still converted by libv4lconvert and recordings by the cpu demosaic.
+     * @param enable - false: cpu demosaic to yuyv, the default
+     * @param redGain, greenGain, blueGain - white balance of the shader preview, 1.0 unchanged
+     */
+    void setBayerPreview(bool enable, qreal redGain, qreal greenGain, qreal blueGain);
+
+    /**
+     * @brief Reopen the camera with the same format, fps and controls when capture fails and it
+     * comes back within RECOVERY_TIMEOUT_MS, instead of reporting it unplugged. A recording
+     * continues, a segmented one in a new segment.
+     */
+    void setStreamRecovery(bool enable);
+
     void updatePreviewFrameSkip(uint previewSkip);
     void setSkipPreviewFrame(bool skipFrame);
 
@@ -608,7 +865,83 @@ public slots:
     // Set the uvc extension control value
     bool setUvcExtControlValue(struct uvc_xu_control_query xquery);
 
-    void doEncodeAudio();
+    /**
+     * @brief Set the number of capture buffers requested on next stream start
+     * @param count - number of buffers, 0 - derive from frame rate and frame size
+     */
+    void setCaptureBufferCount(uint count);
+
+    /**
+     * @brief Enable/disable growing and shrinking the capture buffer count while streaming
+     * @param adaptive - true to adapt on measured latency and dropped frames
+     */
+    void setAdaptiveBufferCount(bool adaptive);
+
+    /**
+     * @brief Set the memory budget for capture buffers
+     * @param megaBytes - maximum memory used by all capture buffers
+     */
+    void setBufferMemoryBudget(uint megaBytes);
+
+    /**
+     * @brief Select the capture memory type used on next stream start
+     * @param memoryType - "mmap", "userptr" or "dmabuf"
+     */
+    void setCaptureMemory(QString memoryType);
+
+    /**
+     * @brief Publish every captured frame to the shared memory ring "/qtcam-<name>"
+     * @param enable - true to publish frames
+     * @param name - ring name, empty to use the video node name [ex: video0]
+     */
+    void setFrameExport(bool enable, QString name);
+
+    /**
+     * @brief Select how the next recordings are written to disk
+     * @param directIo - O_DIRECT, bypass the page cache for the bulk of the file
+     * @param periodicSync - start writeback every few MB instead of in one late flush
+     */
+    void setRecordFileIo(bool directIo, bool periodicSync);
+
+    /**
+     * @brief Split the next recordings into files of limited length or size, without losing
+     * frames at the cuts. Segments are listed in <name>.csv next to them.
+     * @param minutes - start a new file every this many minutes, 0 - no time limit
+     * @param megabytes - start a new file after this many MB, 0 - no size limit
+     */
+    void setRecordSegments(int minutes, int megabytes);
+
+    /**
+     * @brief Take the capture time of each frame from the UVC metadata node of the camera,
+     * if it has one, from the next stream start. Recording timestamps and the frameLatency
+     * signal use it, otherwise they fall back to the driver timestamp.
+     * @param enable - stream the metadata node with the video
+     * @param replayFile - metadata stream recorded with setMetadataDump, used instead of the camera
+     */
+    void setHardwareTimestamps(bool enable, QString replayFile = QString());
+
+    /**
+     * @brief Record the metadata buffers of the next streams to a file, empty to stop
+     */
+    void setMetadataDump(QString fileName);
+
+    /**
+     * @brief Start the HTTP stream endpoint [/mjpeg, /h264]
+     * MJPEG/H264 camera formats are passed through, other formats are served from the
+     * video encoder while recording with MJPEG or H264 encoder.
+     * @param port - tcp port
+     * @param loopbackOnly - true to accept only local clients
+     * @return true - success /false - failure
+     */
+    bool startStreamServer(uint port, bool loopbackOnly);
+    void stopStreamServer();
+
+    /**
+     * @brief Switch still/preview settings with STREAMOFF/S_FMT/REQBUFS/STREAMON only,
+     * keeping renderer buffers allocated for the larger of both resolutions
+     * @param enable - false to always stop and restart the preview
+     */
+    void setFastStillSwitch(bool enable);
 
 signals:
 
@@ -618,6 +951,8 @@ signals:
     // from qml file , rendering animation duration t changed
     void tChanged();
 
+    void sessionChanged();
+
     void captureVideo();
 
     // Added by Sankari: 12 Feb 2018
@@ -630,7 +965,21 @@ signals:
     void enableCaptureAndRecord();
     void newControlAdded(QString ctrlName,QString ctrlType,QString ctrlID,QString ctrlStepSize = "0",QString ctrlMinValue= "0", QString ctrlMaxValue = "0",QString ctrlDefaultValue="0", QString ctrlHardwareDefault="0");
     void deviceUnplugged(QString _title,QString _text);    
+    // capture failed, deviceUnplugged follows if the camera does not come back
+    void streamRecovering();
+    void streamRecovered(qreal outageMs, qreal recoveryMs);
     void averageFPS(unsigned fps);
+    void captureBufferStatus(uint queued, uint userspace, uint total);
+    void streamClientCount(int clients);
+    // disk throughput and packets waiting for the muxer while recording
+    void recordWriteStats(qreal writeMBps, int queuedPackets, qreal queuedMB);
+    void stillSwitchTime(bool stillSettings, int msecs);
+    // capture to processing delay of the frames, every second while streaming
+    void frameLatency(qreal averageMs, qreal maxMs);
+    // capture time spread of the synchronized frame sets, every second while synchronizing
+    void frameSyncStats(qreal meanSkewMs, qreal maxSkewMs, int sets, int dropped, int duplicated);
+    // result of planCaptureFormat, indexes of the format and fps lists
+    void captureFormatPlanned(int formatIndex, QString resolution, int fpsIndex, QString explanation);
     void defaultStillFrameSize(unsigned int outputIndexValue);
     void defaultFrameSize(unsigned int outputIndexValue, unsigned int  defaultWidth, unsigned int defaultHeight);
     void defaultOutputFormat(unsigned int formatIndexValue);